@@ -67,6 +67,13 @@ public:
   /// aggressively to deallocate.
   void SetPolicy(std::unique_ptr<MemoryPolicy> policy);
 
+  /// Add a manager of memory from outside of this library, e.g., views.
+  /// The supervisor owns its managers; if one with the same name is already
+  /// registered, \p manager is dropped. Returns the registered manager.
+  Manager* Register(std::unique_ptr<Manager> manager);
+  /// The registered manager named \p name, or nullptr if there is none
+  Manager* GetManager(const std::string& name);
+
   /// Provide access to a property manager, which manages the property cache
   PropertyManager* GetPropertyManager();
   CacheStats GetPropertyCacheStats() const;
@@ -20,7 +20,10 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PARALLELSTL_H_
 #define KATANA_LIBGALOIS_KATANA_PARALLELSTL_H_
 
+#include <algorithm>
 #include <iterator>
+#include <type_traits>
+#include <vector>
 
 #include "katana/Chunk.h"
 #include "katana/LoopsDecl.h"
@@ -274,6 +277,101 @@ sort(RandomAccessIterator first, RandomAccessIterator last) {
           typename std::iterator_traits<RandomAccessIterator>::value_type>());
 }
 
+/**
+ * Stable sort of [values, values + size) by the unsigned integer keys in
+ * [keys, keys + size), least significant byte first. Both ranges end up
+ * sorted by key. Only the low key_bits bits of the keys are sorted on, and
+ * passes over a byte that is the same for all keys are skipped.
+ *
+ * Unlike sort, the work of each pass is split evenly among threads however
+ * the keys are distributed, at the cost of a temporary copy of both ranges.
+ */
+template <class KeyIt, class ValueIt>
+void
+radix_sort_by_key(
+    KeyIt keys, ValueIt values, size_t size, unsigned key_bits = 64) {
+  using Key = typename std::iterator_traits<KeyIt>::value_type;
+  using Value = typename std::iterator_traits<ValueIt>::value_type;
+  static_assert(
+      std::is_integral_v<Key> && std::is_unsigned_v<Key>,
+      "radix_sort_by_key requires unsigned integer keys");
+
+  constexpr unsigned kDigitBits = 8;
+  constexpr size_t kNumBuckets = size_t{1} << kDigitBits;
+  key_bits = std::min<unsigned>(key_bits, sizeof(Key) * 8);
+  if (size <= 1 || key_bits == 0) {
+    return;
+  }
+
+  std::vector<Key> key_buf(size);
+  std::vector<Value> value_buf(size);
+  // Either the caller's ranges or the buffers, whichever holds the data
+  bool in_buf = false;
+
+  const unsigned num_threads = getActiveThreads();
+  // counts[tid * kNumBuckets + digit] is the number of keys with digit in the
+  // block of tid, and then where the block puts its first key with digit
+  std::vector<size_t> counts(num_threads * kNumBuckets);
+
+  for (unsigned shift = 0; shift < key_bits; shift += kDigitBits) {
+    auto digit_of = [&](const Key& key) {
+      return static_cast<size_t>((key >> shift) & (kNumBuckets - 1));
+    };
+
+    std::fill(counts.begin(), counts.end(), size_t{0});
+    on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] = block_range(size_t{0}, size, tid, total);
+      size_t* local = &counts[tid * kNumBuckets];
+      for (size_t i = begin; i < end; ++i) {
+        local[digit_of(in_buf ? key_buf[i] : keys[i])] += 1;
+      }
+    });
+
+    // Digits major, threads minor, so that the sort is stable
+    size_t offset = 0;
+    bool single_bucket = false;
+    for (size_t digit = 0; digit < kNumBuckets; ++digit) {
+      size_t digit_start = offset;
+      for (unsigned tid = 0; tid < num_threads; ++tid) {
+        size_t count = counts[tid * kNumBuckets + digit];
+        counts[tid * kNumBuckets + digit] = offset;
+        offset += count;
+      }
+      single_bucket = single_bucket || (offset - digit_start == size);
+    }
+    if (single_bucket) {
+      continue;
+    }
+
+    on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] = block_range(size_t{0}, size, tid, total);
+      size_t* local = &counts[tid * kNumBuckets];
+      for (size_t i = begin; i < end; ++i) {
+        if (in_buf) {
+          size_t dst = local[digit_of(key_buf[i])]++;
+          keys[dst] = key_buf[i];
+          values[dst] = std::move(value_buf[i]);
+        } else {
+          size_t dst = local[digit_of(keys[i])]++;
+          key_buf[dst] = keys[i];
+          value_buf[dst] = std::move(values[i]);
+        }
+      }
+    });
+    in_buf = !in_buf;
+  }
+
+  if (in_buf) {
+    on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] = block_range(size_t{0}, size, tid, total);
+      for (size_t i = begin; i < end; ++i) {
+        keys[i] = key_buf[i];
+        values[i] = std::move(value_buf[i]);
+      }
+    });
+  }
+}
+
 template <class InputIterator, class T, typename BinaryOperation>
 T
 accumulate(
@@ -206,6 +206,21 @@ katana::MemorySupervisor::LogMemoryStats(const std::string& message) {
   policy_->LogMemoryStats(message, standby_);
 }
 
+katana::Manager*
+katana::MemorySupervisor::Register(std::unique_ptr<Manager> manager) {
+  auto& info = managers_[manager->Name()];
+  if (!info.manager_) {
+    info.manager_ = std::move(manager);
+  }
+  return info.manager_.get();
+}
+
+katana::Manager*
+katana::MemorySupervisor::GetManager(const std::string& name) {
+  auto it = managers_.find(name);
+  return it == managers_.end() ? nullptr : it->second.manager_.get();
+}
+
 katana::PropertyManager*
 katana::MemorySupervisor::GetPropertyManager() {
   auto name = PropertyManager::name_;
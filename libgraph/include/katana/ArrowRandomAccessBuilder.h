@@ -1,8 +1,21 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ARROWRANDOMACCESSBUILDER_H_
+#define KATANA_LIBGRAPH_KATANA_ARROWRANDOMACCESSBUILDER_H_
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <arrow/api.h>
 
 #include "katana/ErrorCode.h"
 #include "katana/Logging.h"
+#include "katana/Loops.h"
 #include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
 #include "katana/Properties.h"
 #include "katana/Result.h"
 
@@ -10,52 +23,87 @@ namespace katana {
 
 namespace {
 
-/// NoNullBuilder uses std::vector for storage
-/// Finalize() makes a copy of the data
+template <typename StorageType>
+std::shared_ptr<arrow::Buffer>
+AllocateBuilderValues(size_t length) {
+  auto res = internal::AllocateZeroedBuffer(length * sizeof(StorageType));
+  if (!res) {
+    KATANA_LOG_FATAL("failed to allocate builder values: {}", res.error());
+  }
+  return std::move(res.value());
+}
+
+/// \returns a byte per index, zero (i.e., not set) in each
+inline NUMAArray<uint8_t>
+AllocateBuilderValidity(size_t length) {
+  NUMAArray<uint8_t> valid;
+  valid.allocateBlocked(length);
+  ParallelSTL::fill(valid.begin(), valid.end(), uint8_t{0});
+  return valid;
+}
+
+/// \returns the validity bitmap of \p valid, or nullptr if every index is
+/// valid, and sets \p null_count
+inline Result<std::shared_ptr<arrow::Buffer>>
+PackBuilderValidity(NUMAArray<uint8_t>* valid, int64_t* null_count) {
+  std::shared_ptr<arrow::Buffer> bitmap = KATANA_CHECKED(
+      arrow::AllocateBuffer(arrow::BitUtil::BytesForBits(valid->size())));
+  *null_count = internal::PackBytesToBitmap(
+      valid->begin(), valid->size(), bitmap->mutable_data());
+  valid->deallocate();
+  if (*null_count == 0) {
+    return std::shared_ptr<arrow::Buffer>(nullptr);
+  }
+  return bitmap;
+}
+
+/// NoNullBuilder writes values directly into the arrow::Buffer of the
+/// arrow::Array it builds
+/// Finalize() hands the buffer over to the array without copying it
 /// Does not support null values
-template <typename ValueType, typename StorageType, typename ArrowType>
+template <typename ValueType, typename ArrowType>
 class NoNullBuilder {
 public:
   using value_type = ValueType;
   using reference = ValueType&;
+  using StorageType = typename ArrowType::c_type;
 
-  NoNullBuilder(size_t length) : data_(length) {
+  NoNullBuilder(size_t length)
+      : values_(AllocateBuilderValues<StorageType>(length)), length_(length) {
     static_assert(sizeof(ValueType) == sizeof(StorageType));
   }
 
   reference operator[](size_t index) {
     KATANA_LOG_DEBUG_VASSERT(
         index < size(), "index: {}, size: {}", index, size());
-    return static_cast<ValueType*>(data_.data())[index];
+    return reinterpret_cast<ValueType*>(values_->mutable_data())[index];
   }
 
+  void SetValue(size_t index, value_type value) { (*this)[index] = value; }
+
   bool IsValid(size_t) { return true; }
 
-  size_t size() const { return data_.size(); }
+  size_t size() const { return length_; }
 
-  katana::Result<std::shared_ptr<arrow::Array>> Finalize() const {
-    using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    ArrowBuilder builder;
-    if (data_.size() > 0) {
-      if (auto r = builder.AppendValues(data_); !r.ok()) {
-        KATANA_LOG_DEBUG("arrow error: {}", r);
-        return katana::ErrorCode::ArrowError;
-      }
-    }
-    std::shared_ptr<arrow::Array> array;
-    if (auto r = builder.Finish(&array); !r.ok()) {
-      KATANA_LOG_DEBUG("arrow error: {}", r);
-      return katana::ErrorCode::ArrowError;
-    }
-    return array;
+  /// The builder cannot be used after Finalize() because the array owns its
+  /// values
+  katana::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) {
+    *array = arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowType>::type_singleton(), length_,
+        {nullptr, std::move(values_)}, 0));
+    return katana::ResultSuccess();
   }
 
 private:
-  std::vector<StorageType> data_;
+  std::shared_ptr<arrow::Buffer> values_;
+  size_t length_;
 };
 
-/// NullableBuilder uses std::vector for storage
-/// Finalize() makes a copy of the data
+/// NullableBuilder writes values directly into the arrow::Buffer of the
+/// arrow::Array it builds, and validity into a byte per index, which
+/// Finalize() packs in parallel into the validity bitmap of the array
+/// Finalize() hands the values over to the array without copying them,
+/// except for booleans, which arrow packs into bits
 /// Supports null values
 template <typename ValueType, typename StorageType, typename ArrowType>
 class NullableBuilder {
@@ -63,7 +111,10 @@ public:
   using value_type = ValueType;
   using reference = ValueType&;
 
-  NullableBuilder(size_t length) : data_(length), valid_(length, false) {
+  NullableBuilder(size_t length)
+      : values_(AllocateBuilderValues<StorageType>(length)),
+        valid_(AllocateBuilderValidity(length)),
+        length_(length) {
     static_assert(sizeof(ValueType) == sizeof(StorageType));
   }
 
@@ -74,55 +125,152 @@ public:
     KATANA_LOG_DEBUG_VASSERT(
         index < size(), "index: {}, size: {}", index, size());
     valid_[index] = true;
-    return reinterpret_cast<ValueType*>(data_.data())[index];
+    return reinterpret_cast<ValueType*>(values_->mutable_data())[index];
+  }
+
+  void SetValue(size_t index, value_type value) { (*this)[index] = value; }
+
+  void UnsetValue(size_t index) {
+    KATANA_LOG_DEBUG_ASSERT(index < size());
+    valid_[index] = false;
+  }
+
+  bool IsValid(size_t index) { return valid_[index]; }
+
+  size_t size() const { return length_; }
+
+  /// The builder cannot be used after Finalize() because the array owns its
+  /// values
+  katana::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) {
+    int64_t null_count = 0;
+    auto null_bitmap =
+        KATANA_CHECKED(PackBuilderValidity(&valid_, &null_count));
+
+    std::shared_ptr<arrow::Buffer> values = std::move(values_);
+    if constexpr (std::is_same_v<ArrowType, arrow::BooleanType>) {
+      std::shared_ptr<arrow::Buffer> bits = KATANA_CHECKED(
+          arrow::AllocateBuffer(arrow::BitUtil::BytesForBits(length_)));
+      internal::PackBytesToBitmap(
+          values->data(), length_, bits->mutable_data());
+      values = std::move(bits);
+    }
+
+    *array = arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowType>::type_singleton(), length_,
+        {std::move(null_bitmap), std::move(values)}, null_count));
+    return katana::ResultSuccess();
+  }
+
+private:
+  std::shared_ptr<arrow::Buffer> values_;
+  NUMAArray<uint8_t> valid_;
+  size_t length_;
+};
+
+/// NullableStringBuilder appends the characters of values to a buffer per
+/// thread, so that threads never contend on a shared character buffer
+/// Finalize() computes the offsets of the array with a parallel prefix sum
+/// of the value lengths, and then each per-thread buffer is copied to its
+/// offsets in parallel
+/// Supports null values; each index must be set at most once
+template <typename ArrowType>
+class NullableStringBuilder {
+public:
+  using value_type = std::string_view;
+  using offset_type = typename ArrowType::offset_type;
+
+  NullableStringBuilder(size_t length)
+      : valid_(AllocateBuilderValidity(length)), length_(length) {
+    lengths_.allocateBlocked(length);
+    ParallelSTL::fill(lengths_.begin(), lengths_.end(), offset_type{0});
+  }
+
+  void SetValue(size_t index, value_type value) {
+    KATANA_LOG_DEBUG_VASSERT(
+        index < size(), "index: {}, size: {}", index, size());
+    Local& local = *locals_.getLocal();
+    local.entries.emplace_back(Entry{index, local.chars.size()});
+    local.chars.append(value);
+    lengths_[index] = value.size();
+    valid_[index] = true;
   }
 
   void UnsetValue(size_t index) {
     KATANA_LOG_DEBUG_ASSERT(index < size());
+    lengths_[index] = 0;
     valid_[index] = false;
   }
 
   bool IsValid(size_t index) { return valid_[index]; }
 
-  size_t size() const { return data_.size(); }
-
-  katana::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) const {
-    using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    ArrowBuilder builder;
-    if (data_.size() > 0) {
-      if constexpr (std::is_scalar_v<value_type>) {
-        // TODO(danielmawhirter) find a better way to handle this
-        // arrow::NumericBuilder has:
-        // AppendValues(value_type*, int64_t, uint8_t*)
-        // AppendValues(value_type*, int64_t, vector<bool>)
-        // AppendValues(vector<value_type>, vector<bool>)
-        if (auto r =
-                builder.AppendValues(data_.data(), data_.size(), valid_.data());
-            !r.ok()) {
-          KATANA_LOG_DEBUG("arrow error: {}", r);
-          return katana::ErrorCode::ArrowError;
-        }
-      } else {
-        // TODO(danielmawhirter) find a better way to handle this
-        // arrow::BinaryBuilder has:
-        // AppendValues(vector<string>, uint8_t*)
-        // AppendValues(char**, int64_t, uint8_t*)
-        if (auto r = builder.AppendValues(data_, valid_.data()); !r.ok()) {
-          KATANA_LOG_DEBUG("arrow error: {}", r);
-          return katana::ErrorCode::ArrowError;
-        }
-      }
+  size_t size() const { return length_; }
+
+  /// The builder cannot be used after Finalize()
+  katana::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) {
+    // Bounds the sum of the lengths, so that the prefix sum cannot overflow
+    size_t num_appended = 0;
+    for (unsigned i = 0; i < locals_.size(); ++i) {
+      num_appended += locals_.getRemote(i)->chars.size();
     }
-    if (auto r = builder.Finish(array); !r.ok()) {
-      KATANA_LOG_DEBUG("arrow error: {}", r);
-      return katana::ErrorCode::ArrowError;
+    if (num_appended >
+        static_cast<size_t>(std::numeric_limits<offset_type>::max())) {
+      return KATANA_ERROR(
+          ErrorCode::ArrowError, "{} characters do not fit in {}",
+          num_appended,
+          arrow::TypeTraits<ArrowType>::type_singleton()->ToString());
     }
+
+    std::shared_ptr<arrow::Buffer> offsets = KATANA_CHECKED(
+        arrow::AllocateBuffer((length_ + 1) * sizeof(offset_type)));
+    auto* offsets_data =
+        reinterpret_cast<offset_type*>(offsets->mutable_data());
+    offsets_data[0] = 0;
+    ParallelSTL::partial_sum(
+        lengths_.begin(), lengths_.end(), offsets_data + 1);
+
+    std::shared_ptr<arrow::Buffer> chars =
+        KATANA_CHECKED(arrow::AllocateBuffer(offsets_data[length_]));
+    uint8_t* chars_data = chars->mutable_data();
+    do_all(
+        iterate(0u, locals_.size()),
+        [&](unsigned thread) {
+          Local& local = *locals_.getRemote(thread);
+          for (const Entry& entry : local.entries) {
+            std::memcpy(
+                chars_data + offsets_data[entry.index],
+                local.chars.data() + entry.begin, lengths_[entry.index]);
+          }
+          local = Local();
+        },
+        steal(), no_stats());
+    lengths_.deallocate();
+
+    int64_t null_count = 0;
+    auto null_bitmap =
+        KATANA_CHECKED(PackBuilderValidity(&valid_, &null_count));
+
+    *array = arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowType>::type_singleton(), length_,
+        {std::move(null_bitmap), std::move(offsets), std::move(chars)},
+        null_count));
     return katana::ResultSuccess();
   }
 
 private:
-  std::vector<StorageType> data_;
-  std::vector<uint8_t> valid_;
+  struct Entry {
+    size_t index;
+    size_t begin;
+  };
+
+  struct Local {
+    std::string chars;
+    std::vector<Entry> entries;
+  };
+
+  PerThreadStorage<Local> locals_;
+  NUMAArray<offset_type> lengths_;
+  NUMAArray<uint8_t> valid_;
+  size_t length_;
 };
 
 template <typename ArrowType>
@@ -146,16 +294,25 @@ NULLABLE(uint64_t, uint64_t, arrow::UInt64Type);
 NULLABLE(float, float, arrow::FloatType);
 NULLABLE(double, double, arrow::DoubleType);
 NULLABLE(bool, uint8_t, arrow::BooleanType);
-NULLABLE(std::string, std::string, arrow::StringType);
-NULLABLE(std::string, std::string, arrow::LargeStringType);
 
 #undef NULLABLE
 
+template <>
+struct ArrowTypeConfig<arrow::StringType> {
+  using RandomBuilderType = NullableStringBuilder<arrow::StringType>;
+};
+
+template <>
+struct ArrowTypeConfig<arrow::LargeStringType> {
+  using RandomBuilderType = NullableStringBuilder<arrow::LargeStringType>;
+};
+
 }  // namespace
 
 /// ArrowRandomAccessBuilder encapsulates the concept of building
-/// an arrow::Array from <index, value> pairs arriving in unknown order
-/// Functions as a wrapper for NullableBuilder currently, TODO(danielmawhirter)
+/// an arrow::Array from <index, value> pairs arriving in unknown order,
+/// possibly from many threads at once
+/// Functions as a wrapper for NullableBuilder and NullableStringBuilder
 template <typename ArrowType>
 class ArrowRandomAccessBuilder {
 public:
@@ -195,3 +352,5 @@ private:
 };
 
 }  // namespace katana
+
+#endif
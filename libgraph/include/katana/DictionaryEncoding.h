@@ -0,0 +1,29 @@
+#ifndef KATANA_LIBGRAPH_KATANA_DICTIONARYENCODING_H_
+#define KATANA_LIBGRAPH_KATANA_DICTIONARYENCODING_H_
+
+#include <memory>
+
+#include <arrow/api.h>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Dictionary encode a column of strings: every value is replaced by an
+/// int32 code into a dictionary of the distinct large strings of the column.
+///
+/// Low cardinality strings (e.g., countries or categories) then take four
+/// bytes per value, and comparisons and group-bys can work on the codes; see
+/// DictionaryStringPropertyReadOnlyView. The dictionary is sorted, so codes
+/// compare like their strings. Nulls stay null.
+///
+/// \param strings a column of strings, large strings or dictionary encoded
+///   strings, whose chunks may have different dictionaries
+/// \returns a column of one arrow::DictionaryArray
+KATANA_EXPORT Result<std::shared_ptr<arrow::ChunkedArray>>
+DictionaryEncodeStrings(const arrow::ChunkedArray& strings);
+
+}  // namespace katana
+
+#endif
@@ -1,48 +1,217 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ENTITYINDEX_H_
 #define KATANA_LIBGRAPH_KATANA_ENTITYINDEX_H_
 
-#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include <arrow/api.h>
 #include <arrow/array.h>
 #include <arrow/type_traits.h>
-#include <boost/iterator/iterator_categories.hpp>
-#include <boost/iterator/iterator_facade.hpp>
 
+#include "katana/Logging.h"
+#include "katana/NUMAArray.h"
 #include "katana/Result.h"
 #include "katana/config.h"
 
 namespace katana {
 
+/// How an index finds the entities with a value
+enum class EntityIndexKind {
+  /// Sorted by value, for point and range lookups
+  kOrdered,
+  /// Hashed by value, for point lookups only
+  kHash,
+};
+
+namespace internal {
+
+/// A static search tree over a sorted array. The first key of every block of
+/// kBlockSize entries is kept in Eytzinger (breadth-first) order, so the top
+/// levels of the search share a few cache lines and the array itself is only
+/// touched within one block.
+template <typename Key>
+class EytzingerBlockTree {
+public:
+  static constexpr size_t kBlockSize = 32;
+
+  /// Build the tree over num_entries sorted entries; key_at(i) returns the
+  /// key of entry i.
+  template <typename KeyAt>
+  void Build(size_t num_entries, const KeyAt& key_at) {
+    num_entries_ = num_entries;
+    size_t num_blocks = (num_entries + kBlockSize - 1) / kBlockSize;
+    tree_.resize(num_blocks + 1);
+    blocks_.resize(num_blocks + 1);
+    size_t next_block = 0;
+    Fill(1, &next_block, key_at);
+  }
+
+  /// The range [begin, end) of entries that holds the first entry whose key
+  /// is not before(key), or is empty at that entry. before must hold for a
+  /// prefix of the sorted keys.
+  template <typename Before>
+  std::pair<size_t, size_t> Search(const Before& before) const {
+    size_t num_nodes = tree_.size() - 1;
+    size_t k = 1;
+    while (k <= num_nodes) {
+      k = 2 * k + before(tree_[k]);
+    }
+    // Undo the right turns after the last left turn
+    k >>= __builtin_ffsll(~k);
+    // The first block whose first key is not before
+    size_t block = k == 0 ? num_nodes : blocks_[k];
+    if (block == 0) {
+      return {0, 0};
+    }
+    return {
+        (block - 1) * kBlockSize,
+        std::min(block * kBlockSize, num_entries_)};
+  }
+
+private:
+  template <typename KeyAt>
+  void Fill(size_t k, size_t* next_block, const KeyAt& key_at) {
+    if (k >= tree_.size()) {
+      return;
+    }
+    Fill(2 * k, next_block, key_at);
+    blocks_[k] = *next_block;
+    tree_[k] = key_at(*next_block * kBlockSize);
+    ++*next_block;
+    Fill(2 * k + 1, next_block, key_at);
+  }
+
+  size_t num_entries_{0};
+  // 1-based; entry 0 is unused
+  std::vector<Key> tree_ = std::vector<Key>(1);
+  std::vector<uint32_t> blocks_ = std::vector<uint32_t>(1);
+};
+
+/// An open-addressing hash table over distinct keys that maps each key to
+/// its run, its position among the keys. Slots are probed kGroupSize at a
+/// time by comparing a one byte tag of the hash for the whole group at once,
+/// so a lookup usually reads one key. Built in parallel; read-only after.
+template <typename Key>
+class HashRunTable {
+public:
+  static constexpr size_t kGroupSize = 16;
+  static constexpr size_t kNotFound = ~size_t{0};
+
+  /// Insert all of keys, which must be distinct
+  void Build(NUMAArray<Key>&& keys);
+
+  /// The run of key, or kNotFound
+  size_t Find(const Key& key) const {
+    if (keys_.size() == 0) {
+      return kNotFound;
+    }
+    uint64_t hash = Hash(key);
+    uint8_t tag = Tag(hash);
+    for (size_t group = FirstGroup(hash);; group = (group + 1) & group_mask_) {
+      const uint8_t* tags = tags_.data() + group * kGroupSize;
+      for (uint32_t matches = Match(tags, tag); matches != 0;
+           matches &= matches - 1) {
+        size_t run = runs_[group * kGroupSize + __builtin_ctz(matches)];
+        if (keys_[run] == key) {
+          return run;
+        }
+      }
+      // Keys only go past a group once it is full
+      if (Match(tags, 0) != 0) {
+        return kNotFound;
+      }
+    }
+  }
+
+  size_t size() const { return keys_.size(); }
+
+private:
+  static uint64_t Hash(const Key& key) {
+    uint64_t x;
+    if constexpr (std::is_same_v<Key, std::string_view>) {
+      x = std::hash<std::string_view>{}(key);
+    } else {
+      x = static_cast<uint64_t>(key);
+    }
+    // The MurmurHash3 finalizer, so that nearby keys spread out
+    x ^= x >> 33U;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33U;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33U;
+    return x;
+  }
+
+  /// The tag of a used slot; 0 marks an empty one
+  static uint8_t Tag(uint64_t hash) {
+    return static_cast<uint8_t>(0x80U | (hash & 0x7fU));
+  }
+
+  size_t FirstGroup(uint64_t hash) const { return (hash >> 7U) & group_mask_; }
+
+  /// A bit for every slot of the group at tags whose tag is tag
+  static uint32_t Match(const uint8_t* tags, uint8_t tag) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags));
+    return _mm_movemask_epi8(
+        _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag))));
+#else
+    uint32_t matches = 0;
+    for (size_t i = 0; i < kGroupSize; ++i) {
+      matches |= static_cast<uint32_t>(tags[i] == tag) << i;
+    }
+    return matches;
+#endif
+  }
+
+  NUMAArray<Key> keys_;
+  NUMAArray<uint8_t> tags_;
+  NUMAArray<uint64_t> runs_;
+  size_t group_mask_{0};
+};
+
+/// How the values of a property are read for a hash index
+template <typename c_type>
+struct HashIndexTraits {
+  using ArrowArrayType = typename arrow::CTypeTraits<c_type>::ArrayType;
+  static c_type Value(const ArrowArrayType& array, int64_t i) {
+    return array.Value(i);
+  }
+};
+
+template <>
+struct HashIndexTraits<std::string_view> {
+  using ArrowArrayType = arrow::LargeStringArray;
+  static std::string_view Value(const ArrowArrayType& array, int64_t i) {
+    arrow::util::string_view view = array.GetView(i);
+    return std::string_view(view.data(), view.length());
+  }
+};
+
+}  // namespace internal
+
 // EntityIndex provides an interface similar to an ordered container
 // over a single property.
+//
+// Indexes are read-only: the IDs of the entities with a non-null value are
+// kept in one contiguous array, sorted by value and then by ID, with a
+// static search tree on top. EntityIndex::iterator walks that array and
+// returns a sequence of node or edge ids.
 template <typename node_or_edge>
 class KATANA_EXPORT EntityIndex {
 public:
-  // Type-safe container for node and edge ids to avoid overlap with the
-  // primitive types we are indexing.
-  struct IndexID {
-    node_or_edge id;
-  };
-
-  // The set key type is either a node/edge id (all the keys in the actual set)
-  // or a value representing the search key.
-  using set_key_type = typename std::variant<
-      IndexID, bool, uint8_t, int16_t, int32_t, int64_t, uint64_t, double_t,
-      float_t, std::string_view*>;
-
-  // EntityIndex::iterator returns a sequence of node or edge ids.
-  using base_iterator = typename std::multiset<set_key_type>::iterator;
-  class iterator : public base_iterator {
-  public:
-    explicit iterator(const base_iterator& base) : base_iterator(base) {}
-    iterator() : base_iterator(0) {}
-    const node_or_edge& operator*() const {
-      return std::get<IndexID>(base_iterator::operator*()).id;
-    }
-  };
+  using iterator = const node_or_edge*;
 
   EntityIndex(std::string property_name)
       : property_name_(std::move(property_name)) {}
@@ -57,180 +226,414 @@ public:
   // The name of the indexed property.
   std::string property_name() { return property_name_; }
 
-  virtual iterator begin() = 0;
-  virtual iterator end() = 0;
+  iterator begin() const { return ids_.data(); }
+  iterator end() const { return ids_.data() + ids_.size(); }
+
+  // The number of entities in the index, the ones with a non-null value.
+  size_t size() const { return ids_.size(); }
 
+  // Sort the entities by the values of the property, in parallel.
   virtual Result<void> BuildFromProperty() = 0;
-  // virtual Result<void> BuildFromFile() = 0;
+
+  // Take the order of the entities from sorted_ids, as saved from a previous
+  // build over the same values, which saves sorting them again. Fails if
+  // sorted_ids is not exactly the entities with a non-null value, in order.
+  virtual Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) = 0;
+
+protected:
+  NUMAArray<node_or_edge> ids_;
 
 private:
   std::string property_name_;
 };
 
 // PrimitiveEntityIndex provides a EntityIndex for primitive types.
+//
+// Next to the sorted ids it keeps their values, so that searches never go
+// through the Arrow column; an entry costs sizeof(c_type) +
+// sizeof(node_or_edge) bytes.
 template <typename node_or_edge, typename c_type>
 class KATANA_EXPORT PrimitiveEntityIndex : public EntityIndex<node_or_edge> {
 public:
   using ArrowArrayType = typename arrow::CTypeTraits<c_type>::ArrayType;
-  using IndexID = typename EntityIndex<node_or_edge>::IndexID;
   using iterator = typename EntityIndex<node_or_edge>::iterator;
-  using set_key_type = typename EntityIndex<node_or_edge>::set_key_type;
 
   PrimitiveEntityIndex(
       const std::string& column, size_t num_entities,
       std::shared_ptr<arrow::Array> property)
       : EntityIndex<node_or_edge>(column),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<ArrowArrayType>(property)),
-        set_(PropertyCompare(property_)) {}
-
-  iterator begin() override { return iterator(set_.begin()); }
-  iterator end() override { return iterator(set_.end()); }
-
-  // Returns an iterator to the first element in the set with its property
-  // value equal to `key`. The STL does not seem to specify that
-  // multiset::find returns the first value, though it appears so in practice.
-  iterator Find(c_type key) {
-    auto it = set_.lower_bound(key);
-    if (it == set_.end() ||
-        property_->Value(std::get<IndexID>(*it).id) != key) {
-      return end();
+        property_(std::static_pointer_cast<ArrowArrayType>(property)) {}
+
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
+  iterator Find(c_type key) const {
+    iterator it = LowerBound(key);
+    if (it == this->end() || keys_[it - this->begin()] != key) {
+      return this->end();
     }
-    return iterator(it);
+    return it;
   }
 
-  // Returns an iterator to the first element in the set that is greater than or
+  // Returns an iterator to the first element that is greater than or
   // equal to `key`.
-  iterator LowerBound(c_type key) { return iterator(set_.lower_bound(key)); }
-
-  // Returns an iterator to the first element in the set that is greater than
-  // `key`.
-  iterator UpperBound(c_type key) { return iterator(set_.upper_bound(key)); }
+  iterator LowerBound(c_type key) const {
+    return Search([key](c_type k) { return k < key; });
+  }
 
-private:
-  class PropertyCompare {
-  public:
-    PropertyCompare(std::shared_ptr<ArrowArrayType> property)
-        : property_(std::move(property)) {}
-
-    bool operator()(const set_key_type& a, const set_key_type& b) const {
-      // Each operand is either a literal key_type or a node/edge.
-      c_type val_a = GetValue(a);
-      c_type val_b = GetValue(b);
-      // Compare the value of the indexed property for a and b using std::less.
-      return std::less<c_type>{}(val_a, val_b);
-    }
+  // Returns an iterator to the first element that is greater than `key`.
+  iterator UpperBound(c_type key) const {
+    return Search([key](c_type k) { return !(key < k); });
+  }
 
-  private:
-    c_type GetValue(const set_key_type& a) const {
-      if (std::holds_alternative<IndexID>(a)) {
-        node_or_edge id = std::get<IndexID>(a).id;
-        c_type val = property_->Value(id);
-        return val;
-      }
-      return std::get<c_type>(a);
-    }
+  // Returns the range of elements with their property value equal to `key`.
+  std::pair<iterator, iterator> EqualRange(c_type key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
 
-    std::shared_ptr<ArrowArrayType> property_;
-  };
+  // LowerBound of every key, computed in parallel.
+  std::vector<iterator> LowerBounds(const std::vector<c_type>& keys) const;
 
   Result<void> BuildFromProperty() override;
-  // Result<void> BuildFromFile(...) override;
+  Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) override;
+
+private:
+  template <typename Before>
+  iterator Search(const Before& before) const {
+    auto [first, last] = tree_.Search(before);
+    size_t pos = std::partition_point(
+                     keys_.begin() + first, keys_.begin() + last, before) -
+                 keys_.begin();
+    return this->begin() + pos;
+  }
+
+  // Build the search tree over keys_
+  void BuildSearch();
 
   size_t num_entities_;
   std::shared_ptr<ArrowArrayType> property_;
-  std::multiset<set_key_type, PropertyCompare> set_;
+  NUMAArray<c_type> keys_;
+  internal::EytzingerBlockTree<c_type> tree_;
 };
 
 // StringEntityIndex provides a EntityIndex for strings.
+//
+// Only the sorted ids are kept; values are read from the Arrow column, and
+// the search tree holds views of it.
 template <typename node_or_edge>
 class KATANA_EXPORT StringEntityIndex : public EntityIndex<node_or_edge> {
 public:
   using ArrowArrayType =
       typename arrow::TypeTraits<arrow::LargeStringType>::ArrayType;
-  using IndexID = typename EntityIndex<node_or_edge>::IndexID;
   using iterator = typename EntityIndex<node_or_edge>::iterator;
-  using set_key_type = typename EntityIndex<node_or_edge>::set_key_type;
 
   StringEntityIndex(
       const std::string& property_name, size_t num_entities,
       const std::shared_ptr<arrow::Array>& property)
       : EntityIndex<node_or_edge>(property_name),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<arrow::LargeStringArray>(property)),
-        set_(StringCompare(property_)) {}
-
-  iterator begin() override { return iterator(set_.begin()); }
-  iterator end() override { return iterator(set_.end()); }
-
-  // Returns an iterator to the first element in the set with its property
-  // value equal to `key`. The STL does not appear to specify that
-  // multiset::find returns the first value, though it appears so in practice.
-  iterator Find(std::string_view key) {
-    auto it = set_.lower_bound(&key);
-    if (it != set_.end()) {
-      arrow::util::string_view arrow_view =
-          property_->GetView(std::get<IndexID>(*it).id);
-      if (std::string_view(arrow_view.data(), arrow_view.length()) != key) {
-        return end();
-      }
+        property_(
+            std::static_pointer_cast<arrow::LargeStringArray>(property)) {}
+
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
+  iterator Find(std::string_view key) const {
+    iterator it = LowerBound(key);
+    if (it == this->end() || GetValue(*it) != key) {
+      return this->end();
     }
-    return iterator(it);
+    return it;
   }
 
-  // Returns an iterator to the first element in the set that is greater than or
+  // Returns an iterator to the first element that is greater than or
   // equal to `key`.
-  iterator LowerBound(std::string_view key) {
-    return iterator(set_.lower_bound(&key));
+  iterator LowerBound(std::string_view key) const {
+    return Search([key](std::string_view k) { return k < key; });
   }
 
-  // Returns an iterator to the first element in the set that is greater than
-  // `key`.
-  iterator UpperBound(std::string_view key) {
-    return iterator(set_.upper_bound(&key));
+  // Returns an iterator to the first element that is greater than `key`.
+  iterator UpperBound(std::string_view key) const {
+    return Search([key](std::string_view k) { return !(key < k); });
   }
 
+  // Returns the range of elements with their property value equal to `key`.
+  std::pair<iterator, iterator> EqualRange(std::string_view key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  // LowerBound of every key, computed in parallel.
+  std::vector<iterator> LowerBounds(
+      const std::vector<std::string_view>& keys) const;
+
+  Result<void> BuildFromProperty() override;
+  Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) override;
+
 private:
-  class StringCompare {
-  public:
-    StringCompare(std::shared_ptr<arrow::LargeStringArray> property)
-        : property_(std::move(property)) {}
-
-    bool operator()(const set_key_type& a, const set_key_type& b) const {
-      // Each operand is either a pointer to a string_view or a node/edge.
-      std::string_view val_a = GetValue(a);
-      std::string_view val_b = GetValue(b);
-      // Compare the value of the indexed property for a and b using std::less.
-      return std::less<std::string_view>{}(val_a, val_b);
-    }
+  std::string_view GetValue(node_or_edge id) const {
+    arrow::util::string_view arrow_view = property_->GetView(id);
+    return std::string_view(arrow_view.data(), arrow_view.length());
+  }
 
-  private:
-    std::string_view GetValue(const set_key_type& a) const {
-      if (std::holds_alternative<IndexID>(a)) {
-        arrow::util::string_view arrow_view =
-            property_->GetView(std::get<IndexID>(a).id);
-        return std::string_view(arrow_view.data(), arrow_view.length());
-      }
-      return *std::get<std::string_view*>(a);
+  template <typename Before>
+  iterator Search(const Before& before) const {
+    auto [first, last] = tree_.Search(before);
+    return std::partition_point(
+        this->begin() + first, this->begin() + last,
+        [&](node_or_edge id) { return before(GetValue(id)); });
+  }
+
+  // Fill the search tree from the sorted ids_
+  void BuildSearch();
+
+  size_t num_entities_;
+  std::shared_ptr<arrow::LargeStringArray> property_;
+  internal::EytzingerBlockTree<std::string_view> tree_;
+};
+
+// DictionaryEntityIndex provides a EntityIndex for dictionary encoded
+// strings, for point and range lookups.
+//
+// Entities are sorted by the rank of their code, the position of its string
+// among the sorted strings of the dictionary, so a build sorts integers and
+// never compares the strings of entities. A search looks the key up in the
+// sorted dictionary once and returns a run of ids; no per-entity values are
+// kept.
+template <typename node_or_edge>
+class KATANA_EXPORT DictionaryEntityIndex : public EntityIndex<node_or_edge> {
+public:
+  using iterator = typename EntityIndex<node_or_edge>::iterator;
+  using code_type = int32_t;
+
+  DictionaryEntityIndex(
+      const std::string& property_name, size_t num_entities,
+      const std::shared_ptr<arrow::Array>& property)
+      : EntityIndex<node_or_edge>(property_name),
+        num_entities_(num_entities),
+        property_(std::static_pointer_cast<arrow::DictionaryArray>(property)) {}
+
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
+  iterator Find(std::string_view key) const {
+    auto [first, last] = EqualRange(key);
+    return first == last ? this->end() : first;
+  }
+
+  // Returns an iterator to the first element that is greater than or
+  // equal to `key`.
+  iterator LowerBound(std::string_view key) const {
+    return RankBegin(
+        std::lower_bound(sorted_values_.begin(), sorted_values_.end(), key) -
+        sorted_values_.begin());
+  }
+
+  // Returns an iterator to the first element that is greater than `key`.
+  iterator UpperBound(std::string_view key) const {
+    return RankBegin(
+        std::upper_bound(sorted_values_.begin(), sorted_values_.end(), key) -
+        sorted_values_.begin());
+  }
+
+  // Returns the range of elements with their property value equal to `key`.
+  std::pair<iterator, iterator> EqualRange(std::string_view key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  // Returns the range of elements with the code `code`, without looking at
+  // strings, e.g., to group entities by value.
+  std::pair<iterator, iterator> CodeRange(code_type code) const {
+    return {RankBegin(ranks_[code]), RankBegin(ranks_[code] + 1)};
+  }
+
+  // LowerBound of every key, computed in parallel.
+  std::vector<iterator> LowerBounds(
+      const std::vector<std::string_view>& keys) const;
+
+  Result<void> BuildFromProperty() override;
+  Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) override;
+
+private:
+  iterator RankBegin(size_t rank) const { return this->begin() + runs_[rank]; }
+
+  uint32_t GetRank(node_or_edge id) const { return ranks_[codes_[id]]; }
+
+  // Check the property and rank the strings of its dictionary
+  Result<void> RankDictionary();
+
+  // Find the runs of every rank among the sorted ids_, whose ranks are
+  // sorted_ranks
+  void BuildSearch(const NUMAArray<uint32_t>& sorted_ranks);
+
+  size_t num_entities_;
+  std::shared_ptr<arrow::DictionaryArray> property_;
+  const code_type* codes_{nullptr};
+  // The strings of the dictionary in order, and the rank of every code
+  std::vector<std::string_view> sorted_values_;
+  std::vector<uint32_t> ranks_;
+  // The start of the ids of every rank, and the end of the last
+  NUMAArray<uint64_t> runs_;
+};
+
+// HashEntityIndex provides a EntityIndex for point lookups of integer and
+// string keys, c_type std::string_view for strings.
+//
+// The ids are grouped by value, in the same order as an ordered index, and a
+// hash table maps every distinct value to its group.
+template <typename node_or_edge, typename c_type>
+class KATANA_EXPORT HashEntityIndex : public EntityIndex<node_or_edge> {
+public:
+  using ArrowArrayType =
+      typename internal::HashIndexTraits<c_type>::ArrowArrayType;
+  using iterator = typename EntityIndex<node_or_edge>::iterator;
+
+  HashEntityIndex(
+      const std::string& property_name, size_t num_entities,
+      const std::shared_ptr<arrow::Array>& property)
+      : EntityIndex<node_or_edge>(property_name),
+        num_entities_(num_entities),
+        property_(std::static_pointer_cast<ArrowArrayType>(property)) {}
+
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
+  iterator Find(c_type key) const { return EqualRange(key).first; }
+
+  // Returns the range of elements with their property value equal to `key`.
+  std::pair<iterator, iterator> EqualRange(c_type key) const {
+    size_t run = table_.Find(key);
+    if (run == internal::HashRunTable<c_type>::kNotFound) {
+      return {this->end(), this->end()};
     }
+    return {this->begin() + runs_[run], this->begin() + runs_[run + 1]};
+  }
 
-    std::shared_ptr<arrow::LargeStringArray> property_;
-  };
+  // Find of every key, computed in parallel.
+  std::vector<iterator> Finds(const std::vector<c_type>& keys) const;
 
   Result<void> BuildFromProperty() override;
-  // virtual Result<void> BuildFromFile(...) override;
+  Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) override;
+
+private:
+  c_type GetValue(node_or_edge id) const {
+    return internal::HashIndexTraits<c_type>::Value(*property_, id);
+  }
+
+  // Build the hash table over the runs of equal values of ids_
+  void BuildSearch();
 
   size_t num_entities_;
-  std::shared_ptr<arrow::LargeStringArray> property_;
-  std::multiset<set_key_type, StringCompare> set_;
-};  // namespace katana
+  std::shared_ptr<ArrowArrayType> property_;
+  // The start of the ids of every distinct value, and the end of the last
+  NUMAArray<uint64_t> runs_;
+  internal::HashRunTable<c_type> table_;
+};
+
+// CompositeEntityIndex provides a EntityIndex over a tuple of properties.
+//
+// The values of the properties of every entity are encoded into one key
+// whose bytes compare like the tuple, so the index works like a
+// StringEntityIndex over the keys. Entities with a null value in any of the
+// properties are not indexed. Keys are built with EncodeKey.
+template <typename node_or_edge>
+class KATANA_EXPORT CompositeEntityIndex : public EntityIndex<node_or_edge> {
+public:
+  using iterator = typename EntityIndex<node_or_edge>::iterator;
+  // A value of one of the properties. Integers and floating point numbers
+  // are converted to the type of their property. Strings must be passed as
+  // std::string_view; a string literal would convert to bool.
+  using Value = std::variant<bool, int64_t, uint64_t, double, std::string_view>;
+
+  CompositeEntityIndex(
+      const std::vector<std::string>& property_names, size_t num_entities,
+      std::vector<std::shared_ptr<arrow::Array>> properties,
+      EntityIndexKind kind);
+
+  const std::vector<std::string>& property_names() const {
+    return property_names_;
+  }
+
+  EntityIndexKind kind() const { return kind_; }
+
+  // Encode one value per property into a key of this index.
+  Result<std::string> EncodeKey(const std::vector<Value>& values) const;
+
+  // Returns an iterator to the first element with the key `key`, or end()
+  // if there is none.
+  iterator Find(std::string_view key) const { return EqualRange(key).first; }
+
+  // Returns the range of elements with the key `key`.
+  std::pair<iterator, iterator> EqualRange(std::string_view key) const;
+
+  // Returns an iterator to the first element with a key greater than or
+  // equal to `key`. Only for kOrdered indexes.
+  iterator LowerBound(std::string_view key) const {
+    return Search([key](std::string_view k) { return k < key; });
+  }
+
+  // Returns an iterator to the first element with a key greater than `key`.
+  // Only for kOrdered indexes.
+  iterator UpperBound(std::string_view key) const {
+    return Search([key](std::string_view k) { return !(key < k); });
+  }
+
+  Result<void> BuildFromProperty() override;
+  Result<void> BuildFromSortedIDs(
+      NUMAArray<node_or_edge>&& sorted_ids) override;
+
+private:
+  std::string_view GetKey(node_or_edge id) const {
+    return std::string_view(
+        key_data_.data() + key_offsets_[id],
+        key_offsets_[id + 1] - key_offsets_[id]);
+  }
+
+  bool IsValid(node_or_edge id) const;
+
+  template <typename Before>
+  iterator Search(const Before& before) const {
+    KATANA_LOG_DEBUG_ASSERT(kind_ == EntityIndexKind::kOrdered);
+    auto [first, last] = tree_.Search(before);
+    return std::partition_point(
+        this->begin() + first, this->begin() + last,
+        [&](node_or_edge id) { return before(GetKey(id)); });
+  }
+
+  // Encode the keys of all entities
+  Result<void> EncodeKeys();
+
+  // Build the search tree or hash table over the sorted ids_
+  void BuildSearch();
+
+  std::vector<std::string> property_names_;
+  size_t num_entities_;
+  std::vector<std::shared_ptr<arrow::Array>> properties_;
+  EntityIndexKind kind_;
+
+  // The key of entity i is key_data_[key_offsets_[i], key_offsets_[i + 1])
+  NUMAArray<char> key_data_;
+  NUMAArray<uint64_t> key_offsets_;
+
+  internal::EytzingerBlockTree<std::string_view> tree_;
+  NUMAArray<uint64_t> runs_;
+  internal::HashRunTable<std::string_view> table_;
+};
+
+// The name of the composite index over property_names, which is also the
+// name it is looked up and stored by. Each property name is length
+// prefixed, so different lists of names never share a composite name.
+KATANA_EXPORT std::string CompositeIndexName(
+    const std::vector<std::string>& property_names);
 
 // Create a EntityIndex with the appropriate type for 'property'. Does not
 // build the index.
 template <typename node_or_edge>
 Result<std::unique_ptr<EntityIndex<node_or_edge>>> MakeTypedEntityIndex(
     const std::string& property_name, size_t num_entities,
-    std::shared_ptr<arrow::Array> property);
+    std::shared_ptr<arrow::Array> property,
+    EntityIndexKind kind = EntityIndexKind::kOrdered);
 
 }  // namespace katana
 
@@ -0,0 +1,45 @@
+#ifndef KATANA_LIBGRAPH_KATANA_GRAPHREORDERING_H_
+#define KATANA_LIBGRAPH_KATANA_GRAPHREORDERING_H_
+
+#include "katana/GraphTopology.h"
+#include "katana/RDGTopology.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Node reorderings that place nodes that are accessed together close to each
+/// other, which improves cache locality of graph traversals. All orderings
+/// follow the out edges of the topology and are meant for symmetric graphs.
+///
+/// - kReverseCuthillMcKee: BFS order from a pseudo-peripheral node, visiting
+///   the neighbors of each node by increasing degree, reversed. Reduces the
+///   bandwidth of the adjacency matrix. The BFS levels are expanded in
+///   parallel.
+/// - kHubSorted: nodes with more than the average degree (hubs) first, by
+///   decreasing degree, followed by the other nodes in their original order.
+/// - kHubClustered: hubs first, followed by the other nodes, both in their
+///   original order. Cheaper than kHubSorted and keeps more of the original
+///   locality.
+/// - kGorder: greedily appends the node that shares the most neighbors with
+///   the last few placed nodes (Wei et al., SIGMOD 2016). This is a sequential
+///   algorithm and by far the most expensive ordering.
+/// - kRabbitOrder: incrementally merges nodes into communities by modularity
+///   and orders nodes by a DFS of the resulting dendrogram (Arai et al.,
+///   IPDPS 2016). Merging is sequential; the DFS runs in parallel over the
+///   communities.
+///
+/// \param topo the topology to reorder
+/// \param kind one of the orderings above
+/// \returns the permutation from new to old node IDs, i.e., the old ID of
+///     node i of the reordered topology is at position i
+KATANA_EXPORT GraphTopologyTypes::PropIndexVec ComputeNodeReordering(
+    const GraphTopology& topo, RDGTopology::NodeSortKind kind) noexcept;
+
+/// Returns true if kind is one of the orderings supported by
+/// ComputeNodeReordering
+KATANA_EXPORT bool IsNodeReorderingKind(
+    RDGTopology::NodeSortKind kind) noexcept;
+
+}  // namespace katana
+
+#endif
@@ -1,20 +1,31 @@
 #ifndef KATANA_LIBGRAPH_KATANA_GRAPHTOPOLOGY_H_
 #define KATANA_LIBGRAPH_KATANA_GRAPHTOPOLOGY_H_
 
+#include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 
 #include "arrow/util/bitmap.h"
 #include "katana/CompileTimeIntrospection.h"
 #include "katana/DynamicBitset.h"
 #include "katana/Iterators.h"
 #include "katana/Logging.h"
+#include "katana/Manager.h"
 #include "katana/NUMAArray.h"
 #include "katana/RDGTopology.h"
 #include "katana/Result.h"
+#include "katana/URI.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -328,6 +339,12 @@ protected:
 
   void SortEdgesByTypeThenDest(const PropertyGraph* pg) noexcept;
 
+  /// Sort the edges of each node by group_of(edge property index), an
+  /// integer of group_bits bits, then by destination. Used by the sorts above.
+  template <typename GroupFunc>
+  void SortEdgesByGroupThenDest(
+      const GroupFunc& group_of, unsigned group_bits) noexcept;
+
   void SortEdgesByDestType(
       const PropertyGraph* pg, const PropIndexVec& node_prop_indices) noexcept;
 
@@ -407,6 +424,11 @@ public:
   static std::shared_ptr<ShuffleTopology> MakeSortedByNodeType(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo) noexcept;
 
+  /// Reorder the nodes for locality, see katana/GraphReordering.h
+  static std::shared_ptr<ShuffleTopology> MakeReordered(
+      const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo,
+      const RDGTopology::NodeSortKind& node_sort_todo) noexcept;
+
   static std::shared_ptr<ShuffleTopology> MakeFromTopo(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo,
       const RDGTopology::NodeSortKind& node_sort_todo,
@@ -423,6 +445,13 @@ public:
     case RDGTopology::NodeSortKind::kSortedByNodeType:
       ret = MakeSortedByNodeType(pg, seed_topo);
       break;
+    case RDGTopology::NodeSortKind::kReverseCuthillMcKee:
+    case RDGTopology::NodeSortKind::kHubSorted:
+    case RDGTopology::NodeSortKind::kHubClustered:
+    case RDGTopology::NodeSortKind::kGorder:
+    case RDGTopology::NodeSortKind::kRabbitOrder:
+      ret = MakeReordered(pg, seed_topo, node_sort_todo);
+      break;
     default:
       KATANA_LOG_FATAL("switch case fell through");
     }
@@ -452,70 +481,15 @@ private:
         new_to_old.begin(), new_to_old.end(),
         [&](const auto& i1, const auto& i2) { return cmp(i1, i2); });
 
-    GraphTopology::AdjIndexVec degrees;
-    degrees.allocateInterleaved(seed_topo.NumNodes());
-
-    NUMAArray<GraphTopologyTypes::Node> old_to_new_map;
-    old_to_new_map.allocateInterleaved(seed_topo.NumNodes());
-
-    PropIndexVec node_prop_indices;
-    node_prop_indices.allocateInterleaved(seed_topo.NumNodes());
-
-    // TODO(amber): given 32-bit node ids, put a check here that
-    // new_to_old.size() < 2^32
-    katana::do_all(
-        katana::iterate(size_t{0}, new_to_old.size()),
-        [&](auto i) {
-          // new_to_old[i] gives old node id
-          old_to_new_map[new_to_old[i]] = i;
-          degrees[i] = seed_topo.OutDegree(new_to_old[i]);
-          node_prop_indices[i] = seed_topo.GetNodePropertyIndex(new_to_old[i]);
-        },
-        katana::no_stats());
-
-    KATANA_LOG_DEBUG_ASSERT(
-        std::is_sorted(degrees.begin(), degrees.end(), std::greater<>()));
-
-    katana::ParallelSTL::partial_sum(
-        degrees.begin(), degrees.end(), degrees.begin());
-
-    GraphTopologyTypes::EdgeDestVec new_dest_vec;
-    new_dest_vec.allocateInterleaved(seed_topo.NumEdges());
-
-    GraphTopologyTypes::PropIndexVec edge_prop_indices;
-    edge_prop_indices.allocateInterleaved(seed_topo.NumEdges());
-
-    katana::do_all(
-        katana::iterate(seed_topo.Nodes()),
-        [&](auto old_src_id) {
-          auto new_srd_id = old_to_new_map[old_src_id];
-          auto new_out_index = new_srd_id > 0 ? degrees[new_srd_id - 1] : 0;
-
-          for (auto e : seed_topo.OutEdges(old_src_id)) {
-            auto new_edge_dest = old_to_new_map[seed_topo.OutEdgeDst(e)];
-            KATANA_LOG_DEBUG_ASSERT(new_edge_dest < seed_topo.NumNodes());
-
-            auto new_edge_id = new_out_index;
-            ++new_out_index;
-            KATANA_LOG_DEBUG_ASSERT(new_out_index <= degrees[new_srd_id]);
-
-            new_dest_vec[new_edge_id] = new_edge_dest;
-
-            // copy over edge_property_index mapping from old edge to new edge
-            edge_prop_indices[new_edge_id] =
-                seed_topo.GetEdgePropertyIndexFromOutEdge(e);
-          }
-          KATANA_LOG_DEBUG_ASSERT(new_out_index == degrees[new_srd_id]);
-        },
-        katana::steal(), katana::no_stats());
-
-    return std::make_shared<ShuffleTopology>(ShuffleTopology{
-        seed_topo.transpose_state(), node_sort_todo,
-        seed_topo.edge_sort_state(), std::move(degrees),
-        std::move(node_prop_indices), std::move(new_dest_vec),
-        std::move(edge_prop_indices)});
+    return MakeFromNodePermutation(seed_topo, new_to_old, node_sort_todo);
   }
 
+  /// Relabel the nodes of seed_topo so that node i of the new topology is
+  /// node new_to_old[i] of seed_topo. Edges keep their relative order.
+  static std::shared_ptr<ShuffleTopology> MakeFromNodePermutation(
+      const EdgeShuffleTopology& seed_topo, const PropIndexVec& new_to_old,
+      const RDGTopology::NodeSortKind& node_sort_todo) noexcept;
+
   ShuffleTopology(
       const RDGTopology::TransposeKind& tpose_todo,
       const RDGTopology::NodeSortKind& node_sort_todo,
@@ -547,12 +521,38 @@ struct EdgeDestComparator {
     return n < topo_->OutEdgeDst(e);
   }
 };
+
+/// The position of key in [types, types + size), or size if it is not there
+inline size_t
+FindEntityTypeID(
+    const EntityTypeID* types, size_t size, EntityTypeID key) noexcept {
+  size_t i = 0;
+#ifdef __SSE2__
+  static_assert(sizeof(EntityTypeID) == 2);
+  __m128i keys = _mm_set1_epi16(static_cast<int16_t>(key));
+  for (; i + 8 <= size; i += 8) {
+    __m128i group =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(group, keys));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask) / 2;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (types[i] == key) {
+      return i;
+    }
+  }
+  return size;
+}
 }  // end namespace internal
 
 class KATANA_EXPORT CondensedTypeIDMap : public GraphTopologyTypes {
   /// map an integer id to each unique edge edge_type in the graph, such that, the
   /// integer ids assigned are contiguous, i.e., 0 .. num_unique_types-1
-  using TypeIDToIndexMap = std::unordered_map<EntityTypeID, uint32_t>;
+  /// Indexed by edge_type, kInvalidIndex for types that are not in the graph.
+  using TypeIDToIndexMap = std::vector<uint32_t>;
   /// reverse map that allows looking up edge_type using its integer index
   using IndexToTypeIDMap = std::vector<EntityTypeID>;
 
@@ -560,6 +560,9 @@ public:
   using EdgeTypeIDRange =
       katana::StandardRange<IndexToTypeIDMap::const_iterator>;
 
+  static constexpr uint32_t kInvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
   CondensedTypeIDMap() = default;
   CondensedTypeIDMap(CondensedTypeIDMap&&) = default;
   CondensedTypeIDMap& operator=(CondensedTypeIDMap&&) = default;
@@ -577,8 +580,8 @@ public:
   }
 
   uint32_t GetIndex(const EntityTypeID& edge_type) const noexcept {
-    KATANA_LOG_DEBUG_ASSERT(type_to_index_map_.count(edge_type) > 0);
-    return type_to_index_map_.at(edge_type);
+    KATANA_LOG_DEBUG_ASSERT(has_edge_type_id(edge_type));
+    return type_to_index_map_[edge_type];
   }
 
   size_t num_unique_types() const noexcept { return index_to_type_map_.size(); }
@@ -586,7 +589,8 @@ public:
   /// @param edge_type: edge_type to check
   /// @returns true iff there exists some edge in the graph with that edge_type
   bool has_edge_type_id(const EntityTypeID& edge_type) const noexcept {
-    return (type_to_index_map_.find(edge_type) != type_to_index_map_.cend());
+    return edge_type < type_to_index_map_.size() &&
+           type_to_index_map_[edge_type] != kInvalidIndex;
   }
 
   /// Wrapper to get the distinct edge types in the graph.
@@ -627,7 +631,7 @@ private:
       : type_to_index_map_(std::move(type_to_index)),
         index_to_type_map_(std::move(index_to_type)),
         is_valid_(true) {
-    KATANA_LOG_ASSERT(index_to_type_map_.size() == type_to_index_map_.size());
+    KATANA_LOG_ASSERT(index_to_type_map_.size() <= type_to_index_map_.size());
   }
 
   TypeIDToIndexMap type_to_index_map_;
@@ -672,21 +676,12 @@ public:
   /// @param edge_type edge_type to get edges of
   /// @returns Range to edges of node N that have edge type == edge_type
   edges_range OutEdges(Node N, const EntityTypeID& edge_type) const noexcept {
-    // per_type_adj_indices_ is expanded so that it stores P prefix sums per node, where
-    // P == edge_type_index_->num_unique_types()
-    // We pick the prefix sum based on the index of the edge_type provided
-    KATANA_LOG_DEBUG_ASSERT(edge_type_index_->num_unique_types() > 0);
-    auto beg_idx = (N * edge_type_index_->num_unique_types()) +
-                   edge_type_index_->GetIndex(edge_type);
-    edge_iterator e_beg{
-        (beg_idx == 0) ? 0 : per_type_adj_indices_[beg_idx - 1]};
-
-    auto end_idx = (N * edge_type_index_->num_unique_types()) +
-                   edge_type_index_->GetIndex(edge_type);
-    KATANA_LOG_DEBUG_ASSERT(end_idx < per_type_adj_indices_.size());
-    edge_iterator e_end{per_type_adj_indices_[end_idx]};
-
-    return katana::MakeStandardRange(e_beg, e_end);
+    Edge run = FindTypeRun(N, edge_type);
+    if (run == kNoTypeRun) {
+      auto e_end = OutEdges(N).end();
+      return MakeStandardRange(e_end, e_end);
+    }
+    return TypeRunEdges(N, run);
   }
 
   /// @param N node to get degree for
@@ -704,11 +699,27 @@ public:
     return edge_type_index_->has_edge_type_id(edge_type);
   }
 
+  /// The distinct edge types of the out edges of N, in increasing order
+  StandardRange<const EntityTypeID*> GetOutEdgeTypes(Node N) const noexcept {
+    const EntityTypeID* types = run_types_.data();
+    return MakeStandardRange(
+        types + FirstTypeRun(N), types + type_run_indices_[N]);
+  }
+
+  /// The number of (node, edge type) pairs with edges
+  size_t NumTypeRuns() const noexcept { return run_types_.size(); }
+
   /// Returns all edges from src to dst with some edge_type.  If not found, returns
   /// empty range.
   edges_range FindAllEdges(
       Node node, Node key, const EntityTypeID& edge_type) const noexcept {
     auto e_range = OutEdges(node, edge_type);
+    return FindAllEdgesIn(e_range, key);
+  }
+
+  /// Returns the edges of e_range, which are sorted by destination, to key.
+  /// If not found, returns empty range.
+  edges_range FindAllEdgesIn(edges_range e_range, Node key) const noexcept {
     if (e_range.empty()) {
       return e_range;
     }
@@ -742,10 +753,10 @@ public:
       return empty_range;
     }
 
-    // loop through all type_ids
-    for (const EntityTypeID& edge_type : GetDistinctEdgeTypes()) {
+    // loop through the types of the edges of src
+    for (Edge run = FirstTypeRun(src); run < type_run_indices_[src]; ++run) {
       // always use out edges (we want an id to the out edge returned)
-      edges_range r = FindAllEdges(src, dst, edge_type);
+      edges_range r = FindAllEdgesIn(TypeRunEdges(src, run), dst);
 
       // return if something was found
       if (r) {
@@ -807,8 +818,8 @@ public:
     // ensure that return type is bool
     static_assert(std::is_same_v<std::invoke_result_t<TestFunc, Edge>, bool>);
 
-    for (const auto& edge_type : GetDistinctEdgeTypes()) {
-      for (auto e : FindAllEdges(src, dst, edge_type)) {
+    for (Edge run = FirstTypeRun(src); run < type_run_indices_[src]; ++run) {
+      for (auto e : FindAllEdgesIn(TypeRunEdges(src, run), dst)) {
         if (func(e)) {
           return true;
         }
@@ -828,11 +839,10 @@ public:
     // ensure that return type is bool
     static_assert(std::is_same_v<std::invoke_result_t<TestFunc, Edge>, bool>);
 
-    for (const auto& edge_type : GetDistinctEdgeTypes()) {
-      for (auto e : OutEdges(src, edge_type)) {
-        if (func(e)) {
-          return true;
-        }
+    // The out edges of src are the edges of all of its types
+    for (auto e : OutEdges(src)) {
+      if (func(e)) {
+        return true;
       }
     }
     return false;
@@ -850,39 +860,85 @@ public:
       return false;
     }
 
-    for (const auto& edge_type : GetDistinctEdgeTypes()) {
-      if (HasEdge(src, dst, edge_type)) {
+    internal::EdgeDestComparator<EdgeTypeAwareTopology> comp{this};
+    for (Edge run = FirstTypeRun(src); run < type_run_indices_[src]; ++run) {
+      auto e_range = TypeRunEdges(src, run);
+      if (std::binary_search(e_range.begin(), e_range.end(), dst, comp)) {
         return true;
       }
     }
     return false;
   }
 
-  katana::Result<RDGTopology> ToRDGTopology() const;
+  /// The RDG stores an entry per node per edge type of the graph rather than
+  /// the type runs. Those entries are built in \p per_type_adj_indices, which
+  /// the returned RDGTopology refers to, so it must outlive storing it.
+  katana::Result<RDGTopology> ToRDGTopology(
+      AdjIndexVec* per_type_adj_indices) const;
 
 private:
+  static constexpr Edge kNoTypeRun = std::numeric_limits<Edge>::max();
+  /// Nodes with at most this many edge types are searched linearly
+  static constexpr size_t kMaxLinearTypeRuns = 32;
+
+  Edge FirstTypeRun(Node N) const noexcept {
+    return N > 0 ? type_run_indices_[N - 1] : 0;
+  }
+
+  /// The index of the run of edges of N with edge_type, or kNoTypeRun
+  Edge FindTypeRun(Node N, const EntityTypeID& edge_type) const noexcept {
+    Edge first = FirstTypeRun(N);
+    Edge last = type_run_indices_[N];
+    const EntityTypeID* types = run_types_.data();
+    if (last - first <= kMaxLinearTypeRuns) {
+      size_t i =
+          internal::FindEntityTypeID(types + first, last - first, edge_type);
+      return i < last - first ? first + i : kNoTypeRun;
+    }
+    const EntityTypeID* it =
+        std::lower_bound(types + first, types + last, edge_type);
+    return (it != types + last && *it == edge_type) ? it - types : kNoTypeRun;
+  }
+
+  edges_range TypeRunEdges(Node N, Edge run) const noexcept {
+    edge_iterator e_beg{
+        run == FirstTypeRun(N) ? *OutEdges(N).begin() : run_ends_[run - 1]};
+    edge_iterator e_end{run_ends_[run]};
+    return MakeStandardRange(e_beg, e_end);
+  }
+
   // Must invoke SortAllEdgesByDataThenDst() before
   // calling this function
-  static AdjIndexVec CreatePerEdgeTypeAdjacencyIndex(
-      const PropertyGraph& pg, const CondensedTypeIDMap& edge_type_index,
-      const EdgeShuffleTopology& e_topo) noexcept;
+  void CreateTypeRuns(const PropertyGraph& pg) noexcept;
+
+  /// Build the type runs from the dense per type adjacency indices of the
+  /// storage format, see ToRDGTopology
+  void CreateTypeRunsFromPerTypeAdjIndices(
+      const uint64_t* per_type_adj_indices) noexcept;
+
+  /// Allocate the runs, given the number of runs of each node in
+  /// type_run_indices_
+  void AllocateTypeRuns() noexcept;
 
   EdgeTypeAwareTopology(
       EdgeShuffleTopology&& e_topo,
-      std::shared_ptr<const CondensedTypeIDMap> edge_type_index,
-      AdjIndexVec&& per_type_adj_indices) noexcept
-      : Base(std::move(e_topo)),
-        edge_type_index_(std::move(edge_type_index)),
-        per_type_adj_indices_(std::move(per_type_adj_indices)) {
+      std::shared_ptr<const CondensedTypeIDMap> edge_type_index) noexcept
+      : Base(std::move(e_topo)), edge_type_index_(std::move(edge_type_index)) {
     KATANA_LOG_DEBUG_ASSERT(edge_type_index_);
-
-    KATANA_LOG_DEBUG_ASSERT(
-        per_type_adj_indices_.size() ==
-        NumNodes() * edge_type_index_->num_unique_types());
   }
 
   std::shared_ptr<const CondensedTypeIDMap> edge_type_index_;
-  AdjIndexVec per_type_adj_indices_;
+
+  // The out edges of a node, sorted by type, are a sequence of runs of edges
+  // of the same type, one per type that the node has. Only those runs are
+  // kept rather than an entry per node per edge type of the graph.
+  //
+  // type_run_indices_[N] is one past the last run of N, run_types_[r] is the
+  // type of run r, sorted within a node, and run_ends_[r] is one past its
+  // last edge.
+  AdjIndexVec type_run_indices_;
+  NUMAArray<EntityTypeID> run_types_;
+  AdjIndexVec run_ends_;
 };
 
 /****************************/
@@ -1168,6 +1224,197 @@ public:
   }
 };
 
+/// Iterates in increasing order over the set bits of a DynamicBitset that
+/// fall in [begin, end). Unset bits are skipped a word at a time.
+///
+/// This is a forward iterator: std::distance and std::advance over it walk
+/// the bits in between, which is what do_all does to split a range of them
+/// between threads.
+template <typename T>
+class SetBitIterator
+    : public boost::iterator_facade<
+          SetBitIterator<T>, T, std::forward_iterator_tag, T> {
+public:
+  SetBitIterator() = default;
+
+  SetBitIterator(const DynamicBitset* bits, uint64_t begin, uint64_t end)
+      : bits_(bits), end_(end) {
+    pos_ = FindNext(begin);
+  }
+
+private:
+  friend class boost::iterator_core_access;
+
+  static constexpr uint64_t kBitsPerWord = DynamicBitset::kNumBitsInUint64;
+
+  uint64_t FindNext(uint64_t from) const noexcept {
+    if (from >= end_) {
+      return end_;
+    }
+    const auto& words = bits_->get_vec();
+    uint64_t w = from / kBitsPerWord;
+    uint64_t last_w = (end_ - 1) / kBitsPerWord;
+    uint64_t word = words[w].load(std::memory_order_relaxed) &
+                    (~uint64_t{0} << (from % kBitsPerWord));
+    while (word == 0) {
+      if (++w > last_w) {
+        return end_;
+      }
+      word = words[w].load(std::memory_order_relaxed);
+    }
+    return std::min(end_, w * kBitsPerWord + __builtin_ctzll(word));
+  }
+
+  void increment() noexcept { pos_ = FindNext(pos_ + 1); }
+
+  bool equal(const SetBitIterator& that) const noexcept {
+    return pos_ == that.pos_;
+  }
+
+  T dereference() const noexcept { return static_cast<T>(pos_); }
+
+  const DynamicBitset* bits_{nullptr};
+  uint64_t pos_{0};
+  uint64_t end_{0};
+};
+
+/// A view of a topology restricted to the nodes and edges set in two masks,
+/// indexed by node and edge ID, without copying the topology.
+///
+/// Node and edge IDs are those of the underlying topology, so that arrays
+/// indexed by them stay valid: NumNodes(), NumEdges() and size() give the
+/// sizes of the ID ranges, while Nodes(), begin(), end(), OutEdges() and
+/// OutDegree() only cover the nodes and edges that are kept. An edge is only
+/// kept if both its endpoints are.
+///
+/// The ranges of kept nodes and edges are forward ranges, so a parallel loop
+/// over them walks the whole range to split it. Parallel loops should
+/// instead iterate over blocks of IDs, which do_all splits in constant time:
+///
+///   do_all(iterate(uint64_t{0}, view.NumNodeBlocks()), [&](uint64_t b) {
+///     for (Node n : view.NodesInBlock(b)) { ... }
+///   });
+template <typename Topo>
+class MaskedTopologyWrapper : public BasicTopologyWrapper<Topo> {
+  using Base = BasicTopologyWrapper<Topo>;
+
+public:
+  using typename Base::Edge;
+  using typename Base::Node;
+  using node_iterator = SetBitIterator<Node>;
+  using edge_iterator = SetBitIterator<Edge>;
+  using nodes_range = StandardRange<node_iterator>;
+  using edges_range = StandardRange<edge_iterator>;
+  using iterator = node_iterator;
+
+  MaskedTopologyWrapper(
+      std::shared_ptr<const Topo> t,
+      std::shared_ptr<const DynamicBitset> node_mask,
+      std::shared_ptr<const DynamicBitset> edge_mask) noexcept
+      : Base(std::move(t)),
+        node_mask_(std::move(node_mask)),
+        edge_mask_(std::move(edge_mask)),
+        num_kept_nodes_(node_mask_->count()),
+        num_kept_edges_(edge_mask_->count()) {
+    KATANA_LOG_DEBUG_ASSERT(node_mask_->size() == Base::NumNodes());
+    KATANA_LOG_DEBUG_ASSERT(edge_mask_->size() == Base::NumEdges());
+  }
+
+  uint64_t NumKeptNodes() const noexcept { return num_kept_nodes_; }
+
+  uint64_t NumKeptEdges() const noexcept { return num_kept_edges_; }
+
+  bool IsNodeKept(const Node& N) const noexcept { return node_mask_->test(N); }
+
+  bool IsEdgeKept(const Edge& e) const noexcept { return edge_mask_->test(e); }
+
+  iterator begin() const noexcept {
+    return iterator(node_mask_.get(), 0, Base::NumNodes());
+  }
+
+  iterator end() const noexcept {
+    return iterator(node_mask_.get(), Base::NumNodes(), Base::NumNodes());
+  }
+
+  nodes_range Nodes() const noexcept {
+    return MakeStandardRange(begin(), end());
+  }
+
+  bool empty() const noexcept { return num_kept_nodes_ == 0; }
+
+  edges_range OutEdges() const noexcept {
+    return MakeEdgesRange(Edge{0}, Edge{Base::NumEdges()});
+  }
+
+  edges_range OutEdges(const Node& N) const noexcept {
+    auto e_range = Base::OutEdges(N);
+    return MakeEdgesRange(*e_range.begin(), *e_range.end());
+  }
+
+  size_t OutDegree(const Node& N) const noexcept {
+    auto e_range = Base::OutEdges(N);
+    return CountSetBits(*edge_mask_, *e_range.begin(), *e_range.end());
+  }
+
+  /// Number of IDs in a block, a whole number of words of the masks
+  static constexpr uint64_t kBlockSize = 8 * DynamicBitset::kNumBitsInUint64;
+
+  uint64_t NumNodeBlocks() const noexcept {
+    return (Base::NumNodes() + kBlockSize - 1) / kBlockSize;
+  }
+
+  /// The kept nodes with IDs in [block * kBlockSize, (block + 1) * kBlockSize)
+  nodes_range NodesInBlock(uint64_t block) const noexcept {
+    uint64_t end =
+        std::min<uint64_t>((block + 1) * kBlockSize, Base::NumNodes());
+    return MakeStandardRange(
+        node_iterator(node_mask_.get(), block * kBlockSize, end),
+        node_iterator(node_mask_.get(), end, end));
+  }
+
+  uint64_t NumEdgeBlocks() const noexcept {
+    return (Base::NumEdges() + kBlockSize - 1) / kBlockSize;
+  }
+
+  /// The kept edges with IDs in [block * kBlockSize, (block + 1) * kBlockSize)
+  edges_range EdgesInBlock(uint64_t block) const noexcept {
+    uint64_t end =
+        std::min<uint64_t>((block + 1) * kBlockSize, Base::NumEdges());
+    return MakeEdgesRange(Edge(block * kBlockSize), Edge(end));
+  }
+
+private:
+  edges_range MakeEdgesRange(Edge beg, Edge end) const noexcept {
+    return MakeStandardRange(
+        edge_iterator(edge_mask_.get(), beg, end),
+        edge_iterator(edge_mask_.get(), end, end));
+  }
+
+  static size_t CountSetBits(
+      const DynamicBitset& bits, uint64_t beg, uint64_t end) noexcept {
+    constexpr uint64_t kBitsPerWord = DynamicBitset::kNumBitsInUint64;
+    const auto& words = bits.get_vec();
+    size_t count = 0;
+    while (beg < end) {
+      uint64_t w = beg / kBitsPerWord;
+      uint64_t lo = beg % kBitsPerWord;
+      uint64_t n = std::min(kBitsPerWord - lo, end - beg);
+      uint64_t word = words[w].load(std::memory_order_relaxed) >> lo;
+      if (n < kBitsPerWord) {
+        word &= (uint64_t{1} << n) - 1;
+      }
+      count += __builtin_popcountll(word);
+      beg += n;
+    }
+    return count;
+  }
+
+  std::shared_ptr<const DynamicBitset> node_mask_;
+  std::shared_ptr<const DynamicBitset> edge_mask_;
+  uint64_t num_kept_nodes_;
+  uint64_t num_kept_edges_;
+};
+
 class KATANA_EXPORT EdgeTypeAwareBiDirTopology
     : public BasicBiDirTopoWrapper<
           EdgeTypeAwareTopology, EdgeTypeAwareTopology> {
@@ -1313,11 +1560,10 @@ public:
     static_assert(
         std::is_same_v<RetTy, bool>);  // ensure that return type is bool.
 
-    for (const auto& edge_type : GetDistinctEdgeTypes()) {
-      for (auto e : InEdges(dst, edge_type)) {
-        if (func(e)) {
-          return true;
-        }
+    // The in edges of dst are the edges of all of its types
+    for (auto e : InEdges(dst)) {
+      if (func(e)) {
+        return true;
       }
     }
     return false;
@@ -1472,6 +1718,38 @@ struct PGViewBuilder<PGViewNodesSortedByDegreeEdgesSortedByDestID> {
   }
 };
 
+// Nodes reordered for locality, edges sorted by destination view
+
+template <RDGTopology::NodeSortKind kReordering>
+class NodesReorderedTopology : public SortedTopologyWrapper<ShuffleTopology> {
+  using Base = SortedTopologyWrapper<ShuffleTopology>;
+
+public:
+  explicit NodesReorderedTopology(
+      std::shared_ptr<const ShuffleTopology> t) noexcept
+      : Base(std::move(t)) {
+    KATANA_LOG_DEBUG_ASSERT(Base::topo().has_nodes_sorted_by(kReordering));
+  }
+};
+
+template <RDGTopology::NodeSortKind kReordering>
+using PGViewNodesReordered =
+    BasicPropGraphViewWrapper<NodesReorderedTopology<kReordering>>;
+
+template <RDGTopology::NodeSortKind kReordering>
+struct PGViewBuilder<PGViewNodesReordered<kReordering>> {
+  template <typename ViewCache>
+  static PGViewNodesReordered<kReordering> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+    auto reordered_topo = viewCache.BuildOrGetShuffTopo(
+        pg, RDGTopology::TransposeKind::kNo, kReordering,
+        RDGTopology::EdgeSortKind::kSortedByDestID);
+
+    return PGViewNodesReordered<kReordering>{
+        pg, NodesReorderedTopology<kReordering>{reordered_topo}};
+  }
+};
+
 // Bidirectional view
 
 using SimpleBiDirTopology =
@@ -1535,6 +1813,12 @@ struct PGViewBuilder<PGViewEdgeTypeAwareBiDir> {
   }
 };
 
+// View restricted to the nodes and edges of masks, see
+// PropertyGraph::BuildMaskedView
+
+using MaskedTopology = MaskedTopologyWrapper<GraphTopology>;
+using PGViewMasked = BasicPropGraphViewWrapper<MaskedTopology>;
+
 }  // end namespace internal
 
 struct PropertyGraphViews {
@@ -1544,10 +1828,48 @@ struct PropertyGraphViews {
   using Undirected = internal::PGViewUnDirected;
   using EdgesSortedByDestID = internal::PGViewEdgesSortedByDestID;
   using EdgeTypeAwareBiDir = internal::PGViewEdgeTypeAwareBiDir;
+  using Masked = internal::PGViewMasked;
   using NodesSortedByDegreeEdgesSortedByDestID =
       internal::PGViewNodesSortedByDegreeEdgesSortedByDestID;
+  // See katana/GraphReordering.h
+  using NodesReorderedByRCM = internal::PGViewNodesReordered<
+      RDGTopology::NodeSortKind::kReverseCuthillMcKee>;
+  using NodesReorderedByHubSort =
+      internal::PGViewNodesReordered<RDGTopology::NodeSortKind::kHubSorted>;
+  using NodesReorderedByHubCluster =
+      internal::PGViewNodesReordered<RDGTopology::NodeSortKind::kHubClustered>;
+  using NodesReorderedByGorder =
+      internal::PGViewNodesReordered<RDGTopology::NodeSortKind::kGorder>;
+  using NodesReorderedByRabbitOrder =
+      internal::PGViewNodesReordered<RDGTopology::NodeSortKind::kRabbitOrder>;
+};
+
+/// Counters of a PGViewCache
+struct KATANA_EXPORT PGViewCacheStats {
+  /// Views found in the cache
+  uint64_t hits{0};
+  /// Views not in the cache, which were reloaded or built
+  uint64_t misses{0};
+  /// Misses served from a spilled view or a topology in the RDG
+  uint64_t reloads{0};
+  uint64_t builds{0};
+  uint64_t evictions{0};
+  /// Evicted views written to the spill directory
+  uint64_t spills{0};
+  /// Time spent reloading and building views
+  double build_seconds{0};
+  /// Size of the views in the cache
+  count_t bytes{0};
 };
 
+/// Caches the views (topologies) built for a PropertyGraph.
+///
+/// With a memory budget, the cache evicts views that no PGView is using
+/// until it fits, cheapest to rebuild per byte first, least recently used
+/// among equals (GreedyDual-Size). Views the cache holds count as standby
+/// memory of the ViewManager, so the MemorySupervisor can also ask for them
+/// back. With a spill directory, evicted views are written there and
+/// reloaded on their next use instead of being rebuilt.
 class KATANA_EXPORT PGViewCache {
   std::shared_ptr<GraphTopology> original_topo_{
       std::make_shared<GraphTopology>()};
@@ -1558,26 +1880,80 @@ class KATANA_EXPORT PGViewCache {
   std::shared_ptr<CondensedTypeIDMap> edge_type_id_map_;
   // TODO(amber): define a node_type_id_map_;
 
+  /// Shared by the users of a cached view. The bytes of a cached view are
+  /// active memory of the ViewManager while it has users, standby otherwise.
+  struct ViewLease {
+    count_t bytes{0};
+    /// Whether the cache still accounts for the view
+    bool cached{true};
+    ~ViewLease();
+  };
+
+  /// The bookkeeping of a view in the cache
+  struct CachedView {
+    const GraphTopology* topo;
+    count_t bytes;
+    double build_seconds;
+    /// Views are evicted in increasing order of priority
+    double priority;
+    /// The lease of the users of the view, expired if it has none
+    std::weak_ptr<ViewLease> lease;
+  };
+  std::vector<CachedView> cached_views_;
+
+  /// A view written to the spill directory
+  struct SpilledView {
+    /// The file of the view, relative to the spill directory
+    std::string file;
+    RDGTopology::TopologyKind topology_kind;
+    RDGTopology::TransposeKind transpose_kind;
+    RDGTopology::EdgeSortKind edge_sort_kind;
+    RDGTopology::NodeSortKind node_sort_kind;
+  };
+  std::vector<SpilledView> spilled_views_;
+
+  count_t budget_{0};
+  URI spill_dir_;
+  /// The GreedyDual-Size clock, the priority of the last evicted view
+  double clock_{0};
+  PGViewCacheStats stats_;
+
   template <typename>
   friend struct internal::PGViewBuilder;
 
 public:
-  PGViewCache() = default;
-  PGViewCache(GraphTopology&& original_topo)
-      : original_topo_(
-            std::make_shared<GraphTopology>(std::move(original_topo))) {}
-  PGViewCache(PGViewCache&&) = default;
-  PGViewCache& operator=(PGViewCache&&) = default;
+  PGViewCache();
+  PGViewCache(GraphTopology&& original_topo);
+  PGViewCache(PGViewCache&& other) noexcept;
+  PGViewCache& operator=(PGViewCache&& other) noexcept;
+  ~PGViewCache();
 
   PGViewCache(const PGViewCache&) = delete;
   PGViewCache& operator=(const PGViewCache&) = delete;
 
+  /// Keep the views in the cache within \p bytes, evicting views that are
+  /// not in use as needed. 0, the default, means no budget.
+  void SetMemoryBudget(count_t bytes);
+
+  /// Write evicted views to files in \p dir, so that they are reloaded
+  /// instead of rebuilt. An empty \p dir, the default, drops them.
+  void SetSpillDir(const URI& dir) { spill_dir_ = dir; }
+
+  const PGViewCacheStats& stats() const { return stats_; }
+
+  /// Evict views that are not in use until \p goal bytes are freed or
+  /// there are none left. Returns the number of bytes evicted.
+  count_t EvictViews(count_t goal);
+
   template <typename PGView>
   PGView BuildView(PropertyGraph* pg) noexcept {
     return internal::PGViewBuilder<PGView>::BuildView(pg, *this);
   }
 
-  katana::Result<std::vector<RDGTopology>> ToRDGTopology();
+  /// The returned topologies may refer to arrays built in \p buffers, which
+  /// must outlive storing them.
+  katana::Result<std::vector<RDGTopology>> ToRDGTopology(
+      std::vector<GraphTopology::AdjIndexVec>* buffers);
 
   template <typename PGView>
   PGView BuildView(
@@ -1593,6 +1969,11 @@ public:
   // Purge cache and construct an empty topology as the default one.
   void DropAllTopologies() noexcept;
 
+  // Build or get the topology with nodes reordered by kind, see
+  // katana/GraphReordering.h. Edges are sorted by destination.
+  std::shared_ptr<ShuffleTopology> BuildOrGetReorderedTopo(
+      PropertyGraph* pg, const RDGTopology::NodeSortKind& kind) noexcept;
+
 private:
   std::shared_ptr<GraphTopology> GetDefaultTopology() const noexcept;
 
@@ -1623,6 +2004,46 @@ private:
 
   std::shared_ptr<EdgeTypeAwareTopology> BuildOrGetEdgeTypeAwareTopo(
       PropertyGraph* pg, const RDGTopology::TransposeKind& tpose_kind) noexcept;
+
+  /// Account for a view that was just added to the cache, and check it out
+  /// for the caller.
+  template <typename Topo>
+  std::shared_ptr<Topo> AddCachedView(
+      std::shared_ptr<Topo> topo, count_t bytes, double build_seconds);
+
+  /// Mark a cached view as used
+  void TouchCachedView(const GraphTopology* topo);
+
+  /// Hand out a cached view. Its memory is active until the returned
+  /// pointer and all of its copies are gone.
+  template <typename Topo>
+  std::shared_ptr<Topo> CheckOut(std::shared_ptr<Topo> topo);
+
+  /// Stop accounting for a view that left the cache
+  void RemoveCachedView(const GraphTopology* topo);
+
+  /// Stop accounting for \p view. Returns its bytes if they were standby,
+  /// 0 if the view is in use.
+  static count_t ReleaseCachedView(const CachedView& view);
+
+  /// Evict views until the cache fits in the budget
+  void EnforceBudget();
+
+  /// Evict the unused view with the lowest priority. Returns its size, or 0
+  /// if all views are in use.
+  count_t EvictOne();
+
+  /// Write a view to the spill directory
+  Result<void> Spill(const RDGTopology& rdg_topo);
+
+  /// Reload the first spilled view for which \p pred holds and remove it
+  /// from the spill directory. Returns nullptr if there is none.
+  template <typename Topo>
+  std::shared_ptr<Topo> ReloadSpilled(
+      const std::function<bool(const SpilledView&)>& pred);
+
+  /// Drop all views and spilled files
+  void Clear() noexcept;
 };
 
 /// Creates a uniform-random CSR GraphTopology instance, where each node as
@@ -112,6 +112,31 @@ GetMutableValuesWorkAround(
   return data->template GetMutableValues<T>(i, absolute_offset);
 }
 
+/// Allocate a buffer of \p num_bytes and zero it in parallel. The threads
+/// that touch its pages first are the threads of the parallel loops that
+/// later fill it, which spreads the buffer over NUMA nodes.
+KATANA_EXPORT Result<std::shared_ptr<arrow::Buffer>> AllocateZeroedBuffer(
+    int64_t num_bytes);
+
+/// Allocate an array of \p num_rows non-null, zero values of the fixed width
+/// \p type without an arrow builder. Values are written in place through
+/// property views, so the array is never copied.
+KATANA_EXPORT Result<std::shared_ptr<arrow::Array>> AllocateFixedWidthArray(
+    const std::shared_ptr<arrow::DataType>& type, int64_t num_rows);
+
+/// Allocate a large list array of \p num_rows lists, each of \p list_size
+/// non-null, zero values of the fixed width \p value_type
+KATANA_EXPORT Result<std::shared_ptr<arrow::Array>> AllocateUniformListArray(
+    const std::shared_ptr<arrow::DataType>& value_type, int64_t num_rows,
+    int64_t list_size);
+
+/// Pack \p num_bytes bytes, each meaning true if it is not zero, into the
+/// arrow bitmap \p bitmap in parallel
+///
+/// \returns the number of zero bytes
+KATANA_EXPORT int64_t PackBytesToBitmap(
+    const uint8_t* bytes, int64_t num_bytes, uint8_t* bitmap);
+
 template <typename>
 struct PropertyViewTuple;
 
@@ -494,6 +519,70 @@ private:
   const ArrowArrayType& array_;
 };
 
+/// DictionaryStringPropertyReadOnlyView provides a read-only property view
+/// over dictionary encoded strings (i.e., arrow::DictionaryArray with int32
+/// indices into a sorted dictionary of distinct large strings).
+///
+/// Besides the strings, the view exposes the integer code of every value.
+/// Equal strings have equal codes, so comparisons and group-bys can work on
+/// codes, e.g., with an array of num_codes() counters, and only look at the
+/// strings of the dictionary.
+///
+/// \see DictionaryEncodeStrings
+class KATANA_EXPORT DictionaryStringPropertyReadOnlyView {
+public:
+  using value_type = std::string;
+  using code_type = int32_t;
+
+  /// Fails unless the dictionary of \p array is sorted, as it is after
+  /// DictionaryEncodeStrings and when loaded from storage
+  static Result<DictionaryStringPropertyReadOnlyView> Make(
+      const arrow::DictionaryArray& array);
+
+  bool IsValid(size_t i) const { return array_.IsValid(i); }
+
+  size_t size() const { return array_.length(); }
+
+  /// The number of distinct codes, the size of the dictionary
+  size_t num_codes() const { return dictionary_->length(); }
+
+  /// The code of value i, in [0, num_codes())
+  code_type GetCode(size_t i) const {
+    KATANA_LOG_DEBUG_ASSERT(IsValid(i));
+    return codes_[i];
+  }
+
+  /// The string of code
+  std::string_view CodeValue(code_type code) const {
+    arrow::util::string_view view = dictionary_->GetView(code);
+    return std::string_view(view.data(), view.length());
+  }
+
+  /// \returns the code of value, or -1 if value is not in the dictionary
+  code_type FindCode(std::string_view value) const;
+
+  value_type GetValue(size_t i) const {
+    return std::string(CodeValue(GetCode(i)));
+  }
+
+  value_type operator[](size_t i) const {
+    if (!IsValid(i)) {
+      return value_type{};
+    }
+    return GetValue(i);
+  }
+
+private:
+  DictionaryStringPropertyReadOnlyView(
+      const arrow::DictionaryArray& array, const code_type* codes,
+      std::shared_ptr<arrow::LargeStringArray> dictionary)
+      : array_(array), codes_(codes), dictionary_(std::move(dictionary)) {}
+
+  const arrow::DictionaryArray& array_;
+  const code_type* codes_;
+  std::shared_ptr<arrow::LargeStringArray> dictionary_;
+};
+
 template <typename ArrowT, typename ViewT>
 struct Property {
   using ArrowType = ArrowT;
@@ -501,23 +590,27 @@ struct Property {
 
   static Result<std::shared_ptr<arrow::Table>> Allocate(
       size_t num_rows, const std::string& name) {
-    using Builder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    Builder builder;
-
-    KATANA_CHECKED(builder.Reserve(num_rows));
-    KATANA_CHECKED_ERROR_CODE(
-        builder.AppendEmptyValues(num_rows), katana::ErrorCode::ArrowError,
-        "failed to append values");
+    auto type = arrow::TypeTraits<ArrowType>::type_singleton();
 
     std::shared_ptr<arrow::Array> array;
-    KATANA_CHECKED_ERROR_CODE(
-        builder.Finish(&array), katana::ErrorCode::ArrowError,
-        "failed to construct arrow array");
+    if constexpr (arrow::is_fixed_width_type<ArrowType>::value) {
+      array = KATANA_CHECKED(internal::AllocateFixedWidthArray(type, num_rows));
+    } else {
+      using Builder = typename arrow::TypeTraits<ArrowType>::BuilderType;
+      Builder builder;
+
+      KATANA_CHECKED(builder.Reserve(num_rows));
+      KATANA_CHECKED_ERROR_CODE(
+          builder.AppendEmptyValues(num_rows), katana::ErrorCode::ArrowError,
+          "failed to append values");
+
+      KATANA_CHECKED_ERROR_CODE(
+          builder.Finish(&array), katana::ErrorCode::ArrowError,
+          "failed to construct arrow array");
+    }
 
     return arrow::Table::Make(
-        arrow::schema({arrow::field(
-            name, arrow::TypeTraits<ArrowType>::type_singleton())}),
-        {array});
+        arrow::schema({arrow::field(name, type)}), {array});
   }
 };
 
@@ -558,6 +651,10 @@ struct LargeStringReadOnlyProperty
           arrow::LargeStringType,
           StringPropertyReadOnlyView<arrow::LargeStringArray>> {};
 
+struct DictionaryStringReadOnlyProperty
+    : public Property<
+          arrow::DictionaryType, DictionaryStringPropertyReadOnlyView> {};
+
 template <typename T>
 struct StructProperty
     : public Property<arrow::FixedSizeBinaryType, katana::PODPropertyView<T>> {
@@ -571,16 +668,8 @@ struct StructProperty
     }
 
     auto type = res.ValueOrDie();
-    arrow::FixedSizeBinaryBuilder builder(type);
-    KATANA_CHECKED(builder.Reserve(num_rows));
-    KATANA_CHECKED_ERROR_CODE(
-        builder.AppendEmptyValues(num_rows), katana::ErrorCode::ArrowError,
-        "failed to append values");
-
-    std::shared_ptr<arrow::Array> array;
-    KATANA_CHECKED_ERROR_CODE(
-        builder.Finish(&array), katana::ErrorCode::ArrowError,
-        "failed to construct arrow array ");
+    std::shared_ptr<arrow::Array> array =
+        KATANA_CHECKED(internal::AllocateFixedWidthArray(type, num_rows));
 
     return katana::Result<std::shared_ptr<arrow::Table>>(
         arrow::Table::Make(arrow::schema({arrow::field(name, type)}), {array}));
@@ -673,21 +762,8 @@ struct ArrayProperty {
   static katana::Result<std::shared_ptr<arrow::Table>> Allocate(
       size_t num_rows, const std::string& name) {
     // TODO(nojan): type of arrow::large_list() should be determined by T. arrow::float64 is hardcoded here.
-    std::unique_ptr<arrow::ArrayBuilder> builder;
-    KATANA_CHECKED(arrow::MakeBuilder(
-        arrow::default_memory_pool(), arrow::large_list(arrow::float64()),
-        &builder));
-    auto outer = dynamic_cast<arrow::LargeListBuilder*>(builder.get());
-    // TODO(nojanp): arrow builder type should be determined by T. arrow::DoubleBuilder is hardcoded here.
-    auto inner = dynamic_cast<arrow::DoubleBuilder*>(outer->value_builder());
-
-    for (size_t i = 0; i < num_rows; i++) {
-      KATANA_CHECKED(outer->Append());
-      KATANA_CHECKED(inner->AppendEmptyValues(N));
-    }
-
-    std::shared_ptr<arrow::Array> array_of_list_of_double =
-        KATANA_CHECKED(builder->Finish());
+    std::shared_ptr<arrow::Array> array_of_list_of_double = KATANA_CHECKED(
+        internal::AllocateUniformListArray(arrow::float64(), num_rows, N));
 
     return katana::Result<std::shared_ptr<arrow::Table>>(arrow::Table::Make(
         arrow::schema(
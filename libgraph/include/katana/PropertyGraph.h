@@ -233,6 +233,17 @@ public:
     return pg_view_cache_.BuildView<PGView>(this);
   }
 
+  /// Build a view of the topology of this graph restricted to the nodes set
+  /// in \p node_mask and the edges set in \p edge_mask whose endpoints are
+  /// kept. The masks are indexed by property index, as produced by
+  /// PropertyPredicate; a null mask keeps every node or edge.
+  ///
+  /// Unlike MakeProjectedGraph, the view shares the topology of this graph
+  /// and keeps its node and edge IDs: it only allocates a bit per node and
+  /// per edge.
+  Result<PropertyGraphViews::Masked> BuildMaskedView(
+      const DynamicBitset* node_mask, const DynamicBitset* edge_mask);
+
   /// Make a property graph from a constructed RDG. Take ownership of the RDG
   /// and its underlying resources.
   static Result<std::unique_ptr<PropertyGraph>> Make(
@@ -294,6 +305,22 @@ public:
       PropertyGraph& pg, std::optional<SetOfEntityTypeIDs> node_types,
       std::optional<SetOfEntityTypeIDs> edge_types);
 
+  /// Make a projected graph from a property graph, keeping the nodes set in
+  /// \p node_mask and the edges set in \p edge_mask whose endpoints are
+  /// kept. The masks are indexed by property index, as produced by
+  /// PropertyPredicate; a null mask keeps every node or edge. Shares state
+  /// with the original graph.
+  static Result<std::unique_ptr<PropertyGraph>> MakeProjectedGraph(
+      PropertyGraph& pg, const DynamicBitset* node_mask,
+      const DynamicBitset* edge_mask);
+
+  /// Make a transformed graph whose nodes are reordered for locality, see
+  /// katana/GraphReordering.h. Shares properties with the original graph;
+  /// OriginalToTransformedNodeID maps nodes of pg to the reordered graph.
+  /// The reordered topology is cached in pg and persisted with it.
+  static Result<std::unique_ptr<PropertyGraph>> MakeReorderedGraph(
+      PropertyGraph& pg, RDGTopology::NodeSortKind kind);
+
   /// \return A copy of this with the same set of properties. The copy shares no
   ///       state with this.
   Result<std::unique_ptr<PropertyGraph>> Copy(
@@ -603,6 +630,26 @@ public:
         edge_entity_type_id, GetTypeOfEdgeFromPropertyIndex(edge));
   }
 
+  /// Set the bit of \p mask for each node property index whose node has any
+  /// of the node entity types \p node_entity_type_ids (need not be the most
+  /// specific types). \p mask is resized to NumOriginalNodes().
+  ///
+  /// This tests the types of the nodes in batches against their precomputed
+  /// super-types, which is much cheaper than calling DoesNodeHaveType for
+  /// each node and type.
+  void GetNodesWithAnyType(
+      const SetOfEntityTypeIDs& node_entity_type_ids,
+      DynamicBitset* mask) const;
+
+  /// Set the bit of \p mask for each edge property index whose edge has any
+  /// of the edge entity types \p edge_entity_type_ids (need not be the most
+  /// specific types). \p mask is resized to NumOriginalEdges().
+  ///
+  /// \see GetNodesWithAnyType
+  void GetEdgesWithAnyType(
+      const SetOfEntityTypeIDs& edge_entity_type_ids,
+      DynamicBitset* mask) const;
+
   // Return type dictated by arrow
   /// Returns the number of node properties
   /// Does not include types managed by the EntityTypeManager
@@ -723,6 +770,19 @@ public:
     return pg_view_cache_.DropAllTopologies();
   }
 
+  /// Keep the views built for this graph within \p bytes; see PGViewCache.
+  /// 0 means no budget.
+  void SetViewMemoryBudget(count_t bytes) {
+    pg_view_cache_.SetMemoryBudget(bytes);
+  }
+
+  /// Write evicted views to \p dir instead of dropping them
+  void SetViewSpillDir(const URI& dir) { pg_view_cache_.SetSpillDir(dir); }
+
+  const PGViewCacheStats& view_cache_stats() const {
+    return pg_view_cache_.stats();
+  }
+
   const GraphTopology& topology() const noexcept {
     return pg_view_cache_.GetDefaultTopologyRef();
   }
@@ -786,6 +846,19 @@ public:
   Result<void> RemoveEdgeProperty(
       const std::string& prop_name, katana::TxnContext* txn_ctx);
 
+  /// Replace the string node property prop_name by its dictionary encoding,
+  /// under the same name
+  ///
+  /// \see DictionaryEncodeStrings
+  Result<void> DictionaryEncodeNodeProperty(
+      const std::string& prop_name, katana::TxnContext* txn_ctx);
+  /// Replace the string edge property prop_name by its dictionary encoding,
+  /// under the same name
+  ///
+  /// \see DictionaryEncodeStrings
+  Result<void> DictionaryEncodeEdgeProperty(
+      const std::string& prop_name, katana::TxnContext* txn_ctx);
+
   /// Write a node property column out to storage and de-allocate the memory
   /// it was using
   Result<void> UnloadNodeProperty(const std::string& prop_name);
@@ -937,13 +1010,29 @@ public:
   }
 
   // Creates an index over a node property.
-  Result<void> MakeNodeIndex(const std::string& property_name);
+  Result<void> MakeNodeIndex(
+      const std::string& property_name,
+      EntityIndexKind kind = EntityIndexKind::kOrdered);
+
+  // Creates an index over a tuple of node properties. The index is named
+  // CompositeIndexName(property_names).
+  Result<void> MakeCompositeNodeIndex(
+      const std::vector<std::string>& property_names,
+      EntityIndexKind kind = EntityIndexKind::kOrdered);
 
   // Delete an existing index over a node property.
   Result<void> DeleteNodeIndex(const std::string& property_name);
 
   // Creates an index over an edge property.
-  Result<void> MakeEdgeIndex(const std::string& property_name);
+  Result<void> MakeEdgeIndex(
+      const std::string& property_name,
+      EntityIndexKind kind = EntityIndexKind::kOrdered);
+
+  // Creates an index over a tuple of edge properties. The index is named
+  // CompositeIndexName(property_names).
+  Result<void> MakeCompositeEdgeIndex(
+      const std::vector<std::string>& property_names,
+      EntityIndexKind kind = EntityIndexKind::kOrdered);
 
   // Delete an existing index over an edge property.
   Result<void> DeleteEdgeIndex(const std::string& property_name);
@@ -983,6 +1072,18 @@ public:
     return IsTransformed() ? original_to_transformed_nodes_[node] : node;
   }
 
+  /// Return the number of nodes of the original property graph, which is the
+  /// number of node property indices.
+  uint64_t NumOriginalNodes() const {
+    return IsTransformed() ? original_to_transformed_nodes_.size() : NumNodes();
+  }
+
+  /// Return the number of edges of the original property graph, which is the
+  /// number of edge property indices.
+  uint64_t NumOriginalEdges() const {
+    return IsTransformed() ? original_to_transformed_edges_.size() : NumEdges();
+  }
+
 protected:
   RDG& rdg() { return *rdg_; }
   const RDG& rdg() const { return *rdg_; }
@@ -1064,7 +1165,18 @@ private:
   /// Validate performs a sanity check on the the graph after loading
   Result<void> Validate();
 
-  Result<void> DoWriteTopologies();
+  /// Upsert the topologies to store into the RDG. They may refer to arrays
+  /// built in \p buffers, which must outlive the store.
+  Result<void> DoWriteTopologies(
+      std::vector<GraphTopology::AdjIndexVec>* buffers);
+
+  /// Store the sorted order of every index with the RDG, so that building
+  /// them again after loading does not sort.
+  Result<void> DoWriteIndexes();
+
+  /// Build index, taking its order from the RDG if it was stored there.
+  template <typename node_or_edge>
+  Result<void> BuildIndex(EntityIndex<node_or_edge>* index, bool is_node);
 
   Result<void> DoWrite(
       katana::RDGHandle handle, const std::string& command_line,
@@ -1084,16 +1196,6 @@ private:
       const katana::URI& uri, const std::string& command_line,
       katana::TxnContext* txn_ctx);
 
-  /// Return the number of nodes of the original property graph.
-  uint64_t NumOriginalNodes() const {
-    return IsTransformed() ? original_to_transformed_nodes_.size() : NumNodes();
-  }
-
-  /// Return the number of edges of the original property graph.
-  uint64_t NumOriginalEdges() const {
-    return IsTransformed() ? original_to_transformed_edges_.size() : NumEdges();
-  }
-
   Result<RDGTopology*> LoadTopology(const RDGTopology& shadow);
 
   // Data
@@ -0,0 +1,87 @@
+#ifndef KATANA_LIBGRAPH_KATANA_PROPERTYPREDICATE_H_
+#define KATANA_LIBGRAPH_KATANA_PROPERTYPREDICATE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "katana/DynamicBitset.h"
+#include "katana/EntityTypeManager.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+class PropertyGraph;
+
+/// A predicate over the properties and types of the nodes, or of the edges,
+/// of a PropertyGraph, e.g., "weight > 0.5 and type in {A, B}":
+///
+///     using P = katana::PropertyPredicate;
+///     auto pred = P::And(
+///         P::Compare("weight", P::CompareOp::kGreater, 0.5),
+///         P::HasType(types));
+///     katana::DynamicBitset mask = KATANA_CHECKED(pred.EvaluateEdges(pg));
+///
+/// Evaluating a predicate produces a mask with one bit per property index,
+/// set where the predicate holds. The mask can be passed to
+/// PropertyGraph::MakeProjectedGraph or to analytics that take masks.
+///
+/// Predicates are evaluated a column at a time rather than an element at a
+/// time: threads fill whole words of the mask from runs of contiguous
+/// property values, in loops without per-element dispatch that the compiler
+/// can vectorize. Null values never satisfy a comparison.
+class KATANA_EXPORT PropertyPredicate {
+public:
+  enum class CompareOp {
+    kEqual,
+    kNotEqual,
+    kLess,
+    kLessEqual,
+    kGreater,
+    kGreaterEqual,
+  };
+
+  /// Integer values are compared exactly with integer properties; other
+  /// numeric combinations are compared as doubles. Strings are compared
+  /// with string properties, bytewise. Dictionary encoded properties decide
+  /// each string of their dictionary once and then only look up codes.
+  using Value = std::variant<int64_t, double, std::string>;
+
+  /// The numeric or string property \p property compares to \p value with
+  /// \p op
+  static PropertyPredicate Compare(
+      std::string property, CompareOp op, Value value);
+
+  /// The value of \p property is not null
+  static PropertyPredicate IsValid(std::string property);
+
+  /// The entity has at least one of \p types (which need not be its most
+  /// specific type)
+  static PropertyPredicate HasType(SetOfEntityTypeIDs types);
+
+  static PropertyPredicate And(PropertyPredicate lhs, PropertyPredicate rhs);
+  static PropertyPredicate Or(PropertyPredicate lhs, PropertyPredicate rhs);
+  static PropertyPredicate Not(PropertyPredicate operand);
+
+  /// \returns the mask of the nodes of \p pg that satisfy this predicate,
+  /// indexed by node property index
+  Result<DynamicBitset> EvaluateNodes(const PropertyGraph& pg) const;
+
+  /// \returns the mask of the edges of \p pg that satisfy this predicate,
+  /// indexed by edge property index
+  Result<DynamicBitset> EvaluateEdges(const PropertyGraph& pg) const;
+
+  struct Expr;
+
+private:
+  explicit PropertyPredicate(std::shared_ptr<const Expr> expr)
+      : expr_(std::move(expr)) {}
+
+  std::shared_ptr<const Expr> expr_;
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef KATANA_LIBGRAPH_KATANA_VIEWMANAGER_H_
+#define KATANA_LIBGRAPH_KATANA_VIEWMANAGER_H_
+
+#include <string>
+#include <vector>
+
+#include "katana/Manager.h"
+#include "katana/config.h"
+
+namespace katana {
+
+class PGViewCache;
+
+/// Manager for the memory of the views (topologies) cached by PGViewCaches.
+///
+/// A cached view that no PGView uses is standby memory: it can be dropped and
+/// rebuilt, or reloaded if it was spilled. When the MemorySupervisor asks for
+/// memory back, the view manager asks its caches to evict such views.
+class KATANA_EXPORT ViewManager : public Manager {
+public:
+  static const std::string name_;
+  const std::string& Name() const override { return name_; }
+  count_t FreeStandbyMemory(count_t goal) override;
+
+  /// The view manager, registered with the MemorySupervisor on first use.
+  /// It is looked up on every call rather than kept, so it is valid as long
+  /// as the MemorySupervisor is. Not thread safe, like the MemorySupervisor.
+  static ViewManager& Get();
+
+  void Register(PGViewCache* cache);
+  void Unregister(PGViewCache* cache);
+
+  /// \p bytes of standby views came into use
+  void ViewsCheckedOut(count_t bytes);
+  /// \p bytes of cached views are no longer in use
+  void ViewsReleased(count_t bytes);
+  /// \p bytes of standby views were dropped from a cache
+  void ViewsDropped(count_t bytes);
+
+private:
+  std::vector<PGViewCache*> caches_;
+};
+
+}  // namespace katana
+
+#endif
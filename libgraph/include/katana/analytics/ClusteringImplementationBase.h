@@ -20,6 +20,7 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <random>
@@ -64,6 +65,112 @@ using EdgeWeight = katana::PODProperty<EdgeWeightType>;
 struct CurrentSubCommunityID : public katana::PODProperty<uint64_t> {};
 struct NodeWeight : public katana::PODProperty<uint64_t> {};
 
+/**
+ * Reusable accumulator of edge weights by cluster id, meant to be kept
+ * per thread.
+ *
+ * Clusters are kept in the order they are first added. Cluster ids are
+ * mapped to their position with a table that is indexed directly by cluster
+ * id when all ids fit in a table sized for the expected number of clusters,
+ * and is an open addressing hash table otherwise. Clear only resets the
+ * entries of the clusters that were added, so reusing the accumulator costs
+ * time proportional to the number of clusters added, not to its capacity.
+ */
+template <typename WeightTy>
+class ClusterWeightAccumulator {
+public:
+  /**
+   * Prepares the accumulator for cluster ids in [0, num_cluster_ids) and
+   * about max_clusters distinct clusters between calls to Clear. The
+   * accumulator grows if more clusters are added.
+   */
+  void Reserve(uint64_t num_cluster_ids, uint64_t max_clusters) {
+    KATANA_LOG_DEBUG_ASSERT(clusters_.empty());
+    uint64_t capacity = HashCapacity(max_clusters);
+    if (num_cluster_ids <= capacity) {
+      Rebuild(true, num_cluster_ids);
+    } else {
+      Rebuild(false, capacity);
+    }
+  }
+
+  void Add(uint64_t cluster, WeightTy weight) {
+    if (dense_) {
+      if (cluster >= slots_.size()) {
+        Rebuild(false, HashCapacity(clusters_.size() + 1));
+      }
+    } else if (2 * (clusters_.size() + 1) > slots_.size()) {
+      Rebuild(false, 2 * slots_.size());
+    }
+
+    uint64_t& slot = slots_[Find(cluster)];
+    if (slot == kEmpty) {
+      slot = clusters_.size();
+      clusters_.push_back(cluster);
+      weights_.push_back(weight);
+    } else {
+      weights_[slot] += weight;
+    }
+  }
+
+  /// Number of distinct clusters added since the last Clear.
+  size_t size() const { return clusters_.size(); }
+  uint64_t cluster(size_t i) const { return clusters_[i]; }
+  WeightTy weight(size_t i) const { return weights_[i]; }
+
+  void Clear() {
+    // Reverse order keeps the probe sequence of each remaining cluster intact
+    for (auto it = clusters_.rbegin(); it != clusters_.rend(); ++it) {
+      slots_[Find(*it)] = kEmpty;
+    }
+    clusters_.clear();
+    weights_.clear();
+  }
+
+private:
+  constexpr static uint64_t kEmpty = std::numeric_limits<uint64_t>::max();
+  constexpr static uint64_t kMinHashCapacity = 16;
+
+  /// Smallest power of two that keeps the hash table at most half full.
+  static uint64_t HashCapacity(uint64_t num_clusters) {
+    uint64_t capacity = kMinHashCapacity;
+    while (capacity < 2 * num_clusters) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  size_t Find(uint64_t cluster) const {
+    if (dense_) {
+      return cluster;
+    }
+    const size_t mask = slots_.size() - 1;
+    size_t pos = (cluster * 0x9e3779b97f4a7c15ULL) >> hash_shift_;
+    while (slots_[pos] != kEmpty && clusters_[slots_[pos]] != cluster) {
+      pos = (pos + 1) & mask;
+    }
+    return pos;
+  }
+
+  void Rebuild(bool dense, uint64_t num_slots) {
+    dense_ = dense;
+    hash_shift_ = 64;
+    for (uint64_t s = num_slots; s > 1; s >>= 1) {
+      --hash_shift_;
+    }
+    slots_.assign(num_slots, kEmpty);
+    for (size_t i = 0; i < clusters_.size(); ++i) {
+      slots_[Find(clusters_[i])] = i;
+    }
+  }
+
+  bool dense_{true};
+  uint32_t hash_shift_{64};
+  std::vector<uint64_t> slots_;
+  std::vector<uint64_t> clusters_;
+  std::vector<WeightTy> weights_;
+};
+
 template <typename _Graph, typename _EdgeType, typename _CommunityType>
 struct ClusteringImplementationBase {
   using Graph = _Graph;
@@ -77,29 +184,43 @@ struct ClusteringImplementationBase {
       std::numeric_limits<double>::max() / 4;
 
   using CommunityArray = katana::NUMAArray<CommunityType>;
+  using ClusterWeights = ClusterWeightAccumulator<EdgeTy>;
+  using PerThreadClusterWeights = katana::PerThreadStorage<ClusterWeights>;
+
+  /**
+   * Prepares the per-thread cluster weight accumulators for the
+   * neighborhoods of the nodes of graph, whose cluster ids are node ids.
+   */
+  static void ReserveClusterWeights(
+      const Graph& graph, PerThreadClusterWeights* cluster_weights) {
+    katana::GReduceMax<uint64_t> max_degree;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) { max_degree.update(Degree(graph, n)); },
+        katana::no_stats());
+    const uint64_t max_clusters = max_degree.reduce() + 1;
+
+    katana::on_each([&](unsigned, unsigned) {
+      cluster_weights->getLocal()->Reserve(graph.NumNodes(), max_clusters);
+    });
+  }
 
   /**
    * Algorithm to find the best cluster for the node
    * to move to among its neighbors in the graph and moves.
    *
-   * It updates the mapping of neighboring nodes clusters
-   * in cluster_local_map, total unique cluster edge weights
-   * in counter as well as total weight of self edges in self_loop_wt.
+   * It accumulates the total edge weight to each neighboring cluster
+   * in cluster_weights, starting with the node's own cluster, as well
+   * as total weight of self edges in self_loop_wt. The caller must
+   * Clear cluster_weights once done with it.
    */
   template <typename EdgeWeightType>
   static void FindNeighboringClusters(
-      const Graph& graph, const GNode& n,
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
-    uint64_t num_unique_clusters = 0;
-
+      const Graph& graph, const GNode& n, ClusterWeights* cluster_weights,
+      EdgeTy& self_loop_wt) {
     // Add the node's current cluster to be considered
-    // for movement as well
-    cluster_local_map[graph.template GetData<CurrentCommunityID>(n)] =
-        0;                 // Add n's current cluster
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    num_unique_clusters++;
+    // for movement as well (no edges incident yet)
+    cluster_weights->Add(graph.template GetData<CurrentCommunityID>(n), 0);
 
     // Assuming we have grabbed lock on all the neighbors
     for (auto e : Edges(graph, n)) {
@@ -109,17 +230,8 @@ struct ClusteringImplementationBase {
       if (dst == n) {
         self_loop_wt += edge_wt;  // Self loop weights is recorded
       }
-      auto stored_already =
-          cluster_local_map.find(graph.template GetData<CurrentCommunityID>(
-              dst));  // Check if it already exists
-      if (stored_already != cluster_local_map.end()) {
-        counter[stored_already->second] += edge_wt;
-      } else {
-        cluster_local_map[graph.template GetData<CurrentCommunityID>(dst)] =
-            num_unique_clusters;
-        counter.push_back(edge_wt);
-        num_unique_clusters++;
-      }
+      cluster_weights->Add(
+          graph.template GetData<CurrentCommunityID>(dst), edge_wt);
     }  // End edge loop
   }
 
@@ -276,44 +388,41 @@ struct ClusteringImplementationBase {
    * without swapping the cluster assignment.
    */
   static uint64_t MaxModularityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
+      const ClusterWeights& cluster_weights, uint64_t self_loop_wt,
       CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = cluster_weights.weight(0) - self_loop_wt;
     double ax = c_info[sc].degree_wt - degree_wt;
     double eiy = 0;
     double ay = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        ay = c_info[stored_already->first].degree_wt;  // Degree wt of cluster y
+    // The best cluster does not depend on the order clusters are explored
+    // in, ties are broken by cluster id.
+    for (size_t i = 0; i < cluster_weights.size(); ++i) {
+      uint64_t cluster = cluster_weights.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      ay = c_info[cluster].degree_wt;  // Degree wt of cluster y
 
-        if (ay < (ax + degree_wt)) {
-          stored_already++;
-          continue;
-        } else if (ay == (ax + degree_wt) && stored_already->first > sc) {
-          stored_already++;
-          continue;
-        }
+      if (ay < (ax + degree_wt)) {
+        continue;
+      } else if (ay == (ax + degree_wt) && cluster > sc) {
+        continue;
+      }
 
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+      eiy = cluster_weights.weight(i);  // Total edges incident on cluster y
+      cur_gain = 2 * constant * (eiy - eix) +
+                 2 * degree_wt * ((ax - ay) * constant * constant);
 
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+      if ((cur_gain > max_gain) || ((cur_gain == max_gain) && (cur_gain != 0) &&
+                                    (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -436,31 +545,51 @@ struct ClusteringImplementationBase {
  */
   template <typename CommunityIDType>
   static uint64_t RenumberClustersContiguously(Graph* graph) {
-    std::map<uint64_t, uint64_t> cluster_local_map;
-    uint64_t num_unique_clusters = 0;
-
-    // TODO(amber): parallelize
-    for (GNode n : graph->Nodes()) {
-      auto& n_data_curr_comm_id = graph->template GetData<CommunityIDType>(n);
-      if (n_data_curr_comm_id != UNASSIGNED) {
-        auto stored_already = cluster_local_map.find(n_data_curr_comm_id);
-        if (stored_already == cluster_local_map.end()) {
-          cluster_local_map[n_data_curr_comm_id] = num_unique_clusters;
-          num_unique_clusters++;
-        }
-      }
+    katana::GReduceMax<uint64_t> max_comm_id;
+    katana::GAccumulator<uint64_t> num_assigned;
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto n_data_curr_comm_id =
+              graph->template GetData<CommunityIDType>(n);
+          if (n_data_curr_comm_id != UNASSIGNED) {
+            max_comm_id.update(n_data_curr_comm_id);
+            num_assigned += 1;
+          }
+        },
+        katana::no_stats());
+    if (num_assigned.reduce() == 0) {
+      return 0;
     }
 
-    uint64_t new_comm_id = 0;
-    for (std::pair<uint64_t, uint64_t> old_comm_id : cluster_local_map) {
-      cluster_local_map[old_comm_id.first] = new_comm_id;
-      new_comm_id++;
-    }
+    // Mark the cluster ids in use; the inclusive prefix sum of the marks
+    // then numbers them in increasing order of their old id.
+    katana::NUMAArray<uint64_t> new_comm_ids;
+    new_comm_ids.allocateBlocked(max_comm_id.reduce() + 1);
+    katana::ParallelSTL::fill(
+        new_comm_ids.begin(), new_comm_ids.end(), uint64_t{0});
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto n_data_curr_comm_id =
+              graph->template GetData<CommunityIDType>(n);
+          if (n_data_curr_comm_id != UNASSIGNED &&
+              new_comm_ids[n_data_curr_comm_id] == 0) {
+            new_comm_ids[n_data_curr_comm_id] = 1;
+          }
+        },
+        katana::no_stats());
+
+    katana::ParallelSTL::partial_sum(
+        new_comm_ids.begin(), new_comm_ids.end(), new_comm_ids.begin());
+    const uint64_t num_unique_clusters =
+        new_comm_ids[new_comm_ids.size() - 1];
 
     katana::do_all(katana::iterate(*graph), [&](GNode n) {
       auto& n_data_curr_comm_id = graph->template GetData<CommunityIDType>(n);
       if (n_data_curr_comm_id != UNASSIGNED) {
-        n_data_curr_comm_id = cluster_local_map[n_data_curr_comm_id];
+        n_data_curr_comm_id = new_comm_ids[n_data_curr_comm_id] - 1;
       }
     });
 
@@ -561,72 +690,79 @@ struct ClusteringImplementationBase {
 
     const uint64_t num_nodes_next = num_unique_clusters;
 
-    std::vector<std::vector<GNode>> cluster_bags(num_unique_clusters);
-    // TODO(amber): This loop can be parallelized when using a concurrent container
-    // for cluster_bags, but something like katana::InsertBag exhausts the
-    // per-thread-storage memory
-    for (GNode n = 0; n < graph.NumNodes(); ++n) {
-      auto n_data_curr_comm_id = graph.template GetData<CommunityIDType>(n);
-      if (n_data_curr_comm_id != UNASSIGNED) {
-        cluster_bags[n_data_curr_comm_id].push_back(n);
-      }
-    }
-
-    std::vector<katana::gstl::Vector<uint32_t>> edges_id(num_unique_clusters);
-    std::vector<katana::gstl::Vector<EdgeTy>> edges_data(num_unique_clusters);
+    // Group the nodes of each cluster by sorting the assigned nodes by
+    // cluster id, keeping nodes of the same cluster in node order.
+    katana::NUMAArray<GNode> clustered_nodes;
+    clustered_nodes.allocateBlocked(graph.NumNodes());
+    katana::do_all(
+        katana::iterate(graph), [&](GNode n) { clustered_nodes[n] = n; },
+        katana::no_stats());
+    auto comm_of = [&](GNode n) -> uint64_t {
+      return graph.template GetData<CommunityIDType>(n);
+    };
+    katana::ParallelSTL::sort(
+        clustered_nodes.begin(), clustered_nodes.end(),
+        [&](GNode a, GNode b) {
+          return std::make_pair(comm_of(a), a) < std::make_pair(comm_of(b), b);
+        });
 
-    /* First pass to find the number of edges */
+    // cluster_begin[c] is the position of the first node of cluster c in
+    // clustered_nodes; unassigned nodes sort last and are skipped.
+    katana::NUMAArray<uint64_t> cluster_begin;
+    cluster_begin.allocateBlocked(num_nodes_next + 1);
     katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters),
+        katana::iterate(uint64_t{0}, num_nodes_next + 1),
         [&](uint64_t c) {
-          katana::gstl::Map<uint64_t, uint64_t> cluster_local_map;
-          uint64_t num_unique_clusters = 0;
-          for (auto node : cluster_bags[c]) {
-            KATANA_LOG_DEBUG_ASSERT(
-                graph.template GetData<CommunityIDType>(node) ==
-                c);  // All nodes in this bag must have same cluster id
-
-            for (auto e : Edges(graph, node)) {
-              auto dst = EdgeDst(graph, e);
-              auto dst_data_curr_comm_id =
-                  graph.template GetData<CommunityIDType>(dst);
-              KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e);
-              } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
-                edges_id[c].push_back(dst_data_curr_comm_id);
-                edges_data[c].push_back(
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e));
-                num_unique_clusters++;
-              }
-            }  // End edge loop
-          }
+          cluster_begin[c] =
+              std::lower_bound(
+                  clustered_nodes.begin(), clustered_nodes.end(), c,
+                  [&](GNode n, uint64_t cluster) {
+                    return comm_of(n) < cluster;
+                  }) -
+              clustered_nodes.begin();
         },
-        katana::steal(), katana::loopname("BuildGraph: Find edges"));
+        katana::no_stats());
 
-    /* Serial loop to reduce all the edge counts */
+    PerThreadClusterWeights cluster_weights;
+    ReserveClusterWeights(graph, &cluster_weights);
+
+    // Sums the weights of the edges from the nodes of cluster c by the
+    // cluster of their destination.
+    auto accumulate_cluster_edges = [&](uint64_t c, ClusterWeights* weights) {
+      for (uint64_t i = cluster_begin[c]; i < cluster_begin[c + 1]; ++i) {
+        GNode node = clustered_nodes[i];
+        KATANA_LOG_DEBUG_ASSERT(comm_of(node) == c);
+        for (auto e : Edges(graph, node)) {
+          auto dst_data_curr_comm_id = comm_of(EdgeDst(graph, e));
+          KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
+          weights->Add(
+              dst_data_curr_comm_id,
+              graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e));
+        }
+      }
+    };
+
+    /* First pass to find the number of edges */
     katana::NUMAArray<uint64_t> prefix_edges_count;
     prefix_edges_count.allocateInterleaved(num_unique_clusters);
 
-    katana::GAccumulator<uint64_t> num_edges_acc;
     katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t c) {
-          prefix_edges_count[c] = edges_id[c].size();
-          num_edges_acc += prefix_edges_count[c];
-        });
-
-    const uint64_t num_edges_next = num_edges_acc.reduce();
+        katana::iterate(uint64_t{0}, num_nodes_next),
+        [&](uint64_t c) {
+          ClusterWeights& weights = *cluster_weights.getLocal();
+          accumulate_cluster_edges(c, &weights);
+          prefix_edges_count[c] = weights.size();
+          weights.Clear();
+        },
+        katana::steal(), katana::loopname("BuildGraph: Find edges"));
 
     katana::ParallelSTL::partial_sum(
         prefix_edges_count.begin(), prefix_edges_count.end(),
         prefix_edges_count.begin());
 
-    KATANA_LOG_DEBUG_ASSERT(
-        prefix_edges_count[num_unique_clusters - 1] == num_edges_next);
+    const uint64_t num_edges_next =
+        num_nodes_next == 0 ? 0 : prefix_edges_count[num_nodes_next - 1];
+
     katana::StatTimer TimerConstructFrom("Timer_Construct_From");
     TimerConstructFrom.start();
 
@@ -655,30 +791,25 @@ struct ClusteringImplementationBase {
     katana::NUMAArray<EdgeWeightType> edge_data_next;
     edge_data_next.allocateInterleaved(num_edges_next);
 
+    /* Second pass to write the edges of each cluster in place */
     katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t n) {
-          uint64_t number_of_edges =
-              (n == 0) ? prefix_edges_count[0]
-                       : (prefix_edges_count[n] - prefix_edges_count[n - 1]);
-          uint64_t start_index = (n == 0) ? 0 : prefix_edges_count[n - 1];
-          for (uint64_t k = 0; k < number_of_edges; ++k) {
-            out_dests_next[start_index + k] = edges_id[n][k];
-            edge_data_next[start_index + k] = edges_data[n][k];
+        katana::iterate(uint64_t{0}, num_nodes_next),
+        [&](uint64_t c) {
+          ClusterWeights& weights = *cluster_weights.getLocal();
+          accumulate_cluster_edges(c, &weights);
+          uint64_t start_index = (c == 0) ? 0 : prefix_edges_count[c - 1];
+          KATANA_LOG_DEBUG_ASSERT(
+              start_index + weights.size() == prefix_edges_count[c]);
+          for (size_t k = 0; k < weights.size(); ++k) {
+            out_dests_next[start_index + k] = weights.cluster(k);
+            edge_data_next[start_index + k] = weights.weight(k);
           }
-        });
+          weights.Clear();
+        },
+        katana::steal(), katana::loopname("BuildGraph: Write edges"));
 
     TimerConstructFrom.stop();
 
-    // TODO(amber): This is a lame attempt at freeing the memory back to each
-    // thread's pool of free pages and blocks. Due to stealing, the execution of
-    // do_all above that populates these containers may be different from the
-    // do_all below that frees them.
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters), [&](uint64_t c) {
-          edges_id[c] = gstl::Vector<uint32_t>();
-          edges_data[c] = gstl::Vector<EdgeTy>();
-        });
-
     GraphTopology topo_next{
         std::move(prefix_edges_count), std::move(out_dests_next)};
     auto pfg_next_res = katana::PropertyGraph::Make(std::move(topo_next));
@@ -1073,37 +1204,34 @@ struct ClusteringImplementationBase {
 
   template <typename EdgeWeightType>
   uint64_t MaxCPMQualityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeWeightType>& counter, EdgeWeightType self_loop_wt,
+      const ClusterWeights& cluster_weights, EdgeWeightType self_loop_wt,
       CommunityArray& c_info, uint64_t node_wt, uint64_t sc,
       double resolution) {
     uint64_t max_index = sc;  // Assign the initial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = cluster_weights.weight(0) - self_loop_wt;
     double eiy = 0;
     auto size_x = static_cast<double>(c_info[sc].node_wt - node_wt);
     double size_y = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        size_y = c_info[stored_already->first].node_wt;
-
-        cur_gain = 2.0 * (eiy - eix) - resolution *
-                                           static_cast<double>(node_wt) *
-                                           (size_y - size_x);
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+    for (size_t i = 0; i < cluster_weights.size(); ++i) {
+      uint64_t cluster = cluster_weights.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      eiy = cluster_weights.weight(i);  // Total edges incident on cluster y
+      size_y = c_info[cluster].node_wt;
+
+      cur_gain = 2.0 * (eiy - eix) - resolution *
+                                         static_cast<double>(node_wt) *
+                                         (size_y - size_x);
+      if ((cur_gain > max_gain) || ((cur_gain == max_gain) && (cur_gain != 0) &&
+                                    (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
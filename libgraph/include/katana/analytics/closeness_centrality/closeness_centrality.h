@@ -0,0 +1,145 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+
+#include <iostream>
+#include <limits>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for Closeness Centrality, specifying the algorithm
+/// and any parameters associated with it.
+class ClosenessCentralityPlan : public Plan {
+public:
+  enum Algorithm {
+    /// Exact distances from every node, computed with batched
+    /// (bit-parallel) BFS over 64 targets at a time.
+    kExact,
+    /// Estimate distance sums from a random sample of pivot nodes.
+    kSampledPivots,
+    /// Estimate neighborhood sizes with HyperLogLog counters (HyperBall).
+    kHyperBall,
+  };
+
+  static const uint32_t kDefaultNumPivots = 256;
+  static const uint32_t kDefaultLog2Registers = 6;
+  /// The default bound of the estimating plans, which only need the nodes
+  /// within a moderate distance
+  static const uint32_t kDefaultMaxIterations = 1000;
+  /// No bound: searches run until every reachable node is found
+  static const uint32_t kUnboundedIterations =
+      std::numeric_limits<uint32_t>::max();
+
+private:
+  Algorithm algorithm_;
+  uint32_t num_pivots_;
+  uint32_t log2_registers_;
+  uint32_t max_iterations_;
+
+  ClosenessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t num_pivots,
+      uint32_t log2_registers, uint32_t max_iterations)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        num_pivots_(num_pivots),
+        log2_registers_(log2_registers),
+        max_iterations_(max_iterations) {}
+
+public:
+  ClosenessCentralityPlan()
+      : ClosenessCentralityPlan{
+            kCPU, kExact, kDefaultNumPivots, kDefaultLog2Registers,
+            kUnboundedIterations} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of pivots sampled by kSampledPivots.
+  uint32_t num_pivots() const { return num_pivots_; }
+  /// The base 2 logarithm of the number of HyperLogLog registers per node
+  /// used by kHyperBall. Each register is one byte.
+  uint32_t log2_registers() const { return log2_registers_; }
+  /// The maximum number of BFS levels (or HyperBall iterations) to run.
+  /// Nodes further away are treated as unreachable.
+  uint32_t max_iterations() const { return max_iterations_; }
+
+  /// Compute exact centrality from all nodes. Results are only exact if
+  /// max_iterations is at least the diameter of the graph, so searches are
+  /// unbounded by default.
+  static ClosenessCentralityPlan Exact(
+      uint32_t max_iterations = kUnboundedIterations) {
+    return {kCPU, kExact, 0, 0, max_iterations};
+  }
+
+  /// Estimate centrality from num_pivots randomly chosen pivots. The error of
+  /// the estimate is proportional to 1 / sqrt(num_pivots).
+  static ClosenessCentralityPlan SampledPivots(
+      uint32_t num_pivots = kDefaultNumPivots,
+      uint32_t max_iterations = kDefaultMaxIterations) {
+    return {kCPU, kSampledPivots, num_pivots, 0, max_iterations};
+  }
+
+  /// Estimate centrality with HyperBall using 2^log2_registers one byte
+  /// registers per node. The relative standard error of neighborhood sizes is
+  /// about 1.04 / sqrt(2^log2_registers).
+  static ClosenessCentralityPlan HyperBall(
+      uint32_t log2_registers = kDefaultLog2Registers,
+      uint32_t max_iterations = kDefaultMaxIterations) {
+    return {kCPU, kHyperBall, 0, log2_registers, max_iterations};
+  }
+};
+
+/// The centrality measure to compute.
+enum class ClosenessCentralityMeasure {
+  /// Closeness with the Wasserman-Faust correction for disconnected graphs:
+  /// ((r - 1) / (n - 1)) * ((r - 1) / sum of distances) where r is the number
+  /// of nodes reachable from a node.
+  kCloseness,
+  /// Harmonic centrality normalized by n - 1: the sum of 1 / distance over
+  /// all other nodes divided by n - 1.
+  kHarmonic,
+};
+
+/// Compute the closeness (or harmonic) centrality of each node in the graph.
+/// Distances are measured along outgoing edges, i.e., the centrality of a node
+/// describes how close it is to the rest of the graph. Both measures are
+/// normalized to [0, 1].
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+///
+/// @param pg The graph to process.
+/// @param output_property_name The parameter to create with the computed value.
+/// @param txn_ctx The transaction context for the new property.
+/// @param measure Whether to compute closeness or harmonic centrality.
+/// @param plan
+KATANA_EXPORT Result<void> ClosenessCentrality(
+    PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx,
+    ClosenessCentralityMeasure measure = ClosenessCentralityMeasure::kCloseness,
+    ClosenessCentralityPlan plan = {});
+
+/// Check that all centrality values are in [0, 1].
+KATANA_EXPORT Result<void> ClosenessCentralityAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT ClosenessCentralityStatistics {
+  /// The maximum centrality across all nodes.
+  double max_centrality;
+  /// The minimum centrality across all nodes.
+  double min_centrality;
+  /// The average centrality across all nodes.
+  double average_centrality;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<ClosenessCentralityStatistics> Compute(
+      PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_CONNECTEDCOMPONENTS_INCREMENTALCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_CONNECTEDCOMPONENTS_INCREMENTALCONNECTEDCOMPONENTS_H_
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "katana/NUMAArray.h"
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/connected_components/connected_components.h"
+
+// API
+
+namespace katana::analytics {
+
+/// Connected components of a graph that only grows. The union-find forest
+/// computed for the initial graph is kept, so that a batch of inserted edges
+/// costs time proportional to the batch rather than to the graph.
+///
+/// Every tree of the forest is rooted at the smallest node ID of its
+/// component, and that ID is the label of the component. Labels therefore
+/// do not depend on the order edges were inserted in, and labels written by
+/// WriteLabels can be loaded back with FromLabels to resume after a restart.
+///
+/// This class only tracks connectivity; adding the edges of a batch to the
+/// topology of the graph is up to the caller. Treat the graph as undirected:
+/// an edge in either direction joins its endpoints.
+class KATANA_EXPORT IncrementalConnectedComponents {
+public:
+  using Node = uint32_t;
+
+  IncrementalConnectedComponents(IncrementalConnectedComponents&&) = default;
+  IncrementalConnectedComponents& operator=(IncrementalConnectedComponents&&) =
+      default;
+
+  /// Compute the components of pg from scratch with Afforest neighbor and
+  /// component sampling. Only the sampling parameters of plan are used.
+  /// Setting is_symmetric lets the final phase skip the edges of nodes in
+  /// the largest component, which is only correct if every edge also exists
+  /// in the other direction.
+  static Result<IncrementalConnectedComponents> Make(
+      const PropertyGraph& pg, bool is_symmetric = false,
+      const ConnectedComponentsPlan& plan = ConnectedComponentsPlan());
+
+  /// Restore the state from the uint64_t node property property_name, as
+  /// written by WriteLabels.
+  static Result<IncrementalConnectedComponents> FromLabels(
+      PropertyGraph* pg, const std::string& property_name);
+
+  /// Join the endpoints of every edge in edges, in parallel.
+  Result<void> InsertEdges(const std::vector<std::pair<Node, Node>>& edges);
+
+  /// Add nodes num_nodes() to num_nodes - 1, each in its own component.
+  Result<void> AddNodes(uint64_t num_nodes);
+
+  /// Write the label of every node to the uint64_t node property
+  /// property_name, replacing the property if it exists. The property is
+  /// stored with the rest of the RDG when pg is written.
+  Result<void> WriteLabels(
+      PropertyGraph* pg, const std::string& property_name,
+      katana::TxnContext* txn_ctx) const;
+
+  /// The label of the component of node.
+  Node Label(Node node) const;
+
+  uint64_t num_nodes() const { return parent_.size(); }
+  uint64_t num_components() const { return num_components_; }
+
+private:
+  IncrementalConnectedComponents() = default;
+
+  void Initialize(uint64_t num_nodes);
+  /// Join the trees of a and b; returns true if they were different trees.
+  bool Link(Node a, Node b);
+  void Compress();
+
+  katana::NUMAArray<std::atomic<Node>> parent_;
+  uint64_t num_components_{0};
+};
+
+}  // namespace katana::analytics
+
+#endif
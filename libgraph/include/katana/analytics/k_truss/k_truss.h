@@ -69,5 +69,45 @@ struct KATANA_EXPORT KTrussStatistics {
       const std::string& property_name);
 };
 
+/// Compute the trussness of every edge of pg, the largest k such that the
+/// edge is in the k-truss, so that any k-truss is given by the edges with
+/// trussness at least k. The pg is expected to be symmetric; both directions
+/// of an edge get the same trussness. Parallel edges count as one edge, and
+/// self loops are given trussness 0.
+///
+/// Supports are counted by one pass of triangle listing and then edges are
+/// peeled in order of support, one level at a time. Edges of the same level
+/// are peeled in parallel, with the rules of Kabir and Madduri for triangles
+/// that lose several edges at once. Every directed edge is mapped to a
+/// compact undirected edge ID, so support updates never search adjacency.
+///
+/// H. Kabir and K. Madduri, "Shared-memory Graph Truss Decomposition,"
+/// HiPC 2017.
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. It holds the uint32_t trussness of each edge.
+KATANA_EXPORT Result<void> TrussDecomposition(
+    katana::TxnContext* txn_ctx, PropertyGraph* pg,
+    const std::string& output_property_name);
+
+/// Check that every edge with trussness k is in at least k - 2 triangles of
+/// edges with trussness at least k, and in fewer than k - 1 triangles of
+/// edges with trussness above k.
+KATANA_EXPORT Result<void> TrussDecompositionAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT TrussDecompositionStatistics {
+  /// The largest trussness of any edge.
+  uint32_t max_trussness;
+  /// The number of undirected edges with the largest trussness.
+  uint64_t max_truss_edges;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<TrussDecompositionStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
 }  // namespace katana::analytics
 #endif
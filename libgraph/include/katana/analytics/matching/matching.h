@@ -0,0 +1,101 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_MATCHING_MATCHING_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_MATCHING_MATCHING_H_
+
+#include <iostream>
+#include <limits>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for graph matching, specifying the algorithm and any
+/// parameters associated with it.
+class MatchingPlan : public Plan {
+public:
+  enum Algorithm {
+    /// Maximal matching of locally dominant edges.
+    kLocallyDominant,
+    /// Maximum cardinality matching of a bipartite graph.
+    kPothenFan,
+  };
+
+private:
+  Algorithm algorithm_;
+
+  MatchingPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  MatchingPlan() : MatchingPlan{kCPU, kLocallyDominant} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Rounds in which every unmatched node points to the unmatched neighbor
+  /// across its heaviest edge, and mutual pointers are matched. Ties between
+  /// edges of equal weight are broken by a hash of the endpoints, so without
+  /// weights this is a Luby-style random maximal matching. With weights the
+  /// result is at least half the weight of a maximum weight matching. If the
+  /// two directions of an edge have different weights, the larger one is
+  /// used.
+  ///
+  /// F. Manne and R. H. Bisseling, "A Parallel Approximation Algorithm for
+  /// the Weighted Maximum Matching Problem," PPAM 2007.
+  static MatchingPlan LocallyDominant() { return {kCPU, kLocallyDominant}; }
+
+  /// Parallel Pothen-Fan: starting from a maximal matching, phases of
+  /// vertex-disjoint augmenting path searches, one DFS with lookahead from
+  /// every unmatched node on one side, until a phase finds no path. The
+  /// sides are found by 2-coloring the graph. Edge weights are ignored.
+  ///
+  /// A. Azad, M. Halappanavar, S. Rajamanickam, E. G. Boman, A. Khan and
+  /// A. Pothen, "Multithreaded Algorithms for Maximum Matching in Bipartite
+  /// Graphs," IPDPS 2012.
+  static MatchingPlan PothenFan() { return {kCPU, kPothenFan}; }
+};
+
+/// The mate of nodes that are not matched
+constexpr uint32_t kUnmatchedNode = std::numeric_limits<uint32_t>::max();
+
+/// Compute a matching of pg, a set of edges no two of which share a node.
+/// The pg must be symmetric: every edge other than a self loop needs a
+/// reverse edge, or InvalidArgument is returned. Self loops are never matched.
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. It holds the uint32_t ID of the node each node is
+/// matched with, or kUnmatchedNode.
+///
+/// @param pg The graph to process.
+/// @param edge_weight_property_name The edge weights to maximize, or "" to
+///     maximize the number of matched edges.
+/// @param output_property_name The node property to create with the mates.
+/// @param txn_ctx The transaction context for the new property.
+/// @param plan
+KATANA_EXPORT Result<void> Matching(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    MatchingPlan plan = {});
+
+/// Check that mates are mutual and adjacent, and that the matching is
+/// maximal, i.e., no edge joins two unmatched nodes.
+KATANA_EXPORT Result<void> MatchingAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT MatchingStatistics {
+  /// The number of matched edges.
+  uint64_t cardinality;
+  /// The number of nodes without a mate.
+  uint64_t num_unmatched_nodes;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MatchingStatistics> Compute(
+      PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+
+#include <iostream>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for maximum flow, specifying the algorithm and any
+/// parameters associated with it.
+class MaxFlowPlan : public Plan {
+public:
+  enum Algorithm {
+    /// Parallel push-relabel with global relabeling and gap detection.
+    kPushRelabel,
+  };
+
+  /// Use the default global relabel interval, alpha * |V| + |E| / 3 units of
+  /// work, with alpha = 6 as in Goldberg's implementation.
+  static const uint64_t kDefaultGlobalRelabelInterval = 0;
+
+private:
+  Algorithm algorithm_;
+  uint64_t global_relabel_interval_;
+
+  MaxFlowPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint64_t global_relabel_interval)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        global_relabel_interval_(global_relabel_interval) {}
+
+public:
+  MaxFlowPlan() : MaxFlowPlan{kCPU, kPushRelabel, 0} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The units of work between global relabels. A discharge is one unit and
+  /// a relabel is 12 more.
+  uint64_t global_relabel_interval() const { return global_relabel_interval_; }
+
+  /// Push-relabel that discharges the highest active nodes first, using an
+  /// OBIM worklist. Nodes are discharged without locks: only the thread that
+  /// owns a node lowers its excess or relabels it. Heights are recomputed by
+  /// a backward BFS from the sink every global_relabel_interval units of
+  /// work, and as soon as a relabel leaves a height empty (a gap).
+  ///
+  /// A. V. Goldberg and R. E. Tarjan, "A New Approach to the Maximum-Flow
+  /// Problem," J. ACM, 35(4), 1988.
+  static MaxFlowPlan PushRelabel(
+      uint64_t global_relabel_interval = kDefaultGlobalRelabelInterval) {
+    return {kCPU, kPushRelabel, global_relabel_interval};
+  }
+};
+
+/// Compute a maximum flow from source to sink in pg. The capacity of each
+/// edge is given by the integer edge property capacity_property_name and may
+/// not be negative. Parallel edges and edges in both directions are allowed.
+///
+/// The properties named output_flow_property_name and output_cut_property_name
+/// are created by this function and may not exist before the call. The flow
+/// property holds the uint64_t flow along each edge. The cut property holds a
+/// uint8_t that is 1 for the nodes on the source side of a minimum cut, i.e.,
+/// the nodes reachable from the source in the residual graph, and 0 for all
+/// other nodes.
+///
+/// @param pg The graph to process.
+/// @param source The node flow leaves from.
+/// @param sink The node flow arrives at.
+/// @param capacity_property_name The edge capacities.
+/// @param output_flow_property_name The edge property to create with flows.
+/// @param output_cut_property_name The node property to create with the cut.
+/// @param txn_ctx The transaction context for the new properties.
+/// @param plan
+KATANA_EXPORT Result<void> MaxFlow(
+    PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& capacity_property_name,
+    const std::string& output_flow_property_name,
+    const std::string& output_cut_property_name, katana::TxnContext* txn_ctx,
+    MaxFlowPlan plan = {});
+
+/// Check that the flow respects capacities and is conserved at every node
+/// other than source and sink, and that every edge leaving the cut is
+/// saturated while every edge entering it is empty.
+KATANA_EXPORT Result<void> MaxFlowAssertValid(
+    PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& capacity_property_name,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name);
+
+struct KATANA_EXPORT MaxFlowStatistics {
+  /// The value of the flow, which is also the capacity of the minimum cut.
+  uint64_t flow_value;
+  /// The number of nodes on the source side of the cut.
+  uint64_t source_side_size;
+  /// The number of edges leaving the source side of the cut.
+  uint64_t cut_edges;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MaxFlowStatistics> Compute(
+      PropertyGraph* pg, uint32_t source, const std::string& flow_property_name,
+      const std::string& cut_property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+
+#include <iostream>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for k-way graph partitioning, specifying the algorithm
+/// and any parameters associated with it.
+class PartitionPlan : public Plan {
+public:
+  enum Algorithm {
+    /// Multilevel partitioning in the style of METIS: coarsen by heavy edge
+    /// matching, partition the coarsest graph, then project the partition
+    /// back and refine it at every level.
+    kMultilevel,
+  };
+
+  static constexpr double kDefaultImbalance = 0.03;
+  static const uint32_t kDefaultRefinementIterations = 8;
+  static const uint32_t kDefaultCoarseningThreshold = 32;
+
+private:
+  Algorithm algorithm_;
+  double imbalance_;
+  uint32_t refinement_iterations_;
+  uint32_t coarsening_threshold_;
+
+  PartitionPlan(
+      Architecture architecture, Algorithm algorithm, double imbalance,
+      uint32_t refinement_iterations, uint32_t coarsening_threshold)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        imbalance_(imbalance),
+        refinement_iterations_(refinement_iterations),
+        coarsening_threshold_(coarsening_threshold) {}
+
+public:
+  PartitionPlan()
+      : PartitionPlan{
+            kCPU, kMultilevel, kDefaultImbalance,
+            kDefaultRefinementIterations, kDefaultCoarseningThreshold} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// Every partition may hold up to (1 + imbalance) times its share of the
+  /// nodes.
+  double imbalance() const { return imbalance_; }
+  /// The maximum number of refinement passes at each level.
+  uint32_t refinement_iterations() const { return refinement_iterations_; }
+  /// Coarsening stops once the graph has at most coarsening_threshold nodes
+  /// per partition.
+  uint32_t coarsening_threshold() const { return coarsening_threshold_; }
+
+  /// Multilevel partitioning. Coarse graphs are built directly in CSR form,
+  /// and refinement greedily moves boundary nodes to the neighboring
+  /// partition that most reduces the edge cut, in parallel, as long as the
+  /// destination stays within the balance constraint.
+  ///
+  /// G. Karypis and V. Kumar, "A Fast and High Quality Multilevel Scheme for
+  /// Partitioning Irregular Graphs," SIAM Journal on Scientific Computing,
+  /// 20(1), 1998.
+  static PartitionPlan Multilevel(
+      double imbalance = kDefaultImbalance,
+      uint32_t refinement_iterations = kDefaultRefinementIterations,
+      uint32_t coarsening_threshold = kDefaultCoarseningThreshold) {
+    return {
+        kCPU, kMultilevel, imbalance, refinement_iterations,
+        coarsening_threshold};
+  }
+};
+
+/// Partition the nodes of pg into num_partitions parts of about equal size
+/// while minimizing the number of edges between parts. The pg is expected to
+/// be symmetric; edges are given unit weight.
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. It holds the uint32_t partition ID of each node.
+///
+/// @param pg The graph to process.
+/// @param num_partitions The number of partitions to create.
+/// @param output_property_name The property to create with the partition IDs.
+/// @param txn_ctx The transaction context for the new property.
+/// @param plan
+KATANA_EXPORT Result<void> Partition(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PartitionPlan plan = {});
+
+/// Check that every node is assigned a partition ID less than num_partitions.
+KATANA_EXPORT Result<void> PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name);
+
+struct KATANA_EXPORT PartitionStatistics {
+  /// The number of edges whose endpoints are in different partitions. Both
+  /// directions of a symmetric edge are counted.
+  uint64_t edge_cut;
+  /// The number of nodes in the largest partition.
+  uint64_t max_partition_size;
+  /// The number of nodes in the smallest partition.
+  uint64_t min_partition_size;
+  /// The size of the largest partition relative to the average size.
+  double imbalance;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<PartitionStatistics> Compute(
+      PropertyGraph* pg, uint32_t num_partitions,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <iostream>
 
+#include <arrow/api.h>
 #include <katana/analytics/Plan.h>
 
 #include "katana/AtomicHelpers.h"
@@ -123,7 +124,7 @@ public:
       uint32_t number_of_edge_types = kDefaultNumberOfEdgeTypes) {
     return {
         kCPU,
-        kNode2Vec,
+        kEdge2Vec,
         walk_length,
         number_of_walks,
         backward_probability,
@@ -140,6 +141,26 @@ public:
 KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> RandomWalks(
     PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
 
+/// Compute weighted random-walks for pg. The pg is expected to be symmetric.
+/// Edges are followed with probability proportional to their weight in
+/// edge_weight_property_name (or uniformly if it is empty), biased by the
+/// node2vec parameters of the plan. Edge2Vec uses the edge entity types of
+/// pg as edge types and ignores number_of_edge_types.
+///
+/// First-order choices are sampled in constant time from per-node alias
+/// tables. Second-order choices out of high-degree nodes use alias tables
+/// built the first time a walk takes each edge into them; other choices use
+/// rejection sampling.
+///
+/// The walks are returned without copying as a fixed size list array with
+/// one row of walk_length + 1 nodes per walk. Walk i starts at node
+/// i % NumNodes(); if a walk reaches a node without out edges its remaining
+/// steps are null.
+KATANA_EXPORT Result<std::shared_ptr<arrow::FixedSizeListArray>>
+WeightedRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan = RandomWalksPlan());
+
 KATANA_EXPORT Result<void> RandomWalksAssertValid(PropertyGraph* pg);
 
 }  // namespace katana::analytics
@@ -19,6 +19,7 @@ public:
     kDeltaStep,
     kDeltaStepBarrier,
     kDeltaStepFusion,
+    kDeltaStepAuto,
     // TODO(gill): Do we want to expose serial implementations at all?
     kSerialDeltaTile,
     kSerialDelta,
@@ -88,6 +89,12 @@ public:
     return {kCPU, kDeltaStepFusion, delta, 0};
   }
 
+  /// Delta stepping with light/heavy edge splitting where delta is estimated
+  /// from a sample of edge weights and the average degree, and then adjusted
+  /// between buckets: it grows while buckets are too small to keep all threads
+  /// busy and shrinks when nodes are relaxed repeatedly within a bucket.
+  static SsspPlan DeltaStepAuto() { return {kCPU, kDeltaStepAuto, 0, 0}; }
+
   static SsspPlan SerialDeltaTile(
       unsigned delta = kDefaultDelta,
       ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
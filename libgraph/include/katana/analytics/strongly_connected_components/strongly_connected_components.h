@@ -0,0 +1,114 @@
+#ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGRAPH_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <iostream>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for strongly connected components, specifying the
+/// algorithm and any parameters associated with it.
+class StronglyConnectedComponentsPlan : public Plan {
+public:
+  enum Algorithm {
+    /// Forward-backward reachability from pivots, then coloring.
+    kForwardBackward,
+    /// Coloring only.
+    kColoring,
+  };
+
+  static const uint32_t kDefaultForwardBackwardRounds = 4;
+
+private:
+  Algorithm algorithm_;
+  uint32_t forward_backward_rounds_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t forward_backward_rounds)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        forward_backward_rounds_(forward_backward_rounds) {}
+
+public:
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan{
+            kCPU, kForwardBackward, kDefaultForwardBackwardRounds} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of forward-backward rounds before switching to coloring.
+  uint32_t forward_backward_rounds() const { return forward_backward_rounds_; }
+
+  /// Every round first trims nodes without live in-edges or out-edges,
+  /// which are SCCs by themselves. Then, in every partition of the
+  /// remaining nodes, the forward and backward reachable sets of a pivot
+  /// are found by parallel traversals that stay within the partition. Their
+  /// intersection is the SCC of the pivot, and the other three parts become
+  /// the partitions of the next round. The first round usually finds the
+  /// giant SCC; as partitions get smaller and more numerous, the nodes left
+  /// after forward_backward_rounds rounds are finished by coloring.
+  ///
+  /// S. Hong, N. C. Rodia and K. Olukotun, "On Fast Parallel Detection of
+  /// Strongly Connected Components (SCC) in Small-World Graphs," SC 2013.
+  static StronglyConnectedComponentsPlan ForwardBackward(
+      uint32_t forward_backward_rounds = kDefaultForwardBackwardRounds) {
+    return {kCPU, kForwardBackward, forward_backward_rounds};
+  }
+
+  /// Every round trims, then propagates the largest node ID forward along
+  /// edges until no color changes. Each node whose color is its own ID is
+  /// the root of an SCC made of the nodes of its color that reach it, found
+  /// by a backward traversal. Rounds repeat on the nodes left over, with
+  /// each color as a separate partition whose edges to other colors are
+  /// ignored.
+  ///
+  /// S. Orzan, "On Distributed Verification and Verified Distribution,"
+  /// PhD thesis, Free University of Amsterdam, 2004.
+  static StronglyConnectedComponentsPlan Coloring() {
+    return {kCPU, kColoring, 0};
+  }
+};
+
+/// Compute the strongly connected components of pg, treating it as a
+/// directed graph.
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. It holds the uint64_t ID of the SCC of each node,
+/// which is the node ID of one of its members.
+///
+/// @param pg The graph to process.
+/// @param output_property_name The node property to create with SCC IDs.
+/// @param txn_ctx The transaction context for the new property.
+/// @param plan
+KATANA_EXPORT Result<void> StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx, StronglyConnectedComponentsPlan plan = {});
+
+/// Check the SCC IDs in property_name against a serial Tarjan computation.
+KATANA_EXPORT Result<void> StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT StronglyConnectedComponentsStatistics {
+  /// Total number of SCCs in the graph.
+  uint64_t total_components;
+  /// Total number of SCCs with more than 1 node.
+  uint64_t total_non_trivial_components;
+  /// The number of nodes present in the largest SCC.
+  uint64_t largest_component_size;
+  /// The ratio of nodes present in the largest SCC.
+  double largest_component_ratio;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<StronglyConnectedComponentsStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
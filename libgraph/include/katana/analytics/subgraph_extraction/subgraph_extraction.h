@@ -1,6 +1,11 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_SUBGRAPHEXTRACTION_SUBGRAPHEXTRACTION_H_
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_SUBGRAPHEXTRACTION_SUBGRAPHEXTRACTION_H_
 
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "katana/PropertyGraph.h"
 #include "katana/analytics/Plan.h"
 
@@ -48,6 +53,10 @@ public:
  * By default only topology of the sub-graph is constructed.
  * The new sub-graph is independent of the original graph.
  *
+ * Node i of the sub-graph is the i-th distinct node of node_vec, and the
+ * edges of each node are ordered by the node ID of their destination in pg.
+ * Node and edge types are kept.
+ *
  * @param pg The graph to process.
  * @param node_vec Set of node IDs
  * @param plan
@@ -57,7 +66,60 @@ SubGraphExtraction(
     katana::PropertyGraph* pg,
     const std::vector<katana::PropertyGraph::Node>& node_vec,
     SubGraphExtractionPlan plan = {});
-// const std::vector<std::string>& node_properties_to_copy, const std::vector<std::string>& edge_properties_to_copy);
+
+/**
+ * Construct a new sub-graph from the original graph, like above, and copy
+ * the named node and edge properties of pg to it.
+ *
+ * Properties of a run of consecutive nodes or edges are zero-copy slices of
+ * the properties of pg; others are gathered in parallel.
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+SubGraphExtraction(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::PropertyGraph::Node>& node_vec,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx, SubGraphExtractionPlan plan = {});
+
+/// Selects the nodes and edges of a sub-graph. A node is kept if it passes
+/// every filter that is set, and an edge is kept if it passes every edge
+/// filter that is set and both of its endpoints are kept.
+struct KATANA_EXPORT SubGraphFilter {
+  /// Keep nodes that have at least one of these types.
+  std::optional<SetOfEntityTypeIDs> node_types;
+  /// Keep edges that have at least one of these types.
+  std::optional<SetOfEntityTypeIDs> edge_types;
+  /// Keep nodes for which this returns true. It is called in parallel, once
+  /// per node, with the property index of the node, so that it can test
+  /// property values directly.
+  std::function<bool(GraphTopology::PropertyIndex)> node_predicate;
+  /// Keep edges for which this returns true. It is called in parallel, at
+  /// most once per edge, with the property index of the edge.
+  std::function<bool(GraphTopology::PropertyIndex)> edge_predicate;
+  /// Keep nodes whose property index is set in this mask, e.g., one made by
+  /// PropertyPredicate::EvaluateNodes. The mask is not owned.
+  const DynamicBitset* node_mask{nullptr};
+  /// Keep edges whose property index is set in this mask, e.g., one made by
+  /// PropertyPredicate::EvaluateEdges. The mask is not owned.
+  const DynamicBitset* edge_mask{nullptr};
+};
+
+/**
+ * Construct a new sub-graph of the nodes and edges of pg selected by filter,
+ * and copy the named node and edge properties of pg to it.
+ *
+ * The nodes and edges of the sub-graph keep their relative order in pg, as
+ * do their types. The topology is built with two parallel passes and a
+ * prefix sum, and properties are copied as in SubGraphExtraction. The new
+ * sub-graph is independent of the original graph.
+ */
+KATANA_EXPORT katana::Result<std::unique_ptr<katana::PropertyGraph>>
+FilteredSubGraphExtraction(
+    katana::PropertyGraph* pg, const SubGraphFilter& filter,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx);
 
 }  // namespace katana::analytics
 
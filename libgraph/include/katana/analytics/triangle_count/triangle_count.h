@@ -1,6 +1,8 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_TRIANGLECOUNT_TRIANGLECOUNT_H_
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_TRIANGLECOUNT_TRIANGLECOUNT_H_
 
+#include <iostream>
+
 #include "katana/PropertyGraph.h"
 #include "katana/analytics/Plan.h"
 
@@ -104,6 +106,130 @@ public:
 KATANA_EXPORT katana::Result<uint64_t> TriangleCount(
     PropertyGraph* pg, TriangleCountPlan plan = {});
 
+/// A computational plan for approximate triangle counting. None of the
+/// algorithms sort or copy the graph.
+class ApproximateTriangleCountPlan : public Plan {
+public:
+  enum Algorithm {
+    kColorful,
+    kEdgeSampling,
+    kWedgeSampling,
+  };
+
+  static const uint32_t kDefaultNumColors = 8;
+  static const uint32_t kDefaultNumTrials = 5;
+  static constexpr double kDefaultEdgeProbability = 0.1;
+  static const uint64_t kDefaultNumWedges = 1 << 22;
+  static const uint64_t kDefaultSeed = 0;
+
+private:
+  Algorithm algorithm_;
+  uint32_t num_colors_;
+  double edge_probability_;
+  uint64_t num_wedges_;
+  uint32_t num_trials_;
+  uint64_t seed_;
+
+  ApproximateTriangleCountPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t num_colors,
+      double edge_probability, uint64_t num_wedges, uint32_t num_trials,
+      uint64_t seed)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        num_colors_(num_colors),
+        edge_probability_(edge_probability),
+        num_wedges_(num_wedges),
+        num_trials_(num_trials),
+        seed_(seed) {}
+
+public:
+  ApproximateTriangleCountPlan()
+      : ApproximateTriangleCountPlan{
+            kCPU, kWedgeSampling, 0, 0, kDefaultNumWedges, 1, kDefaultSeed} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  uint32_t num_colors() const { return num_colors_; }
+  double edge_probability() const { return edge_probability_; }
+  uint64_t num_wedges() const { return num_wedges_; }
+  uint32_t num_trials() const { return num_trials_; }
+  uint64_t seed() const { return seed_; }
+
+  /**
+   * Color nodes at random with num_colors colors, count the triangles among
+   * edges whose endpoints have the same color exactly, and scale by
+   * num_colors^2. The sampled graph has about 1/num_colors of the edges.
+   * The confidence interval comes from num_trials independent colorings.
+   *
+   *   R. Pagh and C. E. Tsourakakis. Colorful Triangle Counting and a
+   *   MapReduce Implementation. Information Processing Letters, 112(7), 2012.
+   */
+  static ApproximateTriangleCountPlan Colorful(
+      uint32_t num_colors = kDefaultNumColors,
+      uint32_t num_trials = kDefaultNumTrials, uint64_t seed = kDefaultSeed) {
+    return {kCPU, kColorful, num_colors, 0, 0, num_trials, seed};
+  }
+
+  /**
+   * Keep every edge with probability edge_probability, count the triangles
+   * among the kept edges exactly, and scale by edge_probability^-3. The
+   * confidence interval comes from num_trials independent samples.
+   *
+   *   C. E. Tsourakakis, U. Kang, G. L. Miller and C. Faloutsos. DOULION:
+   *   Counting Triangles in Massive Graphs with a Coin. KDD 2009.
+   */
+  static ApproximateTriangleCountPlan EdgeSampling(
+      double edge_probability = kDefaultEdgeProbability,
+      uint32_t num_trials = kDefaultNumTrials, uint64_t seed = kDefaultSeed) {
+    return {kCPU, kEdgeSampling, 0, edge_probability, 0, num_trials, seed};
+  }
+
+  /**
+   * Sample num_wedges paths of length two uniformly and check how many are
+   * closed by a third edge. Every triangle closes three wedges, so the
+   * closed fraction times the number of wedges over three estimates the
+   * number of triangles. The error depends on num_wedges and the fraction,
+   * not on the size of the graph; the confidence interval is the binomial
+   * one. Wedges are drawn over distinct neighbors, so parallel edges and
+   * self loops do not bias the sample.
+   *
+   *   C. Seshadhri, A. Pinar and T. G. Kolda. Triadic Measures on Graphs:
+   *   The Power of Wedge Sampling. SDM 2013.
+   */
+  static ApproximateTriangleCountPlan WedgeSampling(
+      uint64_t num_wedges = kDefaultNumWedges, uint64_t seed = kDefaultSeed) {
+    return {kCPU, kWedgeSampling, 0, 0, num_wedges, 1, seed};
+  }
+};
+
+/// An estimate of the number of triangles with a 95% confidence interval.
+struct KATANA_EXPORT TriangleCountEstimate {
+  double estimate;
+  double lower_bound;
+  double upper_bound;
+
+  /// Print the estimate in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+};
+
+/**
+ * Estimate the total number of triangles in the graph. The graph must be
+ * symmetric. Parallel edges count as one edge and self loops are ignored.
+ *
+ * If output_property_name is not empty, a double node property with that
+ * name is created, which holds an estimate of the number of triangles of
+ * each node. Per-node estimates are much noisier than the total, especially
+ * for nodes in few triangles.
+ *
+ * @param pg The graph to process.
+ * @param txn_ctx The transaction context for the new property.
+ * @param output_property_name The node property to create, or "".
+ * @param plan
+ */
+KATANA_EXPORT katana::Result<TriangleCountEstimate> ApproximateTriangleCount(
+    PropertyGraph* pg, katana::TxnContext* txn_ctx,
+    const std::string& output_property_name = "",
+    ApproximateTriangleCountPlan plan = {});
+
 }  // namespace katana::analytics
 
 #endif
@@ -0,0 +1,141 @@
+#include "katana/DictionaryEncoding.h"
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "katana/EntityIndex.h"
+#include "katana/ErrorCode.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Properties.h"
+
+namespace {
+
+std::string_view
+ToStringView(arrow::util::string_view view) {
+  return std::string_view(view.data(), view.length());
+}
+
+/// Calls fn(value_at) where value_at(i) is the string of value i of chunk;
+/// the type of chunk is dispatched once rather than per value
+template <typename Fn>
+katana::Result<void>
+WithStringValues(const arrow::Array& chunk, const Fn& fn) {
+  switch (chunk.type_id()) {
+  case arrow::Type::STRING: {
+    const auto& array = static_cast<const arrow::StringArray&>(chunk);
+    fn([&](int64_t i) { return ToStringView(array.GetView(i)); });
+    return katana::ResultSuccess();
+  }
+  case arrow::Type::LARGE_STRING: {
+    const auto& array = static_cast<const arrow::LargeStringArray&>(chunk);
+    fn([&](int64_t i) { return ToStringView(array.GetView(i)); });
+    return katana::ResultSuccess();
+  }
+  case arrow::Type::DICTIONARY: {
+    const auto& array = static_cast<const arrow::DictionaryArray&>(chunk);
+    return WithStringValues(
+        *array.dictionary(), [&](const auto& dictionary_value_at) {
+          fn([&](int64_t i) {
+            return dictionary_value_at(array.GetValueIndex(i));
+          });
+        });
+  }
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "cannot dictionary encode {}",
+        chunk.type()->ToString());
+  }
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::ChunkedArray>>
+katana::DictionaryEncodeStrings(const arrow::ChunkedArray& strings) {
+  // The distinct strings, collected per thread
+  PerThreadStorage<std::unordered_set<std::string_view>> local_distinct;
+  for (const auto& chunk : strings.chunks()) {
+    KATANA_CHECKED(WithStringValues(*chunk, [&](const auto& value_at) {
+      do_all(
+          iterate(int64_t{0}, chunk->length()),
+          [&](int64_t i) {
+            if (chunk->IsValid(i)) {
+              local_distinct.getLocal()->emplace(value_at(i));
+            }
+          },
+          steal(), no_stats());
+    }));
+  }
+
+  std::vector<std::string_view> distinct;
+  for (unsigned i = 0; i < local_distinct.size(); ++i) {
+    const auto& local = *local_distinct.getRemote(i);
+    distinct.insert(distinct.end(), local.begin(), local.end());
+  }
+  ParallelSTL::sort(distinct.begin(), distinct.end());
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+  if (distinct.size() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} distinct strings do not fit in codes",
+        distinct.size());
+  }
+
+  arrow::LargeStringBuilder dictionary_builder;
+  for (std::string_view value : distinct) {
+    KATANA_CHECKED(dictionary_builder.Append(value.data(), value.size()));
+  }
+  std::shared_ptr<arrow::Array> dictionary =
+      KATANA_CHECKED(dictionary_builder.Finish());
+
+  // The code of a string is its position among the sorted distinct strings
+  NUMAArray<std::string_view> keys;
+  keys.allocateBlocked(distinct.size());
+  std::copy(distinct.begin(), distinct.end(), keys.begin());
+  internal::HashRunTable<std::string_view> codes_of;
+  codes_of.Build(std::move(keys));
+
+  int64_t length = strings.length();
+  std::shared_ptr<arrow::Buffer> codes =
+      KATANA_CHECKED(arrow::AllocateBuffer(length * sizeof(int32_t)));
+  auto* codes_data = reinterpret_cast<int32_t*>(codes->mutable_data());
+  NUMAArray<uint8_t> valid;
+  valid.allocateBlocked(length);
+
+  int64_t chunk_begin = 0;
+  for (const auto& chunk : strings.chunks()) {
+    KATANA_CHECKED(WithStringValues(*chunk, [&](const auto& value_at) {
+      do_all(
+          iterate(int64_t{0}, chunk->length()),
+          [&](int64_t i) {
+            bool is_valid = chunk->IsValid(i);
+            valid[chunk_begin + i] = is_valid;
+            codes_data[chunk_begin + i] =
+                is_valid ? codes_of.Find(value_at(i)) : 0;
+          },
+          no_stats());
+    }));
+    chunk_begin += chunk->length();
+  }
+
+  std::shared_ptr<arrow::Buffer> null_bitmap;
+  int64_t null_count = strings.null_count();
+  if (null_count > 0) {
+    null_bitmap = KATANA_CHECKED(
+        arrow::AllocateBuffer(arrow::BitUtil::BytesForBits(length)));
+    internal::PackBytesToBitmap(
+        valid.begin(), length, null_bitmap->mutable_data());
+  }
+
+  // The codes are in range by construction, so skip the validation of
+  // DictionaryArray::FromArrays
+  auto data = arrow::ArrayData::Make(
+      arrow::dictionary(arrow::int32(), arrow::large_utf8()), length,
+      {null_bitmap, codes}, null_count);
+  data->dictionary = dictionary->data();
+  return std::make_shared<arrow::ChunkedArray>(arrow::MakeArray(data));
+}
@@ -1,17 +1,499 @@
 #include "katana/EntityIndex.h"
 
+#include <cstring>
+#include <numeric>
+#include <optional>
+
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
 #include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
 
 namespace katana {
 
+namespace {
+
+/// Number of entities counted or copied by one task
+constexpr size_t kChunkSize = 1U << 16U;
+
+/// The ids of the entities below num_entities for which is_valid holds, in
+/// order. all_valid says that it holds for all of them.
+template <typename node_or_edge, typename IsValid>
+NUMAArray<node_or_edge>
+ValidIDs(size_t num_entities, bool all_valid, const IsValid& is_valid) {
+  NUMAArray<node_or_edge> ids;
+  if (all_valid) {
+    ids.allocateBlocked(num_entities);
+    ParallelSTL::iota(ids.begin(), ids.end(), node_or_edge{0});
+    return ids;
+  }
+
+  size_t num_chunks = (num_entities + kChunkSize - 1) / kChunkSize;
+  if (num_chunks == 0) {
+    return ids;
+  }
+  NUMAArray<size_t> offsets;
+  offsets.allocateBlocked(num_chunks);
+  do_all(
+      iterate(size_t{0}, num_chunks),
+      [&](size_t chunk) {
+        size_t count = 0;
+        size_t end = std::min((chunk + 1) * kChunkSize, num_entities);
+        for (size_t i = chunk * kChunkSize; i < end; ++i) {
+          count += is_valid(i);
+        }
+        offsets[chunk] = count;
+      },
+      no_stats());
+  ParallelSTL::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  ids.allocateBlocked(offsets[num_chunks - 1]);
+  do_all(
+      iterate(size_t{0}, num_chunks),
+      [&](size_t chunk) {
+        size_t pos = chunk == 0 ? 0 : offsets[chunk - 1];
+        size_t end = std::min((chunk + 1) * kChunkSize, num_entities);
+        for (size_t i = chunk * kChunkSize; i < end; ++i) {
+          if (is_valid(i)) {
+            ids[pos++] = i;
+          }
+        }
+      },
+      no_stats());
+  return ids;
+}
+
+/// The ids of the entities of property below num_entities that are not null,
+/// in order.
+template <typename node_or_edge>
+NUMAArray<node_or_edge>
+ValidIDs(const arrow::Array& property, size_t num_entities) {
+  return ValidIDs<node_or_edge>(
+      num_entities, property.null_count() == 0,
+      [&](size_t i) { return property.IsValid(i); });
+}
+
+/// The number of entities below num_entities for which is_valid holds
+template <typename IsValid>
+size_t
+NumValid(size_t num_entities, bool all_valid, const IsValid& is_valid) {
+  if (all_valid) {
+    return num_entities;
+  }
+  GAccumulator<size_t> num_valid;
+  do_all(
+      iterate(size_t{0}, num_entities),
+      [&](size_t i) { num_valid += is_valid(i); }, no_stats());
+  return num_valid.reduce();
+}
+
+/// Check that sorted_ids are the entities for which is_valid holds, sorted
+/// by value(id) and then id
+template <typename node_or_edge, typename IsValid, typename Value>
+Result<void>
+CheckSortedIDs(
+    size_t num_entities, bool all_valid, const IsValid& is_valid,
+    const NUMAArray<node_or_edge>& sorted_ids, const Value& value) {
+  size_t num_ids = sorted_ids.size();
+  size_t num_valid = NumValid(num_entities, all_valid, is_valid);
+  if (num_ids != num_valid) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "index has {} entities, expected {}",
+        num_ids, num_valid);
+  }
+
+  GReduceLogicalOr out_of_range;
+  do_all(
+      iterate(size_t{0}, num_ids),
+      [&](size_t i) {
+        node_or_edge id = sorted_ids[i];
+        if (id >= num_entities || !is_valid(id)) {
+          out_of_range.update(true);
+        }
+      },
+      no_stats());
+  if (out_of_range.reduce()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "index has entities without values");
+  }
+
+  GReduceLogicalOr out_of_order;
+  do_all(
+      iterate(size_t{1}, std::max<size_t>(num_ids, 1)),
+      [&](size_t i) {
+        node_or_edge a = sorted_ids[i - 1];
+        node_or_edge b = sorted_ids[i];
+        if (!(std::make_pair(value(a), a) < std::make_pair(value(b), b))) {
+          out_of_order.update(true);
+        }
+      },
+      no_stats());
+  if (out_of_order.reduce()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "index entities are not sorted");
+  }
+  return ResultSuccess();
+}
+
+/// Check that sorted_ids are the non-null entities of property, sorted by
+/// value(id) and then id
+template <typename node_or_edge, typename Value>
+Result<void>
+CheckSortedIDs(
+    const arrow::Array& property, size_t num_entities,
+    const NUMAArray<node_or_edge>& sorted_ids, const Value& value) {
+  return CheckSortedIDs(
+      num_entities, property.null_count() == 0,
+      [&](size_t i) { return property.IsValid(i); }, sorted_ids, value);
+}
+
+/// Sort ids by value(id) and then id. The values are sorted along with the
+/// ids so that the sort never goes through the column; they are returned in
+/// their sorted order.
+template <typename c_type, typename node_or_edge, typename ValueOf>
+NUMAArray<c_type>
+SortByValue(NUMAArray<node_or_edge>* ids, const ValueOf& value_of) {
+  size_t num_ids = ids->size();
+  NUMAArray<std::pair<c_type, node_or_edge>> entries;
+  entries.allocateBlocked(num_ids);
+  do_all(
+      iterate(size_t{0}, num_ids),
+      [&](size_t i) { entries[i] = {value_of((*ids)[i]), (*ids)[i]}; },
+      no_stats());
+  ParallelSTL::sort(entries.begin(), entries.end());
+
+  NUMAArray<c_type> values;
+  values.allocateBlocked(num_ids);
+  do_all(
+      iterate(size_t{0}, num_ids),
+      [&](size_t i) {
+        values[i] = entries[i].first;
+        (*ids)[i] = entries[i].second;
+      },
+      no_stats());
+  return values;
+}
+
+/// The position of the first of every run of equal keys among num_entries
+/// sorted entries, followed by num_entries. key_at(i) returns the key of
+/// entry i.
+template <typename KeyAt>
+NUMAArray<uint64_t>
+RunStarts(size_t num_entries, const KeyAt& key_at) {
+  // rank[i] is the number of runs that start at or before i
+  NUMAArray<uint64_t> rank;
+  rank.allocateBlocked(num_entries);
+  do_all(
+      iterate(size_t{0}, num_entries),
+      [&](size_t i) { rank[i] = i == 0 || key_at(i) != key_at(i - 1); },
+      no_stats());
+  ParallelSTL::partial_sum(rank.begin(), rank.end(), rank.begin());
+
+  size_t num_runs = num_entries == 0 ? 0 : rank[num_entries - 1];
+  NUMAArray<uint64_t> runs;
+  runs.allocateBlocked(num_runs + 1);
+  do_all(
+      iterate(size_t{0}, num_entries),
+      [&](size_t i) {
+        if (i == 0 || rank[i] != rank[i - 1]) {
+          runs[rank[i] - 1] = i;
+        }
+      },
+      no_stats());
+  runs[num_runs] = num_entries;
+  return runs;
+}
+
+/// The keys of a composite index: integers and floating point numbers are
+/// written big-endian with their sign flipped so that they compare bytewise
+/// like their values, and strings are escaped and terminated so that a
+/// string sorts before its extensions. Each encoder returns the length of
+/// the encoding and only writes it if out is not null.
+size_t
+EncodeUInt(uint64_t value, char* out) {
+  if (out) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      out[i] = static_cast<char>(value >> (8 * (sizeof(value) - 1 - i)));
+    }
+  }
+  return sizeof(value);
+}
+
+size_t
+EncodeInt(int64_t value, char* out) {
+  return EncodeUInt(static_cast<uint64_t>(value) ^ (uint64_t{1} << 63U), out);
+}
+
+size_t
+EncodeDouble(double value, char* out) {
+  // -0.0 == 0.0, so they get the same key
+  if (value == 0) {
+    value = 0;
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = (bits >> 63U) ? ~bits : bits | (uint64_t{1} << 63U);
+  return EncodeUInt(bits, out);
+}
+
+size_t
+EncodeBool(bool value, char* out) {
+  if (out) {
+    *out = value;
+  }
+  return 1;
+}
+
+size_t
+EncodeString(std::string_view value, char* out) {
+  size_t len = 0;
+  for (char c : value) {
+    if (out) {
+      out[len] = c;
+    }
+    ++len;
+    if (c == '\0') {
+      if (out) {
+        out[len] = '\xff';
+      }
+      ++len;
+    }
+  }
+  if (out) {
+    out[len] = '\0';
+    out[len + 1] = '\x01';
+  }
+  return len + 2;
+}
+
+bool
+IsSupportedKeyType(arrow::Type::type type) {
+  switch (type) {
+  case arrow::Type::BOOL:
+  case arrow::Type::INT8:
+  case arrow::Type::INT16:
+  case arrow::Type::INT32:
+  case arrow::Type::INT64:
+  case arrow::Type::UINT8:
+  case arrow::Type::UINT16:
+  case arrow::Type::UINT32:
+  case arrow::Type::UINT64:
+  case arrow::Type::FLOAT:
+  case arrow::Type::DOUBLE:
+  case arrow::Type::STRING:
+  case arrow::Type::LARGE_STRING:
+    return true;
+  default:
+    return false;
+  }
+}
+
+template <typename ArrayType>
+const ArrayType&
+As(const arrow::Array& array) {
+  return static_cast<const ArrayType&>(array);
+}
+
+/// Encode entry i of property, which must have a supported key type
+size_t
+EncodeEntry(const arrow::Array& property, int64_t i, char* out) {
+  switch (property.type_id()) {
+  case arrow::Type::BOOL:
+    return EncodeBool(As<arrow::BooleanArray>(property).Value(i), out);
+  case arrow::Type::INT8:
+    return EncodeInt(As<arrow::Int8Array>(property).Value(i), out);
+  case arrow::Type::INT16:
+    return EncodeInt(As<arrow::Int16Array>(property).Value(i), out);
+  case arrow::Type::INT32:
+    return EncodeInt(As<arrow::Int32Array>(property).Value(i), out);
+  case arrow::Type::INT64:
+    return EncodeInt(As<arrow::Int64Array>(property).Value(i), out);
+  case arrow::Type::UINT8:
+    return EncodeUInt(As<arrow::UInt8Array>(property).Value(i), out);
+  case arrow::Type::UINT16:
+    return EncodeUInt(As<arrow::UInt16Array>(property).Value(i), out);
+  case arrow::Type::UINT32:
+    return EncodeUInt(As<arrow::UInt32Array>(property).Value(i), out);
+  case arrow::Type::UINT64:
+    return EncodeUInt(As<arrow::UInt64Array>(property).Value(i), out);
+  case arrow::Type::FLOAT:
+    return EncodeDouble(As<arrow::FloatArray>(property).Value(i), out);
+  case arrow::Type::DOUBLE:
+    return EncodeDouble(As<arrow::DoubleArray>(property).Value(i), out);
+  case arrow::Type::STRING: {
+    auto view = As<arrow::StringArray>(property).GetView(i);
+    return EncodeString(std::string_view(view.data(), view.length()), out);
+  }
+  case arrow::Type::LARGE_STRING: {
+    auto view = As<arrow::LargeStringArray>(property).GetView(i);
+    return EncodeString(std::string_view(view.data(), view.length()), out);
+  }
+  default:
+    KATANA_LOG_FATAL("unsupported key type {}", property.type()->ToString());
+  }
+}
+
+/// Encode value as a value of a property of type type
+template <typename Value>
+Result<void>
+EncodeValue(const arrow::DataType& type, const Value& value, std::string* key) {
+  const auto* as_bool = std::get_if<bool>(&value);
+  const auto* as_int = std::get_if<int64_t>(&value);
+  const auto* as_uint = std::get_if<uint64_t>(&value);
+  const auto* as_double = std::get_if<double>(&value);
+  const auto* as_string = std::get_if<std::string_view>(&value);
+
+  size_t old_size = key->size();
+  auto append = [&](auto encode, auto v) {
+    key->resize(old_size + encode(v, nullptr));
+    encode(v, key->data() + old_size);
+  };
+
+  switch (type.id()) {
+  case arrow::Type::BOOL:
+    if (as_bool) {
+      append(EncodeBool, *as_bool);
+      return ResultSuccess();
+    }
+    break;
+  case arrow::Type::INT8:
+  case arrow::Type::INT16:
+  case arrow::Type::INT32:
+  case arrow::Type::INT64:
+    if (as_int) {
+      append(EncodeInt, *as_int);
+      return ResultSuccess();
+    }
+    if (as_uint) {
+      if (*as_uint > static_cast<uint64_t>(INT64_MAX)) {
+        return KATANA_ERROR(
+            ErrorCode::InvalidArgument, "{} is out of range for {}", *as_uint,
+            type.ToString());
+      }
+      append(EncodeInt, static_cast<int64_t>(*as_uint));
+      return ResultSuccess();
+    }
+    break;
+  case arrow::Type::UINT8:
+  case arrow::Type::UINT16:
+  case arrow::Type::UINT32:
+  case arrow::Type::UINT64:
+    if (as_uint) {
+      append(EncodeUInt, *as_uint);
+      return ResultSuccess();
+    }
+    if (as_int) {
+      if (*as_int < 0) {
+        return KATANA_ERROR(
+            ErrorCode::InvalidArgument, "{} is out of range for {}", *as_int,
+            type.ToString());
+      }
+      append(EncodeUInt, static_cast<uint64_t>(*as_int));
+      return ResultSuccess();
+    }
+    break;
+  case arrow::Type::FLOAT:
+  case arrow::Type::DOUBLE: {
+    std::optional<double> v;
+    if (as_double) {
+      v = *as_double;
+    } else if (as_int) {
+      v = static_cast<double>(*as_int);
+    } else if (as_uint) {
+      v = static_cast<double>(*as_uint);
+    }
+    if (v) {
+      // Match the rounding of the values of the property
+      if (type.id() == arrow::Type::FLOAT) {
+        v = static_cast<float>(*v);
+      }
+      append(EncodeDouble, *v);
+      return ResultSuccess();
+    }
+    break;
+  }
+  case arrow::Type::STRING:
+  case arrow::Type::LARGE_STRING:
+    if (as_string) {
+      append(EncodeString, *as_string);
+      return ResultSuccess();
+    }
+    break;
+  default:
+    break;
+  }
+  return KATANA_ERROR(
+      ErrorCode::InvalidArgument, "value does not match property type {}",
+      type.ToString());
+}
+
+}  // namespace
+
+// Switch statement over creation of per-type hash indexes.
+template <typename node_or_edge>
+Result<std::unique_ptr<EntityIndex<node_or_edge>>>
+MakeHashEntityIndex(
+    const std::string& property_name, size_t num_entities,
+    const std::shared_ptr<arrow::Array>& property) {
+  std::unique_ptr<EntityIndex<node_or_edge>> index;
+
+  switch (property->type_id()) {
+  case arrow::Type::BOOL:
+    index = std::make_unique<HashEntityIndex<node_or_edge, bool>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::UINT8:
+    index = std::make_unique<HashEntityIndex<node_or_edge, uint8_t>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::INT16:
+    index = std::make_unique<HashEntityIndex<node_or_edge, int16_t>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::INT32:
+    index = std::make_unique<HashEntityIndex<node_or_edge, int32_t>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::INT64:
+    index = std::make_unique<HashEntityIndex<node_or_edge, int64_t>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::UINT64:
+    index = std::make_unique<HashEntityIndex<node_or_edge, uint64_t>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::LARGE_STRING:
+    index = std::make_unique<HashEntityIndex<node_or_edge, std::string_view>>(
+        property_name, num_entities, property);
+    break;
+  case arrow::Type::DICTIONARY:
+    // The dictionary already maps strings to runs
+    index = std::make_unique<DictionaryEntityIndex<node_or_edge>>(
+        property_name, num_entities, property);
+    break;
+  default:
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "Column has type unknown for hash indexing: {}",
+        property->type()->ToString());
+  }
+
+  return Result<std::unique_ptr<EntityIndex<node_or_edge>>>(std::move(index));
+}
+
 // Switch statement over creation of per-type indexes.
 template <typename node_or_edge>
 Result<std::unique_ptr<EntityIndex<node_or_edge>>>
 MakeTypedEntityIndex(
     const std::string& property_name, size_t num_entities,
-    std::shared_ptr<arrow::Array> property) {
+    std::shared_ptr<arrow::Array> property, EntityIndexKind kind) {
   std::unique_ptr<EntityIndex<node_or_edge>> index;
 
+  if (kind == EntityIndexKind::kHash) {
+    return MakeHashEntityIndex<node_or_edge>(
+        property_name, num_entities, property);
+  }
+
   switch (property->type_id()) {
   case arrow::Type::BOOL:
     index = std::make_unique<PrimitiveEntityIndex<node_or_edge, bool>>(
@@ -49,6 +531,10 @@ MakeTypedEntityIndex(
     index = std::make_unique<StringEntityIndex<node_or_edge>>(
         property_name, num_entities, property);
     break;
+  case arrow::Type::DICTIONARY:
+    index = std::make_unique<DictionaryEntityIndex<node_or_edge>>(
+        property_name, num_entities, property);
+    break;
   default:
     return KATANA_ERROR(
         ErrorCode::InvalidArgument, "Column has type unknown for indexing: {}",
@@ -67,16 +553,55 @@ PrimitiveEntityIndex<node_or_edge, c_type>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
-    }
+  NUMAArray<node_or_edge> ids =
+      ValidIDs<node_or_edge>(*property_, num_entities_);
+  keys_ = SortByValue<c_type>(
+      &ids, [&](node_or_edge id) { return property_->Value(id); });
+  this->ids_ = std::move(ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge, typename c_type>
+Result<void>
+PrimitiveEntityIndex<node_or_edge, c_type>::BuildFromSortedIDs(
+    NUMAArray<node_or_edge>&& sorted_ids) {
+  if (static_cast<uint64_t>(property_->length()) < num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
+  KATANA_CHECKED(CheckSortedIDs(
+      *property_, num_entities_, sorted_ids,
+      [&](node_or_edge id) { return property_->Value(id); }));
+
+  size_t num_ids = sorted_ids.size();
+  keys_.allocateBlocked(num_ids);
+  do_all(
+      iterate(size_t{0}, num_ids),
+      [&](size_t i) { keys_[i] = property_->Value(sorted_ids[i]); },
+      no_stats());
+  this->ids_ = std::move(sorted_ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge, typename c_type>
+void
+PrimitiveEntityIndex<node_or_edge, c_type>::BuildSearch() {
+  tree_.Build(keys_.size(), [&](size_t i) { return keys_[i]; });
+}
 
-  return katana::ResultSuccess();
+template <typename node_or_edge, typename c_type>
+std::vector<typename PrimitiveEntityIndex<node_or_edge, c_type>::iterator>
+PrimitiveEntityIndex<node_or_edge, c_type>::LowerBounds(
+    const std::vector<c_type>& keys) const {
+  std::vector<iterator> result(keys.size());
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t i) { result[i] = LowerBound(keys[i]); }, no_stats());
+  return result;
 }
 
 template <typename node_or_edge>
@@ -87,16 +612,429 @@ StringEntityIndex<node_or_edge>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
+  NUMAArray<node_or_edge> ids =
+      ValidIDs<node_or_edge>(*property_, num_entities_);
+  ParallelSTL::sort(
+      ids.begin(), ids.end(), [&](node_or_edge a, node_or_edge b) {
+        return std::make_pair(GetValue(a), a) < std::make_pair(GetValue(b), b);
+      });
+  this->ids_ = std::move(ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+Result<void>
+StringEntityIndex<node_or_edge>::BuildFromSortedIDs(
+    NUMAArray<node_or_edge>&& sorted_ids) {
+  if (static_cast<uint64_t>(property_->length()) < num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Property does not contain all entities");
+  }
+  KATANA_CHECKED(CheckSortedIDs(
+      *property_, num_entities_, sorted_ids,
+      [&](node_or_edge id) { return GetValue(id); }));
+  this->ids_ = std::move(sorted_ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+void
+StringEntityIndex<node_or_edge>::BuildSearch() {
+  tree_.Build(
+      this->ids_.size(), [&](size_t i) { return GetValue(this->ids_[i]); });
+}
+
+template <typename node_or_edge>
+std::vector<typename StringEntityIndex<node_or_edge>::iterator>
+StringEntityIndex<node_or_edge>::LowerBounds(
+    const std::vector<std::string_view>& keys) const {
+  std::vector<iterator> result(keys.size());
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t i) { result[i] = LowerBound(keys[i]); }, no_stats());
+  return result;
+}
+
+template <typename node_or_edge>
+Result<void>
+DictionaryEntityIndex<node_or_edge>::RankDictionary() {
+  if (static_cast<uint64_t>(property_->length()) < num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Property does not contain all entities");
+  }
+  const auto& type =
+      static_cast<const arrow::DictionaryType&>(*property_->type());
+  if (type.index_type()->id() != arrow::Type::INT32 ||
+      type.value_type()->id() != arrow::Type::LARGE_STRING) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "Column has dictionary type unknown for indexing: {}",
+        type.ToString());
+  }
+  codes_ = property_->indices()->data()->GetValues<code_type>(1);
+
+  // Dictionaries are small, so they are sorted serially
+  const auto& dictionary =
+      static_cast<const arrow::LargeStringArray&>(*property_->dictionary());
+  size_t num_codes = dictionary.length();
+  std::vector<uint32_t> order(num_codes);
+  std::iota(order.begin(), order.end(), uint32_t{0});
+  auto value = [&](uint32_t code) {
+    arrow::util::string_view view = dictionary.GetView(code);
+    return std::string_view(view.data(), view.length());
+  };
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return value(a) < value(b);
+  });
+
+  sorted_values_.resize(num_codes);
+  ranks_.resize(num_codes);
+  for (size_t rank = 0; rank < num_codes; ++rank) {
+    sorted_values_[rank] = value(order[rank]);
+    ranks_[order[rank]] = rank;
+  }
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+Result<void>
+DictionaryEntityIndex<node_or_edge>::BuildFromProperty() {
+  KATANA_CHECKED(RankDictionary());
+
+  NUMAArray<node_or_edge> ids =
+      ValidIDs<node_or_edge>(*property_, num_entities_);
+  NUMAArray<uint32_t> sorted_ranks = SortByValue<uint32_t>(
+      &ids, [&](node_or_edge id) { return GetRank(id); });
+  this->ids_ = std::move(ids);
+
+  BuildSearch(sorted_ranks);
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+Result<void>
+DictionaryEntityIndex<node_or_edge>::BuildFromSortedIDs(
+    NUMAArray<node_or_edge>&& sorted_ids) {
+  KATANA_CHECKED(RankDictionary());
+  KATANA_CHECKED(CheckSortedIDs(
+      *property_, num_entities_, sorted_ids,
+      [&](node_or_edge id) { return GetRank(id); }));
+
+  size_t num_ids = sorted_ids.size();
+  NUMAArray<uint32_t> sorted_ranks;
+  sorted_ranks.allocateBlocked(num_ids);
+  do_all(
+      iterate(size_t{0}, num_ids),
+      [&](size_t i) { sorted_ranks[i] = GetRank(sorted_ids[i]); },
+      no_stats());
+  this->ids_ = std::move(sorted_ids);
+
+  BuildSearch(sorted_ranks);
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+void
+DictionaryEntityIndex<node_or_edge>::BuildSearch(
+    const NUMAArray<uint32_t>& sorted_ranks) {
+  size_t num_ranks = sorted_values_.size();
+  runs_.allocateBlocked(num_ranks + 1);
+  do_all(
+      iterate(size_t{0}, num_ranks + 1),
+      [&](size_t rank) {
+        runs_[rank] = std::lower_bound(
+                          sorted_ranks.begin(), sorted_ranks.end(), rank) -
+                      sorted_ranks.begin();
+      },
+      no_stats());
+}
+
+template <typename node_or_edge>
+std::vector<typename DictionaryEntityIndex<node_or_edge>::iterator>
+DictionaryEntityIndex<node_or_edge>::LowerBounds(
+    const std::vector<std::string_view>& keys) const {
+  std::vector<iterator> result(keys.size());
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t i) { result[i] = LowerBound(keys[i]); }, no_stats());
+  return result;
+}
+
+template <typename Key>
+void
+internal::HashRunTable<Key>::Build(NUMAArray<Key>&& keys) {
+  keys_ = std::move(keys);
+  size_t num_keys = keys_.size();
+
+  // Keep the table at most 7/8 full so that probes stay short
+  size_t num_groups = 1;
+  while (num_groups * kGroupSize * 7 < num_keys * 8 + 1) {
+    num_groups *= 2;
+  }
+  group_mask_ = num_groups - 1;
+  tags_.allocateBlocked(num_groups * kGroupSize);
+  ParallelSTL::fill(tags_.begin(), tags_.end(), uint8_t{0});
+  runs_.allocateBlocked(num_groups * kGroupSize);
+
+  do_all(
+      iterate(size_t{0}, num_keys),
+      [&](size_t run) {
+        uint64_t hash = Hash(keys_[run]);
+        uint8_t tag = Tag(hash);
+        for (size_t group = FirstGroup(hash);;
+             group = (group + 1) & group_mask_) {
+          for (size_t slot = group * kGroupSize;
+               slot < (group + 1) * kGroupSize; ++slot) {
+            if (tags_[slot] == 0 &&
+                __sync_bool_compare_and_swap(&tags_[slot], 0, tag)) {
+              runs_[slot] = run;
+              return;
+            }
+          }
+        }
+      },
+      steal(), no_stats());
+}
+
+template <typename node_or_edge, typename c_type>
+Result<void>
+HashEntityIndex<node_or_edge, c_type>::BuildFromProperty() {
+  if (static_cast<uint64_t>(property_->length()) < num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Property does not contain all entities");
+  }
+
+  NUMAArray<node_or_edge> ids =
+      ValidIDs<node_or_edge>(*property_, num_entities_);
+  SortByValue<c_type>(&ids, [&](node_or_edge id) { return GetValue(id); });
+  this->ids_ = std::move(ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge, typename c_type>
+Result<void>
+HashEntityIndex<node_or_edge, c_type>::BuildFromSortedIDs(
+    NUMAArray<node_or_edge>&& sorted_ids) {
+  if (static_cast<uint64_t>(property_->length()) < num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Property does not contain all entities");
+  }
+  KATANA_CHECKED(CheckSortedIDs(
+      *property_, num_entities_, sorted_ids,
+      [&](node_or_edge id) { return GetValue(id); }));
+  this->ids_ = std::move(sorted_ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge, typename c_type>
+void
+HashEntityIndex<node_or_edge, c_type>::BuildSearch() {
+  const auto& ids = this->ids_;
+  runs_ = RunStarts(
+      ids.size(), [&](size_t i) { return GetValue(ids[i]); });
+
+  NUMAArray<c_type> keys;
+  keys.allocateBlocked(runs_.size() - 1);
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t run) { keys[run] = GetValue(ids[runs_[run]]); }, no_stats());
+  table_.Build(std::move(keys));
+}
+
+template <typename node_or_edge, typename c_type>
+std::vector<typename HashEntityIndex<node_or_edge, c_type>::iterator>
+HashEntityIndex<node_or_edge, c_type>::Finds(
+    const std::vector<c_type>& keys) const {
+  std::vector<iterator> result(keys.size());
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t i) { result[i] = Find(keys[i]); }, no_stats());
+  return result;
+}
+
+std::string
+CompositeIndexName(const std::vector<std::string>& property_names) {
+  // Length prefixes keep names with commas or colons apart, and the prefix
+  // keeps a composite over one property apart from the plain index over it
+  std::string name = "composite:";
+  for (const auto& property_name : property_names) {
+    name += fmt::format("{}:{},", property_name.size(), property_name);
+  }
+  return name;
+}
+
+template <typename node_or_edge>
+CompositeEntityIndex<node_or_edge>::CompositeEntityIndex(
+    const std::vector<std::string>& property_names, size_t num_entities,
+    std::vector<std::shared_ptr<arrow::Array>> properties,
+    EntityIndexKind kind)
+    : EntityIndex<node_or_edge>(CompositeIndexName(property_names)),
+      property_names_(property_names),
+      num_entities_(num_entities),
+      properties_(std::move(properties)),
+      kind_(kind) {}
+
+template <typename node_or_edge>
+bool
+CompositeEntityIndex<node_or_edge>::IsValid(node_or_edge id) const {
+  for (const auto& property : properties_) {
+    if (property->IsNull(id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename node_or_edge>
+Result<std::string>
+CompositeEntityIndex<node_or_edge>::EncodeKey(
+    const std::vector<Value>& values) const {
+  if (values.size() != properties_.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "index has {} properties, got {} values",
+        properties_.size(), values.size());
+  }
+  std::string key;
+  for (size_t i = 0; i < values.size(); ++i) {
+    KATANA_CHECKED_CONTEXT(
+        EncodeValue(*properties_[i]->type(), values[i], &key), "property {}",
+        property_names_[i]);
+  }
+  return key;
+}
+
+template <typename node_or_edge>
+std::pair<
+    typename CompositeEntityIndex<node_or_edge>::iterator,
+    typename CompositeEntityIndex<node_or_edge>::iterator>
+CompositeEntityIndex<node_or_edge>::EqualRange(std::string_view key) const {
+  if (kind_ == EntityIndexKind::kOrdered) {
+    return {LowerBound(key), UpperBound(key)};
+  }
+  size_t run = table_.Find(key);
+  if (run == internal::HashRunTable<std::string_view>::kNotFound) {
+    return {this->end(), this->end()};
+  }
+  return {this->begin() + runs_[run], this->begin() + runs_[run + 1]};
+}
+
+template <typename node_or_edge>
+Result<void>
+CompositeEntityIndex<node_or_edge>::EncodeKeys() {
+  if (properties_.empty()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "composite index needs properties");
+  }
+  for (size_t i = 0; i < properties_.size(); ++i) {
+    if (static_cast<uint64_t>(properties_[i]->length()) < num_entities_) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "Property {} does not contain all entities", property_names_[i]);
+    }
+    if (!IsSupportedKeyType(properties_[i]->type_id())) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "Property {} has type unknown for indexing: {}", property_names_[i],
+          properties_[i]->type()->ToString());
     }
   }
 
-  return katana::ResultSuccess();
+  key_offsets_.allocateBlocked(num_entities_ + 1);
+  key_offsets_[0] = 0;
+  do_all(
+      iterate(size_t{0}, num_entities_),
+      [&](size_t i) {
+        size_t len = 0;
+        if (IsValid(i)) {
+          for (const auto& property : properties_) {
+            len += EncodeEntry(*property, i, nullptr);
+          }
+        }
+        key_offsets_[i + 1] = len;
+      },
+      no_stats());
+  ParallelSTL::partial_sum(
+      key_offsets_.begin(), key_offsets_.end(), key_offsets_.begin());
+
+  key_data_.allocateBlocked(key_offsets_[num_entities_]);
+  do_all(
+      iterate(size_t{0}, num_entities_),
+      [&](size_t i) {
+        if (!IsValid(i)) {
+          return;
+        }
+        char* out = key_data_.data() + key_offsets_[i];
+        for (const auto& property : properties_) {
+          out += EncodeEntry(*property, i, out);
+        }
+      },
+      no_stats());
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+Result<void>
+CompositeEntityIndex<node_or_edge>::BuildFromProperty() {
+  KATANA_CHECKED(EncodeKeys());
+
+  bool all_valid = std::all_of(
+      properties_.begin(), properties_.end(),
+      [](const auto& property) { return property->null_count() == 0; });
+  NUMAArray<node_or_edge> ids = ValidIDs<node_or_edge>(
+      num_entities_, all_valid, [&](size_t i) { return IsValid(i); });
+  // The keys are already in memory, so sort the ids alone
+  ParallelSTL::sort(
+      ids.begin(), ids.end(), [&](node_or_edge a, node_or_edge b) {
+        return std::make_pair(GetKey(a), a) < std::make_pair(GetKey(b), b);
+      });
+  this->ids_ = std::move(ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+Result<void>
+CompositeEntityIndex<node_or_edge>::BuildFromSortedIDs(
+    NUMAArray<node_or_edge>&& sorted_ids) {
+  KATANA_CHECKED(EncodeKeys());
+
+  bool all_valid = std::all_of(
+      properties_.begin(), properties_.end(),
+      [](const auto& property) { return property->null_count() == 0; });
+  KATANA_CHECKED(CheckSortedIDs(
+      num_entities_, all_valid, [&](size_t i) { return IsValid(i); },
+      sorted_ids, [&](node_or_edge id) { return GetKey(id); }));
+  this->ids_ = std::move(sorted_ids);
+
+  BuildSearch();
+  return ResultSuccess();
+}
+
+template <typename node_or_edge>
+void
+CompositeEntityIndex<node_or_edge>::BuildSearch() {
+  const auto& ids = this->ids_;
+  if (kind_ == EntityIndexKind::kOrdered) {
+    tree_.Build(ids.size(), [&](size_t i) { return GetKey(ids[i]); });
+    return;
+  }
+
+  runs_ = RunStarts(ids.size(), [&](size_t i) { return GetKey(ids[i]); });
+  NUMAArray<std::string_view> keys;
+  keys.allocateBlocked(runs_.size() - 1);
+  do_all(
+      iterate(size_t{0}, keys.size()),
+      [&](size_t run) { keys[run] = GetKey(ids[runs_[run]]); }, no_stats());
+  table_.Build(std::move(keys));
 }
 
 // Forward declare template types to allow implementation in .cpp.
@@ -120,13 +1058,42 @@ template class PrimitiveEntityIndex<GraphTopology::Edge, float_t>;
 template class StringEntityIndex<GraphTopology::Node>;
 template class StringEntityIndex<GraphTopology::Edge>;
 
+template class DictionaryEntityIndex<GraphTopology::Node>;
+template class DictionaryEntityIndex<GraphTopology::Edge>;
+
+template class internal::HashRunTable<bool>;
+template class internal::HashRunTable<uint8_t>;
+template class internal::HashRunTable<int16_t>;
+template class internal::HashRunTable<int32_t>;
+template class internal::HashRunTable<int64_t>;
+template class internal::HashRunTable<uint64_t>;
+template class internal::HashRunTable<std::string_view>;
+
+template class HashEntityIndex<GraphTopology::Node, bool>;
+template class HashEntityIndex<GraphTopology::Edge, bool>;
+template class HashEntityIndex<GraphTopology::Node, uint8_t>;
+template class HashEntityIndex<GraphTopology::Edge, uint8_t>;
+template class HashEntityIndex<GraphTopology::Node, int16_t>;
+template class HashEntityIndex<GraphTopology::Edge, int16_t>;
+template class HashEntityIndex<GraphTopology::Node, int32_t>;
+template class HashEntityIndex<GraphTopology::Edge, int32_t>;
+template class HashEntityIndex<GraphTopology::Node, int64_t>;
+template class HashEntityIndex<GraphTopology::Edge, int64_t>;
+template class HashEntityIndex<GraphTopology::Node, uint64_t>;
+template class HashEntityIndex<GraphTopology::Edge, uint64_t>;
+template class HashEntityIndex<GraphTopology::Node, std::string_view>;
+template class HashEntityIndex<GraphTopology::Edge, std::string_view>;
+
+template class CompositeEntityIndex<GraphTopology::Node>;
+template class CompositeEntityIndex<GraphTopology::Edge>;
+
 template Result<std::unique_ptr<EntityIndex<GraphTopology::Node>>>
 MakeTypedEntityIndex(
     const std::string& property_name, size_t num_entities,
-    std::shared_ptr<arrow::Array> property);
+    std::shared_ptr<arrow::Array> property, EntityIndexKind kind);
 template Result<std::unique_ptr<EntityIndex<GraphTopology::Edge>>>
 MakeTypedEntityIndex(
     const std::string& property_name, size_t num_entities,
-    std::shared_ptr<arrow::Array> property);
+    std::shared_ptr<arrow::Array> property, EntityIndexKind kind);
 
 }  // namespace katana
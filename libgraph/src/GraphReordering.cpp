@@ -0,0 +1,600 @@
+#include "katana/GraphReordering.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using PropIndexVec = katana::GraphTopologyTypes::PropIndexVec;
+
+constexpr uint32_t kUnclaimed = std::numeric_limits<uint32_t>::max();
+
+/// Number of BFS sweeps used to look for a pseudo-peripheral start node
+constexpr uint32_t kMaxPeripheralSweeps = 4;
+
+/// Gorder window size suggested by Wei et al.
+constexpr size_t kGorderWindow = 5;
+
+bool
+LessByDegree(const katana::GraphTopology& topo, Node a, Node b) {
+  auto da = topo.OutDegree(a);
+  auto db = topo.OutDegree(b);
+  return da < db || (da == db && a < b);
+}
+
+katana::NUMAArray<Node>
+NodesByDegree(const katana::GraphTopology& topo) {
+  katana::NUMAArray<Node> nodes;
+  nodes.allocateInterleaved(topo.NumNodes());
+  katana::ParallelSTL::iota(nodes.begin(), nodes.end(), Node{0});
+  katana::ParallelSTL::sort(nodes.begin(), nodes.end(), [&](Node a, Node b) {
+    return LessByDegree(topo, a, b);
+  });
+  return nodes;
+}
+
+void
+GatherInto(
+    katana::PerThreadStorage<std::vector<Node>>* locals,
+    std::vector<Node>* out) {
+  out->clear();
+  for (unsigned i = 0; i < locals->size(); ++i) {
+    auto* local = locals->getRemote(i);
+    out->insert(out->end(), local->begin(), local->end());
+    local->clear();
+  }
+}
+
+/// Parallel BFS from root that only records the last level. Nodes are visited
+/// once per stamp, so marks need not be cleared between sweeps.
+uint32_t
+BfsLastLevel(
+    const katana::GraphTopology& topo, Node root,
+    katana::NUMAArray<std::atomic<uint32_t>>* marks, uint32_t stamp,
+    std::vector<Node>* last_level) {
+  katana::PerThreadStorage<std::vector<Node>> next;
+  std::vector<Node> frontier{root};
+  (*marks)[root].store(stamp, std::memory_order_relaxed);
+
+  uint32_t depth = 0;
+  while (true) {
+    katana::do_all(
+        katana::iterate(frontier.begin(), frontier.end()),
+        [&](Node u) {
+          for (auto e : topo.OutEdges(u)) {
+            auto v = topo.OutEdgeDst(e);
+            auto& mark = (*marks)[v];
+            if (mark.load(std::memory_order_relaxed) != stamp &&
+                mark.exchange(stamp, std::memory_order_relaxed) != stamp) {
+              next.getLocal()->push_back(v);
+            }
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Reordering-BfsSweep"));
+
+    std::vector<Node> level;
+    GatherInto(&next, &level);
+    if (level.empty()) {
+      break;
+    }
+    frontier = std::move(level);
+    ++depth;
+  }
+
+  *last_level = std::move(frontier);
+  return depth;
+}
+
+/// George and Liu's heuristic: repeatedly restart the BFS from a minimum
+/// degree node of the last level as long as the eccentricity grows.
+Node
+FindPseudoPeripheralNode(
+    const katana::GraphTopology& topo, Node start,
+    katana::NUMAArray<std::atomic<uint32_t>>* marks, uint32_t* stamp) {
+  auto next_stamp = [&]() {
+    if (*stamp == std::numeric_limits<uint32_t>::max()) {
+      katana::do_all(
+          katana::iterate(size_t{0}, marks->size()),
+          [&](size_t i) { (*marks)[i].store(0, std::memory_order_relaxed); },
+          katana::no_stats());
+      *stamp = 0;
+    }
+    return ++*stamp;
+  };
+
+  std::vector<Node> last_level;
+  Node root = start;
+  uint32_t ecc = BfsLastLevel(topo, root, marks, next_stamp(), &last_level);
+
+  for (uint32_t i = 0; i < kMaxPeripheralSweeps; ++i) {
+    Node candidate = *std::min_element(
+        last_level.begin(), last_level.end(),
+        [&](Node a, Node b) { return LessByDegree(topo, a, b); });
+
+    std::vector<Node> candidate_level;
+    uint32_t candidate_ecc =
+        BfsLastLevel(topo, candidate, marks, next_stamp(), &candidate_level);
+    if (candidate_ecc <= ecc) {
+      break;
+    }
+    root = candidate;
+    ecc = candidate_ecc;
+    last_level = std::move(candidate_level);
+  }
+  return root;
+}
+
+/// Level-synchronous Cuthill-McKee. Every unvisited node is claimed by the
+/// earliest node of the current level that reaches it, which is the node a
+/// sequential BFS would reach it from. The children of each node are sorted
+/// by degree and placed after the level using a prefix sum over the level.
+PropIndexVec
+ReverseCuthillMcKee(const katana::GraphTopology& topo) {
+  const size_t num_nodes = topo.NumNodes();
+  KATANA_LOG_ASSERT(num_nodes < kUnclaimed);
+
+  // claim[v] is the position of the node that placed v. Placed nodes always
+  // have a smaller claim than any position in the current level.
+  katana::NUMAArray<std::atomic<uint32_t>> claim;
+  claim.allocateInterleaved(num_nodes);
+  katana::NUMAArray<std::atomic<uint32_t>> marks;
+  marks.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        claim[i].store(kUnclaimed, std::memory_order_relaxed);
+        marks[i].store(0, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  katana::NUMAArray<Node> order;
+  order.allocateInterleaved(num_nodes);
+  katana::NUMAArray<uint64_t> child_offsets;
+  child_offsets.allocateInterleaved(num_nodes);
+
+  katana::PerThreadStorage<std::vector<Node>> scratch;
+  auto collect_children = [&](Node u, uint32_t pos) {
+    auto* children = scratch.getLocal();
+    children->clear();
+    for (auto e : topo.OutEdges(u)) {
+      auto v = topo.OutEdgeDst(e);
+      if (v != u && claim[v].load(std::memory_order_relaxed) == pos) {
+        children->push_back(v);
+      }
+    }
+    std::sort(children->begin(), children->end(), [&](Node a, Node b) {
+      return LessByDegree(topo, a, b);
+    });
+    children->erase(
+        std::unique(children->begin(), children->end()), children->end());
+    return children;
+  };
+
+  auto by_degree = NodesByDegree(topo);
+  uint32_t stamp = 0;
+  size_t next = 0;
+
+  for (Node start : by_degree) {
+    if (claim[start].load(std::memory_order_relaxed) != kUnclaimed) {
+      continue;
+    }
+
+    Node root = start;
+    if (topo.OutDegree(start) > 0) {
+      root = FindPseudoPeripheralNode(topo, start, &marks, &stamp);
+    }
+    // Without symmetric edges the sweeps may leave the unplaced nodes
+    if (claim[root].load(std::memory_order_relaxed) != kUnclaimed) {
+      root = start;
+    }
+    claim[root].store(static_cast<uint32_t>(next), std::memory_order_relaxed);
+    order[next++] = root;
+
+    size_t level_begin = next - 1;
+    size_t level_end = next;
+    while (level_begin < level_end) {
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](size_t pos) {
+            Node u = order[pos];
+            for (auto e : topo.OutEdges(u)) {
+              auto v = topo.OutEdgeDst(e);
+              if (v != u) {
+                katana::atomicMin(claim[v], static_cast<uint32_t>(pos));
+              }
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("Reordering-RCMClaim"));
+
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](size_t pos) {
+            child_offsets[pos] = collect_children(order[pos], pos)->size();
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("Reordering-RCMCount"));
+
+      katana::ParallelSTL::partial_sum(
+          child_offsets.begin() + level_begin,
+          child_offsets.begin() + level_end,
+          child_offsets.begin() + level_begin);
+
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](size_t pos) {
+            auto* children = collect_children(order[pos], pos);
+            size_t out = level_end + child_offsets[pos] - children->size();
+            for (Node v : *children) {
+              order[out++] = v;
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("Reordering-RCMPlace"));
+
+      next = level_end + child_offsets[level_end - 1];
+      level_begin = level_end;
+      level_end = next;
+    }
+  }
+  KATANA_LOG_DEBUG_ASSERT(next == num_nodes);
+
+  PropIndexVec new_to_old;
+  new_to_old.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { new_to_old[i] = order[num_nodes - 1 - i]; },
+      katana::no_stats());
+  return new_to_old;
+}
+
+/// Hubs, nodes with more than the average degree, first. Both hubs and
+/// non-hubs keep their original relative order, which is computed with a
+/// prefix sum over the hub flags.
+PropIndexVec
+HubFirst(const katana::GraphTopology& topo, bool sort_hubs) {
+  const size_t num_nodes = topo.NumNodes();
+  PropIndexVec new_to_old;
+  new_to_old.allocateInterleaved(num_nodes);
+  if (num_nodes == 0) {
+    return new_to_old;
+  }
+
+  const double average_degree =
+      static_cast<double>(topo.NumEdges()) / num_nodes;
+  auto is_hub = [&](Node n) { return topo.OutDegree(n) > average_degree; };
+
+  katana::NUMAArray<uint64_t> hubs_upto;
+  hubs_upto.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { hubs_upto[i] = is_hub(i) ? 1 : 0; }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      hubs_upto.begin(), hubs_upto.end(), hubs_upto.begin());
+  const uint64_t num_hubs = hubs_upto[num_nodes - 1];
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        if (is_hub(i)) {
+          new_to_old[hubs_upto[i] - 1] = i;
+        } else {
+          new_to_old[num_hubs + i - hubs_upto[i]] = i;
+        }
+      },
+      katana::no_stats());
+
+  if (sort_hubs) {
+    katana::ParallelSTL::sort(
+        new_to_old.begin(), new_to_old.begin() + num_hubs,
+        [&](Node a, Node b) { return LessByDegree(topo, b, a); });
+  }
+  return new_to_old;
+}
+
+/// A max priority queue over nodes whose keys only change by one, kept as
+/// one doubly linked list per key.
+class UnitHeap {
+public:
+  explicit UnitHeap(const katana::NUMAArray<Node>& initial_order)
+      : key_(initial_order.size(), 0),
+        prev_(initial_order.size(), kNil),
+        next_(initial_order.size(), kNil),
+        removed_(initial_order.size(), false),
+        heads_(1, kNil) {
+    // Pushing to the front leaves the last node at the head of its bucket
+    for (Node n : initial_order) {
+      Link(n);
+    }
+  }
+
+  void Increment(Node n) {
+    if (removed_[n]) {
+      return;
+    }
+    Unlink(n);
+    ++key_[n];
+    if (key_[n] >= heads_.size()) {
+      heads_.push_back(kNil);
+    }
+    top_ = std::max(top_, key_[n]);
+    Link(n);
+  }
+
+  void Decrement(Node n) {
+    if (removed_[n]) {
+      return;
+    }
+    KATANA_LOG_DEBUG_ASSERT(key_[n] > 0);
+    Unlink(n);
+    --key_[n];
+    Link(n);
+  }
+
+  Node PopMax() {
+    while (top_ > 0 && heads_[top_] == kNil) {
+      --top_;
+    }
+    Node n = heads_[top_];
+    KATANA_LOG_DEBUG_ASSERT(n != kNil);
+    Unlink(n);
+    removed_[n] = true;
+    return n;
+  }
+
+private:
+  static constexpr Node kNil = std::numeric_limits<Node>::max();
+
+  void Link(Node n) {
+    Node head = heads_[key_[n]];
+    prev_[n] = kNil;
+    next_[n] = head;
+    if (head != kNil) {
+      prev_[head] = n;
+    }
+    heads_[key_[n]] = n;
+  }
+
+  void Unlink(Node n) {
+    if (prev_[n] != kNil) {
+      next_[prev_[n]] = next_[n];
+    } else {
+      heads_[key_[n]] = next_[n];
+    }
+    if (next_[n] != kNil) {
+      prev_[next_[n]] = prev_[n];
+    }
+  }
+
+  std::vector<uint32_t> key_;
+  std::vector<Node> prev_;
+  std::vector<Node> next_;
+  std::vector<bool> removed_;
+  std::vector<Node> heads_;
+  uint32_t top_{0};
+};
+
+/// Gorder: the score of a candidate is the number of edges and shared
+/// neighbors it has with the last kGorderWindow placed nodes. Neighbors with
+/// a degree above sqrt(n) are not expanded when counting shared neighbors;
+/// they would touch most of the graph while adding little locality.
+PropIndexVec
+Gorder(const katana::GraphTopology& topo) {
+  const size_t num_nodes = topo.NumNodes();
+  PropIndexVec new_to_old;
+  new_to_old.allocateInterleaved(num_nodes);
+
+  const auto hub_degree =
+      static_cast<uint64_t>(std::sqrt(static_cast<double>(num_nodes)));
+
+  // Start every component at its highest degree node
+  UnitHeap heap(NodesByDegree(topo));
+
+  auto update = [&](Node placed, bool entering) {
+    auto change = [&](Node n) {
+      if (entering) {
+        heap.Increment(n);
+      } else {
+        heap.Decrement(n);
+      }
+    };
+    for (auto e : topo.OutEdges(placed)) {
+      Node u = topo.OutEdgeDst(e);
+      change(u);
+      if (topo.OutDegree(u) > hub_degree) {
+        continue;
+      }
+      for (auto e2 : topo.OutEdges(u)) {
+        Node w = topo.OutEdgeDst(e2);
+        if (w != placed) {
+          change(w);
+        }
+      }
+    }
+  };
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    new_to_old[i] = heap.PopMax();
+    update(new_to_old[i], true);
+    if (i >= kGorderWindow) {
+      update(new_to_old[i - kGorderWindow], false);
+    }
+  }
+  return new_to_old;
+}
+
+/// Rabbit order: visit nodes by increasing degree and merge each community
+/// into the neighboring community with the largest positive modularity gain.
+/// The merges form a dendrogram per remaining community, and nodes are
+/// numbered by a DFS of each dendrogram.
+PropIndexVec
+RabbitOrder(const katana::GraphTopology& topo) {
+  const size_t num_nodes = topo.NumNodes();
+  PropIndexVec new_to_old;
+  new_to_old.allocateInterleaved(num_nodes);
+  if (num_nodes == 0) {
+    return new_to_old;
+  }
+
+  constexpr Node kNil = std::numeric_limits<Node>::max();
+  const double total_weight = static_cast<double>(topo.NumEdges());
+
+  std::vector<Node> parent(num_nodes);
+  std::vector<double> degree(num_nodes);
+  std::vector<Node> first_child(num_nodes, kNil);
+  std::vector<Node> next_sibling(num_nodes, kNil);
+  std::vector<std::vector<std::pair<Node, uint64_t>>> edges(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) {
+        parent[n] = n;
+        degree[n] = topo.OutDegree(n);
+        edges[n].reserve(topo.OutDegree(n));
+        for (auto e : topo.OutEdges(n)) {
+          edges[n].emplace_back(topo.OutEdgeDst(e), 1);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  auto find = [&](Node n) {
+    Node root = n;
+    while (parent[root] != root) {
+      root = parent[root];
+    }
+    while (parent[n] != root) {
+      Node up = parent[n];
+      parent[n] = root;
+      n = up;
+    }
+    return root;
+  };
+
+  std::vector<uint64_t> weight_to(num_nodes, 0);
+  std::vector<Node> touched;
+  std::vector<Node> top_levels;
+
+  for (Node u : NodesByDegree(topo)) {
+    // Collapse the edges merged into u onto the current communities
+    touched.clear();
+    for (const auto& [dst, weight] : edges[u]) {
+      Node community = find(dst);
+      if (community == u) {
+        continue;
+      }
+      if (weight_to[community] == 0) {
+        touched.push_back(community);
+      }
+      weight_to[community] += weight;
+    }
+
+    std::vector<std::pair<Node, uint64_t>> collapsed;
+    collapsed.reserve(touched.size());
+    Node best = kNil;
+    double best_gain = 0;
+    for (Node community : touched) {
+      double gain = weight_to[community] -
+                    degree[u] * degree[community] / total_weight;
+      if (gain > best_gain || (gain == best_gain && gain > 0 &&
+                               community < best)) {
+        best = community;
+        best_gain = gain;
+      }
+      collapsed.emplace_back(community, weight_to[community]);
+      weight_to[community] = 0;
+    }
+
+    if (best == kNil) {
+      top_levels.push_back(u);
+      edges[u] = std::move(collapsed);
+      continue;
+    }
+
+    parent[u] = best;
+    degree[best] += degree[u];
+    next_sibling[u] = first_child[best];
+    first_child[best] = u;
+    edges[best].insert(edges[best].end(), collapsed.begin(), collapsed.end());
+    edges[u] = {};
+  }
+
+  // Number the dendrograms in parallel, each from its offset
+  katana::NUMAArray<uint64_t> sizes;
+  sizes.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::fill(sizes.begin(), sizes.end(), uint64_t{0});
+  for (size_t n = 0; n < num_nodes; ++n) {
+    ++sizes[find(n)];
+  }
+  std::vector<uint64_t> offsets(top_levels.size() + 1, 0);
+  for (size_t i = 0; i < top_levels.size(); ++i) {
+    offsets[i + 1] = offsets[i] + sizes[top_levels[i]];
+  }
+  KATANA_LOG_DEBUG_ASSERT(offsets.back() == num_nodes);
+
+  katana::do_all(
+      katana::iterate(size_t{0}, top_levels.size()),
+      [&](size_t i) {
+        uint64_t out = offsets[i];
+        std::vector<Node> stack{top_levels[i]};
+        while (!stack.empty()) {
+          Node n = stack.back();
+          stack.pop_back();
+          new_to_old[out++] = n;
+          for (Node c = first_child[n]; c != kNil; c = next_sibling[c]) {
+            stack.push_back(c);
+          }
+        }
+        KATANA_LOG_DEBUG_ASSERT(out == offsets[i + 1]);
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("Reordering-RabbitNumber"));
+
+  return new_to_old;
+}
+
+}  // namespace
+
+bool
+katana::IsNodeReorderingKind(RDGTopology::NodeSortKind kind) noexcept {
+  switch (kind) {
+  case RDGTopology::NodeSortKind::kReverseCuthillMcKee:
+  case RDGTopology::NodeSortKind::kHubSorted:
+  case RDGTopology::NodeSortKind::kHubClustered:
+  case RDGTopology::NodeSortKind::kGorder:
+  case RDGTopology::NodeSortKind::kRabbitOrder:
+    return true;
+  default:
+    return false;
+  }
+}
+
+katana::GraphTopologyTypes::PropIndexVec
+katana::ComputeNodeReordering(
+    const GraphTopology& topo, RDGTopology::NodeSortKind kind) noexcept {
+  switch (kind) {
+  case RDGTopology::NodeSortKind::kReverseCuthillMcKee:
+    return ReverseCuthillMcKee(topo);
+  case RDGTopology::NodeSortKind::kHubSorted:
+    return HubFirst(topo, true);
+  case RDGTopology::NodeSortKind::kHubClustered:
+    return HubFirst(topo, false);
+  case RDGTopology::NodeSortKind::kGorder:
+    return Gorder(topo);
+  case RDGTopology::NodeSortKind::kRabbitOrder:
+    return RabbitOrder(topo);
+  default:
+    KATANA_LOG_FATAL("not a node reordering: {}", static_cast<int>(kind));
+  }
+}
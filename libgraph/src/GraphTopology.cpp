@@ -2,13 +2,22 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_set>
 
+#include "katana/FileFrame.h"
+#include "katana/FileView.h"
+#include "katana/GraphReordering.h"
 #include "katana/Logging.h"
 #include "katana/PropertyGraph.h"
 #include "katana/RDGTopology.h"
 #include "katana/Random.h"
+#include "katana/Reduction.h"
 #include "katana/Result.h"
+#include "katana/Time.h"
+#include "katana/ViewManager.h"
+#include "katana/file.h"
 
 katana::GraphTopology::~GraphTopology() = default;
 
@@ -337,41 +346,99 @@ katana::EdgeShuffleTopology::FindAllEdges(
   return ret_range;
 }
 
+template <typename GroupFunc>
 void
-katana::EdgeShuffleTopology::SortEdgesByDestID() noexcept {
+katana::EdgeShuffleTopology::SortEdgesByGroupThenDest(
+    const GroupFunc& group_of, unsigned group_bits) noexcept {
+  // Nodes with more edges than this are sorted one at a time by all threads
+  // so that the few hubs of a power law graph do not hold up the build.
+  constexpr size_t kHubDegree = size_t{1} << 14;
+
+  // Sort on one integer key per edge, the group above the destination, so
+  // that the group is looked up once per edge rather than per comparison.
+  const unsigned dest_bits =
+      NumNodes() > 1 ? 64 - __builtin_clzll(NumNodes() - 1) : 1;
+  const uint64_t dest_mask = (uint64_t{1} << dest_bits) - 1;
+  KATANA_LOG_DEBUG_ASSERT(dest_bits + group_bits <= 64);
+  auto key_of = [&](Edge e) -> uint64_t {
+    uint64_t group = group_bits > 0 ? group_of(edge_prop_indices_[e]) : 0;
+    return (group << dest_bits) | GetDests()[e];
+  };
+
+  using KeyedEdge = std::pair<uint64_t, PropertyIndex>;
+  katana::PerThreadStorage<std::vector<KeyedEdge>> buffers;
+  katana::PerThreadStorage<std::vector<Node>> hubs;
+
   katana::do_all(
       katana::iterate(Nodes()),
       [&](Node node) {
-        // get this node's first and last edge
         auto e_beg = *OutEdges(node).begin();
         auto e_end = *OutEdges(node).end();
+        if (e_end - e_beg <= 1) {
+          return;
+        }
+        if (e_end - e_beg > kHubDegree) {
+          hubs.getLocal()->emplace_back(node);
+          return;
+        }
 
-        // get iterators to locations to sort in the vector
-        auto begin_sort_iter = katana::make_zip_iterator(
-            edge_prop_indices_.begin() + e_beg, GetDests().begin() + e_beg);
-
-        auto end_sort_iter = katana::make_zip_iterator(
-            edge_prop_indices_.begin() + e_end, GetDests().begin() + e_end);
-
-        // rearrange vector indices based on how the destinations of this
-        // graph will eventually be sorted sort function not based on vector
-        // being passed, but rather the type and destination of the graph
-        std::sort(
-            begin_sort_iter, end_sort_iter,
-            [&](const auto& tup1, const auto& tup2) {
-              auto dst1 = std::get<1>(tup1);
-              auto dst2 = std::get<1>(tup2);
-              static_assert(
-                  std::is_same_v<decltype(dst1), GraphTopology::Node>);
-              static_assert(
-                  std::is_same_v<decltype(dst2), GraphTopology::Node>);
-              return dst1 < dst2;
-            });
-
-        KATANA_LOG_DEBUG_ASSERT(std::is_sorted(
-            GetDests().begin() + e_beg, GetDests().begin() + e_end));
+        std::vector<KeyedEdge>& buffer = *buffers.getLocal();
+        buffer.clear();
+        for (auto e = e_beg; e < e_end; ++e) {
+          buffer.emplace_back(key_of(e), edge_prop_indices_[e]);
+        }
+        std::sort(buffer.begin(), buffer.end());
+        for (auto e = e_beg; e < e_end; ++e) {
+          const auto& [key, prop_index] = buffer[e - e_beg];
+          GetDests()[e] = static_cast<Node>(key & dest_mask);
+          edge_prop_indices_[e] = prop_index;
+        }
       },
       katana::steal(), katana::no_stats());
+
+  std::vector<Node> all_hubs;
+  for (unsigned i = 0; i < hubs.size(); ++i) {
+    auto& local = *hubs.getRemote(i);
+    all_hubs.insert(all_hubs.end(), local.begin(), local.end());
+  }
+
+  Edge max_hub_degree = 0;
+  for (Node hub : all_hubs) {
+    max_hub_degree = std::max(max_hub_degree, OutDegree(hub));
+  }
+  NUMAArray<uint64_t> keys;
+  keys.allocateBlocked(max_hub_degree);
+
+  for (Node hub : all_hubs) {
+    auto e_beg = *OutEdges(hub).begin();
+    auto e_end = *OutEdges(hub).end();
+    katana::do_all(
+        katana::iterate(e_beg, e_end),
+        [&](Edge e) { keys[e - e_beg] = key_of(e); }, katana::no_stats());
+
+    katana::ParallelSTL::radix_sort_by_key(
+        keys.begin(), edge_prop_indices_.begin() + e_beg, e_end - e_beg,
+        dest_bits + group_bits);
+
+    katana::do_all(
+        katana::iterate(e_beg, e_end),
+        [&](Edge e) {
+          GetDests()[e] = static_cast<Node>(keys[e - e_beg] & dest_mask);
+        },
+        katana::no_stats());
+  }
+}
+
+void
+katana::EdgeShuffleTopology::SortEdgesByDestID() noexcept {
+  SortEdgesByGroupThenDest([](PropertyIndex) { return uint64_t{0}; }, 0);
+
+  KATANA_LOG_DEBUG_ASSERT(std::all_of(
+      Nodes().begin(), Nodes().end(), [&](Node node) {
+        return std::is_sorted(
+            GetDests().begin() + *OutEdges(node).begin(),
+            GetDests().begin() + *OutEdges(node).end());
+      }));
   // remember to update sort state
   edge_sort_state_ = katana::RDGTopology::EdgeSortKind::kSortedByDestID;
 }
@@ -379,52 +446,12 @@ katana::EdgeShuffleTopology::SortEdgesByDestID() noexcept {
 void
 katana::EdgeShuffleTopology::SortEdgesByTypeThenDest(
     const PropertyGraph* pg) noexcept {
-  katana::do_all(
-      katana::iterate(Nodes()),
-      [&](Node node) {
-        // get this node's first and last edge
-        auto e_beg = *OutEdges(node).begin();
-        auto e_end = *OutEdges(node).end();
-
-        // get iterators to locations to sort in the vector
-        auto begin_sort_iter = katana::make_zip_iterator(
-            edge_prop_indices_.begin() + e_beg, GetDests().begin() + e_beg);
-
-        auto end_sort_iter = katana::make_zip_iterator(
-            edge_prop_indices_.begin() + e_end, GetDests().begin() + e_end);
-
-        // rearrange vector indices based on how the destinations of this
-        // graph will eventually be sorted sort function not based on vector
-        // being passed, but rather the type and destination of the graph
-        std::sort(
-            begin_sort_iter, end_sort_iter,
-            [&](const auto& tup1, const auto& tup2) {
-              // get edge type and destinations
-              auto e1 = std::get<0>(tup1);
-              auto e2 = std::get<0>(tup2);
-              static_assert(
-                  std::is_same_v<decltype(e1), GraphTopology::PropertyIndex>);
-              static_assert(
-                  std::is_same_v<decltype(e2), GraphTopology::PropertyIndex>);
-
-              katana::EntityTypeID data1 =
-                  pg->GetTypeOfEdgeFromPropertyIndex(e1);
-              katana::EntityTypeID data2 =
-                  pg->GetTypeOfEdgeFromPropertyIndex(e2);
-              if (data1 != data2) {
-                return data1 < data2;
-              }
-
-              auto dst1 = std::get<1>(tup1);
-              auto dst2 = std::get<1>(tup2);
-              static_assert(
-                  std::is_same_v<decltype(dst1), GraphTopology::Node>);
-              static_assert(
-                  std::is_same_v<decltype(dst2), GraphTopology::Node>);
-              return dst1 < dst2;
-            });
+  // Edge types are sorted by their id
+  SortEdgesByGroupThenDest(
+      [&](PropertyIndex prop_index) {
+        return uint64_t{pg->GetTypeOfEdgeFromPropertyIndex(prop_index)};
       },
-      katana::steal(), katana::no_stats());
+      sizeof(katana::EntityTypeID) * 8);
 
   // remember to update sort state
   edge_sort_state_ = katana::RDGTopology::EdgeSortKind::kSortedByEdgeType;
@@ -441,18 +468,39 @@ std::shared_ptr<katana::ShuffleTopology>
 katana::ShuffleTopology::MakeSortedByDegree(
     const PropertyGraph*,
     const katana::EdgeShuffleTopology& seed_topo) noexcept {
-  auto cmp = [&](const auto& i1, const auto& i2) {
-    auto d1 = seed_topo.OutDegree(i1);
-    auto d2 = seed_topo.OutDegree(i2);
-    // TODO(amber): Triangle-Counting needs degrees sorted in descending order. I
-    // need to think of a way to specify in the interface whether degrees should be
-    // sorted in ascending or descending order.
-    // return d1 < d2;
-    return d1 > d2;
-  };
+  // TODO(amber): Triangle-Counting needs degrees sorted in descending order. I
+  // need to think of a way to specify in the interface whether degrees should be
+  // sorted in ascending or descending order.
+  //
+  // Degrees are radix sorted, so the key is the distance from the maximum
+  // degree for a descending order. Nodes of the same degree keep their order.
+  katana::GReduceMax<Edge> max_degree_reducer;
+  katana::do_all(
+      katana::iterate(seed_topo.Nodes()),
+      [&](Node n) { max_degree_reducer.update(seed_topo.OutDegree(n)); },
+      katana::no_stats());
+  Edge max_degree = max_degree_reducer.reduce();
 
-  return MakeNodeSortedTopo(
-      seed_topo, cmp, katana::RDGTopology::NodeSortKind::kSortedByDegree);
+  NUMAArray<Edge> keys;
+  keys.allocateInterleaved(seed_topo.NumNodes());
+  katana::do_all(
+      katana::iterate(seed_topo.Nodes()),
+      [&](Node n) { keys[n] = max_degree - seed_topo.OutDegree(n); },
+      katana::no_stats());
+
+  GraphTopology::PropIndexVec new_to_old;
+  new_to_old.allocateInterleaved(seed_topo.NumNodes());
+  katana::ParallelSTL::iota(
+      new_to_old.begin(), new_to_old.end(),
+      GraphTopologyTypes::PropertyIndex{0});
+
+  unsigned key_bits = max_degree > 0 ? 64 - __builtin_clzll(max_degree) : 0;
+  katana::ParallelSTL::radix_sort_by_key(
+      keys.begin(), new_to_old.begin(), seed_topo.NumNodes(), key_bits);
+
+  return MakeFromNodePermutation(
+      seed_topo, new_to_old,
+      katana::RDGTopology::NodeSortKind::kSortedByDegree);
 }
 
 std::shared_ptr<katana::ShuffleTopology>
@@ -474,6 +522,86 @@ katana::ShuffleTopology::MakeSortedByNodeType(
       seed_topo, cmp, katana::RDGTopology::NodeSortKind::kSortedByNodeType);
 }
 
+std::shared_ptr<katana::ShuffleTopology>
+katana::ShuffleTopology::MakeReordered(
+    const PropertyGraph*, const katana::EdgeShuffleTopology& seed_topo,
+    const katana::RDGTopology::NodeSortKind& node_sort_todo) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(katana::IsNodeReorderingKind(node_sort_todo));
+  auto new_to_old = katana::ComputeNodeReordering(seed_topo, node_sort_todo);
+  return MakeFromNodePermutation(seed_topo, new_to_old, node_sort_todo);
+}
+
+std::shared_ptr<katana::ShuffleTopology>
+katana::ShuffleTopology::MakeFromNodePermutation(
+    const katana::EdgeShuffleTopology& seed_topo,
+    const PropIndexVec& new_to_old,
+    const katana::RDGTopology::NodeSortKind& node_sort_todo) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(new_to_old.size() == seed_topo.NumNodes());
+
+  GraphTopology::AdjIndexVec degrees;
+  degrees.allocateInterleaved(seed_topo.NumNodes());
+
+  NUMAArray<GraphTopologyTypes::Node> old_to_new_map;
+  old_to_new_map.allocateInterleaved(seed_topo.NumNodes());
+
+  PropIndexVec node_prop_indices;
+  node_prop_indices.allocateInterleaved(seed_topo.NumNodes());
+
+  // TODO(amber): given 32-bit node ids, put a check here that
+  // new_to_old.size() < 2^32
+  katana::do_all(
+      katana::iterate(size_t{0}, new_to_old.size()),
+      [&](auto i) {
+        // new_to_old[i] gives old node id
+        old_to_new_map[new_to_old[i]] = i;
+        degrees[i] = seed_topo.OutDegree(new_to_old[i]);
+        node_prop_indices[i] = seed_topo.GetNodePropertyIndex(new_to_old[i]);
+      },
+      katana::no_stats());
+
+  KATANA_LOG_DEBUG_ASSERT(
+      node_sort_todo != katana::RDGTopology::NodeSortKind::kSortedByDegree ||
+      std::is_sorted(degrees.begin(), degrees.end(), std::greater<>()));
+
+  katana::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), degrees.begin());
+
+  GraphTopologyTypes::EdgeDestVec new_dest_vec;
+  new_dest_vec.allocateInterleaved(seed_topo.NumEdges());
+
+  GraphTopologyTypes::PropIndexVec edge_prop_indices;
+  edge_prop_indices.allocateInterleaved(seed_topo.NumEdges());
+
+  katana::do_all(
+      katana::iterate(seed_topo.Nodes()),
+      [&](auto old_src_id) {
+        auto new_srd_id = old_to_new_map[old_src_id];
+        auto new_out_index = new_srd_id > 0 ? degrees[new_srd_id - 1] : 0;
+
+        for (auto e : seed_topo.OutEdges(old_src_id)) {
+          auto new_edge_dest = old_to_new_map[seed_topo.OutEdgeDst(e)];
+          KATANA_LOG_DEBUG_ASSERT(new_edge_dest < seed_topo.NumNodes());
+
+          auto new_edge_id = new_out_index;
+          ++new_out_index;
+          KATANA_LOG_DEBUG_ASSERT(new_out_index <= degrees[new_srd_id]);
+
+          new_dest_vec[new_edge_id] = new_edge_dest;
+
+          // copy over edge_property_index mapping from old edge to new edge
+          edge_prop_indices[new_edge_id] =
+              seed_topo.GetEdgePropertyIndexFromOutEdge(e);
+        }
+        KATANA_LOG_DEBUG_ASSERT(new_out_index == degrees[new_srd_id]);
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::make_shared<ShuffleTopology>(ShuffleTopology{
+      seed_topo.transpose_state(), node_sort_todo, seed_topo.edge_sort_state(),
+      std::move(degrees), std::move(node_prop_indices),
+      std::move(new_dest_vec), std::move(edge_prop_indices)});
+}
+
 std::shared_ptr<katana::ShuffleTopology>
 katana::ShuffleTopology::Make(katana::RDGTopology* rdg_topo) {
   KATANA_LOG_DEBUG_ASSERT(rdg_topo);
@@ -532,10 +660,13 @@ katana::ShuffleTopology::ToRDGTopology() const {
 std::shared_ptr<katana::CondensedTypeIDMap>
 katana::CondensedTypeIDMap::MakeFromEdgeTypes(
     const katana::PropertyGraph* pg) noexcept {
-  TypeIDToIndexMap edge_type_to_index;
-  IndexToTypeIDMap edge_index_to_type;
+  constexpr size_t kNumTypeIDs =
+      size_t{std::numeric_limits<katana::EntityTypeID>::max()} + 1;
 
-  katana::PerThreadStorage<katana::gstl::Set<katana::EntityTypeID>> edgeTypes;
+  // Threads mark the types they see in a shared bitset, which is set
+  // atomically; test first so that common types are not written over and over
+  katana::DynamicBitset seen;
+  seen.resize(kNumTypeIDs);
 
   const auto& topo = pg->topology();
 
@@ -543,32 +674,28 @@ katana::CondensedTypeIDMap::MakeFromEdgeTypes(
       katana::iterate(Edge{0}, topo.NumEdges()),
       [&](const Edge& e) {
         katana::EntityTypeID type = pg->GetTypeOfEdgeFromTopoIndex(e);
-        edgeTypes.getLocal()->insert(type);
+        if (!seen.test(type)) {
+          seen.set(type);
+        }
       },
       katana::no_stats());
 
-  // ordered map
-  std::set<katana::EntityTypeID> mergedSet;
-  for (uint32_t i = 0; i < katana::activeThreads; ++i) {
-    auto& edgeTypesSet = *edgeTypes.getRemote(i);
-    for (auto edgeType : edgeTypesSet) {
-      mergedSet.insert(edgeType);
+  // Indexes are assigned in increasing order of type
+  IndexToTypeIDMap edge_index_to_type;
+  for (size_t type = 0; type < kNumTypeIDs; ++type) {
+    if (seen.test(type)) {
+      edge_index_to_type.emplace_back(static_cast<katana::EntityTypeID>(type));
     }
   }
 
-  // unordered map
-  uint32_t num_edge_types = 0u;
-  for (const auto& edgeType : mergedSet) {
-    edge_type_to_index[edgeType] = num_edge_types++;
-    edge_index_to_type.emplace_back(edgeType);
+  TypeIDToIndexMap edge_type_to_index;
+  if (!edge_index_to_type.empty()) {
+    edge_type_to_index.resize(
+        size_t{edge_index_to_type.back()} + 1, kInvalidIndex);
+  }
+  for (uint32_t i = 0; i < edge_index_to_type.size(); ++i) {
+    edge_type_to_index[edge_index_to_type[i]] = i;
   }
-
-  // TODO(amber): introduce a per-thread-container type that frees memory
-  // correctly
-  katana::on_each([&](unsigned, unsigned) {
-    // free up memory by resetting
-    *edgeTypes.getLocal() = gstl::Set<katana::EntityTypeID>();
-  });
 
   return std::make_shared<CondensedTypeIDMap>(CondensedTypeIDMap{
       std::move(edge_type_to_index), std::move(edge_index_to_type)});
@@ -576,52 +703,113 @@ katana::CondensedTypeIDMap::MakeFromEdgeTypes(
 
 katana::EdgeTypeAwareTopology::~EdgeTypeAwareTopology() = default;
 
-katana::EdgeTypeAwareTopology::AdjIndexVec
-katana::EdgeTypeAwareTopology::CreatePerEdgeTypeAdjacencyIndex(
-    const PropertyGraph& pg, const CondensedTypeIDMap& edge_type_index,
-    const EdgeShuffleTopology& e_topo) noexcept {
-  if (e_topo.empty()) {
-    KATANA_LOG_VASSERT(
-        e_topo.NumEdges() == 0, "Found graph with edges but no nodes");
-    return AdjIndexVec{};
-  }
+void
+katana::EdgeTypeAwareTopology::AllocateTypeRuns() noexcept {
+  katana::ParallelSTL::partial_sum(
+      type_run_indices_.begin(), type_run_indices_.end(),
+      type_run_indices_.begin());
 
-  if (edge_type_index.num_unique_types() == 0) {
-    KATANA_LOG_VASSERT(
-        e_topo.NumEdges() == 0, "Found graph with edges but no edge types");
-    // Graph has some nodes but no edges.
-    return AdjIndexVec{};
-  }
+  size_t num_runs = type_run_indices_.empty() ? 0 : type_run_indices_.back();
+  run_types_.allocateInterleaved(num_runs);
+  run_ends_.allocateInterleaved(num_runs);
+}
 
-  const size_t sz = e_topo.NumNodes() * edge_type_index.num_unique_types();
-  AdjIndexVec adj_indices;
-  adj_indices.allocateInterleaved(sz);
+void
+katana::EdgeTypeAwareTopology::CreateTypeRuns(
+    const PropertyGraph& pg) noexcept {
+  // Since we sort the edges, we must use the
+  // edge_property_index because EdgeShuffleTopology rearranges the edges
+  auto type_of = [&](Edge e) {
+    return pg.GetTypeOfEdgeFromPropertyIndex(
+        GetEdgePropertyIndexFromOutEdge(e));
+  };
 
+  type_run_indices_.allocateInterleaved(NumNodes());
   katana::do_all(
-      katana::iterate(e_topo.Nodes()),
+      katana::iterate(Nodes()),
       [&](Node N) {
-        auto offset = N * edge_type_index.num_unique_types();
-        uint32_t index = 0;
-        for (auto e : e_topo.OutEdges(N)) {
-          // Since we sort the edges, we must use the
-          // edge_property_index because EdgeShuffleTopology rearranges the edges
-          const auto type = pg.GetTypeOfEdgeFromPropertyIndex(
-              e_topo.GetEdgePropertyIndexFromOutEdge(e));
-          while (type != edge_type_index.GetType(index)) {
-            adj_indices[offset + index] = e;
-            index++;
-            KATANA_LOG_DEBUG_ASSERT(index < edge_type_index.num_unique_types());
+        Edge num_runs = 0;
+        auto e_range = OutEdges(N);
+        for (auto e = *e_range.begin(); e < *e_range.end(); ++e) {
+          if (e == *e_range.begin() || type_of(e) != type_of(e - 1)) {
+            ++num_runs;
           }
         }
-        auto e = *e_topo.OutEdges(N).end();
-        while (index < edge_type_index.num_unique_types()) {
-          adj_indices[offset + index] = e;
-          index++;
+        type_run_indices_[N] = num_runs;
+      },
+      katana::no_stats(), katana::steal());
+
+  AllocateTypeRuns();
+
+  katana::do_all(
+      katana::iterate(Nodes()),
+      [&](Node N) {
+        Edge run = FirstTypeRun(N);
+        auto e_range = OutEdges(N);
+        for (auto e = *e_range.begin(); e < *e_range.end(); ++e) {
+          auto type = type_of(e);
+          if (e == *e_range.begin()) {
+            run_types_[run] = type;
+          } else if (type != run_types_[run]) {
+            KATANA_LOG_DEBUG_ASSERT(type > run_types_[run]);
+            run_ends_[run] = e;
+            ++run;
+            run_types_[run] = type;
+          }
         }
+        if (!e_range.empty()) {
+          run_ends_[run] = *e_range.end();
+          ++run;
+        }
+        KATANA_LOG_DEBUG_ASSERT(run == type_run_indices_[N]);
       },
       katana::no_stats(), katana::steal());
+}
+
+void
+katana::EdgeTypeAwareTopology::CreateTypeRunsFromPerTypeAdjIndices(
+    const uint64_t* per_type_adj_indices) noexcept {
+  const size_t num_types = edge_type_index_->num_unique_types();
+  // The edges of type index t of node N end at
+  // per_type_adj_indices[N * num_types + t] and start where the previous
+  // type ends
+  auto type_range = [&](Node N, size_t t) {
+    size_t i = N * num_types + t;
+    return std::make_pair(
+        i == 0 ? Edge{0} : per_type_adj_indices[i - 1],
+        per_type_adj_indices[i]);
+  };
 
-  return adj_indices;
+  type_run_indices_.allocateInterleaved(NumNodes());
+  katana::do_all(
+      katana::iterate(Nodes()),
+      [&](Node N) {
+        Edge num_runs = 0;
+        for (size_t t = 0; t < num_types; ++t) {
+          auto [beg, end] = type_range(N, t);
+          num_runs += end > beg ? 1 : 0;
+        }
+        type_run_indices_[N] = num_runs;
+      },
+      katana::no_stats(), katana::steal());
+
+  AllocateTypeRuns();
+
+  katana::do_all(
+      katana::iterate(Nodes()),
+      [&](Node N) {
+        Edge run = FirstTypeRun(N);
+        for (size_t t = 0; t < num_types; ++t) {
+          auto [beg, end] = type_range(N, t);
+          if (end > beg) {
+            run_types_[run] = edge_type_index_->GetType(t);
+            run_ends_[run] = end;
+            ++run;
+          }
+        }
+        KATANA_LOG_DEBUG_ASSERT(run == type_run_indices_[N]);
+      },
+      katana::no_stats(), katana::steal());
 }
 
 std::shared_ptr<katana::EdgeTypeAwareTopology>
@@ -634,18 +822,38 @@ katana::EdgeTypeAwareTopology::MakeFrom(
 
   KATANA_LOG_DEBUG_ASSERT(e_topo.NumEdges() == pg->topology().NumEdges());
 
-  AdjIndexVec per_type_adj_indices =
-      CreatePerEdgeTypeAdjacencyIndex(*pg, *edge_type_index, e_topo);
-
-  return std::make_shared<EdgeTypeAwareTopology>(EdgeTypeAwareTopology{
-      std::move(e_topo), std::move(edge_type_index),
-      std::move(per_type_adj_indices)});
+  auto topo = std::make_shared<EdgeTypeAwareTopology>(EdgeTypeAwareTopology{
+      std::move(e_topo), std::move(edge_type_index)});
+  topo->CreateTypeRuns(*pg);
+  return topo;
 }
 
 katana::Result<katana::RDGTopology>
-katana::EdgeTypeAwareTopology::ToRDGTopology() const {
+katana::EdgeTypeAwareTopology::ToRDGTopology(
+    AdjIndexVec* per_type_adj_indices) const {
+  KATANA_LOG_DEBUG_ASSERT(per_type_adj_indices);
+  const size_t num_types = edge_type_index_->num_unique_types();
+  per_type_adj_indices->deallocate();
+  per_type_adj_indices->allocateInterleaved(NumNodes() * num_types);
+  katana::do_all(
+      katana::iterate(Nodes()),
+      [&](Node N) {
+        // Types without edges end where the previous type does
+        Edge run = FirstTypeRun(N);
+        Edge end = *OutEdges(N).begin();
+        for (size_t t = 0; t < num_types; ++t) {
+          if (run < type_run_indices_[N] &&
+              run_types_[run] == edge_type_index_->GetType(t)) {
+            end = run_ends_[run];
+            ++run;
+          }
+          (*per_type_adj_indices)[N * num_types + t] = end;
+        }
+      },
+      katana::no_stats(), katana::steal());
+
   katana::RDGTopology topo = KATANA_CHECKED(katana::RDGTopology::Make(
-      per_type_adj_indices_.data(), NumNodes(), Base::DestData(), NumEdges(),
+      per_type_adj_indices->data(), NumNodes(), Base::DestData(), NumEdges(),
       katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology,
       transpose_state(), edge_sort_state(), Base::edge_property_index_data(),
       edge_type_index_->num_unique_types(),
@@ -677,22 +885,453 @@ katana::EdgeTypeAwareTopology::Make(
       "tried to load out of date EdgeTypeAwareTopology; on disk topologies "
       "must be invalidated when updates occur");
 
-  AdjIndexVec per_type_adj_indices;
-  size_t sz = rdg_topo->num_nodes() * edge_type_index->num_unique_types();
-  per_type_adj_indices.allocateInterleaved(sz);
-
-  katana::ParallelSTL::copy(
-      &(rdg_topo->adj_indices()[0]), &(rdg_topo->adj_indices()[sz]),
-      per_type_adj_indices.begin());
+  auto topo = std::make_shared<EdgeTypeAwareTopology>(EdgeTypeAwareTopology{
+      std::move(e_topo), std::move(edge_type_index)});
+  topo->CreateTypeRunsFromPerTypeAdjIndices(rdg_topo->adj_indices());
 
   // Since we copy the data we need out of the RDGTopology into our own arrays,
   // unbind the RDGTopologys file store to save memory.
   auto res = rdg_topo->unbind_file_storage();
   KATANA_LOG_ASSERT(res);
 
-  return std::make_shared<EdgeTypeAwareTopology>(EdgeTypeAwareTopology{
-      std::move(e_topo), std::move(edge_type_index),
-      std::move(per_type_adj_indices)});
+  return topo;
+}
+
+namespace {
+
+/// The memory held by a view
+katana::count_t
+ViewBytes(const katana::EdgeShuffleTopology& topo) {
+  using T = katana::GraphTopologyTypes;
+  return topo.NumNodes() * sizeof(T::Edge) +
+         topo.NumEdges() * (sizeof(T::Node) + sizeof(T::PropertyIndex));
+}
+
+katana::count_t
+ViewBytes(const katana::ShuffleTopology& topo) {
+  using T = katana::GraphTopologyTypes;
+  return ViewBytes(static_cast<const katana::EdgeShuffleTopology&>(topo)) +
+         topo.NumNodes() * sizeof(T::PropertyIndex);
+}
+
+katana::count_t
+ViewBytes(const katana::EdgeTypeAwareTopology& topo) {
+  using T = katana::GraphTopologyTypes;
+  return ViewBytes(static_cast<const katana::EdgeShuffleTopology&>(topo)) +
+         topo.NumNodes() * sizeof(T::Edge) +
+         topo.NumTypeRuns() * (sizeof(katana::EntityTypeID) + sizeof(T::Edge));
+}
+
+double
+SecondsSince(const katana::TimePoint& start) {
+  return katana::UsSince(start) / 1e6;
+}
+
+// Spilled views are written as a header of kSpillHeaderSize words followed
+// by the adjacency indices, the edge property indices, the node property
+// indices (shuffle topologies only) and the destinations.
+constexpr uint64_t kSpillMagic = 0x6b61746176696577;  // "katanaview"
+constexpr size_t kSpillHeaderSize = 7;
+
+bool
+SpillHasNodeMap(katana::RDGTopology::TopologyKind kind) {
+  return kind == katana::RDGTopology::TopologyKind::kShuffleTopology;
+}
+
+katana::Result<void>
+SpillWrite(katana::FileFrame* ff, const void* data, uint64_t nbytes) {
+  if (nbytes == 0) {
+    return katana::ResultSuccess();
+  }
+  if (auto res = ff->Write(data, nbytes); !res.ok()) {
+    return KATANA_ERROR(
+        katana::ArrowToKatana(res.code()), "arrow error: {}", res);
+  }
+  return katana::ResultSuccess();
+}
+
+/// Share topo so that it, and the lease of its users, are held for as long
+/// as the returned pointer is
+template <typename Topo, typename Lease>
+std::shared_ptr<Topo>
+ShareWithLease(std::shared_ptr<Topo> topo, std::shared_ptr<Lease> lease) {
+  Topo* ptr = topo.get();
+  return std::shared_ptr<Topo>(
+      ptr, [topo = std::move(topo), lease = std::move(lease)](Topo*) mutable {
+        lease.reset();
+        topo.reset();
+      });
+}
+
+}  // namespace
+
+katana::PGViewCache::ViewLease::~ViewLease() {
+  if (cached) {
+    ViewManager::Get().ViewsReleased(bytes);
+  }
+}
+
+katana::PGViewCache::PGViewCache() { ViewManager::Get().Register(this); }
+
+katana::PGViewCache::PGViewCache(GraphTopology&& original_topo)
+    : original_topo_(
+          std::make_shared<GraphTopology>(std::move(original_topo))) {
+  ViewManager::Get().Register(this);
+}
+
+katana::PGViewCache::PGViewCache(PGViewCache&& other) noexcept
+    : PGViewCache() {
+  *this = std::move(other);
+}
+
+katana::PGViewCache&
+katana::PGViewCache::operator=(PGViewCache&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  Clear();
+
+  original_topo_ = std::move(other.original_topo_);
+  edge_shuff_topos_ = std::move(other.edge_shuff_topos_);
+  fully_shuff_topos_ = std::move(other.fully_shuff_topos_);
+  edge_type_aware_topos_ = std::move(other.edge_type_aware_topos_);
+  edge_type_id_map_ = std::move(other.edge_type_id_map_);
+  cached_views_ = std::move(other.cached_views_);
+  spilled_views_ = std::move(other.spilled_views_);
+  budget_ = other.budget_;
+  spill_dir_ = std::move(other.spill_dir_);
+  clock_ = other.clock_;
+  stats_ = other.stats_;
+
+  // other no longer owns the views, nor the memory accounted for them
+  other.original_topo_ = std::make_shared<GraphTopology>();
+  other.edge_shuff_topos_.clear();
+  other.fully_shuff_topos_.clear();
+  other.edge_type_aware_topos_.clear();
+  other.cached_views_.clear();
+  other.spilled_views_.clear();
+  other.stats_.bytes = 0;
+
+  return *this;
+}
+
+katana::PGViewCache::~PGViewCache() {
+  Clear();
+  ViewManager::Get().Unregister(this);
+}
+
+void
+katana::PGViewCache::Clear() noexcept {
+  edge_shuff_topos_.clear();
+  fully_shuff_topos_.clear();
+  edge_type_aware_topos_.clear();
+
+  // Views still in use stay active until their users are done with them
+  count_t standby = 0;
+  for (const auto& view : cached_views_) {
+    standby += ReleaseCachedView(view);
+  }
+  if (standby > 0) {
+    ViewManager::Get().ViewsDropped(standby);
+  }
+  cached_views_.clear();
+  stats_.bytes = 0;
+
+  if (!spilled_views_.empty()) {
+    std::unordered_set<std::string> files;
+    for (const auto& spilled : spilled_views_) {
+      files.emplace(spilled.file);
+    }
+    if (auto res = katana::FileDelete(spill_dir_.string(), files); !res) {
+      KATANA_LOG_WARN("could not delete spilled views: {}", res.error());
+    }
+    spilled_views_.clear();
+  }
+}
+
+void
+katana::PGViewCache::SetMemoryBudget(count_t bytes) {
+  budget_ = bytes;
+  EnforceBudget();
+}
+
+template <typename Topo>
+std::shared_ptr<Topo>
+katana::PGViewCache::AddCachedView(
+    std::shared_ptr<Topo> topo, count_t bytes, double build_seconds) {
+  // A new view is active memory already, it becomes standby when released
+  auto lease = std::make_shared<ViewLease>();
+  lease->bytes = bytes;
+
+  // GreedyDual-Size: views that are expensive to rebuild per byte stay
+  // longer, and every eviction ages the views that remain.
+  double cost = std::max(build_seconds, 1e-6);
+  cached_views_.emplace_back(CachedView{
+      topo.get(), bytes, build_seconds,
+      clock_ + cost / std::max<count_t>(bytes, 1), lease});
+  stats_.bytes += bytes;
+
+  std::shared_ptr<Topo> checked_out =
+      ShareWithLease(std::move(topo), std::move(lease));
+  EnforceBudget();
+  return checked_out;
+}
+
+void
+katana::PGViewCache::TouchCachedView(const GraphTopology* topo) {
+  for (auto& view : cached_views_) {
+    if (view.topo == topo) {
+      double cost = std::max(view.build_seconds, 1e-6);
+      view.priority = clock_ + cost / std::max<count_t>(view.bytes, 1);
+      return;
+    }
+  }
+}
+
+template <typename Topo>
+std::shared_ptr<Topo>
+katana::PGViewCache::CheckOut(std::shared_ptr<Topo> topo) {
+  auto it = std::find_if(
+      cached_views_.begin(), cached_views_.end(),
+      [&](const CachedView& view) { return view.topo == topo.get(); });
+  if (it == cached_views_.end()) {
+    return topo;
+  }
+
+  std::shared_ptr<ViewLease> lease = it->lease.lock();
+  if (!lease) {
+    lease = std::make_shared<ViewLease>();
+    lease->bytes = it->bytes;
+    it->lease = lease;
+    // May reclaim memory, which evicts other views and moves it
+    ViewManager::Get().ViewsCheckedOut(lease->bytes);
+  }
+  return ShareWithLease(std::move(topo), std::move(lease));
+}
+
+void
+katana::PGViewCache::RemoveCachedView(const GraphTopology* topo) {
+  auto it = std::find_if(
+      cached_views_.begin(), cached_views_.end(),
+      [&](const CachedView& view) { return view.topo == topo; });
+  if (it == cached_views_.end()) {
+    return;
+  }
+  stats_.bytes -= it->bytes;
+  count_t standby = ReleaseCachedView(*it);
+  cached_views_.erase(it);
+  if (standby > 0) {
+    ViewManager::Get().ViewsDropped(standby);
+  }
+}
+
+katana::count_t
+katana::PGViewCache::ReleaseCachedView(const CachedView& view) {
+  if (std::shared_ptr<ViewLease> lease = view.lease.lock()) {
+    lease->cached = false;
+    return 0;
+  }
+  return view.bytes;
+}
+
+void
+katana::PGViewCache::EnforceBudget() {
+  while (budget_ > 0 && stats_.bytes > budget_) {
+    if (EvictOne() == 0) {
+      // everything left is in use
+      return;
+    }
+  }
+}
+
+katana::count_t
+katana::PGViewCache::EvictViews(count_t goal) {
+  count_t evicted = 0;
+  while (evicted < goal) {
+    count_t bytes = EvictOne();
+    if (bytes == 0) {
+      break;
+    }
+    evicted += bytes;
+  }
+  return evicted;
+}
+
+katana::count_t
+katana::PGViewCache::EvictOne() {
+  // A view is in use if anything but the cache refers to it
+  auto find_unused = [](auto& topos, const GraphTopology* topo) {
+    return std::find_if(topos.begin(), topos.end(), [&](const auto& ptr) {
+      return ptr.get() == topo && ptr.use_count() == 1;
+    });
+  };
+  auto is_unused = [&](const GraphTopology* topo) {
+    return find_unused(edge_shuff_topos_, topo) != edge_shuff_topos_.end() ||
+           find_unused(fully_shuff_topos_, topo) != fully_shuff_topos_.end() ||
+           find_unused(edge_type_aware_topos_, topo) !=
+               edge_type_aware_topos_.end();
+  };
+
+  auto victim = cached_views_.end();
+  for (auto it = cached_views_.begin(); it != cached_views_.end(); ++it) {
+    if ((victim == cached_views_.end() || it->priority < victim->priority) &&
+        is_unused(it->topo)) {
+      victim = it;
+    }
+  }
+  if (victim == cached_views_.end()) {
+    return 0;
+  }
+  const GraphTopology* topo = victim->topo;
+  count_t bytes = victim->bytes;
+  clock_ = victim->priority;
+
+  // Take the view out of the cache, but keep it until it is spilled
+  std::shared_ptr<EdgeShuffleTopology> evicted;
+  std::shared_ptr<ShuffleTopology> evicted_shuffle;
+  if (auto it = find_unused(edge_shuff_topos_, topo);
+      it != edge_shuff_topos_.end()) {
+    evicted = std::move(*it);
+    edge_shuff_topos_.erase(it);
+  } else if (auto it = find_unused(fully_shuff_topos_, topo);
+             it != fully_shuff_topos_.end()) {
+    evicted_shuffle = std::move(*it);
+    fully_shuff_topos_.erase(it);
+  } else if (auto it = find_unused(edge_type_aware_topos_, topo);
+             it != edge_type_aware_topos_.end()) {
+    evicted = std::move(*it);
+    edge_type_aware_topos_.erase(it);
+  }
+
+  if (!spill_dir_.empty()) {
+    // Edge type aware views are spilled as their edge shuffle topology,
+    // which is most of their size and what they are rebuilt from.
+    auto spill = [&](const auto& view) -> katana::Result<void> {
+      katana::RDGTopology rdg_topo = KATANA_CHECKED(view.ToRDGTopology());
+      return Spill(rdg_topo);
+    };
+    auto res = evicted_shuffle ? spill(*evicted_shuffle) : spill(*evicted);
+    if (res) {
+      stats_.spills += 1;
+    } else {
+      KATANA_LOG_WARN("could not spill view, dropping it: {}", res.error());
+    }
+  }
+
+  stats_.evictions += 1;
+  RemoveCachedView(topo);
+  return bytes;
+}
+
+katana::Result<void>
+katana::PGViewCache::Spill(const RDGTopology& rdg_topo) {
+  katana::URI path = spill_dir_.RandFile("view");
+
+  uint64_t num_nodes = rdg_topo.num_nodes();
+  uint64_t num_edges = rdg_topo.num_edges();
+  bool has_node_map = SpillHasNodeMap(rdg_topo.topology_state());
+  uint64_t header[kSpillHeaderSize] = {
+      kSpillMagic,
+      static_cast<uint64_t>(rdg_topo.topology_state()),
+      static_cast<uint64_t>(rdg_topo.transpose_state()),
+      static_cast<uint64_t>(rdg_topo.edge_sort_state()),
+      static_cast<uint64_t>(rdg_topo.node_sort_state()),
+      num_nodes,
+      num_edges,
+  };
+
+  auto ff = std::make_unique<katana::FileFrame>();
+  KATANA_CHECKED(ff->Init());
+  KATANA_CHECKED(SpillWrite(ff.get(), header, sizeof(header)));
+  KATANA_CHECKED(SpillWrite(
+      ff.get(), rdg_topo.adj_indices(), num_nodes * sizeof(uint64_t)));
+  KATANA_CHECKED(SpillWrite(
+      ff.get(), rdg_topo.edge_index_to_property_index_map(),
+      num_edges * sizeof(uint64_t)));
+  if (has_node_map) {
+    KATANA_CHECKED(SpillWrite(
+        ff.get(), rdg_topo.node_index_to_property_index_map(),
+        num_nodes * sizeof(uint64_t)));
+  }
+  KATANA_CHECKED(
+      SpillWrite(ff.get(), rdg_topo.dests(), num_edges * sizeof(uint32_t)));
+  ff->Bind(path.string());
+  KATANA_CHECKED(ff->Persist());
+
+  spilled_views_.emplace_back(SpilledView{
+      path.BaseName(), rdg_topo.topology_state(), rdg_topo.transpose_state(),
+      rdg_topo.edge_sort_state(), rdg_topo.node_sort_state()});
+  return katana::ResultSuccess();
+}
+
+template <typename Topo>
+std::shared_ptr<Topo>
+katana::PGViewCache::ReloadSpilled(
+    const std::function<bool(const SpilledView&)>& pred) {
+  auto it = std::find_if(spilled_views_.begin(), spilled_views_.end(), pred);
+  if (it == spilled_views_.end()) {
+    return nullptr;
+  }
+  SpilledView spilled = std::move(*it);
+  spilled_views_.erase(it);
+
+  auto load = [&]() -> katana::Result<std::shared_ptr<Topo>> {
+    katana::FileView fv;
+    KATANA_CHECKED(fv.Bind(spill_dir_.Join(spilled.file).string(), true));
+    if (fv.size() < kSpillHeaderSize * sizeof(uint64_t) ||
+        fv.ptr<uint64_t>()[0] != kSpillMagic) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "{} is not a spilled view",
+          spilled.file);
+    }
+    const uint64_t* header = fv.ptr<uint64_t>();
+    uint64_t num_nodes = header[5];
+    uint64_t num_edges = header[6];
+    bool has_node_map = SpillHasNodeMap(spilled.topology_kind);
+
+    const uint64_t* adj_indices = header + kSpillHeaderSize;
+    const uint64_t* edge_map = adj_indices + num_nodes;
+    const uint64_t* node_map = edge_map + num_edges;
+    const uint32_t* dests = reinterpret_cast<const uint32_t*>(
+        node_map + (has_node_map ? num_nodes : 0));
+    uint64_t expected =
+        (kSpillHeaderSize + num_nodes * (has_node_map ? 2 : 1) + num_edges) *
+            sizeof(uint64_t) +
+        num_edges * sizeof(uint32_t);
+    if (fv.size() != expected) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "spilled view {} has {} bytes, expected {}", spilled.file, fv.size(),
+          expected);
+    }
+
+    katana::RDGTopology rdg_topo = KATANA_CHECKED(
+        has_node_map
+            ? katana::RDGTopology::Make(
+                  adj_indices, num_nodes, dests, num_edges,
+                  spilled.topology_kind, spilled.transpose_kind,
+                  spilled.edge_sort_kind, spilled.node_sort_kind, edge_map,
+                  node_map)
+            : katana::RDGTopology::Make(
+                  adj_indices, num_nodes, dests, num_edges,
+                  spilled.topology_kind, spilled.transpose_kind,
+                  spilled.edge_sort_kind, edge_map));
+    // Make copies out of the file, so it can go right after
+    std::shared_ptr<Topo> topo = Topo::Make(&rdg_topo);
+    KATANA_CHECKED(fv.Unbind());
+    return topo;
+  };
+
+  auto res = load();
+  if (auto del = katana::FileDelete(spill_dir_.string(), {spilled.file});
+      !del) {
+    KATANA_LOG_WARN("could not delete spilled view: {}", del.error());
+  }
+  if (!res) {
+    KATANA_LOG_WARN("could not reload spilled view: {}", res.error());
+    return nullptr;
+  }
+  return res.value();
 }
 
 const katana::GraphTopology&
@@ -723,9 +1362,7 @@ void
 katana::PGViewCache::DropAllTopologies() noexcept {
   original_topo_ = std::make_shared<katana::GraphTopology>();
 
-  edge_shuff_topos_.clear();
-  fully_shuff_topos_.clear();
-  edge_type_aware_topos_.clear();
+  Clear();
   edge_type_id_map_.reset();
 }
 
@@ -768,6 +1405,11 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopoImpl(
     katana::PropertyGraph* pg,
     const katana::RDGTopology::TransposeKind& tpose_kind,
     const katana::RDGTopology::EdgeSortKind& sort_kind, bool pop) noexcept {
+  // A popped topology is the seed of a view that the caller builds and
+  // counts, so it is not counted here
+  PGViewCacheStats popped_stats;
+  PGViewCacheStats& stats = pop ? popped_stats : stats_;
+
   // Try to find a matching topology in the cache.
   auto pred = [&](const auto& topo_ptr) {
     return topo_ptr->is_valid() && topo_ptr->has_transpose_state(tpose_kind) &&
@@ -778,12 +1420,15 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopoImpl(
 
   if (it != edge_shuff_topos_.end()) {
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
+    stats.hits += 1;
     if (pop) {
       auto topo = *it;
       edge_shuff_topos_.erase(it);
+      RemoveCachedView(topo.get());
       return topo;
     } else {
-      return *it;
+      TouchCachedView(it->get());
+      return CheckOut(*it);
     }
   }
 
@@ -793,26 +1438,52 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopoImpl(
         edge_type_aware_topos_.begin(), edge_type_aware_topos_.end(), pred);
     if (it != edge_type_aware_topos_.end()) {
       KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-      return *it;
+      stats.hits += 1;
+      TouchCachedView(it->get());
+      return CheckOut(*it);
     }
   }
 
-  // No matching topology in cache, see if we have it in storage
-  katana::RDGTopology shadow = katana::RDGTopology::MakeShadow(
-      katana::RDGTopology::TopologyKind::kEdgeShuffleTopology, tpose_kind,
-      sort_kind, katana::RDGTopology::NodeSortKind::kAny);
+  stats.misses += 1;
+  auto start = katana::Now();
+
+  // No matching topology in cache, see if we spilled it
+  std::shared_ptr<EdgeShuffleTopology> new_topo =
+      ReloadSpilled<EdgeShuffleTopology>([&](const SpilledView& spilled) {
+        return spilled.topology_kind ==
+                   katana::RDGTopology::TopologyKind::kEdgeShuffleTopology &&
+               spilled.transpose_kind == tpose_kind &&
+               (sort_kind == katana::RDGTopology::EdgeSortKind::kAny ||
+                spilled.edge_sort_kind == sort_kind);
+      });
+
+  if (new_topo) {
+    stats.reloads += 1;
+  } else {
+    // or if we have it in storage
+    katana::RDGTopology shadow = katana::RDGTopology::MakeShadow(
+        katana::RDGTopology::TopologyKind::kEdgeShuffleTopology, tpose_kind,
+        sort_kind, katana::RDGTopology::NodeSortKind::kAny);
 
-  auto res = pg->LoadTopology(std::move(shadow));
-  auto new_topo = (!res) ? EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind)
-                         : EdgeShuffleTopology::Make(res.value());
+    auto res = pg->LoadTopology(std::move(shadow));
+    if (res) {
+      new_topo = EdgeShuffleTopology::Make(res.value());
+      stats.reloads += 1;
+    } else {
+      new_topo = EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind);
+      stats.builds += 1;
+    }
+  }
   KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, new_topo.get()));
 
+  double seconds = SecondsSince(start);
+  stats.build_seconds += seconds;
+
   if (pop) {
     return new_topo;
-  } else {
-    edge_shuff_topos_.emplace_back(std::move(new_topo));
-    return edge_shuff_topos_.back();
   }
+  edge_shuff_topos_.emplace_back(new_topo);
+  return AddCachedView(new_topo, ViewBytes(*new_topo), seconds);
 }
 
 std::shared_ptr<katana::ShuffleTopology>
@@ -833,10 +1504,30 @@ katana::PGViewCache::BuildOrGetShuffTopo(
 
   if (it != fully_shuff_topos_.end()) {
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-    return *it;
-  } else {
-    // no matching topology in cache, see if we have it in storage
+    stats_.hits += 1;
+    TouchCachedView(it->get());
+    return CheckOut(*it);
+  }
 
+  stats_.misses += 1;
+  auto start = katana::Now();
+
+  // no matching topology in cache, see if we spilled it
+  std::shared_ptr<ShuffleTopology> new_topo =
+      ReloadSpilled<ShuffleTopology>([&](const SpilledView& spilled) {
+        return spilled.topology_kind ==
+                   katana::RDGTopology::TopologyKind::kShuffleTopology &&
+               spilled.transpose_kind == tpose_kind &&
+               (edge_sort_todo == katana::RDGTopology::EdgeSortKind::kAny ||
+                spilled.edge_sort_kind == edge_sort_todo) &&
+               (node_sort_todo == katana::RDGTopology::NodeSortKind::kAny ||
+                spilled.node_sort_kind == node_sort_todo);
+      });
+
+  if (new_topo) {
+    stats_.reloads += 1;
+  } else {
+    // or if we have it in storage
     katana::RDGTopology shadow = katana::RDGTopology::MakeShadow(
         katana::RDGTopology::TopologyKind::kShuffleTopology, tpose_kind,
         edge_sort_todo, node_sort_todo);
@@ -853,18 +1544,33 @@ katana::PGViewCache::BuildOrGetShuffTopo(
           pg, tpose_kind, katana::RDGTopology::EdgeSortKind::kAny);
       KATANA_LOG_DEBUG_ASSERT(e_topo->has_transpose_state(tpose_kind));
 
-      fully_shuff_topos_.emplace_back(ShuffleTopology::MakeFromTopo(
-          pg, *e_topo, node_sort_todo, edge_sort_todo));
-
+      new_topo = ShuffleTopology::MakeFromTopo(
+          pg, *e_topo, node_sort_todo, edge_sort_todo);
+      stats_.builds += 1;
     } else {
       // found matching topology in storage
       katana::RDGTopology* topo = res.value();
-      fully_shuff_topos_.emplace_back(katana::ShuffleTopology::Make(topo));
+      new_topo = katana::ShuffleTopology::Make(topo);
+      stats_.reloads += 1;
     }
-
-    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, fully_shuff_topos_.back().get()));
-    return fully_shuff_topos_.back();
   }
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, new_topo.get()));
+
+  double seconds = SecondsSince(start);
+  stats_.build_seconds += seconds;
+
+  fully_shuff_topos_.emplace_back(new_topo);
+  return AddCachedView(new_topo, ViewBytes(*new_topo), seconds);
+}
+
+std::shared_ptr<katana::ShuffleTopology>
+katana::PGViewCache::BuildOrGetReorderedTopo(
+    katana::PropertyGraph* pg,
+    const katana::RDGTopology::NodeSortKind& kind) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(katana::IsNodeReorderingKind(kind));
+  return BuildOrGetShuffTopo(
+      pg, katana::RDGTopology::TransposeKind::kNo, kind,
+      katana::RDGTopology::EdgeSortKind::kSortedByDestID);
 }
 
 std::shared_ptr<katana::EdgeTypeAwareTopology>
@@ -880,49 +1586,64 @@ katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
 
   if (it != edge_type_aware_topos_.end()) {
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
-    return *it;
-  } else {
-    // no matching topology in cache, see if we have it in storage
-    katana::RDGTopology shadow = katana::RDGTopology::MakeShadow(
-        katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology, tpose_kind,
-        katana::RDGTopology::EdgeSortKind::kSortedByEdgeType,
-        katana::RDGTopology::NodeSortKind::kAny);
-    auto res = pg->LoadTopology(std::move(shadow));
-
-    // In either generation, or loading, the EdgeTypeAwareTopology depends on an EdgeShuffleTopology.
-    // This call does NOT cache the resulting edge shuffled topology.
-    auto sorted_topo = PopEdgeShuffTopo(
-        pg, tpose_kind, katana::RDGTopology::EdgeSortKind::kSortedByEdgeType);
+    stats_.hits += 1;
+    TouchCachedView(it->get());
+    return CheckOut(*it);
+  }
 
-    // There are two use cases for the EdgeTypeIndex, either we:
-    // Are generating an EdgeTypeAwareTopology, and need the EdgeTypeIndex
-    // Are loading an EdgeTypeAwareTopology from storage, and need to confirm
-    // the EdgeTypeIndex in storage matches the one we have.
-    // If it doesn't match, then the EdgeTypeAwareTopology on storage is out of date and cannot be used
-    auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
+  stats_.misses += 1;
+  auto start = katana::Now();
 
-    if (res) {
-      // found matching topology in storage
-      katana::RDGTopology* rdg_topo = res.value();
+  // no matching topology in cache, see if we have it in storage
+  katana::RDGTopology shadow = katana::RDGTopology::MakeShadow(
+      katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology, tpose_kind,
+      katana::RDGTopology::EdgeSortKind::kSortedByEdgeType,
+      katana::RDGTopology::NodeSortKind::kAny);
+  auto res = pg->LoadTopology(std::move(shadow));
 
-      edge_type_aware_topos_.emplace_back(katana::EdgeTypeAwareTopology::Make(
-          rdg_topo, std::move(edge_type_index), std::move(*sorted_topo)));
-    } else {
-      // no matching topology in cache or storage, generate it
-      edge_type_aware_topos_.emplace_back(EdgeTypeAwareTopology::MakeFrom(
-          pg, std::move(edge_type_index), std::move(*sorted_topo)));
-    }
+  // In either generation, or loading, the EdgeTypeAwareTopology depends on an EdgeShuffleTopology.
+  // This call does NOT cache the resulting edge shuffled topology. If this
+  // view was evicted before, it reloads the edge shuffled topology spilled.
+  auto sorted_topo = PopEdgeShuffTopo(
+      pg, tpose_kind, katana::RDGTopology::EdgeSortKind::kSortedByEdgeType);
+
+  // There are two use cases for the EdgeTypeIndex, either we:
+  // Are generating an EdgeTypeAwareTopology, and need the EdgeTypeIndex
+  // Are loading an EdgeTypeAwareTopology from storage, and need to confirm
+  // the EdgeTypeIndex in storage matches the one we have.
+  // If it doesn't match, then the EdgeTypeAwareTopology on storage is out of date and cannot be used
+  auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
+
+  std::shared_ptr<EdgeTypeAwareTopology> new_topo;
+  if (res) {
+    // found matching topology in storage
+    katana::RDGTopology* rdg_topo = res.value();
+
+    new_topo = katana::EdgeTypeAwareTopology::Make(
+        rdg_topo, std::move(edge_type_index), std::move(*sorted_topo));
+    stats_.reloads += 1;
+  } else {
+    // no matching topology in cache or storage, generate it
+    new_topo = EdgeTypeAwareTopology::MakeFrom(
+        pg, std::move(edge_type_index), std::move(*sorted_topo));
+    stats_.builds += 1;
+  }
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, new_topo.get()));
 
-    KATANA_LOG_DEBUG_ASSERT(
-        CheckTopology(pg, edge_type_aware_topos_.back().get()));
+  double seconds = SecondsSince(start);
+  stats_.build_seconds += seconds;
 
-    return edge_type_aware_topos_.back();
-  }
+  edge_type_aware_topos_.emplace_back(new_topo);
+  return AddCachedView(new_topo, ViewBytes(*new_topo), seconds);
 }
 
 katana::Result<std::vector<katana::RDGTopology>>
-katana::PGViewCache::ToRDGTopology() {
+katana::PGViewCache::ToRDGTopology(
+    std::vector<GraphTopology::AdjIndexVec>* buffers) {
   std::vector<katana::RDGTopology> rdg_topos;
+  // Sized upfront so that the buffers do not move once referred to
+  buffers->clear();
+  buffers->resize(edge_type_aware_topos_.size());
 
   for (size_t i = 0; i < edge_shuff_topos_.size(); i++) {
     katana::RDGTopology topo =
@@ -937,8 +1658,8 @@ katana::PGViewCache::ToRDGTopology() {
   }
 
   for (size_t i = 0; i < edge_type_aware_topos_.size(); i++) {
-    katana::RDGTopology topo =
-        KATANA_CHECKED(edge_type_aware_topos_[i]->ToRDGTopology());
+    katana::RDGTopology topo = KATANA_CHECKED(
+        edge_type_aware_topos_[i]->ToRDGTopology(&buffers->at(i)));
     rdg_topos.emplace_back(std::move(topo));
   }
 
@@ -1,12 +1,153 @@
 #include "katana/Properties.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include <arrow/buffer.h>
+#include <arrow/util/bit_util.h>
+
+#include "katana/Loops.h"
+#include "katana/Reduction.h"
 #include "katana/Result.h"
 
+namespace {
+
+/// Bytes zeroed by a task of AllocateZeroedBuffer; a multiple of the page size
+constexpr int64_t kZeroBlockBytes = int64_t{1} << 16;
+
+}  // namespace
+
 namespace katana {
 
+Result<std::shared_ptr<arrow::Buffer>>
+internal::AllocateZeroedBuffer(int64_t num_bytes) {
+  std::shared_ptr<arrow::Buffer> buffer =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_bytes));
+
+  uint8_t* data = buffer->mutable_data();
+  int64_t num_blocks = (num_bytes + kZeroBlockBytes - 1) / kZeroBlockBytes;
+  do_all(
+      iterate(int64_t{0}, num_blocks),
+      [&](int64_t block) {
+        int64_t begin = block * kZeroBlockBytes;
+        int64_t end = std::min(begin + kZeroBlockBytes, num_bytes);
+        std::memset(data + begin, 0, end - begin);
+      },
+      no_stats());
+
+  return buffer;
+}
+
+Result<std::shared_ptr<arrow::Array>>
+internal::AllocateFixedWidthArray(
+    const std::shared_ptr<arrow::DataType>& type, int64_t num_rows) {
+  const auto* fixed_width =
+      dynamic_cast<const arrow::FixedWidthType*>(type.get());
+  if (fixed_width == nullptr) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "not a fixed width type: {}",
+        type->ToString());
+  }
+
+  auto values = KATANA_CHECKED(AllocateZeroedBuffer(
+      arrow::BitUtil::BytesForBits(num_rows * fixed_width->bit_width())));
+
+  // No validity bitmap: every value is valid
+  return arrow::MakeArray(
+      arrow::ArrayData::Make(type, num_rows, {nullptr, values}, 0));
+}
+
+Result<std::shared_ptr<arrow::Array>>
+internal::AllocateUniformListArray(
+    const std::shared_ptr<arrow::DataType>& value_type, int64_t num_rows,
+    int64_t list_size) {
+  auto values =
+      KATANA_CHECKED(AllocateFixedWidthArray(value_type, num_rows * list_size));
+
+  std::shared_ptr<arrow::Buffer> offsets = KATANA_CHECKED(
+      arrow::AllocateBuffer((num_rows + 1) * sizeof(int64_t)));
+  auto* offsets_data = reinterpret_cast<int64_t*>(offsets->mutable_data());
+  do_all(
+      iterate(int64_t{0}, num_rows + 1),
+      [&](int64_t i) { offsets_data[i] = i * list_size; }, no_stats());
+
+  return arrow::MakeArray(arrow::ArrayData::Make(
+      arrow::large_list(value_type), num_rows, {nullptr, offsets},
+      {values->data()}, 0));
+}
+
+int64_t
+internal::PackBytesToBitmap(
+    const uint8_t* bytes, int64_t num_bytes, uint8_t* bitmap) {
+  // Each task packs 64 bytes into 8 whole bytes of the bitmap, so that tasks
+  // never write the same byte
+  int64_t num_words = (num_bytes + 63) / 64;
+
+  GAccumulator<int64_t> num_zeros;
+  do_all(
+      iterate(int64_t{0}, num_words),
+      [&](int64_t word) {
+        int64_t begin = word * 64;
+        int64_t end = std::min(begin + 64, num_bytes);
+        uint64_t packed = 0;
+        for (int64_t i = begin; i < end; ++i) {
+          packed |= static_cast<uint64_t>(bytes[i] != 0) << (i - begin);
+        }
+        for (int64_t i = 0; i * 8 < end - begin; ++i) {
+          bitmap[word * 8 + i] = static_cast<uint8_t>(packed >> (i * 8));
+        }
+        num_zeros += (end - begin) - __builtin_popcountll(packed);
+      },
+      steal(), no_stats());
+
+  return num_zeros.reduce();
+}
+
 Result<BooleanPropertyReadOnlyView>
 BooleanPropertyReadOnlyView::Make(const arrow::BooleanArray& array) {
   return BooleanPropertyReadOnlyView(array);
 }
 
+Result<DictionaryStringPropertyReadOnlyView>
+DictionaryStringPropertyReadOnlyView::Make(
+    const arrow::DictionaryArray& array) {
+  const auto& type = static_cast<const arrow::DictionaryType&>(*array.type());
+  if (type.index_type()->id() != arrow::Type::INT32 ||
+      type.value_type()->id() != arrow::Type::LARGE_STRING) {
+    return KATANA_ERROR(
+        ErrorCode::TypeError,
+        "expected int32 codes into large strings, given {}",
+        type.ToString());
+  }
+  DictionaryStringPropertyReadOnlyView view(
+      array, array.indices()->data()->GetValues<code_type>(1),
+      std::static_pointer_cast<arrow::LargeStringArray>(array.dictionary()));
+  for (size_t code = 1; code < view.num_codes(); ++code) {
+    if (!(view.CodeValue(code - 1) < view.CodeValue(code))) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "dictionary is not sorted; see DictionaryEncodeStrings");
+    }
+  }
+  return view;
+}
+
+DictionaryStringPropertyReadOnlyView::code_type
+DictionaryStringPropertyReadOnlyView::FindCode(std::string_view value) const {
+  size_t first = 0;
+  size_t last = num_codes();
+  while (first < last) {
+    size_t mid = first + (last - first) / 2;
+    if (CodeValue(mid) < value) {
+      first = mid + 1;
+    } else {
+      last = mid;
+    }
+  }
+  if (first == num_codes() || CodeValue(first) != value) {
+    return -1;
+  }
+  return static_cast<code_type>(first);
+}
+
 }  // namespace katana
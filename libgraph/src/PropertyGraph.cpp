@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -10,8 +11,10 @@
 #include <arrow/array.h>
 
 #include "katana/ArrowInterchange.h"
+#include "katana/DictionaryEncoding.h"
 #include "katana/ErrorCode.h"
 #include "katana/FileFrame.h"
+#include "katana/GraphReordering.h"
 #include "katana/GraphTopology.h"
 #include "katana/Iterators.h"
 #include "katana/Logging.h"
@@ -20,6 +23,7 @@
 #include "katana/PerThreadStorage.h"
 #include "katana/Platform.h"
 #include "katana/Properties.h"
+#include "katana/PropertyPredicate.h"
 #include "katana/RDG.h"
 #include "katana/RDGManifest.h"
 #include "katana/RDGPrefix.h"
@@ -149,6 +153,27 @@ FillBitMask(
   });
 }
 
+/// Set the bit of mask for each of the num_entities entity_types that is one
+/// of the types, 64 entities at a time
+void
+FillEntityTypeMask(
+    const katana::SetOfEntityTypeIDs& types,
+    const katana::EntityTypeID* entity_types, size_t num_entities,
+    katana::DynamicBitset* mask) {
+  constexpr size_t kBitsPerWord = katana::DynamicBitset::kNumBitsInUint64;
+  mask->resize(num_entities);
+  auto& words = mask->get_vec();
+  katana::do_all(
+      katana::iterate(size_t{0}, words.size()),
+      [&](size_t w) {
+        size_t begin = w * kBitsPerWord;
+        words[w] = katana::EntityTypeManager::MatchEntityTypes(
+            types, entity_types + begin,
+            std::min(kBitsPerWord, num_entities - begin));
+      },
+      katana::no_stats());
+}
+
 }  // namespace
 
 katana::PropertyGraph::~PropertyGraph() = default;
@@ -383,10 +408,43 @@ katana::Result<std::unique_ptr<katana::PropertyGraph>>
 katana::PropertyGraph::MakeProjectedGraph(
     PropertyGraph& pg, std::optional<SetOfEntityTypeIDs> node_types,
     std::optional<SetOfEntityTypeIDs> edge_types) {
+  std::optional<DynamicBitset> node_mask;
+  if (node_types) {
+    node_mask = KATANA_CHECKED(
+        PropertyPredicate::HasType(std::move(node_types.value()))
+            .EvaluateNodes(pg));
+  }
+  std::optional<DynamicBitset> edge_mask;
+  if (edge_types) {
+    edge_mask = KATANA_CHECKED(
+        PropertyPredicate::HasType(std::move(edge_types.value()))
+            .EvaluateEdges(pg));
+  }
+  return MakeProjectedGraph(
+      pg, node_mask ? &node_mask.value() : nullptr,
+      edge_mask ? &edge_mask.value() : nullptr);
+}
+
+/// Make a projected graph from a property graph. Shares state with
+/// the original graph.
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::PropertyGraph::MakeProjectedGraph(
+    PropertyGraph& pg, const DynamicBitset* node_mask,
+    const DynamicBitset* edge_mask) {
   const auto& topology = pg.topology();
   if (topology.empty()) {
     return MakeEmptyProjectedGraph(pg, katana::DynamicBitset{});
   }
+  if (node_mask && node_mask->size() != pg.NumOriginalNodes()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "node mask has {} bits, expected {}",
+        node_mask->size(), pg.NumOriginalNodes());
+  }
+  if (edge_mask && edge_mask->size() != pg.NumOriginalEdges()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "edge mask has {} bits, expected {}",
+        edge_mask->size(), pg.NumOriginalEdges());
+  }
 
   // calculate number of new nodes
   uint32_t num_new_nodes = 0;
@@ -398,7 +456,7 @@ katana::PropertyGraph::MakeProjectedGraph(
   NUMAArray<Node> original_to_projected_nodes_mapping;
   original_to_projected_nodes_mapping.allocateInterleaved(topology.NumNodes());
 
-  if (!node_types) {
+  if (!node_mask) {
     num_new_nodes = topology.NumNodes();
     // set all nodes
     katana::do_all(katana::iterate(topology.Nodes()), [&](auto src) {
@@ -406,22 +464,17 @@ katana::PropertyGraph::MakeProjectedGraph(
       original_to_projected_nodes_mapping[src] = 1;
     });
   } else {
-    katana::ParallelSTL::fill(
-        original_to_projected_nodes_mapping.begin(),
-        original_to_projected_nodes_mapping.end(), Node{0});
-
     katana::GAccumulator<uint32_t> accum_num_new_nodes;
 
     katana::do_all(katana::iterate(topology.Nodes()), [&](auto src) {
-      for (auto type : node_types.value()) {
-        if (pg.DoesNodeHaveType(src, type)) {
-          accum_num_new_nodes += 1;
-          bitset_nodes.set(src);
-          // this sets the corresponding entry in the array to 1
-          // will perform a prefix sum on this array later on
-          original_to_projected_nodes_mapping[src] = 1;
-          return;
-        }
+      // this sets the corresponding entry in the array to 1
+      // will perform a prefix sum on this array later on
+      if (node_mask->test(pg.GetNodePropertyIndex(src))) {
+        accum_num_new_nodes += 1;
+        bitset_nodes.set(src);
+        original_to_projected_nodes_mapping[src] = 1;
+      } else {
+        original_to_projected_nodes_mapping[src] = 0;
       }
     });
     num_new_nodes = accum_num_new_nodes.reduce();
@@ -469,7 +522,7 @@ katana::PropertyGraph::MakeProjectedGraph(
   // initializes the edge-index array to all zeros
   katana::ParallelSTL::fill(out_indices.begin(), out_indices.end(), Edge{0});
 
-  if (!edge_types) {
+  if (!edge_mask) {
     katana::GAccumulator<uint32_t> accum_num_new_edges;
     // set all edges incident to projected nodes
     katana::do_all(
@@ -498,15 +551,11 @@ katana::PropertyGraph::MakeProjectedGraph(
 
           for (Edge e : topology.OutEdges(old_src)) {
             auto dest = topology.OutEdgeDst(e);
-            if (bitset_nodes.test(dest)) {
-              for (auto type : edge_types.value()) {
-                if (pg.DoesEdgeHaveTypeFromTopoIndex(e, type)) {
-                  accum_num_new_edges += 1;
-                  bitset_edges.set(e);
-                  out_indices[src] += 1;
-                  break;
-                }
-              }
+            if (bitset_nodes.test(dest) &&
+                edge_mask->test(pg.GetEdgePropertyIndexFromOutEdge(e))) {
+              accum_num_new_edges += 1;
+              bitset_edges.set(e);
+              out_indices[src] += 1;
             }
           }
         },
@@ -591,6 +640,131 @@ katana::PropertyGraph::MakeProjectedGraph(
       std::move(edge_bitmask)));
 }
 
+katana::Result<katana::PropertyGraphViews::Masked>
+katana::PropertyGraph::BuildMaskedView(
+    const DynamicBitset* node_mask, const DynamicBitset* edge_mask) {
+  if (node_mask && node_mask->size() != NumOriginalNodes()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "node mask has {} bits, expected {}",
+        node_mask->size(), NumOriginalNodes());
+  }
+  if (edge_mask && edge_mask->size() != NumOriginalEdges()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "edge mask has {} bits, expected {}",
+        edge_mask->size(), NumOriginalEdges());
+  }
+
+  std::shared_ptr<const GraphTopology> topo =
+      pg_view_cache_.GetDefaultTopology();
+
+  // The view masks are indexed by node and edge ID, so that iterators can
+  // scan them a word at a time
+  auto kept_nodes = std::make_shared<DynamicBitset>();
+  kept_nodes->resize(topo->NumNodes());
+  katana::do_all(
+      katana::iterate(topo->Nodes()),
+      [&](Node n) {
+        if (!node_mask || node_mask->test(topo->GetNodePropertyIndex(n))) {
+          kept_nodes->set(n);
+        }
+      },
+      katana::no_stats());
+
+  auto kept_edges = std::make_shared<DynamicBitset>();
+  kept_edges->resize(topo->NumEdges());
+  katana::do_all(
+      katana::iterate(topo->Nodes()),
+      [&](Node n) {
+        if (!kept_nodes->test(n)) {
+          return;
+        }
+        for (Edge e : topo->OutEdges(n)) {
+          if (kept_nodes->test(topo->OutEdgeDst(e)) &&
+              (!edge_mask ||
+               edge_mask->test(topo->GetEdgePropertyIndexFromOutEdge(e)))) {
+            kept_edges->set(e);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return PropertyGraphViews::Masked{
+      this, internal::MaskedTopology{
+                std::move(topo), std::move(kept_nodes),
+                std::move(kept_edges)}};
+}
+
+void
+katana::PropertyGraph::GetNodesWithAnyType(
+    const SetOfEntityTypeIDs& node_entity_type_ids, DynamicBitset* mask) const {
+  FillEntityTypeMask(
+      GetNodeTypeManager().GetSupertypesOfAny(node_entity_type_ids),
+      node_type_data(), NumOriginalNodes(), mask);
+}
+
+void
+katana::PropertyGraph::GetEdgesWithAnyType(
+    const SetOfEntityTypeIDs& edge_entity_type_ids, DynamicBitset* mask) const {
+  FillEntityTypeMask(
+      GetEdgeTypeManager().GetSupertypesOfAny(edge_entity_type_ids),
+      edge_type_data(), NumOriginalEdges(), mask);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::PropertyGraph::MakeReorderedGraph(
+    katana::PropertyGraph& pg, katana::RDGTopology::NodeSortKind kind) {
+  if (!katana::IsNodeReorderingKind(kind)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "not a node reordering: {}",
+        static_cast<int>(kind));
+  }
+  if (pg.IsTransformed()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "cannot reorder a transformed graph");
+  }
+
+  auto reordered = pg.pg_view_cache_.BuildOrGetReorderedTopo(&pg, kind);
+  // The cached topology stays with pg; the new graph gets its own copy.
+  GraphTopology topo = GraphTopology::Copy(*reordered);
+
+  NUMAArray<Node> original_to_reordered_nodes;
+  original_to_reordered_nodes.allocateInterleaved(topo.NumNodes());
+  katana::do_all(
+      katana::iterate(topo.Nodes()),
+      [&](Node n) {
+        original_to_reordered_nodes[topo.GetNodePropertyIndex(n)] = n;
+      },
+      katana::no_stats());
+
+  NUMAArray<Edge> original_to_reordered_edges;
+  original_to_reordered_edges.allocateInterleaved(topo.NumEdges());
+  katana::do_all(
+      katana::iterate(topo.OutEdges()),
+      [&](Edge e) {
+        original_to_reordered_edges[topo.GetEdgePropertyIndexFromOutEdge(e)] =
+            e;
+      },
+      katana::no_stats());
+
+  // Every node and edge is kept
+  NUMAArray<uint8_t> node_bitmask;
+  node_bitmask.allocateInterleaved((topo.NumNodes() + 7) / 8);
+  katana::ParallelSTL::fill(
+      node_bitmask.begin(), node_bitmask.end(), uint8_t{0xff});
+
+  NUMAArray<uint8_t> edge_bitmask;
+  edge_bitmask.allocateInterleaved((topo.NumEdges() + 7) / 8);
+  katana::ParallelSTL::fill(
+      edge_bitmask.begin(), edge_bitmask.end(), uint8_t{0xff});
+
+  // Using `new` to access a non-public constructor.
+  return std::unique_ptr<PropertyGraph>(new PropertyGraph(
+      pg, std::move(topo), std::move(original_to_reordered_nodes),
+      std::move(original_to_reordered_edges), std::move(node_bitmask),
+      std::move(edge_bitmask)));
+}
+
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 katana::PropertyGraph::Copy(
     const std::vector<std::string>& node_properties,
@@ -744,7 +918,8 @@ katana::PropertyGraph::LoadTopology(const katana::RDGTopology& shadow) {
 }
 
 katana::Result<void>
-katana::PropertyGraph::DoWriteTopologies() {
+katana::PropertyGraph::DoWriteTopologies(
+    std::vector<katana::GraphTopology::AdjIndexVec>* buffers) {
   // Since PGViewCache doesn't manage the main csr topology, see if we need to store it now
   katana::RDGTopology shadow = KATANA_CHECKED(katana::RDGTopology::Make(
       topology().AdjData(), topology().NumNodes(), topology().DestData(),
@@ -756,13 +931,39 @@ katana::PropertyGraph::DoWriteTopologies() {
   rdg_->UpsertTopology(std::move(shadow));
 
   std::vector<katana::RDGTopology> topologies =
-      KATANA_CHECKED(pg_view_cache_.ToRDGTopology());
+      KATANA_CHECKED(pg_view_cache_.ToRDGTopology(buffers));
   for (size_t i = 0; i < topologies.size(); i++) {
     rdg_->UpsertTopology(std::move(topologies.at(i)));
   }
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+katana::PropertyGraph::DoWriteIndexes() {
+  // Index files are written next to the RDG and moved with it by Store, so
+  // there must be an RDG directory to write them to.
+  if ((node_indexes_.empty() && edge_indexes_.empty()) ||
+      rdg_->rdg_dir().empty()) {
+    return katana::ResultSuccess();
+  }
+
+  std::optional<katana::EntityIndexPrimitive> stored =
+      KATANA_CHECKED(rdg_->LoadEntityIndexPrimitive());
+  katana::EntityIndexPrimitive primitive =
+      stored ? std::move(stored.value()) : katana::EntityIndexPrimitive();
+  for (const auto& index : node_indexes_) {
+    KATANA_CHECKED(primitive.AddIndex(
+        rdg_->rdg_dir(), index->property_name(), true, index->begin(),
+        index->size(), sizeof(Node)));
+  }
+  for (const auto& index : edge_indexes_) {
+    KATANA_CHECKED(primitive.AddIndex(
+        rdg_->rdg_dir(), index->property_name(), false, index->begin(),
+        index->size(), sizeof(Edge)));
+  }
+  return rdg_->WriteEntityIndexPrimitive(primitive);
+}
+
 katana::Result<void>
 katana::PropertyGraph::DoWrite(
     katana::RDGHandle handle, const std::string& command_line,
@@ -773,7 +974,10 @@ katana::PropertyGraph::DoWrite(
       rdg_->node_entity_type_id_array_file_storage().Valid(),
       rdg_->edge_entity_type_id_array_file_storage().Valid());
 
-  KATANA_CHECKED(DoWriteTopologies());
+  // Arrays built only to be stored, freed once the store is done
+  std::vector<katana::GraphTopology::AdjIndexVec> topology_buffers;
+  KATANA_CHECKED(DoWriteTopologies(&topology_buffers));
+  KATANA_CHECKED(DoWriteIndexes());
 
   //TODO(emcginnis): we don't actually have any lifetime tracking for the in memory
   // entity_type_id arrays, which means we don't actually know when the array
@@ -1264,6 +1468,40 @@ katana::PropertyGraph::RemoveEdgeProperty(
   return katana::ErrorCode::PropertyNotFound;
 }
 
+namespace {
+
+katana::Result<std::shared_ptr<arrow::Table>>
+DictionaryEncodedTable(
+    const std::string& prop_name,
+    const std::shared_ptr<arrow::ChunkedArray>& column) {
+  if (!column) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no property named {}",
+        prop_name);
+  }
+  auto encoded = KATANA_CHECKED(katana::DictionaryEncodeStrings(*column));
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(prop_name, encoded->type())}), {encoded});
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::PropertyGraph::DictionaryEncodeNodeProperty(
+    const std::string& prop_name, katana::TxnContext* txn_ctx) {
+  auto column = KATANA_CHECKED(GetNodeProperty(prop_name));
+  auto table = KATANA_CHECKED(DictionaryEncodedTable(prop_name, column));
+  return UpsertNodeProperties(table, txn_ctx);
+}
+
+katana::Result<void>
+katana::PropertyGraph::DictionaryEncodeEdgeProperty(
+    const std::string& prop_name, katana::TxnContext* txn_ctx) {
+  auto column = KATANA_CHECKED(GetEdgeProperty(prop_name));
+  auto table = KATANA_CHECKED(DictionaryEncodedTable(prop_name, column));
+  return UpsertEdgeProperties(table, txn_ctx);
+}
+
 katana::Result<void>
 katana::PropertyGraph::UnloadEdgeProperty(const std::string& prop_name) {
   return rdg_->UnloadEdgeProperty(prop_name);
@@ -1284,9 +1522,40 @@ katana::PropertyGraph::EnsureEdgePropertyLoaded(const std::string& name) {
   return LoadEdgeProperty(name);
 }
 
+template <typename node_or_edge>
+katana::Result<void>
+katana::PropertyGraph::BuildIndex(
+    katana::EntityIndex<node_or_edge>* index, bool is_node) {
+  // The entities of a transformed graph are not the ones of its RDG
+  if (!IsTransformed() && !rdg_->rdg_dir().empty()) {
+    std::optional<katana::EntityIndexPrimitive> stored =
+        KATANA_CHECKED(rdg_->LoadEntityIndexPrimitive());
+    const katana::EntityIndexPrimitive::Entry* entry =
+        stored ? stored->FindIndex(index->property_name(), is_node) : nullptr;
+    if (entry && entry->id_size == sizeof(node_or_edge)) {
+      katana::NUMAArray<node_or_edge> sorted_ids;
+      sorted_ids.allocateBlocked(entry->num_ids);
+      // The file may be gone or have been replaced, and the property may
+      // have changed since the index was stored
+      auto res = stored->ReadIndex(rdg_->rdg_dir(), *entry, sorted_ids.data());
+      if (res) {
+        res = index->BuildFromSortedIDs(std::move(sorted_ids));
+      }
+      if (res) {
+        return katana::ResultSuccess();
+      }
+      KATANA_LOG_DEBUG(
+          "stored index over {} is out of date: {}", index->property_name(),
+          res.error());
+    }
+  }
+  return index->BuildFromProperty();
+}
+
 // Build an index over nodes.
 katana::Result<void>
-katana::PropertyGraph::MakeNodeIndex(const std::string& property_name) {
+katana::PropertyGraph::MakeNodeIndex(
+    const std::string& property_name, katana::EntityIndexKind kind) {
   for (const auto& existing_index : node_indexes_) {
     if (existing_index->property_name() == property_name) {
       return KATANA_ERROR(
@@ -1304,9 +1573,40 @@ katana::PropertyGraph::MakeNodeIndex(const std::string& property_name) {
   // Create an index based on the type of the field.
   std::shared_ptr<katana::EntityIndex<GraphTopology::Node>> index =
       KATANA_CHECKED(katana::MakeTypedEntityIndex<katana::GraphTopology::Node>(
-          property_name, NumNodes(), property));
+          property_name, NumNodes(), property, kind));
 
-  KATANA_CHECKED(index->BuildFromProperty());
+  KATANA_CHECKED(BuildIndex(index.get(), true));
+
+  node_indexes_.push_back(std::move(index));
+
+  return katana::ResultSuccess();
+}
+
+// Build an index over a tuple of node properties.
+katana::Result<void>
+katana::PropertyGraph::MakeCompositeNodeIndex(
+    const std::vector<std::string>& property_names,
+    katana::EntityIndexKind kind) {
+  std::string index_name = katana::CompositeIndexName(property_names);
+  if (HasNodeIndex(index_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "Index already exists for columns {}",
+        index_name);
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> properties;
+  for (const auto& property_name : property_names) {
+    std::shared_ptr<arrow::ChunkedArray> chunked_property =
+        KATANA_CHECKED(GetNodeProperty(property_name));
+    KATANA_LOG_ASSERT(chunked_property->num_chunks() == 1);
+    properties.emplace_back(chunked_property->chunk(0));
+  }
+
+  auto index =
+      std::make_shared<katana::CompositeEntityIndex<GraphTopology::Node>>(
+          property_names, NumNodes(), std::move(properties), kind);
+
+  KATANA_CHECKED(BuildIndex<GraphTopology::Node>(index.get(), true));
 
   node_indexes_.push_back(std::move(index));
 
@@ -1331,7 +1631,8 @@ katana::PropertyGraph::DeleteNodeIndex(const std::string& property_name) {
 
 // Build an index over edges.
 katana::Result<void>
-katana::PropertyGraph::MakeEdgeIndex(const std::string& property_name) {
+katana::PropertyGraph::MakeEdgeIndex(
+    const std::string& property_name, katana::EntityIndexKind kind) {
   for (const auto& existing_index : edge_indexes_) {
     if (existing_index->property_name() == property_name) {
       return KATANA_ERROR(
@@ -1349,9 +1650,40 @@ katana::PropertyGraph::MakeEdgeIndex(const std::string& property_name) {
   // Create an index based on the type of the field.
   std::unique_ptr<katana::EntityIndex<katana::GraphTopology::Edge>> index =
       KATANA_CHECKED(katana::MakeTypedEntityIndex<katana::GraphTopology::Edge>(
-          property_name, NumEdges(), property));
+          property_name, NumEdges(), property, kind));
+
+  KATANA_CHECKED(BuildIndex(index.get(), false));
+
+  edge_indexes_.push_back(std::move(index));
+
+  return katana::ResultSuccess();
+}
+
+// Build an index over a tuple of edge properties.
+katana::Result<void>
+katana::PropertyGraph::MakeCompositeEdgeIndex(
+    const std::vector<std::string>& property_names,
+    katana::EntityIndexKind kind) {
+  std::string index_name = katana::CompositeIndexName(property_names);
+  if (HasEdgeIndex(index_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "Index already exists for columns {}",
+        index_name);
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> properties;
+  for (const auto& property_name : property_names) {
+    std::shared_ptr<arrow::ChunkedArray> chunked_property =
+        KATANA_CHECKED(GetEdgeProperty(property_name));
+    KATANA_LOG_ASSERT(chunked_property->num_chunks() == 1);
+    properties.emplace_back(chunked_property->chunk(0));
+  }
+
+  auto index =
+      std::make_shared<katana::CompositeEntityIndex<GraphTopology::Edge>>(
+          property_names, NumEdges(), std::move(properties), kind);
 
-  KATANA_CHECKED(index->BuildFromProperty());
+  KATANA_CHECKED(BuildIndex<GraphTopology::Edge>(index.get(), false));
 
   edge_indexes_.push_back(std::move(index));
 
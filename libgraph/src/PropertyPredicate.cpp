@@ -0,0 +1,500 @@
+#include "katana/PropertyPredicate.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowVisitor.h"
+#include "katana/ErrorCode.h"
+#include "katana/Loops.h"
+#include "katana/PropertyGraph.h"
+
+struct katana::PropertyPredicate::Expr {
+  enum class Kind { kCompare, kIsValid, kHasType, kAnd, kOr, kNot };
+
+  Kind kind;
+  std::string property;
+  CompareOp op{CompareOp::kEqual};
+  Value value;
+  SetOfEntityTypeIDs types;
+  std::shared_ptr<const Expr> lhs;
+  std::shared_ptr<const Expr> rhs;
+};
+
+namespace {
+
+using Expr = katana::PropertyPredicate::Expr;
+using CompareOp = katana::PropertyPredicate::CompareOp;
+
+constexpr uint64_t kBitsPerWord = katana::DynamicBitset::kNumBitsInUint64;
+/// Words of the mask filled by one task
+constexpr uint64_t kWordsPerBlock = 256;
+
+uint64_t
+LowBits(uint64_t n) {
+  return n == kBitsPerWord ? ~uint64_t{0} : (uint64_t{1} << n) - 1;
+}
+
+/// The validity of the n values of chunk starting at begin, as bits
+uint64_t
+ValidBits(const arrow::Array& chunk, int64_t begin, uint64_t n) {
+  if (chunk.null_count() == 0) {
+    return LowBits(n);
+  }
+  uint64_t bits = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    bits |= uint64_t{chunk.IsValid(begin + i)} << i;
+  }
+  return bits;
+}
+
+/// Fill mask with the bits computed by word_fn, in parallel. word_fn(begin, n)
+/// returns the bits of the n <= 64 entities starting at begin.
+template <typename WordFn>
+void
+FillMask(uint64_t size, const WordFn& word_fn, katana::DynamicBitset* mask) {
+  mask->resize(size);
+  auto& words = mask->get_vec();
+  uint64_t num_words = words.size();
+  uint64_t num_blocks = (num_words + kWordsPerBlock - 1) / kWordsPerBlock;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block) {
+        uint64_t end = std::min(num_words, (block + 1) * kWordsPerBlock);
+        for (uint64_t w = block * kWordsPerBlock; w < end; ++w) {
+          uint64_t begin = w * kBitsPerWord;
+          words[w] = word_fn(begin, std::min(kBitsPerWord, size - begin));
+        }
+      },
+      katana::no_stats());
+}
+
+/// Fill mask from a column, where chunk_fn(chunk, begin, n) returns the bits
+/// of the n values of chunk starting at begin. Words that straddle chunks are
+/// assembled from each of them.
+template <typename ChunkFn>
+void
+FillMaskFromColumn(
+    const arrow::ChunkedArray& column, const ChunkFn& chunk_fn,
+    katana::DynamicBitset* mask) {
+  std::vector<uint64_t> chunk_begins{0};
+  for (const auto& chunk : column.chunks()) {
+    chunk_begins.emplace_back(chunk_begins.back() + chunk->length());
+  }
+
+  auto word_fn = [&](uint64_t begin, uint64_t n) {
+    // The last chunk that starts at or before begin
+    size_t c = std::upper_bound(
+                   chunk_begins.begin(), chunk_begins.end() - 1, begin) -
+               chunk_begins.begin() - 1;
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < n; ++c) {
+      uint64_t in_chunk = std::min(n - i, chunk_begins[c + 1] - (begin + i));
+      if (in_chunk == 0) {
+        continue;
+      }
+      const arrow::Array& chunk = *column.chunk(c);
+      bits |= chunk_fn(chunk, begin + i - chunk_begins[c], in_chunk) << i;
+      i += in_chunk;
+    }
+    return bits;
+  };
+
+  FillMask(column.length(), word_fn, mask);
+}
+
+/// Calls fn with the comparison function object of op
+template <typename Fn>
+auto
+WithComparator(CompareOp op, const Fn& fn) {
+  switch (op) {
+  case CompareOp::kEqual:
+    return fn(std::equal_to<>{});
+  case CompareOp::kNotEqual:
+    return fn(std::not_equal_to<>{});
+  case CompareOp::kLess:
+    return fn(std::less<>{});
+  case CompareOp::kLessEqual:
+    return fn(std::less_equal<>{});
+  case CompareOp::kGreater:
+    return fn(std::greater<>{});
+  case CompareOp::kGreaterEqual:
+    return fn(std::greater_equal<>{});
+  }
+  KATANA_LOG_FATAL("unknown comparison: {}", static_cast<int>(op));
+}
+
+/// Fill mask with cmp(value of column, value), as T
+template <typename C, typename T, typename Cmp>
+void
+FillCompare(
+    const arrow::ChunkedArray& column, const Cmp& cmp, T value,
+    katana::DynamicBitset* mask) {
+  auto chunk_fn = [&](const arrow::Array& chunk, int64_t begin, uint64_t n) {
+    const C* values = chunk.data()->GetValues<C>(1) + begin;
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      bits |= uint64_t{cmp(static_cast<T>(values[i]), value)} << i;
+    }
+    return bits & ValidBits(chunk, begin, n);
+  };
+  FillMaskFromColumn(column, chunk_fn, mask);
+}
+
+std::string_view
+ToStringView(arrow::util::string_view view) {
+  return std::string_view(view.data(), view.length());
+}
+
+/// Fill mask with cmp(value of column, value) for a column of strings or
+/// large strings, given as ArrayType
+template <typename ArrayType, typename Cmp>
+void
+FillCompareStrings(
+    const arrow::ChunkedArray& column, const Cmp& cmp, std::string_view value,
+    katana::DynamicBitset* mask) {
+  auto chunk_fn = [&](const arrow::Array& chunk, int64_t begin, uint64_t n) {
+    const auto& strings = static_cast<const ArrayType&>(chunk);
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      bits |= uint64_t{cmp(ToStringView(strings.GetView(begin + i)), value)}
+              << i;
+    }
+    return bits & ValidBits(chunk, begin, n);
+  };
+  FillMaskFromColumn(column, chunk_fn, mask);
+}
+
+/// Calls fn(I{}) with the C type I of the codes of a dictionary
+template <typename Fn>
+uint64_t
+WithCodeType(const arrow::DataType& index_type, const Fn& fn) {
+  switch (index_type.id()) {
+  case arrow::Type::INT8:
+    return fn(int8_t{});
+  case arrow::Type::UINT8:
+    return fn(uint8_t{});
+  case arrow::Type::INT16:
+    return fn(int16_t{});
+  case arrow::Type::UINT16:
+    return fn(uint16_t{});
+  case arrow::Type::INT32:
+    return fn(int32_t{});
+  case arrow::Type::UINT32:
+    return fn(uint32_t{});
+  case arrow::Type::INT64:
+    return fn(int64_t{});
+  case arrow::Type::UINT64:
+    return fn(uint64_t{});
+  default:
+    KATANA_LOG_FATAL(
+        "unknown dictionary index type: {}", index_type.ToString());
+  }
+}
+
+/// Fill mask with cmp(value of column, value) for a column of dictionary
+/// encoded strings. Each string of a dictionary is compared once, and then
+/// values only look up the result for their code.
+template <typename Cmp>
+katana::Result<void>
+FillCompareCodes(
+    const arrow::ChunkedArray& column, const Cmp& cmp, std::string_view value,
+    katana::DynamicBitset* mask) {
+  // Chunks may have different dictionaries
+  std::unordered_map<const arrow::Array*, std::vector<uint8_t>> passes;
+  for (const auto& chunk : column.chunks()) {
+    const auto& dictionary =
+        *static_cast<const arrow::DictionaryArray&>(*chunk).dictionary();
+    std::vector<uint8_t>& chunk_passes = passes[chunk.get()];
+    chunk_passes.resize(dictionary.length());
+    for (int64_t code = 0; code < dictionary.length(); ++code) {
+      std::string_view code_value;
+      if (dictionary.type_id() == arrow::Type::STRING) {
+        code_value = ToStringView(
+            static_cast<const arrow::StringArray&>(dictionary).GetView(code));
+      } else if (dictionary.type_id() == arrow::Type::LARGE_STRING) {
+        code_value = ToStringView(
+            static_cast<const arrow::LargeStringArray&>(dictionary).GetView(
+                code));
+      } else {
+        return KATANA_ERROR(
+            katana::ErrorCode::TypeError,
+            "cannot compare dictionary of {} with a string",
+            dictionary.type()->ToString());
+      }
+      chunk_passes[code] = cmp(code_value, value);
+    }
+  }
+
+  auto chunk_fn = [&](const arrow::Array& chunk, int64_t begin, uint64_t n) {
+    const auto& dictionary_array =
+        static_cast<const arrow::DictionaryArray&>(chunk);
+    const std::vector<uint8_t>& chunk_passes = passes.at(&chunk);
+    uint64_t num_codes = chunk_passes.size();
+    const auto& index_type =
+        *static_cast<const arrow::DictionaryType&>(*chunk.type()).index_type();
+    uint64_t bits = WithCodeType(index_type, [&](auto code_type) {
+      using I = decltype(code_type);
+      const I* codes =
+          dictionary_array.indices()->data()->GetValues<I>(1) + begin;
+      uint64_t code_bits = 0;
+      for (uint64_t i = 0; i < n; ++i) {
+        // The codes of nulls may be anything
+        auto code = static_cast<uint64_t>(codes[i]);
+        code_bits |= uint64_t{code < num_codes && chunk_passes[code]} << i;
+      }
+      return code_bits;
+    });
+    return bits & ValidBits(chunk, begin, n);
+  };
+  FillMaskFromColumn(column, chunk_fn, mask);
+  return katana::ResultSuccess();
+}
+
+/// Fill mask with the comparison of a column of strings with the string
+/// value of expr
+katana::Result<void>
+CompareStrings(
+    const arrow::ChunkedArray& column, const Expr& expr,
+    std::string_view value, katana::DynamicBitset* mask) {
+  return WithComparator(expr.op, [&](const auto& cmp) -> katana::Result<void> {
+    switch (column.type()->id()) {
+    case arrow::Type::STRING:
+      FillCompareStrings<arrow::StringArray>(column, cmp, value, mask);
+      return katana::ResultSuccess();
+    case arrow::Type::LARGE_STRING:
+      FillCompareStrings<arrow::LargeStringArray>(column, cmp, value, mask);
+      return katana::ResultSuccess();
+    case arrow::Type::DICTIONARY:
+      return FillCompareCodes(column, cmp, value, mask);
+    default:
+      return KATANA_ERROR(
+          katana::ErrorCode::TypeError,
+          "cannot compare property {} of type {} with a string",
+          expr.property, column.type()->ToString());
+    }
+  });
+}
+
+struct CompareVisitor {
+  using ResultType = katana::Result<void>;
+  using AcceptTypes = std::tuple<katana::AcceptNumericArrowTypes>;
+
+  const arrow::ChunkedArray& column;
+  const Expr& expr;
+  katana::DynamicBitset* mask;
+
+  template <typename ArrowType, typename DataType>
+  ResultType Call(const DataType&) {
+    using C = typename ArrowType::c_type;
+
+    const auto* int_value = std::get_if<int64_t>(&expr.value);
+    if constexpr (std::is_integral_v<C>) {
+      if (int_value) {
+        return CompareInteger<C>(*int_value);
+      }
+    }
+    double value = int_value ? *int_value : std::get<double>(expr.value);
+    WithComparator(expr.op, [&](const auto& cmp) {
+      FillCompare<C>(column, cmp, value, mask);
+    });
+    return katana::ResultSuccess();
+  }
+
+  /// Integers are compared in the type of the property. A value outside the
+  /// range of that type compares the same way with every property value.
+  template <typename C>
+  ResultType CompareInteger(int64_t value) {
+    using Limits = std::numeric_limits<C>;
+    bool below = std::is_signed_v<C> ? value < int64_t{Limits::min()}
+                                     : value < 0;
+    bool above = value > 0 && uint64_t(value) > uint64_t{Limits::max()};
+    if (!below && !above) {
+      WithComparator(expr.op, [&](const auto& cmp) {
+        FillCompare<C>(column, cmp, static_cast<C>(value), mask);
+      });
+      return katana::ResultSuccess();
+    }
+
+    // Every property value is greater than (below) or less than (above)
+    // the value
+    bool result = false;
+    switch (expr.op) {
+    case CompareOp::kEqual:
+      result = false;
+      break;
+    case CompareOp::kNotEqual:
+      result = true;
+      break;
+    case CompareOp::kLess:
+    case CompareOp::kLessEqual:
+      result = above;
+      break;
+    case CompareOp::kGreater:
+    case CompareOp::kGreaterEqual:
+      result = below;
+      break;
+    }
+    FillCompare<C>(
+        column, [result](C, C) { return result; }, C{0}, mask);
+    return katana::ResultSuccess();
+  }
+
+  ResultType AcceptFailed(const arrow::DataType& type) {
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "cannot compare property {} of type {}",
+        expr.property, type.ToString());
+  }
+};
+
+struct Evaluator {
+  const katana::PropertyGraph& pg;
+  bool is_node;
+
+  uint64_t size() const {
+    return is_node ? pg.NumOriginalNodes() : pg.NumOriginalEdges();
+  }
+
+  katana::Result<std::shared_ptr<arrow::ChunkedArray>> GetProperty(
+      const std::string& name) const {
+    auto column = KATANA_CHECKED(
+        is_node ? pg.GetNodeProperty(name) : pg.GetEdgeProperty(name));
+    if (!column) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "no property named {}", name);
+    }
+    if (static_cast<uint64_t>(column->length()) != size()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "property {} has {} values, expected {}", name, column->length(),
+          size());
+    }
+    return column;
+  }
+
+  katana::Result<void> Evaluate(
+      const Expr& expr, katana::DynamicBitset* mask) const {
+    switch (expr.kind) {
+    case Expr::Kind::kCompare: {
+      auto column = KATANA_CHECKED(GetProperty(expr.property));
+      if (const auto* value = std::get_if<std::string>(&expr.value)) {
+        return CompareStrings(*column, expr, *value, mask);
+      }
+      return katana::VisitArrow(
+          CompareVisitor{*column, expr, mask}, *column->type());
+    }
+    case Expr::Kind::kIsValid: {
+      auto column = KATANA_CHECKED(GetProperty(expr.property));
+      FillMaskFromColumn(*column, ValidBits, mask);
+      return katana::ResultSuccess();
+    }
+    case Expr::Kind::kHasType:
+      EvaluateHasType(expr.types, mask);
+      return katana::ResultSuccess();
+    case Expr::Kind::kAnd:
+    case Expr::Kind::kOr: {
+      KATANA_CHECKED(Evaluate(*expr.lhs, mask));
+      katana::DynamicBitset rhs;
+      KATANA_CHECKED(Evaluate(*expr.rhs, &rhs));
+      if (expr.kind == Expr::Kind::kAnd) {
+        mask->bitwise_and(rhs);
+      } else {
+        mask->bitwise_or(rhs);
+      }
+      return katana::ResultSuccess();
+    }
+    case Expr::Kind::kNot:
+      KATANA_CHECKED(Evaluate(*expr.lhs, mask));
+      mask->bitwise_not();
+      return katana::ResultSuccess();
+    }
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "unknown predicate kind: {}",
+        static_cast<int>(expr.kind));
+  }
+
+  void EvaluateHasType(
+      const katana::SetOfEntityTypeIDs& types,
+      katana::DynamicBitset* mask) const {
+    if (is_node) {
+      pg.GetNodesWithAnyType(types, mask);
+    } else {
+      pg.GetEdgesWithAnyType(types, mask);
+    }
+  }
+};
+
+std::shared_ptr<const Expr>
+MakeExpr(Expr&& expr) {
+  return std::make_shared<const Expr>(std::move(expr));
+}
+
+}  // namespace
+
+katana::PropertyPredicate
+katana::PropertyPredicate::Compare(
+    std::string property, CompareOp op, Value value) {
+  Expr expr{Expr::Kind::kCompare};
+  expr.property = std::move(property);
+  expr.op = op;
+  expr.value = std::move(value);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::PropertyPredicate
+katana::PropertyPredicate::IsValid(std::string property) {
+  Expr expr{Expr::Kind::kIsValid};
+  expr.property = std::move(property);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::PropertyPredicate
+katana::PropertyPredicate::HasType(SetOfEntityTypeIDs types) {
+  Expr expr{Expr::Kind::kHasType};
+  expr.types = std::move(types);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::PropertyPredicate
+katana::PropertyPredicate::And(PropertyPredicate lhs, PropertyPredicate rhs) {
+  Expr expr{Expr::Kind::kAnd};
+  expr.lhs = std::move(lhs.expr_);
+  expr.rhs = std::move(rhs.expr_);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::PropertyPredicate
+katana::PropertyPredicate::Or(PropertyPredicate lhs, PropertyPredicate rhs) {
+  Expr expr{Expr::Kind::kOr};
+  expr.lhs = std::move(lhs.expr_);
+  expr.rhs = std::move(rhs.expr_);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::PropertyPredicate
+katana::PropertyPredicate::Not(PropertyPredicate operand) {
+  Expr expr{Expr::Kind::kNot};
+  expr.lhs = std::move(operand.expr_);
+  return PropertyPredicate(MakeExpr(std::move(expr)));
+}
+
+katana::Result<katana::DynamicBitset>
+katana::PropertyPredicate::EvaluateNodes(const PropertyGraph& pg) const {
+  katana::DynamicBitset mask;
+  KATANA_CHECKED(Evaluator{pg, true}.Evaluate(*expr_, &mask));
+  return MakeResult(std::move(mask));
+}
+
+katana::Result<katana::DynamicBitset>
+katana::PropertyPredicate::EvaluateEdges(const PropertyGraph& pg) const {
+  katana::DynamicBitset mask;
+  KATANA_CHECKED(Evaluator{pg, false}.Evaluate(*expr_, &mask));
+  return MakeResult(std::move(mask));
+}
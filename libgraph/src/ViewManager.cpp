@@ -0,0 +1,68 @@
+#include "katana/ViewManager.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "katana/GraphTopology.h"
+#include "katana/MemorySupervisor.h"
+#include "katana/ProgressTracer.h"
+#include "katana/Time.h"
+
+const std::string katana::ViewManager::name_ = "view";
+
+katana::ViewManager&
+katana::ViewManager::Get() {
+  MemorySupervisor& ms = MemorySupervisor::Get();
+  Manager* manager = ms.GetManager(name_);
+  if (manager == nullptr) {
+    manager = ms.Register(std::make_unique<ViewManager>());
+  }
+  return *static_cast<ViewManager*>(manager);
+}
+
+void
+katana::ViewManager::Register(PGViewCache* cache) {
+  caches_.emplace_back(cache);
+}
+
+void
+katana::ViewManager::Unregister(PGViewCache* cache) {
+  caches_.erase(
+      std::remove(caches_.begin(), caches_.end(), cache), caches_.end());
+}
+
+void
+katana::ViewManager::ViewsCheckedOut(count_t bytes) {
+  MemorySupervisor::Get().StandbyToActive(Name(), bytes);
+}
+
+void
+katana::ViewManager::ViewsReleased(count_t bytes) {
+  MemorySupervisor::Get().ActiveToStandby(Name(), bytes);
+}
+
+void
+katana::ViewManager::ViewsDropped(count_t bytes) {
+  MemorySupervisor::Get().PutStandby(Name(), bytes);
+}
+
+katana::count_t
+katana::ViewManager::FreeStandbyMemory(count_t goal) {
+  auto scope = katana::GetTracer().StartActiveSpan("free standby views");
+
+  count_t reclaimed = 0;
+  // Evicting calls ViewsDropped, which returns the memory to the supervisor
+  for (PGViewCache* cache : caches_) {
+    if (reclaimed >= goal) {
+      break;
+    }
+    reclaimed += cache->EvictViews(goal - reclaimed);
+  }
+
+  scope.span().Log(
+      "after", {
+                   {"goal_gb", ToGB(goal)},
+                   {"reclaimed_gb", ToGB(reclaimed)},
+               });
+  return reclaimed;
+}
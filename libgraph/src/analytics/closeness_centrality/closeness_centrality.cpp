@@ -0,0 +1,456 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2020, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/closeness_centrality/closeness_centrality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "katana/NUMAArray.h"
+#include "katana/Random.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct ClosenessCentralityValue : public katana::PODProperty<double> {};
+
+using NodeData = std::tuple<ClosenessCentralityValue>;
+using EdgeData = std::tuple<>;
+
+using Graph = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::Default, NodeData, EdgeData>;
+using GNode = typename Graph::Node;
+
+/// Per node sums over the (possibly sampled) nodes reachable from that node.
+struct DistanceSums {
+  /// Number of other nodes reached.
+  katana::NUMAArray<double> reached;
+  /// Sum of distances to the reached nodes.
+  katana::NUMAArray<double> distance;
+  /// Sum of inverse distances to the reached nodes.
+  katana::NUMAArray<double> inverse_distance;
+
+  explicit DistanceSums(size_t num_nodes) {
+    for (auto* array : {&reached, &distance, &inverse_distance}) {
+      array->allocateBlocked(num_nodes);
+      katana::ParallelSTL::fill(array->begin(), array->end(), 0.0);
+    }
+  }
+
+  void Add(GNode node, double count, uint32_t level) {
+    reached[node] += count;
+    distance[node] += count * level;
+    inverse_distance[node] += count / level;
+  }
+};
+
+/// Multi-source BFS that computes, for up to 64 targets at once, the distance
+/// from every node to each target. Every target owns one bit lane of a 64-bit
+/// word per node, so a single sweep over the edges advances all 64 searches.
+///
+/// The search runs backwards (a node is at distance d from a target if one of
+/// its out-neighbors is at distance d - 1), which lets each node pull from its
+/// out-edges and update only its own state, so no atomics are needed.
+class BatchedBfs {
+public:
+  static constexpr uint32_t kBatchSize = 64;
+
+  BatchedBfs(const Graph& graph, uint32_t max_levels)
+      : graph_(graph), max_levels_(max_levels) {
+    for (auto* array : {&seen_, &frontier_, &next_}) {
+      array->allocateBlocked(graph_.NumNodes());
+    }
+  }
+
+  /// Search from targets[0, num_targets) and add count_weight for every
+  /// (node, target) pair found to sums.
+  void Run(
+      const GNode* targets, size_t num_targets, double count_weight,
+      DistanceSums* sums) {
+    KATANA_LOG_DEBUG_ASSERT(num_targets <= kBatchSize);
+
+    katana::ParallelSTL::fill(seen_.begin(), seen_.end(), uint64_t{0});
+    katana::ParallelSTL::fill(frontier_.begin(), frontier_.end(), uint64_t{0});
+
+    for (size_t i = 0; i < num_targets; ++i) {
+      seen_[targets[i]] |= uint64_t{1} << i;
+      frontier_[targets[i]] |= uint64_t{1} << i;
+    }
+
+    for (uint32_t level = 1; level <= max_levels_; ++level) {
+      katana::GReduceLogicalOr changed;
+
+      katana::do_all(
+          katana::iterate(graph_),
+          [&](const GNode& node) {
+            const uint64_t unseen = ~seen_[node];
+            uint64_t found = 0;
+            if (unseen != 0) {
+              for (auto e : graph_.OutEdges(node)) {
+                found |= frontier_[graph_.OutEdgeDst(e)];
+                if ((found & unseen) == unseen) {
+                  break;
+                }
+              }
+              found &= unseen;
+            }
+            next_[node] = found;
+            if (found != 0) {
+              seen_[node] |= found;
+              sums->Add(node, count_weight * __builtin_popcountll(found), level);
+              changed.update(true);
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("ClosenessCentrality BatchedBfs"));
+
+      if (!changed.reduce()) {
+        break;
+      }
+      std::swap(frontier_, next_);
+    }
+  }
+
+private:
+  const Graph& graph_;
+  uint32_t max_levels_;
+
+  katana::NUMAArray<uint64_t> seen_;
+  katana::NUMAArray<uint64_t> frontier_;
+  katana::NUMAArray<uint64_t> next_;
+};
+
+void
+ExactDistanceSums(
+    const Graph& graph, const ClosenessCentralityPlan& plan,
+    DistanceSums* sums) {
+  std::vector<GNode> targets(BatchedBfs::kBatchSize);
+  BatchedBfs bfs(graph, plan.max_iterations());
+
+  for (GNode begin = 0; begin < graph.NumNodes();
+       begin += BatchedBfs::kBatchSize) {
+    size_t num_targets = std::min<size_t>(
+        BatchedBfs::kBatchSize, graph.NumNodes() - begin);
+    std::iota(targets.begin(), targets.begin() + num_targets, begin);
+    bfs.Run(targets.data(), num_targets, 1.0, sums);
+  }
+}
+
+void
+SampledPivotsDistanceSums(
+    const Graph& graph, const ClosenessCentralityPlan& plan,
+    DistanceSums* sums) {
+  const uint64_t num_nodes = graph.NumNodes();
+  if (plan.num_pivots() >= num_nodes) {
+    ExactDistanceSums(graph, plan, sums);
+    return;
+  }
+
+  // Draw distinct pivots uniformly at random (partial Fisher-Yates).
+  std::vector<GNode> pivots(num_nodes);
+  std::iota(pivots.begin(), pivots.end(), GNode{0});
+  auto& gen = katana::GetGenerator();
+  for (uint32_t i = 0; i < plan.num_pivots(); ++i) {
+    std::uniform_int_distribution<uint64_t> dist(i, num_nodes - 1);
+    std::swap(pivots[i], pivots[dist(gen)]);
+  }
+  pivots.resize(plan.num_pivots());
+
+  // Each pivot stands for (n - 1) / k nodes (Eppstein-Wang estimator).
+  const double weight = static_cast<double>(num_nodes - 1) / pivots.size();
+
+  BatchedBfs bfs(graph, plan.max_iterations());
+  for (size_t begin = 0; begin < pivots.size();
+       begin += BatchedBfs::kBatchSize) {
+    size_t num_targets =
+        std::min<size_t>(BatchedBfs::kBatchSize, pivots.size() - begin);
+    bfs.Run(&pivots[begin], num_targets, weight, sums);
+  }
+}
+
+/// HyperBall: approximate the size of the ball of radius t around each node
+/// with a HyperLogLog counter, computed as the union of the radius t - 1
+/// counters of its out-neighbors. The change in ball size between iterations
+/// is the number of nodes at distance exactly t.
+class HyperBall {
+public:
+  HyperBall(const Graph& graph, const ClosenessCentralityPlan& plan)
+      : graph_(graph),
+        log2_registers_(plan.log2_registers()),
+        num_registers_(uint32_t{1} << plan.log2_registers()),
+        max_iterations_(plan.max_iterations()) {
+    const size_t num_nodes = graph_.NumNodes();
+    current_.allocateBlocked(num_nodes * num_registers_);
+    next_.allocateBlocked(num_nodes * num_registers_);
+    ball_size_.allocateBlocked(num_nodes);
+    modified_.allocateBlocked(num_nodes);
+    next_modified_.allocateBlocked(num_nodes);
+
+    if (num_registers_ <= 16) {
+      alpha_ = 0.673;
+    } else if (num_registers_ == 32) {
+      alpha_ = 0.697;
+    } else if (num_registers_ == 64) {
+      alpha_ = 0.709;
+    } else {
+      alpha_ = 0.7213 / (1.0 + 1.079 / num_registers_);
+    }
+  }
+
+  void Run(DistanceSums* sums) {
+    katana::ParallelSTL::fill(current_.begin(), current_.end(), uint8_t{0});
+
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& node) {
+          uint64_t hash = Hash(node);
+          uint32_t index = hash >> (64 - log2_registers_);
+          uint64_t rest = hash << log2_registers_;
+          uint8_t rank = rest == 0 ? (64 - log2_registers_ + 1)
+                                   : (__builtin_clzll(rest) + 1);
+          current_[Offset(node) + index] = rank;
+          ball_size_[node] = Estimate(&current_[Offset(node)]);
+          modified_[node] = 1;
+        },
+        katana::no_stats(), katana::loopname("ClosenessCentrality HLLInit"));
+
+    for (uint32_t iteration = 1; iteration <= max_iterations_; ++iteration) {
+      katana::GReduceLogicalOr changed;
+
+      katana::do_all(
+          katana::iterate(graph_),
+          [&](const GNode& node) {
+            uint8_t* out = &next_[Offset(node)];
+            const uint8_t* own = &current_[Offset(node)];
+            std::copy(own, own + num_registers_, out);
+            next_modified_[node] = 0;
+
+            bool neighbor_modified = false;
+            for (auto e : graph_.OutEdges(node)) {
+              auto dst = graph_.OutEdgeDst(e);
+              if (!modified_[dst]) {
+                continue;
+              }
+              neighbor_modified = true;
+              const uint8_t* in = &current_[Offset(dst)];
+              for (uint32_t r = 0; r < num_registers_; ++r) {
+                out[r] = std::max(out[r], in[r]);
+              }
+            }
+            if (!neighbor_modified ||
+                std::equal(own, own + num_registers_, out)) {
+              return;
+            }
+
+            double size = Estimate(out);
+            double delta = size - ball_size_[node];
+            if (delta > 0) {
+              sums->Add(node, delta, iteration);
+              ball_size_[node] = size;
+            }
+            next_modified_[node] = 1;
+            changed.update(true);
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("ClosenessCentrality HyperBall"));
+
+      std::swap(current_, next_);
+      std::swap(modified_, next_modified_);
+      if (!changed.reduce()) {
+        break;
+      }
+    }
+  }
+
+private:
+  size_t Offset(GNode node) const {
+    return static_cast<size_t>(node) << log2_registers_;
+  }
+
+  static uint64_t Hash(uint64_t x) {
+    // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31U);
+  }
+
+  double Estimate(const uint8_t* registers) const {
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint32_t r = 0; r < num_registers_; ++r) {
+      sum += std::ldexp(1.0, -static_cast<int>(registers[r]));
+      zeros += registers[r] == 0;
+    }
+    double m = num_registers_;
+    double estimate = alpha_ * m * m / sum;
+    if (estimate <= 2.5 * m && zeros != 0) {
+      // Small range correction (linear counting).
+      estimate = m * std::log(m / zeros);
+    }
+    return std::min(estimate, static_cast<double>(graph_.NumNodes()));
+  }
+
+  const Graph& graph_;
+  uint32_t log2_registers_;
+  uint32_t num_registers_;
+  uint32_t max_iterations_;
+  double alpha_;
+
+  katana::NUMAArray<uint8_t> current_;
+  katana::NUMAArray<uint8_t> next_;
+  katana::NUMAArray<double> ball_size_;
+  katana::NUMAArray<uint8_t> modified_;
+  katana::NUMAArray<uint8_t> next_modified_;
+};
+
+katana::Result<void>
+ClosenessCentralityImpl(
+    Graph* graph, ClosenessCentralityMeasure measure,
+    const ClosenessCentralityPlan& plan) {
+  const uint64_t num_nodes = graph->NumNodes();
+  if (num_nodes == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("ClosenessCentrality");
+  exec_time.start();
+
+  DistanceSums sums(num_nodes);
+
+  switch (plan.algorithm()) {
+  case ClosenessCentralityPlan::kExact:
+    ExactDistanceSums(*graph, plan, &sums);
+    break;
+  case ClosenessCentralityPlan::kSampledPivots:
+    if (plan.num_pivots() == 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "number of pivots must be > 0");
+    }
+    SampledPivotsDistanceSums(*graph, plan, &sums);
+    break;
+  case ClosenessCentralityPlan::kHyperBall: {
+    if (plan.log2_registers() < 4 || plan.log2_registers() > 16) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "log2 registers must be in [4, 16], got {}", plan.log2_registers());
+    }
+    HyperBall hyper_ball(*graph, plan);
+    hyper_ball.Run(&sums);
+    break;
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  const double others = static_cast<double>(num_nodes - 1);
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        double centrality = 0;
+        if (others > 0) {
+          double reached = std::min(sums.reached[node], others);
+          if (measure == ClosenessCentralityMeasure::kHarmonic) {
+            centrality = sums.inverse_distance[node] / others;
+          } else if (sums.distance[node] > 0) {
+            centrality = (reached / others) * (reached / sums.distance[node]);
+          }
+        }
+        graph->GetData<ClosenessCentralityValue>(node) =
+            std::min(centrality, 1.0);
+      },
+      katana::no_stats(), katana::loopname("ClosenessCentrality Finalize"));
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::ClosenessCentrality(
+    PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx, ClosenessCentralityMeasure measure,
+    ClosenessCentralityPlan plan) {
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  return ClosenessCentralityImpl(&graph, measure, plan);
+}
+
+constexpr static const double kEpsilon = 1e-6;
+
+katana::Result<void>
+katana::analytics::ClosenessCentralityAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  auto is_bad = [&graph](const GNode& n) {
+    double centrality = graph.GetData<ClosenessCentralityValue>(n);
+    return !(centrality >= 0 && centrality <= 1 + kEpsilon);
+  };
+
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<ClosenessCentralityStatistics>
+katana::analytics::ClosenessCentralityStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GReduceMax<double> max_centrality;
+  katana::GReduceMin<double> min_centrality;
+  katana::GAccumulator<double> total_centrality;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        double centrality = graph.GetData<ClosenessCentralityValue>(n);
+        max_centrality.update(centrality);
+        min_centrality.update(centrality);
+        total_centrality += centrality;
+      },
+      katana::no_stats(), katana::loopname("ClosenessCentrality Statistics"));
+
+  return ClosenessCentralityStatistics{
+      max_centrality.reduce(), min_centrality.reduce(),
+      graph.NumNodes() > 0 ? total_centrality.reduce() / graph.NumNodes() : 0};
+}
+
+void
+katana::analytics::ClosenessCentralityStatistics::Print(
+    std::ostream& os) const {
+  os << "Maximum centrality = " << max_centrality << std::endl;
+  os << "Minimum centrality = " << min_centrality << std::endl;
+  os << "Average centrality = " << average_centrality << std::endl;
+}
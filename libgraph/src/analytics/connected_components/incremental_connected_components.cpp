@@ -0,0 +1,313 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/connected_components/incremental_connected_components.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <unordered_map>
+
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct NodeLabel : public katana::PODProperty<uint64_t> {};
+
+using NodeData = std::tuple<NodeLabel>;
+using EdgeData = std::tuple<>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+}  // namespace
+
+void
+IncrementalConnectedComponents::Initialize(uint64_t num_nodes) {
+  parent_.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { parent_[n].store(n, std::memory_order_relaxed); },
+      katana::no_stats());
+  num_components_ = num_nodes;
+}
+
+IncrementalConnectedComponents::Node
+IncrementalConnectedComponents::Label(Node node) const {
+  Node p = parent_[node].load(std::memory_order_relaxed);
+  while (p != node) {
+    node = p;
+    p = parent_[node].load(std::memory_order_relaxed);
+  }
+  return node;
+}
+
+bool
+IncrementalConnectedComponents::Link(Node a, Node b) {
+  auto find = [this](Node x) {
+    Node p = parent_[x].load(std::memory_order_relaxed);
+    while (p != x) {
+      // Path halving
+      Node grandparent = parent_[p].load(std::memory_order_relaxed);
+      parent_[x].compare_exchange_weak(
+          p, grandparent, std::memory_order_relaxed);
+      x = p;
+      p = parent_[x].load(std::memory_order_relaxed);
+    }
+    return x;
+  };
+
+  while (true) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+      return false;
+    }
+    // Hook the larger root below the smaller one so that every root is the
+    // smallest node of its tree
+    if (a < b) {
+      std::swap(a, b);
+    }
+    Node expected = a;
+    if (parent_[a].compare_exchange_strong(
+            expected, b, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+void
+IncrementalConnectedComponents::Compress() {
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes()),
+      [&](uint64_t n) {
+        parent_[n].store(Label(n), std::memory_order_relaxed);
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("IncrementalCC-Compress"));
+}
+
+katana::Result<IncrementalConnectedComponents>
+IncrementalConnectedComponents::Make(
+    const katana::PropertyGraph& pg, bool is_symmetric,
+    const ConnectedComponentsPlan& plan) {
+  const auto& topology = pg.topology();
+  const uint64_t num_nodes = topology.NumNodes();
+  if (num_nodes > std::numeric_limits<Node>::max()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "too many nodes: {}", num_nodes);
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("IncrementalConnectedComponents");
+  exec_time.start();
+
+  IncrementalConnectedComponents cc;
+  cc.Initialize(num_nodes);
+  if (num_nodes == 0) {
+    return cc;
+  }
+
+  // Link the first few neighbors of every node
+  const uint32_t neighbor_sample_size = plan.neighbor_sample_size();
+  for (uint32_t r = 0; r < neighbor_sample_size; ++r) {
+    katana::do_all(
+        katana::iterate(topology.Nodes()),
+        [&](const Node& n) {
+          auto edges = topology.OutEdges(n);
+          if (r < edges.size()) {
+            cc.Link(n, topology.OutEdgeDst(*edges.begin() + r));
+          }
+        },
+        katana::steal(), katana::loopname("IncrementalCC-VNS-Link"));
+    cc.Compress();
+  }
+
+  // The sampled subgraph very likely already holds most of the largest
+  // component; its nodes need not be visited again
+  Node largest = num_nodes;
+  if (is_symmetric && plan.component_sample_frequency() > 0) {
+    std::unordered_map<Node, uint32_t> frequency;
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<Node> dist(0, num_nodes - 1);
+    for (uint32_t i = 0; i < plan.component_sample_frequency(); ++i) {
+      ++frequency[cc.Label(dist(rng))];
+    }
+    largest = std::max_element(
+                  frequency.begin(), frequency.end(),
+                  [](const auto& a, const auto& b) {
+                    return a.second < b.second;
+                  })
+                  ->first;
+  }
+
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const Node& n) {
+        if (cc.Label(n) == largest) {
+          return;
+        }
+        auto edges = topology.OutEdges(n);
+        uint64_t skip = std::min<uint64_t>(neighbor_sample_size, edges.size());
+        for (auto e = *edges.begin() + skip; e < *edges.end(); ++e) {
+          cc.Link(n, topology.OutEdgeDst(e));
+        }
+      },
+      katana::steal(), katana::loopname("IncrementalCC-LCS-Link"));
+  cc.Compress();
+
+  katana::GAccumulator<uint64_t> roots;
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const Node& n) {
+        if (cc.parent_[n].load(std::memory_order_relaxed) == n) {
+          roots += 1;
+        }
+      },
+      katana::no_stats());
+  cc.num_components_ = roots.reduce();
+
+  exec_time.stop();
+  return cc;
+}
+
+katana::Result<IncrementalConnectedComponents>
+IncrementalConnectedComponents::FromLabels(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+  const uint64_t num_nodes = graph.NumNodes();
+
+  // Labels must name the smallest node of a component, which is labeled
+  // with itself
+  auto is_bad = [&](const Node& n) {
+    uint64_t label = graph.GetData<NodeLabel>(n);
+    return label > n || graph.GetData<NodeLabel>(label) != label;
+  };
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} does not hold connected component labels", property_name);
+  }
+
+  IncrementalConnectedComponents cc;
+  cc.parent_.allocateBlocked(num_nodes);
+  katana::GAccumulator<uint64_t> roots;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        uint64_t label = graph.GetData<NodeLabel>(n);
+        cc.parent_[n].store(label, std::memory_order_relaxed);
+        if (label == n) {
+          roots += 1;
+        }
+      },
+      katana::no_stats());
+  cc.num_components_ = roots.reduce();
+
+  return cc;
+}
+
+katana::Result<void>
+IncrementalConnectedComponents::InsertEdges(
+    const std::vector<std::pair<Node, Node>>& edges) {
+  katana::GReduceLogicalOr out_of_range;
+  katana::do_all(
+      katana::iterate(edges),
+      [&](const std::pair<Node, Node>& edge) {
+        if (edge.first >= num_nodes() || edge.second >= num_nodes()) {
+          out_of_range.update(true);
+        }
+      },
+      katana::no_stats());
+  if (out_of_range.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "edge endpoint is not a node; call AddNodes first");
+  }
+
+  katana::GAccumulator<uint64_t> merges;
+  katana::do_all(
+      katana::iterate(edges),
+      [&](const std::pair<Node, Node>& edge) {
+        if (Link(edge.first, edge.second)) {
+          merges += 1;
+        }
+      },
+      katana::steal(), katana::loopname("IncrementalCC-Insert"));
+
+  num_components_ -= merges.reduce();
+  katana::ReportStatSingle(
+      "IncrementalConnectedComponents", "Merges", merges.reduce());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+IncrementalConnectedComponents::AddNodes(uint64_t num_nodes) {
+  const uint64_t old_num_nodes = this->num_nodes();
+  if (num_nodes < old_num_nodes ||
+      num_nodes > std::numeric_limits<Node>::max()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "cannot grow {} nodes to {} nodes", old_num_nodes, num_nodes);
+  }
+
+  katana::NUMAArray<std::atomic<Node>> old_parent = std::move(parent_);
+  Initialize(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, old_num_nodes),
+      [&](uint64_t n) {
+        parent_[n].store(
+            old_parent[n].load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  num_components_ = num_components_ - old_num_nodes + num_nodes;
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+IncrementalConnectedComponents::WriteLabels(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::TxnContext* txn_ctx) const {
+  if (pg->topology().NumNodes() != num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "graph has {} nodes but components were computed for {}",
+        pg->topology().NumNodes(), num_nodes());
+  }
+
+  if (pg->HasNodeProperty(property_name)) {
+    KATANA_CHECKED(pg->RemoveNodeProperty(property_name, txn_ctx));
+  }
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {property_name}));
+
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) { graph.GetData<NodeLabel>(n) = Label(n); },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
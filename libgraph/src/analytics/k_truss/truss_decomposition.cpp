@@ -0,0 +1,489 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include "katana/Bag.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/k_truss/k_truss.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct EdgeTrussness : public katana::PODProperty<uint32_t> {};
+
+using NodeData = std::tuple<>;
+using EdgeData = std::tuple<EdgeTrussness>;
+using SortedGraphView = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::EdgesSortedByDestID, NodeData, EdgeData>;
+using GNode = SortedGraphView::Node;
+
+/// An edge of the sorted view
+using Edge = uint64_t;
+/// An undirected edge
+using EdgeID = uint64_t;
+
+constexpr EdgeID kNoEdge = std::numeric_limits<EdgeID>::max();
+
+Edge
+BeginEdge(const SortedGraphView& g, GNode n) {
+  return *g.OutEdges(n).begin();
+}
+
+Edge
+EndEdge(const SortedGraphView& g, GNode n) {
+  return *g.OutEdges(n).end();
+}
+
+/// The first edge of n whose destination is not less than dst.
+Edge
+LowerBound(const SortedGraphView& g, GNode n, GNode dst) {
+  Edge lo = BeginEdge(g, n);
+  Edge hi = EndEdge(g, n);
+  while (lo < hi) {
+    Edge mid = lo + (hi - lo) / 2;
+    if (g.OutEdgeDst(mid) < dst) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/// Whether e is the first of the parallel edges to its destination.
+bool
+IsFirst(const SortedGraphView& g, GNode n, Edge e) {
+  return e == BeginEdge(g, n) || g.OutEdgeDst(e - 1) != g.OutEdgeDst(e);
+}
+
+/// Call fn(i, j) for every common neighbor w of u and v other than u and v
+/// themselves, where i is the first edge from u to w and j the first edge
+/// from v to w. Only neighbors in [lower, ...) are considered.
+template <typename Fn>
+void
+ForEachCommonNeighbor(
+    const SortedGraphView& g, GNode u, GNode v, GNode lower, Fn fn) {
+  Edge i = LowerBound(g, u, lower);
+  Edge j = LowerBound(g, v, lower);
+  const Edge end_u = EndEdge(g, u);
+  const Edge end_v = EndEdge(g, v);
+  while (i < end_u && j < end_v) {
+    GNode wi = g.OutEdgeDst(i);
+    GNode wj = g.OutEdgeDst(j);
+    if (wi < wj) {
+      ++i;
+    } else if (wj < wi) {
+      ++j;
+    } else {
+      if (wi != u && wi != v) {
+        fn(i, j);
+      }
+      // Skip parallel edges
+      while (i < end_u && g.OutEdgeDst(i) == wi) {
+        ++i;
+      }
+      while (j < end_v && g.OutEdgeDst(j) == wi) {
+        ++j;
+      }
+    }
+  }
+}
+
+/// Maps every edge of the sorted view to the ID of its undirected edge, so
+/// that both directions and all parallel copies of an edge share one slot.
+/// IDs are dense: they number the first edges from each node to a larger
+/// neighbor in node order.
+class UndirectedEdgeIndex {
+public:
+  explicit UndirectedEdgeIndex(const SortedGraphView& g) {
+    const uint64_t num_nodes = g.NumNodes();
+    id_.allocateBlocked(g.NumEdges());
+
+    katana::NUMAArray<uint64_t> offsets;
+    offsets.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(g),
+        [&](const GNode& u) {
+          uint64_t count = 0;
+          for (Edge e = LowerBound(g, u, u + 1); e < EndEdge(g, u); ++e) {
+            count += IsFirst(g, u, e);
+          }
+          offsets[u] = count;
+        },
+        katana::steal(), katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        offsets.begin(), offsets.end(), offsets.begin());
+    num_edges_ = num_nodes == 0 ? 0 : offsets[num_nodes - 1];
+
+    src_.allocateBlocked(num_edges_);
+    dst_.allocateBlocked(num_edges_);
+    katana::do_all(
+        katana::iterate(g),
+        [&](const GNode& u) {
+          Edge first = LowerBound(g, u, u + 1);
+          uint64_t count = 0;
+          for (Edge e = first; e < EndEdge(g, u); ++e) {
+            count += IsFirst(g, u, e);
+          }
+          EdgeID next = offsets[u] - count;
+          for (Edge e = first; e < EndEdge(g, u); ++e) {
+            if (IsFirst(g, u, e)) {
+              id_[e] = next;
+              src_[next] = u;
+              dst_[next] = g.OutEdgeDst(e);
+              ++next;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    // The other edges reuse the ID of the first edge from the smaller node
+    katana::do_all(
+        katana::iterate(g),
+        [&](const GNode& u) {
+          for (Edge e = BeginEdge(g, u); e < EndEdge(g, u); ++e) {
+            GNode v = g.OutEdgeDst(e);
+            if (v == u) {
+              id_[e] = kNoEdge;
+            } else if (v < u) {
+              id_[e] = id_[LowerBound(g, v, u)];
+            } else if (!IsFirst(g, u, e)) {
+              id_[e] = id_[e - 1];
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  EdgeID Id(Edge e) const { return id_[e]; }
+  GNode Src(EdgeID id) const { return src_[id]; }
+  GNode Dst(EdgeID id) const { return dst_[id]; }
+  uint64_t num_edges() const { return num_edges_; }
+
+private:
+  katana::NUMAArray<EdgeID> id_;
+  katana::NUMAArray<GNode> src_;
+  katana::NUMAArray<GNode> dst_;
+  uint64_t num_edges_{0};
+};
+
+/// Count the triangles of every edge. Each triangle u < v < w is found once,
+/// from its edge u - v.
+void
+ComputeSupport(
+    const SortedGraphView& g, const UndirectedEdgeIndex& index,
+    katana::NUMAArray<std::atomic<uint32_t>>* support) {
+  katana::do_all(
+      katana::iterate(uint64_t{0}, index.num_edges()),
+      [&](EdgeID id) { (*support)[id].store(0, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, index.num_edges()),
+      [&](EdgeID uv) {
+        GNode u = index.Src(uv);
+        GNode v = index.Dst(uv);
+        uint32_t triangles = 0;
+        ForEachCommonNeighbor(g, u, v, v + 1, [&](Edge uw, Edge vw) {
+          ++triangles;
+          (*support)[index.Id(uw)].fetch_add(1, std::memory_order_relaxed);
+          (*support)[index.Id(vw)].fetch_add(1, std::memory_order_relaxed);
+        });
+        (*support)[uv].fetch_add(triangles, std::memory_order_relaxed);
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("TrussDecomposition-Support"));
+}
+
+/// Peel edges in order of support. Level l removes the edges whose support
+/// is at most l among the edges still there, which have trussness l + 2.
+/// Removing an edge lowers the support of the other two edges of each of
+/// its remaining triangles, which can pull them into the current level;
+/// they are removed in a later sub-round of the same level.
+void
+Peel(
+    const SortedGraphView& g, const UndirectedEdgeIndex& index,
+    katana::NUMAArray<std::atomic<uint32_t>>* support_ptr,
+    katana::NUMAArray<uint32_t>* trussness) {
+  auto& support = *support_ptr;
+  const uint64_t num_edges = index.num_edges();
+
+  katana::NUMAArray<uint8_t> processed;
+  katana::NUMAArray<uint8_t> in_current;
+  processed.allocateBlocked(num_edges);
+  in_current.allocateBlocked(num_edges);
+  katana::ParallelSTL::fill(processed.begin(), processed.end(), 0);
+  katana::ParallelSTL::fill(in_current.begin(), in_current.end(), 0);
+
+  auto alive = std::make_unique<katana::InsertBag<EdgeID>>();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](EdgeID id) { alive->push(id); }, katana::no_stats());
+  uint64_t num_alive = num_edges;
+  uint64_t processed_since_compaction = 0;
+
+  uint32_t level = 0;
+  uint64_t sub_rounds = 0;
+  while (num_alive > 0) {
+    // Skip empty levels
+    katana::GReduceMin<uint32_t> min_support;
+    katana::do_all(
+        katana::iterate(*alive),
+        [&](EdgeID id) {
+          if (!processed[id]) {
+            min_support.update(support[id].load(std::memory_order_relaxed));
+          }
+        },
+        katana::no_stats());
+    level = std::max(level, min_support.reduce());
+
+    auto current = std::make_unique<katana::InsertBag<EdgeID>>();
+    katana::do_all(
+        katana::iterate(*alive),
+        [&](EdgeID id) {
+          if (!processed[id] &&
+              support[id].load(std::memory_order_relaxed) <= level) {
+            in_current[id] = 1;
+            current->push(id);
+          }
+        },
+        katana::no_stats());
+
+    auto decrement = [&](EdgeID id, katana::InsertBag<EdgeID>* next) {
+      uint32_t old = support[id].fetch_sub(1, std::memory_order_relaxed);
+      if (old == level + 1) {
+        next->push(id);
+      } else if (old <= level) {
+        // Never drop below the level; the edge is already being removed
+        support[id].fetch_add(1, std::memory_order_relaxed);
+      }
+    };
+
+    while (!current->empty()) {
+      ++sub_rounds;
+      auto next = std::make_unique<katana::InsertBag<EdgeID>>();
+      katana::do_all(
+          katana::iterate(*current),
+          [&](EdgeID uv) {
+            GNode u = index.Src(uv);
+            GNode v = index.Dst(uv);
+            ForEachCommonNeighbor(g, u, v, 0, [&](Edge uw_edge, Edge vw_edge) {
+              EdgeID uw = index.Id(uw_edge);
+              EdgeID vw = index.Id(vw_edge);
+              if (processed[uw] || processed[vw]) {
+                return;
+              }
+              bool uw_above =
+                  support[uw].load(std::memory_order_relaxed) > level;
+              bool vw_above =
+                  support[vw].load(std::memory_order_relaxed) > level;
+              // When two edges of a triangle go in the same sub-round, the
+              // one with the smaller ID updates the third
+              if (uw_above && vw_above) {
+                decrement(uw, next.get());
+                decrement(vw, next.get());
+              } else if (uw_above) {
+                if (!in_current[vw] || uv < vw) {
+                  decrement(uw, next.get());
+                }
+              } else if (vw_above) {
+                if (!in_current[uw] || uv < uw) {
+                  decrement(vw, next.get());
+                }
+              }
+            });
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("TrussDecomposition-Peel"));
+
+      katana::GAccumulator<uint64_t> removed;
+      katana::do_all(
+          katana::iterate(*current),
+          [&](EdgeID id) {
+            processed[id] = 1;
+            in_current[id] = 0;
+            (*trussness)[id] = level + 2;
+            removed += 1;
+          },
+          katana::no_stats());
+      num_alive -= removed.reduce();
+      processed_since_compaction += removed.reduce();
+
+      katana::do_all(
+          katana::iterate(*next), [&](EdgeID id) { in_current[id] = 1; },
+          katana::no_stats());
+      current = std::move(next);
+    }
+
+    // Keep the scans of later levels proportional to the remaining edges
+    if (processed_since_compaction > num_alive) {
+      auto compacted = std::make_unique<katana::InsertBag<EdgeID>>();
+      katana::do_all(
+          katana::iterate(*alive),
+          [&](EdgeID id) {
+            if (!processed[id]) {
+              compacted->push(id);
+            }
+          },
+          katana::no_stats());
+      alive = std::move(compacted);
+      processed_since_compaction = 0;
+    }
+    ++level;
+  }
+
+  katana::ReportStatSingle("TrussDecomposition", "SubRounds", sub_rounds);
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::TrussDecomposition(
+    katana::TxnContext* txn_ctx, katana::PropertyGraph* pg,
+    const std::string& output_property_name) {
+  katana::ReportPageAllocGuard page_alloc;
+
+  KATANA_CHECKED(
+      pg->ConstructEdgeProperties<EdgeData>(txn_ctx, {output_property_name}));
+  auto graph =
+      KATANA_CHECKED(SortedGraphView::Make(pg, {}, {output_property_name}));
+
+  katana::StatTimer exec_time("TrussDecomposition");
+  exec_time.start();
+
+  UndirectedEdgeIndex index(graph);
+  katana::NUMAArray<std::atomic<uint32_t>> support;
+  support.allocateBlocked(index.num_edges());
+  ComputeSupport(graph, index, &support);
+
+  katana::NUMAArray<uint32_t> trussness;
+  trussness.allocateBlocked(index.num_edges());
+  Peel(graph, index, &support, &trussness);
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.OutEdges(n)) {
+          EdgeID id = index.Id(e);
+          graph.GetEdgeData<EdgeTrussness>(e) =
+              id == kNoEdge ? 0 : trussness[id];
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::TrussDecompositionAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(SortedGraphView::Make(pg, {}, {property_name}));
+
+  auto is_bad = [&](const GNode& u) {
+    for (auto e : graph.OutEdges(u)) {
+      GNode v = graph.OutEdgeDst(e);
+      uint32_t k = graph.GetEdgeData<EdgeTrussness>(e);
+      if (v == u) {
+        if (k != 0) {
+          return true;
+        }
+        continue;
+      }
+      Edge reverse = LowerBound(graph, v, u);
+      if (k < 2 || reverse == EndEdge(graph, v) ||
+          graph.OutEdgeDst(reverse) != u ||
+          graph.GetEdgeData<EdgeTrussness>(reverse) != k) {
+        return true;
+      }
+
+      uint32_t at_least_k = 0;
+      uint32_t above_k = 0;
+      ForEachCommonNeighbor(graph, u, v, 0, [&](Edge uw, Edge vw) {
+        uint32_t k_uw = graph.GetEdgeData<EdgeTrussness>(uw);
+        uint32_t k_vw = graph.GetEdgeData<EdgeTrussness>(vw);
+        at_least_k += k_uw >= k && k_vw >= k;
+        above_k += k_uw > k && k_vw > k;
+      });
+      if (at_least_k + 2 < k || above_k + 1 >= k) {
+        KATANA_LOG_DEBUG(
+            "{} - {} (trussness: {}) has {} triangles of trussness {} or "
+            "more and {} above",
+            u, v, k, at_least_k, k, above_k);
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<TrussDecompositionStatistics>
+katana::analytics::TrussDecompositionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(SortedGraphView::Make(pg, {}, {property_name}));
+
+  katana::GReduceMax<uint32_t> max_trussness;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.OutEdges(n)) {
+          max_trussness.update(graph.GetEdgeData<EdgeTrussness>(e));
+        }
+      },
+      katana::no_stats());
+  uint32_t max = max_trussness.reduce();
+
+  katana::GAccumulator<uint64_t> max_truss_edges;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.OutEdges(n)) {
+          if (n < graph.OutEdgeDst(e) && IsFirst(graph, n, e) &&
+              graph.GetEdgeData<EdgeTrussness>(e) == max) {
+            max_truss_edges += 1;
+          }
+        }
+      },
+      katana::no_stats(), katana::loopname("TrussDecomposition Statistics"));
+
+  return TrussDecompositionStatistics{max, max_truss_edges.reduce()};
+}
+
+void
+katana::analytics::TrussDecompositionStatistics::Print(std::ostream& os) const {
+  os << "Maximum trussness = " << max_trussness << std::endl;
+  os << "Number of edges with maximum trussness = " << max_truss_edges
+     << std::endl;
+}
@@ -98,6 +98,10 @@ struct LeidenClusteringImplementation
             c_info[n_data_curr_comm_id].degree_wt, n_data_degree_wt);
       });
     }
+
+    typename Base::PerThreadClusterWeights cluster_weights;
+    Base::ReserveClusterWeights(*graph, &cluster_weights);
+
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
     while (true) {
@@ -114,21 +118,18 @@ struct LeidenClusteringImplementation
 
             uint64_t degree = Degree(*graph, n);
             uint64_t local_target = Base::UNASSIGNED;
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            auto& local_cluster_weights = *cluster_weights.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  *graph, n, cluster_local_map, counter, self_loop_wt);
+                  *graph, n, &local_cluster_weights, self_loop_wt);
               // Find the max gain in modularity
               local_target = Base::MaxModularityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
+                  local_cluster_weights, self_loop_wt, c_info,
                   n_data_node_wt, n_data_curr_comm_id,
                   constant_for_second_term);
+              local_cluster_weights.Clear();
             } else {
               local_target = Base::UNASSIGNED;
             }
@@ -255,6 +256,9 @@ struct LeidenClusteringImplementation
       c_update_subtract[n].node_wt = 0;
     });
 
+    typename Base::PerThreadClusterWeights cluster_weights;
+    Base::ReserveClusterWeights(*graph, &cluster_weights);
+
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
@@ -275,21 +279,18 @@ struct LeidenClusteringImplementation
 
               uint64_t degree = Degree(*graph, n);
 
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              auto& local_cluster_weights = *cluster_weights.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    *graph, n, cluster_local_map, counter, self_loop_wt);
+                    *graph, n, &local_cluster_weights, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
+                    local_cluster_weights, self_loop_wt, c_info,
                     n_data_degree_wt, n_data_curr_comm_id,
                     constant_for_second_term);
+                local_cluster_weights.Clear();
 
               } else {
                 local_target[n] = 0;
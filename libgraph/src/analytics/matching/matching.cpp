@@ -0,0 +1,632 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/matching/matching.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct NodeMate : public katana::PODProperty<uint32_t> {};
+
+using NodeData = std::tuple<NodeMate>;
+using EdgeData = std::tuple<>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+using GNode = uint32_t;
+using MateArray = katana::NUMAArray<std::atomic<uint32_t>>;
+
+uint32_t
+MateOf(const MateArray& mate, GNode n) {
+  return mate[n].load(std::memory_order_relaxed);
+}
+
+/// A symmetric pseudo-random priority that breaks ties between edges of
+/// equal weight.
+uint64_t
+EdgePriority(uint32_t a, uint32_t b) {
+  uint64_t x = (uint64_t{std::min(a, b)} << 32U | std::max(a, b)) *
+               0x9e3779b97f4a7c15ULL;
+  return x ^ (x >> 29U);
+}
+
+template <typename Weight>
+katana::Result<katana::NUMAArray<double>>
+ReadWeights(katana::PropertyGraph* pg, const std::string& property_name) {
+  using WeightGraph = katana::TypedPropertyGraph<
+      std::tuple<>, std::tuple<katana::PODProperty<Weight>>>;
+  auto graph = KATANA_CHECKED(WeightGraph::Make(pg, {}, {property_name}));
+
+  katana::NUMAArray<double> weights;
+  weights.allocateBlocked(graph.NumEdges());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.OutEdges(n)) {
+          weights[e] =
+              graph.template GetEdgeData<katana::PODProperty<Weight>>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return weights;
+}
+
+/// Edge weights as doubles; all ones if property_name is empty.
+katana::Result<katana::NUMAArray<double>>
+GetWeights(katana::PropertyGraph* pg, const std::string& property_name) {
+  if (property_name.empty()) {
+    katana::NUMAArray<double> weights;
+    weights.allocateBlocked(pg->NumEdges());
+    katana::ParallelSTL::fill(weights.begin(), weights.end(), 1.0);
+    return weights;
+  }
+
+  auto property = KATANA_CHECKED(pg->GetEdgeProperty(property_name));
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return ReadWeights<uint32_t>(pg, property_name);
+  case arrow::Int32Type::type_id:
+    return ReadWeights<int32_t>(pg, property_name);
+  case arrow::UInt64Type::type_id:
+    return ReadWeights<uint64_t>(pg, property_name);
+  case arrow::Int64Type::type_id:
+    return ReadWeights<int64_t>(pg, property_name);
+  case arrow::FloatType::type_id:
+    return ReadWeights<float>(pg, property_name);
+  case arrow::DoubleType::type_id:
+    return ReadWeights<double>(pg, property_name);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported weight type: {}",
+        property->type()->ToString());
+  }
+}
+
+using EndpointArray = katana::NUMAArray<std::pair<uint64_t, uint64_t>>;
+
+/// The edges sorted by their endpoints, as pairs of the key
+/// (min endpoint << 32 | max endpoint) and the edge ID, so that the
+/// directions of an undirected edge (and any parallel edges) are adjacent.
+EndpointArray
+SortByEndpoints(const katana::GraphTopology& topology) {
+  EndpointArray by_endpoints;
+  by_endpoints.allocateBlocked(topology.NumEdges());
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& u) {
+        for (auto e : topology.OutEdges(u)) {
+          GNode v = topology.OutEdgeDst(e);
+          uint64_t key = uint64_t{std::min(u, v)} << 32U | std::max(u, v);
+          by_endpoints[e] = std::make_pair(key, uint64_t{e});
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::sort(by_endpoints.begin(), by_endpoints.end());
+  return by_endpoints;
+}
+
+/// Call fn(begin, end) for every run of edges between the same endpoints.
+template <typename Fn>
+void
+ForEachEndpointRun(const EndpointArray& by_endpoints, const Fn& fn) {
+  const uint64_t num_edges = by_endpoints.size();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t begin) {
+        uint64_t key = by_endpoints[begin].first;
+        if (begin > 0 && by_endpoints[begin - 1].first == key) {
+          return;
+        }
+        uint64_t end = begin;
+        while (end < num_edges && by_endpoints[end].first == key) {
+          ++end;
+        }
+        fn(begin, end);
+      },
+      katana::no_stats());
+}
+
+/// Whether every edge other than a self loop has a reverse edge. Both
+/// algorithms rely on it: locally dominant matching waits for a node to
+/// propose back, which a node without the reverse edge never does.
+bool
+IsSymmetric(
+    const katana::GraphTopology& topology, const EndpointArray& by_endpoints) {
+  katana::GReduceLogicalOr one_way;
+  ForEachEndpointRun(by_endpoints, [&](uint64_t begin, uint64_t end) {
+    GNode high = by_endpoints[begin].first & 0xFFFFFFFFU;
+    GNode low = by_endpoints[begin].first >> 32U;
+    if (low == high) {
+      return;
+    }
+    bool up = false;
+    bool down = false;
+    for (uint64_t i = begin; i < end; ++i) {
+      bool to_high = topology.OutEdgeDst(by_endpoints[i].second) == high;
+      up |= to_high;
+      down |= !to_high;
+    }
+    if (!up || !down) {
+      one_way.update(true);
+    }
+  });
+  return !one_way.reduce();
+}
+
+/// Give both directions of every undirected edge the larger of their weights.
+/// Locally dominant matching needs a total order on undirected edges: with
+/// different weights in the two directions, nodes can propose around a cycle
+/// forever and the approximation guarantee is lost.
+void
+SymmetrizeWeights(
+    const EndpointArray& by_endpoints, katana::NUMAArray<double>* weights) {
+  ForEachEndpointRun(by_endpoints, [&](uint64_t begin, uint64_t end) {
+    double weight = (*weights)[by_endpoints[begin].second];
+    for (uint64_t i = begin; i < end; ++i) {
+      weight = std::max(weight, (*weights)[by_endpoints[i].second]);
+    }
+    for (uint64_t i = begin; i < end; ++i) {
+      (*weights)[by_endpoints[i].second] = weight;
+    }
+  });
+}
+
+/// Rounds of handshakes between unmatched nodes. The heaviest remaining edge
+/// is always mutual, so every round matches at least one edge; with random
+/// tie breaking the number of rounds is logarithmic in expectation. Only
+/// nodes left with an unmatched neighbor take part in the next round.
+void
+LocallyDominantMatching(
+    const katana::GraphTopology& topology,
+    const katana::NUMAArray<double>& weights, MateArray* mate) {
+  const uint32_t num_nodes = topology.NumNodes();
+
+  katana::NUMAArray<uint32_t> candidate;
+  candidate.allocateBlocked(num_nodes);
+
+  katana::InsertBag<GNode> active;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](const GNode& n) {
+        if (MateOf(*mate, n) == kUnmatchedNode) {
+          active.push(n);
+        }
+      },
+      katana::no_stats());
+
+  uint64_t rounds = 0;
+  while (!active.empty()) {
+    ++rounds;
+    katana::do_all(
+        katana::iterate(active),
+        [&](const GNode& n) {
+          uint32_t best = kUnmatchedNode;
+          double best_weight = 0;
+          uint64_t best_priority = 0;
+          for (auto e : topology.OutEdges(n)) {
+            GNode v = topology.OutEdgeDst(e);
+            if (v == n || MateOf(*mate, v) != kUnmatchedNode) {
+              continue;
+            }
+            uint64_t priority = EdgePriority(n, v);
+            if (best == kUnmatchedNode || weights[e] > best_weight ||
+                (weights[e] == best_weight && priority > best_priority)) {
+              best = v;
+              best_weight = weights[e];
+              best_priority = priority;
+            }
+          }
+          candidate[n] = best;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Matching-Propose"));
+
+    katana::InsertBag<GNode> next;
+    katana::do_all(
+        katana::iterate(active),
+        [&](const GNode& n) {
+          GNode v = candidate[n];
+          if (v == kUnmatchedNode) {
+            return;
+          }
+          if (candidate[v] == n) {
+            // The smaller endpoint writes both mates
+            if (n < v) {
+              (*mate)[n].store(v, std::memory_order_relaxed);
+              (*mate)[v].store(n, std::memory_order_relaxed);
+            }
+            return;
+          }
+          next.push(n);
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Matching-Handshake"));
+
+    // Nodes whose candidate was matched elsewhere try again
+    active.clear();
+    for (auto n : next) {
+      active.push(n);
+    }
+  }
+  katana::ReportStatSingle("Matching", "Rounds", rounds);
+}
+
+/// Split nodes into two sides by connected components of the bipartite
+/// double cover, which has nodes (v, 0) and (v, 1) and, for every edge u - v,
+/// edges (u, 0) - (v, 1) and (u, 1) - (v, 0). The graph is bipartite iff
+/// (v, 0) and (v, 1) are never in the same component, and comparing their
+/// component roots gives a 2-coloring.
+katana::Result<katana::NUMAArray<uint8_t>>
+TwoColor(const katana::GraphTopology& topology) {
+  const uint32_t num_nodes = topology.NumNodes();
+
+  katana::NUMAArray<std::atomic<uint64_t>> parent;
+  parent.allocateBlocked(2 * uint64_t{num_nodes});
+  katana::do_all(
+      katana::iterate(uint64_t{0}, 2 * uint64_t{num_nodes}),
+      [&](uint64_t x) { parent[x].store(x, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  auto find = [&](uint64_t x) {
+    uint64_t p = parent[x].load(std::memory_order_relaxed);
+    while (p != x) {
+      // Path halving
+      uint64_t grandparent = parent[p].load(std::memory_order_relaxed);
+      parent[x].compare_exchange_weak(
+          p, grandparent, std::memory_order_relaxed);
+      x = p;
+      p = parent[x].load(std::memory_order_relaxed);
+    }
+    return x;
+  };
+
+  // Link the larger root below the smaller one
+  auto unite = [&](uint64_t a, uint64_t b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      uint64_t expected = a;
+      if (parent[a].compare_exchange_strong(
+              expected, b, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  };
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](const GNode& u) {
+        for (auto e : topology.OutEdges(u)) {
+          GNode v = topology.OutEdgeDst(e);
+          if (u < v) {
+            unite(2 * uint64_t{u}, 2 * uint64_t{v} + 1);
+            unite(2 * uint64_t{u} + 1, 2 * uint64_t{v});
+          } else if (u == v) {
+            unite(2 * uint64_t{u}, 2 * uint64_t{u} + 1);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("Matching-TwoColor"));
+
+  katana::NUMAArray<uint8_t> left;
+  left.allocateBlocked(num_nodes);
+  katana::GReduceLogicalOr odd_cycle;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](const GNode& n) {
+        uint64_t even = find(2 * uint64_t{n});
+        uint64_t odd = find(2 * uint64_t{n} + 1);
+        if (even == odd) {
+          odd_cycle.update(true);
+        }
+        left[n] = even < odd;
+      },
+      katana::no_stats());
+
+  if (odd_cycle.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "Pothen-Fan matching requires a bipartite graph");
+  }
+  return left;
+}
+
+/// One DFS of a Pothen-Fan phase. Right side nodes are claimed with the
+/// phase stamp, so the augmenting paths of a phase are vertex disjoint and
+/// only the DFS that claimed a node changes its mate.
+class PothenFanSearch {
+public:
+  PothenFanSearch(
+      const katana::GraphTopology& topology, MateArray* mate,
+      katana::NUMAArray<std::atomic<uint32_t>>* visited,
+      katana::NUMAArray<uint64_t>* lookahead)
+      : topology_(topology),
+        mate_(*mate),
+        visited_(*visited),
+        lookahead_(*lookahead) {}
+
+  /// Search for an augmenting path from the unmatched left node root and
+  /// augment along it. Returns true if a path was found.
+  bool Search(GNode root, uint32_t stamp) {
+    stack_.clear();
+    path_.clear();
+    stack_.emplace_back(root, *topology_.OutEdges(root).begin());
+
+    while (!stack_.empty()) {
+      GNode x = stack_.back().first;
+
+      // Lookahead: a free neighbor ends the search right away
+      auto end = *topology_.OutEdges(x).end();
+      for (auto& la = lookahead_[x]; la < end;) {
+        GNode r = topology_.OutEdgeDst(la++);
+        if (MateOf(mate_, r) == kUnmatchedNode && Claim(r, stamp)) {
+          Augment(r);
+          return true;
+        }
+      }
+
+      auto& it = stack_.back().second;
+      bool descended = false;
+      for (; it < end; ++it) {
+        GNode r = topology_.OutEdgeDst(it);
+        if (!Claim(r, stamp)) {
+          continue;
+        }
+        GNode m = MateOf(mate_, r);
+        if (m == kUnmatchedNode) {
+          Augment(r);
+          return true;
+        }
+        ++it;
+        path_.push_back(r);
+        stack_.emplace_back(m, *topology_.OutEdges(m).begin());
+        descended = true;
+        break;
+      }
+
+      if (!descended) {
+        stack_.pop_back();
+        if (!path_.empty()) {
+          path_.pop_back();
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  bool Claim(GNode r, uint32_t stamp) {
+    auto& v = visited_[r];
+    return v.load(std::memory_order_relaxed) != stamp &&
+           v.exchange(stamp, std::memory_order_relaxed) != stamp;
+  }
+
+  /// stack_[i] is matched with path_[i - 1]; shift every left node on the
+  /// stack to the next right node and match the last one with free.
+  void Augment(GNode free) {
+    GNode r = free;
+    for (size_t i = stack_.size(); i-- > 0;) {
+      GNode x = stack_[i].first;
+      GNode next_r = i > 0 ? path_[i - 1] : kUnmatchedNode;
+      mate_[x].store(r, std::memory_order_relaxed);
+      mate_[r].store(x, std::memory_order_relaxed);
+      r = next_r;
+    }
+  }
+
+  const katana::GraphTopology& topology_;
+  MateArray& mate_;
+  katana::NUMAArray<std::atomic<uint32_t>>& visited_;
+  katana::NUMAArray<uint64_t>& lookahead_;
+
+  std::vector<std::pair<GNode, uint64_t>> stack_;
+  std::vector<GNode> path_;
+};
+
+katana::Result<void>
+PothenFanMatching(const katana::GraphTopology& topology, MateArray* mate) {
+  const uint32_t num_nodes = topology.NumNodes();
+  auto left = KATANA_CHECKED(TwoColor(topology));
+
+  // A maximal matching leaves few nodes for the augmenting searches
+  katana::NUMAArray<double> unit_weights;
+  unit_weights.allocateBlocked(topology.NumEdges());
+  katana::ParallelSTL::fill(unit_weights.begin(), unit_weights.end(), 1.0);
+  LocallyDominantMatching(topology, unit_weights, mate);
+
+  katana::NUMAArray<std::atomic<uint32_t>> visited;
+  visited.allocateBlocked(num_nodes);
+  katana::NUMAArray<uint64_t> lookahead;
+  lookahead.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](const GNode& n) {
+        visited[n].store(0, std::memory_order_relaxed);
+        lookahead[n] = *topology.OutEdges(n).begin();
+      },
+      katana::no_stats());
+
+  katana::PerThreadStorage<PothenFanSearch> searches(
+      topology, mate, &visited, &lookahead);
+
+  uint32_t stamp = 0;
+  while (true) {
+    ++stamp;
+    katana::GAccumulator<uint64_t> augmented;
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](const GNode& n) {
+          if (left[n] && MateOf(*mate, n) == kUnmatchedNode &&
+              searches.getLocal()->Search(n, stamp)) {
+            augmented += 1;
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Matching-PothenFan"));
+    if (augmented.reduce() == 0) {
+      break;
+    }
+  }
+  katana::ReportStatSingle("Matching", "Phases", stamp);
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Matching(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    MatchingPlan plan) {
+  EndpointArray by_endpoints = SortByEndpoints(pg->topology());
+  if (!IsSymmetric(pg->topology(), by_endpoints)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "Matching requires a symmetric graph");
+  }
+
+  katana::NUMAArray<double> weights;
+  if (plan.algorithm() == MatchingPlan::kLocallyDominant) {
+    weights = KATANA_CHECKED(GetWeights(pg, edge_weight_property_name));
+    if (!edge_weight_property_name.empty()) {
+      SymmetrizeWeights(by_endpoints, &weights);
+    }
+  }
+  by_endpoints.deallocate();
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("Matching");
+  exec_time.start();
+
+  const auto& topology = pg->topology();
+  MateArray mate;
+  mate.allocateBlocked(topology.NumNodes());
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& n) {
+        mate[n].store(kUnmatchedNode, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  switch (plan.algorithm()) {
+  case MatchingPlan::kLocallyDominant:
+    LocallyDominantMatching(topology, weights, &mate);
+    break;
+  case MatchingPlan::kPothenFan:
+    KATANA_CHECKED(PothenFanMatching(topology, &mate));
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "Unknown algorithm");
+  }
+  exec_time.stop();
+
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeMate>(n) = MateOf(mate, n); },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::MatchingAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+  const uint32_t num_nodes = graph.NumNodes();
+
+  auto is_bad = [&](const GNode& n) {
+    uint32_t m = graph.GetData<NodeMate>(n);
+    if (m == kUnmatchedNode) {
+      // Maximal: no unmatched neighbor
+      for (auto e : graph.OutEdges(n)) {
+        GNode v = graph.OutEdgeDst(e);
+        if (v != n && graph.GetData<NodeMate>(v) == kUnmatchedNode) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (m >= num_nodes || m == n || graph.GetData<NodeMate>(m) != n) {
+      return true;
+    }
+    for (auto e : graph.OutEdges(n)) {
+      if (graph.OutEdgeDst(e) == m) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<MatchingStatistics>
+katana::analytics::MatchingStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GAccumulator<uint64_t> matched;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        if (graph.GetData<NodeMate>(n) != kUnmatchedNode) {
+          matched += 1;
+        }
+      },
+      katana::no_stats(), katana::loopname("Matching Statistics"));
+
+  uint64_t num_matched = matched.reduce();
+  return MatchingStatistics{num_matched / 2, graph.NumNodes() - num_matched};
+}
+
+void
+katana::analytics::MatchingStatistics::Print(std::ostream& os) const {
+  os << "Matched edges = " << cardinality << std::endl;
+  os << "Unmatched nodes = " << num_unmatched_nodes << std::endl;
+}
@@ -0,0 +1,688 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/max_flow/max_flow.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "katana/BulkSynchronous.h"
+#include "katana/NUMAArray.h"
+#include "katana/Range.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/WorkList.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct EdgeFlow : public katana::PODProperty<uint64_t> {};
+struct SourceSide : public katana::PODProperty<uint8_t> {};
+
+template <typename Capacity>
+using EdgeCapacity = katana::PODProperty<Capacity>;
+
+template <typename Capacity>
+using Graph = katana::TypedPropertyGraph<
+    std::tuple<SourceSide>, std::tuple<EdgeFlow, EdgeCapacity<Capacity>>>;
+
+using GNode = uint32_t;
+
+/// Goldberg's global relabel frequency parameters, as in preflowpush
+constexpr uint64_t kGlobalRelabelAlpha = 6;
+constexpr uint64_t kRelabelWork = 12;
+
+/// A gap only triggers a global relabel once this fraction of the global
+/// relabel interval has passed since the last one.
+constexpr uint64_t kGapRelabelFraction = 16;
+
+constexpr unsigned kChunkSize = 16;
+
+/// Call fn with a value of the type of the capacity property
+template <typename Fn>
+katana::Result<void>
+WithCapacityType(
+    katana::PropertyGraph* pg, const std::string& capacity_property_name,
+    Fn fn) {
+  auto capacity = KATANA_CHECKED(pg->GetEdgeProperty(capacity_property_name));
+  switch (capacity->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return fn(uint32_t{});
+  case arrow::Int32Type::type_id:
+    return fn(int32_t{});
+  case arrow::UInt64Type::type_id:
+    return fn(uint64_t{});
+  case arrow::Int64Type::type_id:
+    return fn(int64_t{});
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported capacity type: {}",
+        capacity->type()->ToString());
+  }
+}
+
+/// The residual graph in CSR form. Every edge u -> v of the property graph
+/// gives a forward arc u -> v holding its remaining capacity and a backward
+/// arc v -> u holding its flow. The arcs of a node are its forward arcs in
+/// edge order followed by its backward arcs.
+struct ResidualGraph {
+  katana::NUMAArray<uint64_t> arc_begin;
+  katana::NUMAArray<GNode> head;
+  katana::NUMAArray<uint64_t> reverse;
+  katana::NUMAArray<std::atomic<int64_t>> residual;
+  /// The forward arc of each edge of the property graph
+  katana::NUMAArray<uint64_t> forward_arc;
+
+  uint32_t num_nodes() const { return arc_begin.size() - 1; }
+
+  auto arcs(GNode n) const {
+    using Iterator = boost::counting_iterator<uint64_t>;
+    return katana::MakeStandardRange(
+        Iterator{arc_begin[n]}, Iterator{arc_begin[n + 1]});
+  }
+};
+
+template <typename Capacity>
+ResidualGraph
+MakeResidualGraph(const Graph<Capacity>& graph) {
+  const uint32_t num_nodes = graph.NumNodes();
+  const uint64_t num_edges = graph.NumEdges();
+
+  katana::NUMAArray<std::atomic<uint64_t>> in_degree;
+  in_degree.allocateBlocked(num_nodes);
+  katana::ParallelSTL::fill(in_degree.begin(), in_degree.end(), 0);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.OutEdges(n)) {
+          in_degree[graph.OutEdgeDst(e)].fetch_add(
+              1, std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  ResidualGraph rg;
+  rg.arc_begin.allocateBlocked(num_nodes + 1);
+  rg.arc_begin[0] = 0;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        rg.arc_begin[n + 1] =
+            graph.OutDegree(n) + in_degree[n].load(std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      rg.arc_begin.begin(), rg.arc_begin.end(), rg.arc_begin.begin());
+
+  // in_degree now tracks the next free backward arc of each node
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        in_degree[n].store(
+            rg.arc_begin[n] + graph.OutDegree(n), std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  rg.head.allocateBlocked(2 * num_edges);
+  rg.reverse.allocateBlocked(2 * num_edges);
+  rg.residual.allocateBlocked(2 * num_edges);
+  rg.forward_arc.allocateBlocked(num_edges);
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& u) {
+        auto forward = rg.arc_begin[u];
+        for (auto e : graph.OutEdges(u)) {
+          GNode v = graph.OutEdgeDst(e);
+          auto backward =
+              in_degree[v].fetch_add(1, std::memory_order_relaxed);
+
+          rg.head[forward] = v;
+          rg.reverse[forward] = backward;
+          rg.residual[forward].store(
+              graph.template GetEdgeData<EdgeCapacity<Capacity>>(e),
+              std::memory_order_relaxed);
+
+          rg.head[backward] = u;
+          rg.reverse[backward] = forward;
+          rg.residual[backward].store(0, std::memory_order_relaxed);
+
+          rg.forward_arc[e] = forward;
+          ++forward;
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("MaxFlow-BuildResidual"));
+
+  return rg;
+}
+
+/// Push-relabel toward a target node. The same machinery runs twice: first
+/// toward the sink to find a maximum preflow, then toward the source to
+/// return the excess that cannot reach the sink, which leaves a flow.
+class PushRelabel {
+public:
+  PushRelabel(ResidualGraph* rg, uint64_t global_relabel_interval)
+      : rg_(*rg), global_relabel_interval_(global_relabel_interval) {
+    const uint32_t num_nodes = rg_.num_nodes();
+    excess_.allocateBlocked(num_nodes);
+    height_.allocateBlocked(num_nodes);
+    height_count_.allocateBlocked(num_nodes + 1);
+    katana::ParallelSTL::fill(excess_.begin(), excess_.end(), 0);
+  }
+
+  /// Saturate the arcs out of the source.
+  void InitializePreflow(GNode source) {
+    for (auto a : rg_.arcs(source)) {
+      int64_t amount = rg_.residual[a].load(std::memory_order_relaxed);
+      if (amount > 0) {
+        Push(a, amount);
+        excess_[source].fetch_sub(amount, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Discharge all active nodes toward target. Nodes at max_height or above
+  /// are not active.
+  void Run(GNode target, GNode other_terminal, uint32_t max_height) {
+    target_ = target;
+    other_terminal_ = other_terminal;
+    max_height_ = max_height;
+
+    katana::InsertBag<GNode> active;
+    GlobalRelabel(&active);
+    while (!active.empty()) {
+      should_global_relabel_ = false;
+      Discharge(active);
+      if (!should_global_relabel_) {
+        break;
+      }
+      active.clear();
+      GlobalRelabel(&active);
+    }
+  }
+
+  int64_t excess(GNode n) const {
+    return excess_[n].load(std::memory_order_relaxed);
+  }
+
+  uint64_t num_global_relabels() const { return num_global_relabels_; }
+
+private:
+  struct HeightIndexer {
+    const katana::NUMAArray<std::atomic<uint32_t>>* height;
+    uint32_t max_height;
+
+    /// Highest nodes first
+    uint32_t operator()(const GNode& n) const {
+      return max_height - (*height)[n].load(std::memory_order_relaxed);
+    }
+  };
+
+  using Chunk = katana::PerSocketChunkFIFO<kChunkSize>;
+  using OBIM = katana::OrderedByIntegerMetric<HeightIndexer, Chunk>;
+
+  bool IsTerminal(GNode n) const {
+    return n == target_ || n == other_terminal_;
+  }
+
+  uint32_t height(GNode n) const {
+    return height_[n].load(std::memory_order_relaxed);
+  }
+
+  /// Move amount along arc a. Returns true if the head of a had no excess
+  /// before, in which case the caller owns it.
+  bool Push(uint64_t a, int64_t amount) {
+    rg_.residual[a].fetch_sub(amount, std::memory_order_relaxed);
+    rg_.residual[rg_.reverse[a]].fetch_add(amount, std::memory_order_relaxed);
+    return excess_[rg_.head[a]].fetch_add(amount, std::memory_order_relaxed) ==
+           0;
+  }
+
+  /// Only the thread that owns u lowers its excess, lowers the residual
+  /// capacity of its arcs or changes its height, so the excess read at the
+  /// start of an iteration and the residual capacity of the chosen arc can
+  /// only have grown when the push happens. Ownership ends when the excess
+  /// of u reaches zero; whoever raises it from zero again owns u next.
+  template <typename Context>
+  uint64_t DischargeNode(GNode u, Context& ctx) {
+    uint64_t work = 1;
+    while (true) {
+      uint32_t min_height = std::numeric_limits<uint32_t>::max();
+      uint64_t min_arc = 0;
+      for (auto a : rg_.arcs(u)) {
+        if (rg_.residual[a].load(std::memory_order_relaxed) > 0) {
+          uint32_t h = height(rg_.head[a]);
+          if (h < min_height) {
+            min_height = h;
+            min_arc = a;
+          }
+        }
+      }
+
+      uint32_t u_height = height(u);
+      if (min_height < u_height) {
+        int64_t amount = std::min(
+            excess(u), rg_.residual[min_arc].load(std::memory_order_relaxed));
+        GNode v = rg_.head[min_arc];
+        if (Push(min_arc, amount) && !IsTerminal(v) &&
+            height(v) < max_height_) {
+          ctx.push(v);
+        }
+        if (excess_[u].fetch_sub(amount, std::memory_order_relaxed) ==
+            amount) {
+          break;
+        }
+        continue;
+      }
+
+      // Relabel
+      work += kRelabelWork;
+      uint32_t new_height =
+          min_height == std::numeric_limits<uint32_t>::max()
+              ? max_height_
+              : std::min(min_height + 1, max_height_);
+      const uint32_t num_nodes = rg_.num_nodes();
+      if (u_height < num_nodes &&
+          height_count_[u_height].fetch_sub(1, std::memory_order_relaxed) ==
+              1) {
+        gap_found_ = true;
+      }
+      if (new_height < num_nodes) {
+        height_count_[new_height].fetch_add(1, std::memory_order_relaxed);
+      }
+      height_[u].store(new_height, std::memory_order_relaxed);
+      if (new_height >= max_height_) {
+        break;
+      }
+    }
+    return work;
+  }
+
+  void Discharge(katana::InsertBag<GNode>& active) {
+    const uint64_t interval_per_thread =
+        std::max<uint64_t>(
+            1, global_relabel_interval_ / katana::getActiveThreads());
+    const uint64_t gap_interval_per_thread =
+        interval_per_thread / kGapRelabelFraction;
+
+    katana::GAccumulator<uint64_t> work;
+    katana::for_each(
+        katana::iterate(active),
+        [&](const GNode& u, auto& ctx) {
+          uint64_t& local_work = work.getLocal();
+          local_work += DischargeNode(u, ctx);
+
+          bool gap_relabel =
+              gap_found_ && local_work >= gap_interval_per_thread;
+          if (local_work >= interval_per_thread || gap_relabel) {
+            should_global_relabel_ = true;
+            ctx.breakLoop();
+          }
+        },
+        katana::wl<OBIM>(HeightIndexer{&height_, max_height_}),
+        katana::parallel_break(), katana::disable_conflict_detection(),
+        katana::loopname("MaxFlow-Discharge"));
+  }
+
+  /// Set every height to the distance to the target in the residual graph by
+  /// a backward BFS, and collect the active nodes.
+  void GlobalRelabel(katana::InsertBag<GNode>* active) {
+    ++num_global_relabels_;
+    gap_found_ = false;
+    const uint32_t num_nodes = rg_.num_nodes();
+
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](const GNode& n) {
+          height_[n].store(max_height_, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+    height_[target_].store(0, std::memory_order_relaxed);
+
+    katana::for_each(
+        katana::iterate({target_}),
+        [&](const GNode& x, auto& ctx) {
+          uint32_t new_height = height(x) + 1;
+          for (auto a : rg_.arcs(x)) {
+            GNode y = rg_.head[a];
+            if (y == other_terminal_ ||
+                rg_.residual[rg_.reverse[a]].load(std::memory_order_relaxed) ==
+                    0) {
+              continue;
+            }
+            uint32_t old_height = height(y);
+            while (new_height < old_height) {
+              if (height_[y].compare_exchange_weak(
+                      old_height, new_height, std::memory_order_relaxed)) {
+                ctx.push(y);
+                break;
+              }
+            }
+          }
+        },
+        katana::wl<katana::BulkSynchronous<>>(),
+        katana::disable_conflict_detection(),
+        katana::loopname("MaxFlow-GlobalRelabel"));
+
+    katana::ParallelSTL::fill(
+        height_count_.begin(), height_count_.end(), 0);
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](const GNode& n) {
+          uint32_t h = height(n);
+          if (h < num_nodes) {
+            height_count_[h].fetch_add(1, std::memory_order_relaxed);
+          }
+          if (!IsTerminal(n) && h < max_height_ && excess(n) > 0) {
+            active->push(n);
+          }
+        },
+        katana::no_stats(), katana::loopname("MaxFlow-FindWork"));
+  }
+
+  ResidualGraph& rg_;
+  uint64_t global_relabel_interval_;
+
+  katana::NUMAArray<std::atomic<int64_t>> excess_;
+  katana::NUMAArray<std::atomic<uint32_t>> height_;
+  katana::NUMAArray<std::atomic<uint64_t>> height_count_;
+
+  GNode target_{0};
+  GNode other_terminal_{0};
+  uint32_t max_height_{0};
+  std::atomic<bool> gap_found_{false};
+  std::atomic<bool> should_global_relabel_{false};
+  uint64_t num_global_relabels_{0};
+};
+
+/// Mark the nodes reachable from source in the residual graph.
+void
+MarkSourceSide(
+    const ResidualGraph& rg, GNode source,
+    katana::NUMAArray<std::atomic<uint8_t>>* source_side) {
+  katana::ParallelSTL::fill(source_side->begin(), source_side->end(), 0);
+  (*source_side)[source].store(1, std::memory_order_relaxed);
+
+  katana::for_each(
+      katana::iterate({source}),
+      [&](const GNode& x, auto& ctx) {
+        for (auto a : rg.arcs(x)) {
+          GNode y = rg.head[a];
+          if (rg.residual[a].load(std::memory_order_relaxed) > 0 &&
+              (*source_side)[y].exchange(1, std::memory_order_relaxed) == 0) {
+            ctx.push(y);
+          }
+        }
+      },
+      katana::wl<katana::BulkSynchronous<>>(),
+      katana::disable_conflict_detection(),
+      katana::loopname("MaxFlow-MinCut"));
+}
+
+template <typename Capacity>
+katana::Result<void>
+MaxFlowImpl(
+    Graph<Capacity>* graph, GNode source, GNode sink,
+    const MaxFlowPlan& plan) {
+  using Cap = EdgeCapacity<Capacity>;
+
+  auto is_negative = [&](const GNode& n) {
+    for (auto e : graph->OutEdges(n)) {
+      if (graph->template GetEdgeData<Cap>(e) < 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+  if (katana::ParallelSTL::find_if(graph->begin(), graph->end(), is_negative) !=
+      graph->end()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "capacities must be >= 0");
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("MaxFlow");
+  exec_time.start();
+
+  const uint32_t num_nodes = graph->NumNodes();
+  uint64_t interval = plan.global_relabel_interval();
+  if (interval == MaxFlowPlan::kDefaultGlobalRelabelInterval) {
+    interval = kGlobalRelabelAlpha * num_nodes + graph->NumEdges() / 3;
+  }
+
+  ResidualGraph rg = MakeResidualGraph(*graph);
+  PushRelabel push_relabel(&rg, interval);
+
+  // Phase one: a maximum preflow. Nodes that cannot reach the sink are lifted
+  // to num_nodes and keep their excess.
+  push_relabel.InitializePreflow(source);
+  push_relabel.Run(sink, source, num_nodes);
+
+  // Phase two: every node with excess can reach the source, so with heights
+  // up to 2 * num_nodes all of it returns there.
+  push_relabel.Run(source, sink, 2 * num_nodes);
+
+  katana::ReportStatSingle("MaxFlow", "FlowValue", push_relabel.excess(sink));
+  katana::ReportStatSingle(
+      "MaxFlow", "GlobalRelabels", push_relabel.num_global_relabels());
+
+  katana::NUMAArray<std::atomic<uint8_t>> source_side;
+  source_side.allocateBlocked(num_nodes);
+  MarkSourceSide(rg, source, &source_side);
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        graph->template GetData<SourceSide>(n) =
+            source_side[n].load(std::memory_order_relaxed);
+        for (auto e : graph->OutEdges(n)) {
+          graph->template GetEdgeData<EdgeFlow>(e) =
+              rg.residual[rg.reverse[rg.forward_arc[e]]].load(
+                  std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("MaxFlow-Extract"));
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+CheckTerminals(katana::PropertyGraph* pg, uint32_t source, uint32_t sink) {
+  if (source >= pg->NumNodes() || sink >= pg->NumNodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "source {} or sink {} is not a node", source, sink);
+  }
+  if (source == sink) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "source and sink must differ");
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MaxFlow(
+    katana::PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& capacity_property_name,
+    const std::string& output_flow_property_name,
+    const std::string& output_cut_property_name, katana::TxnContext* txn_ctx,
+    MaxFlowPlan plan) {
+  KATANA_CHECKED(CheckTerminals(pg, source, sink));
+
+  auto run = [&](auto tag) -> katana::Result<void> {
+    using Capacity = decltype(tag);
+    using G = Graph<Capacity>;
+
+    KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<SourceSide>>(
+        txn_ctx, {output_cut_property_name}));
+    KATANA_CHECKED(pg->ConstructEdgeProperties<std::tuple<EdgeFlow>>(
+        txn_ctx, {output_flow_property_name}));
+
+    G graph = KATANA_CHECKED(G::Make(
+        pg, {output_cut_property_name},
+        {output_flow_property_name, capacity_property_name}));
+
+    return MaxFlowImpl(&graph, source, sink, plan);
+  };
+  return WithCapacityType(pg, capacity_property_name, run);
+}
+
+katana::Result<void>
+katana::analytics::MaxFlowAssertValid(
+    katana::PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& capacity_property_name,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name) {
+  KATANA_CHECKED(CheckTerminals(pg, source, sink));
+
+  auto check = [&](auto tag) -> katana::Result<void> {
+    using Capacity = decltype(tag);
+    using G = Graph<Capacity>;
+    using Cap = EdgeCapacity<Capacity>;
+
+    G graph = KATANA_CHECKED(G::Make(
+        pg, {cut_property_name}, {flow_property_name, capacity_property_name}));
+
+    if (!graph.template GetData<SourceSide>(source) ||
+        graph.template GetData<SourceSide>(sink)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "cut does not separate source and sink");
+    }
+
+    // Net outflow of every node
+    katana::NUMAArray<std::atomic<int64_t>> net_flow;
+    net_flow.allocateBlocked(graph.NumNodes());
+    katana::ParallelSTL::fill(net_flow.begin(), net_flow.end(), 0);
+    katana::GReduceLogicalOr bad_edge;
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) {
+          bool n_side = graph.template GetData<SourceSide>(n);
+          for (auto e : graph.OutEdges(n)) {
+            uint64_t flow = graph.template GetEdgeData<EdgeFlow>(e);
+            auto capacity =
+                static_cast<uint64_t>(graph.template GetEdgeData<Cap>(e));
+            GNode dst = graph.OutEdgeDst(e);
+            bool dst_side = graph.template GetData<SourceSide>(dst);
+
+            if (flow > capacity) {
+              bad_edge.update(true);
+            }
+            // Edges leaving the cut are saturated, edges entering it empty
+            if (n_side && !dst_side && flow != capacity) {
+              bad_edge.update(true);
+            }
+            if (!n_side && dst_side && flow != 0) {
+              bad_edge.update(true);
+            }
+            net_flow[n].fetch_add(flow, std::memory_order_relaxed);
+            net_flow[dst].fetch_sub(flow, std::memory_order_relaxed);
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    if (bad_edge.reduce()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "flow exceeds a capacity or does not match the cut");
+    }
+
+    auto not_conserved = [&](const GNode& n) {
+      return n != source && n != sink &&
+             net_flow[n].load(std::memory_order_relaxed) != 0;
+    };
+    if (katana::ParallelSTL::find_if(
+            graph.begin(), graph.end(), not_conserved) != graph.end()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed, "flow is not conserved");
+    }
+
+    return katana::ResultSuccess();
+  };
+  return WithCapacityType(pg, capacity_property_name, check);
+}
+
+katana::Result<MaxFlowStatistics>
+katana::analytics::MaxFlowStatistics::Compute(
+    katana::PropertyGraph* pg, uint32_t source,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name) {
+  using G =
+      katana::TypedPropertyGraph<std::tuple<SourceSide>, std::tuple<EdgeFlow>>;
+  if (source >= pg->NumNodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "source {} is not a node", source);
+  }
+
+  G graph =
+      KATANA_CHECKED(G::Make(pg, {cut_property_name}, {flow_property_name}));
+
+  katana::GAccumulator<int64_t> flow_value;
+  katana::GAccumulator<uint64_t> source_side_size;
+  katana::GAccumulator<uint64_t> cut_edges;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        bool n_side = graph.GetData<SourceSide>(n);
+        if (n_side) {
+          source_side_size += 1;
+        }
+        for (auto e : graph.OutEdges(n)) {
+          GNode dst = graph.OutEdgeDst(e);
+          int64_t flow = graph.GetEdgeData<EdgeFlow>(e);
+          if (n == source) {
+            flow_value += flow;
+          }
+          if (dst == source) {
+            flow_value += -flow;
+          }
+          if (n_side && !graph.GetData<SourceSide>(dst)) {
+            cut_edges += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("MaxFlow Statistics"));
+
+  return MaxFlowStatistics{
+      static_cast<uint64_t>(flow_value.reduce()), source_side_size.reduce(),
+      cut_edges.reduce()};
+}
+
+void
+katana::analytics::MaxFlowStatistics::Print(std::ostream& os) const {
+  os << "Flow value = " << flow_value << std::endl;
+  os << "Nodes on the source side of the cut = " << source_side_size
+     << std::endl;
+  os << "Edges crossing the cut = " << cut_edges << std::endl;
+}
@@ -0,0 +1,285 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "katana/NUMAArray.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+#include "pagerank-impl.h"
+
+namespace {
+
+using NodeData = std::tuple<NodeValue>;
+using EdgeData = std::tuple<>;
+
+using Graph = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::Default, NodeData, EdgeData>;
+using GNode = typename Graph::Node;
+
+/// Blocks have at least 2^kMinLog2BlockSize nodes (128KiB of ranks), so that
+/// the accumulation of a block stays in the L2 cache.
+constexpr uint32_t kMinLog2BlockSize = 15;
+/// Large graphs use larger blocks to keep the number of bins (and so the
+/// number of concurrent write streams while binning) bounded.
+constexpr uint32_t kMaxLog2NumBlocks = 12;
+constexpr uint32_t kChunksPerThread = 4;
+
+/// Propagation blocking (Beamer, Asanovic and Patterson): instead of pulling
+/// ranks with random reads, every iteration streams the contributions of the
+/// sources into bins, one per block of destinations, and then accumulates
+/// each bin into a block of ranks that fits in cache.
+///
+/// Sources are split into chunks of roughly equal numbers of edges. Bin
+/// entries are laid out by (destination block, source chunk), and the
+/// destinations of the entries are recorded once, so each iteration only
+/// writes contributions and all writes within a chunk go to disjoint ranges.
+///
+/// BEAMER, Scott; ASANOVIC, Krste; PATTERSON, David. Reducing pagerank
+/// communication via propagation blocking. In: 2017 IEEE International
+/// Parallel and Distributed Processing Symposium (IPDPS). IEEE, 2017.
+/// p. 820-831.
+class PropagationBlocks {
+public:
+  explicit PropagationBlocks(const Graph& graph) : graph_(graph) {
+    const uint64_t num_nodes = graph_.size();
+    uint32_t log2_nodes = 0;
+    while ((uint64_t{1} << log2_nodes) < num_nodes) {
+      ++log2_nodes;
+    }
+    log2_block_size_ = std::max<uint32_t>(
+        kMinLog2BlockSize,
+        log2_nodes > kMaxLog2NumBlocks ? log2_nodes - kMaxLog2NumBlocks : 0);
+    num_blocks_ = ((num_nodes - 1) >> log2_block_size_) + 1;
+
+    SplitSourceChunks();
+    ComputeBinOffsets();
+
+    bin_dst_.allocateBlocked(graph_.NumEdges());
+    bin_contribution_.allocateBlocked(graph_.NumEdges());
+
+    ForEachChunkEdge(
+        [&](GNode, GNode dst, uint64_t pos) { bin_dst_[pos] = dst; });
+  }
+
+  uint64_t block_size() const { return uint64_t{1} << log2_block_size_; }
+  uint64_t num_blocks() const { return num_blocks_; }
+
+  /// Write the contribution of every edge into its bin.
+  template <typename ContributionFn>
+  void Bin(const ContributionFn& contribution) {
+    ForEachChunkEdge([&](GNode src, GNode, uint64_t pos) {
+      bin_contribution_[pos] = contribution(src);
+    });
+  }
+
+  /// Sum the contributions to each node of block and pass them to fn.
+  template <typename Fn>
+  void Accumulate(uint64_t block, std::vector<PRTy>* sums, const Fn& fn) const {
+    const GNode first = block << log2_block_size_;
+    const GNode last = std::min<uint64_t>(
+        graph_.size(), (block + 1) << log2_block_size_);
+
+    sums->assign(last - first, 0);
+    const uint64_t begin = bin_offsets_[block * num_chunks_];
+    const uint64_t end = bin_offsets_[(block + 1) * num_chunks_];
+    for (uint64_t i = begin; i < end; ++i) {
+      (*sums)[bin_dst_[i] - first] += bin_contribution_[i];
+    }
+
+    for (GNode n = first; n < last; ++n) {
+      fn(n, (*sums)[n - first]);
+    }
+  }
+
+private:
+  uint64_t BlockOf(GNode n) const { return n >> log2_block_size_; }
+
+  uint64_t FirstEdge(GNode n) const { return *graph_.OutEdges(n).begin(); }
+
+  void SplitSourceChunks() {
+    const uint64_t num_edges = graph_.NumEdges();
+    num_chunks_ = kChunksPerThread * katana::getActiveThreads();
+    chunk_begin_.resize(num_chunks_ + 1);
+
+    // Chunk c starts at the first node whose edges start at or after
+    // c * num_edges / num_chunks.
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_ + 1),
+        [&](uint64_t c) {
+          uint64_t target = c * num_edges / num_chunks_;
+          GNode lo = 0;
+          GNode hi = graph_.size();
+          while (lo < hi) {
+            GNode mid = lo + (hi - lo) / 2;
+            if (FirstEdge(mid) < target) {
+              lo = mid + 1;
+            } else {
+              hi = mid;
+            }
+          }
+          chunk_begin_[c] = lo;
+        },
+        katana::no_stats());
+    chunk_begin_[num_chunks_] = graph_.size();
+  }
+
+  void ComputeBinOffsets() {
+    // counts[block * num_chunks + chunk], the last entry stays zero so that
+    // the exclusive prefix sum is stored at index + 1.
+    bin_offsets_.allocateBlocked(num_blocks_ * num_chunks_ + 1);
+    katana::ParallelSTL::fill(
+        bin_offsets_.begin(), bin_offsets_.end(), uint64_t{0});
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_),
+        [&](uint64_t c) {
+          for (GNode n = chunk_begin_[c]; n < chunk_begin_[c + 1]; ++n) {
+            for (auto e : graph_.OutEdges(n)) {
+              ++bin_offsets_[BlockOf(graph_.OutEdgeDst(e)) * num_chunks_ + c +
+                             1];
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    katana::ParallelSTL::partial_sum(
+        bin_offsets_.begin(), bin_offsets_.end(), bin_offsets_.begin());
+  }
+
+  /// Visit all edges in the order they are stored in the bins, calling
+  /// fn(src, dst, bin position).
+  template <typename Fn>
+  void ForEachChunkEdge(const Fn& fn) {
+    katana::PerThreadStorage<std::vector<uint64_t>> cursors;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_),
+        [&](uint64_t c) {
+          auto& cursor = *cursors.getLocal();
+          cursor.resize(num_blocks_);
+          for (uint64_t b = 0; b < num_blocks_; ++b) {
+            cursor[b] = bin_offsets_[b * num_chunks_ + c];
+          }
+
+          for (GNode n = chunk_begin_[c]; n < chunk_begin_[c + 1]; ++n) {
+            for (auto e : graph_.OutEdges(n)) {
+              GNode dst = graph_.OutEdgeDst(e);
+              fn(n, dst, cursor[BlockOf(dst)]++);
+            }
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("PagerankPullBlocked Bin"));
+  }
+
+  const Graph& graph_;
+  uint32_t log2_block_size_;
+  uint64_t num_blocks_;
+  uint64_t num_chunks_;
+  std::vector<GNode> chunk_begin_;
+  katana::NUMAArray<uint64_t> bin_offsets_;
+  katana::NUMAArray<GNode> bin_dst_;
+  katana::NUMAArray<PRTy> bin_contribution_;
+};
+
+/// Computes the same ranks as the topological pull algorithm.
+katana::Result<void>
+ComputePRBlocked(Graph* graph, katana::analytics::PagerankPlan plan) {
+  katana::StatTimer exec_time("PagerankPullBlocked");
+  exec_time.start();
+
+  katana::NUMAArray<PRTy> value;
+  katana::NUMAArray<uint32_t> out_degree;
+  value.allocateBlocked(graph->size());
+  out_degree.allocateBlocked(graph->size());
+
+  PRTy init_value = 1.0f / graph->size();
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        value[n] = init_value;
+        out_degree[n] = graph->OutDegree(n);
+      },
+      katana::no_stats(), katana::loopname("initNodeData"));
+
+  PropagationBlocks blocks(*graph);
+  katana::ReportStatSingle("PageRank", "Blocks", blocks.num_blocks());
+
+  katana::PerThreadStorage<std::vector<PRTy>> sums;
+  const PRTy base_score = 1.0f - plan.alpha();
+  unsigned int iteration = 0;
+
+  while (true) {
+    blocks.Bin([&](GNode src) { return value[src] / out_degree[src]; });
+
+    katana::GAccumulator<float> accum;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, blocks.num_blocks()),
+        [&](uint64_t block) {
+          blocks.Accumulate(block, sums.getLocal(), [&](GNode n, PRTy sum) {
+            PRTy new_value = sum * plan.alpha() + base_score;
+            accum += std::fabs(new_value - value[n]);
+            value[n] = new_value;
+          });
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("PagerankPullBlocked Accumulate"));
+
+    iteration += 1;
+    if (accum.reduce() <= plan.tolerance() ||
+        iteration >= plan.max_iterations()) {
+      break;
+    }
+  }
+
+  katana::ReportStatSingle("PageRank", "Iterations", iteration);
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) { graph->GetData<NodeValue>(n) = value[n]; },
+      katana::loopname("Extract pagerank"), katana::no_stats());
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+PagerankPullBlocked(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx) {
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+  if (graph.size() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::EnsurePreallocated(
+      2, 2 * graph.size() * sizeof(NodeData) +
+             graph.NumEdges() * (sizeof(GNode) + sizeof(PRTy)));
+  katana::ReportPageAllocGuard page_alloc;
+
+  return ComputePRBlocked(&graph, plan);
+}
@@ -0,0 +1,350 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "pagerank-impl.h"
+
+using katana::analytics::PersonalizedPagerankPlan;
+using katana::analytics::PersonalizedPagerankScore;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+struct PushEntry {
+  /// The current Personalized Page Rank estimate.
+  PRTy estimate{0};
+  /// Probability mass that has not been pushed yet.
+  PRTy residual{0};
+};
+
+/// Sparse estimates and residuals of (a shard of the nodes of) a query.
+using SparseVector = std::unordered_map<Node, PushEntry>;
+/// The shards of a query; each node belongs to exactly one shard.
+using PushResult = std::vector<SparseVector>;
+
+class ForwardPush {
+public:
+  ForwardPush(
+      const katana::GraphTopology& topo, const std::vector<Node>& seeds,
+      const PersonalizedPagerankPlan& plan)
+      : topo_(topo),
+        seeds_(seeds),
+        seed_mass_(PRTy{1} / seeds.size()),
+        epsilon_(plan.epsilon()),
+        alpha_(plan.alpha()) {}
+
+  /// Push one query on the calling thread.
+  PushResult RunSerial() const {
+    PushResult result(1);
+    SparseVector& entries = result[0];
+    std::vector<Node> queue;
+
+    auto add_residual = [&](Node n, PRTy amount) {
+      PushEntry& entry = entries[n];
+      PRTy old = entry.residual;
+      entry.residual += amount;
+      if (CrossesThreshold(n, old, entry.residual)) {
+        queue.push_back(n);
+      }
+    };
+
+    for (Node seed : seeds_) {
+      add_residual(seed, seed_mass_);
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+      Node src = queue[head];
+      // References into an unordered_map are stable across rehashing.
+      PushEntry& entry = entries[src];
+      PRTy residual = entry.residual;
+      entry.residual = 0;
+      entry.estimate += (1 - alpha_) * residual;
+
+      size_t degree = topo_.OutDegree(src);
+      if (degree == 0) {
+        for (Node seed : seeds_) {
+          add_residual(seed, alpha_ * residual * seed_mass_);
+        }
+        continue;
+      }
+
+      PRTy delta = alpha_ * residual / degree;
+      for (auto e : topo_.OutEdges(src)) {
+        add_residual(topo_.OutEdgeDst(e), delta);
+      }
+    }
+
+    return result;
+  }
+
+  /// Push one query using all threads. Each round pushes every active node
+  /// in parallel. The pushed residuals are buffered per thread and per shard,
+  /// and then each thread applies the buffered updates of the shards it owns,
+  /// so the sparse maps are never modified concurrently.
+  PushResult RunParallel() const {
+    const size_t num_shards = katana::getActiveThreads();
+    auto shard_of = [num_shards](Node n) { return n % num_shards; };
+
+    PushResult shards(num_shards);
+    std::vector<std::vector<Node>> frontier(num_shards);
+    std::vector<std::vector<Node>> next_frontier(num_shards);
+
+    using Update = std::pair<Node, PRTy>;
+    katana::PerThreadStorage<std::vector<std::vector<Update>>> outboxes;
+
+    for (Node seed : seeds_) {
+      shards[shard_of(seed)][seed].residual += seed_mass_;
+    }
+    for (size_t s = 0; s < num_shards; ++s) {
+      for (const auto& [n, entry] : shards[s]) {
+        if (CrossesThreshold(n, 0, entry.residual)) {
+          frontier[s].push_back(n);
+        }
+      }
+    }
+
+    std::vector<Node> active;
+    size_t rounds = 0;
+
+    for (;;) {
+      active.clear();
+      for (const auto& nodes : frontier) {
+        active.insert(active.end(), nodes.begin(), nodes.end());
+      }
+      if (active.empty()) {
+        break;
+      }
+      ++rounds;
+
+      katana::do_all(
+          katana::iterate(active),
+          [&](const Node& src) {
+            auto& outbox = *outboxes.getLocal();
+            outbox.resize(num_shards);
+
+            PRTy residual = shards[shard_of(src)].at(src).residual;
+            size_t degree = topo_.OutDegree(src);
+            if (degree == 0) {
+              for (Node seed : seeds_) {
+                outbox[shard_of(seed)].emplace_back(
+                    seed, alpha_ * residual * seed_mass_);
+              }
+              return;
+            }
+
+            PRTy delta = alpha_ * residual / degree;
+            for (auto e : topo_.OutEdges(src)) {
+              Node dst = topo_.OutEdgeDst(e);
+              outbox[shard_of(dst)].emplace_back(dst, delta);
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("PersonalizedPagerank Push"));
+
+      katana::on_each([&](unsigned tid, unsigned num_threads) {
+        for (size_t s = tid; s < num_shards; s += num_threads) {
+          SparseVector& entries = shards[s];
+
+          for (Node src : frontier[s]) {
+            PushEntry& entry = entries[src];
+            entry.estimate += (1 - alpha_) * entry.residual;
+            entry.residual = 0;
+          }
+
+          next_frontier[s].clear();
+          for (unsigned t = 0; t < outboxes.size(); ++t) {
+            auto& outbox = *outboxes.getRemote(t);
+            if (s >= outbox.size()) {
+              continue;
+            }
+            for (const auto& [dst, delta] : outbox[s]) {
+              PushEntry& entry = entries[dst];
+              PRTy old = entry.residual;
+              entry.residual += delta;
+              if (CrossesThreshold(dst, old, entry.residual)) {
+                next_frontier[s].push_back(dst);
+              }
+            }
+            outbox[s].clear();
+          }
+        }
+      });
+
+      std::swap(frontier, next_frontier);
+    }
+
+    katana::ReportStatSingle("PersonalizedPagerank", "Rounds", rounds);
+
+    return shards;
+  }
+
+private:
+  bool CrossesThreshold(Node n, PRTy old_residual, PRTy new_residual) const {
+    PRTy threshold =
+        epsilon_ * std::max<size_t>(topo_.OutDegree(n), size_t{1});
+    return old_residual < threshold && new_residual >= threshold;
+  }
+
+  const katana::GraphTopology& topo_;
+  const std::vector<Node>& seeds_;
+  PRTy seed_mass_;
+  PRTy epsilon_;
+  PRTy alpha_;
+};
+
+katana::Result<void>
+CheckArguments(
+    const katana::GraphTopology& topo, const std::vector<Node>& seeds,
+    const PersonalizedPagerankPlan& plan) {
+  if (seeds.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "seed set must not be empty");
+  }
+  for (Node seed : seeds) {
+    if (seed >= topo.NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "seed {} is not a node", seed);
+    }
+  }
+  if (!(plan.epsilon() > 0)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "epsilon must be positive");
+  }
+  if (!(plan.alpha() >= 0 && plan.alpha() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "alpha must be in [0, 1)");
+  }
+  return katana::ResultSuccess();
+}
+
+PushResult
+RunForwardPush(
+    const katana::GraphTopology& topo, const std::vector<Node>& seeds,
+    const PersonalizedPagerankPlan& plan) {
+  ForwardPush push(topo, seeds, plan);
+  switch (plan.algorithm()) {
+  case PersonalizedPagerankPlan::kBatchedForwardPush:
+    return push.RunSerial();
+  case PersonalizedPagerankPlan::kForwardPush:
+  default:
+    return push.RunParallel();
+  }
+}
+
+std::vector<PersonalizedPagerankScore>
+TopK(const PushResult& result, size_t k) {
+  std::vector<PersonalizedPagerankScore> scores;
+  for (const auto& entries : result) {
+    for (const auto& [n, entry] : entries) {
+      if (entry.estimate > 0) {
+        scores.emplace_back(PersonalizedPagerankScore{n, entry.estimate});
+      }
+    }
+  }
+
+  auto by_rank = [](const PersonalizedPagerankScore& a,
+                    const PersonalizedPagerankScore& b) {
+    return a.rank > b.rank || (a.rank == b.rank && a.node < b.node);
+  };
+  size_t top = std::min(k, scores.size());
+  std::partial_sort(scores.begin(), scores.begin() + top, scores.end(), by_rank);
+  scores.resize(top);
+  return scores;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::PersonalizedPagerank(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PersonalizedPagerankPlan plan) {
+  KATANA_CHECKED(CheckArguments(pg->topology(), seeds, plan));
+
+  using Graph = katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::Default, std::tuple<NodeValue>,
+      std::tuple<>>;
+
+  KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<NodeValue>>(
+      txn_ctx, {output_property_name}));
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  katana::StatTimer exec_time("PersonalizedPagerank");
+  exec_time.start();
+
+  PushResult result = RunForwardPush(pg->topology(), seeds, plan);
+
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) { graph.GetData<NodeValue>(n) = 0; },
+      katana::no_stats(), katana::loopname("PersonalizedPagerank Initialize"));
+
+  katana::do_all(
+      katana::iterate(size_t{0}, result.size()),
+      [&](size_t shard) {
+        for (const auto& [n, entry] : result[shard]) {
+          graph.GetData<NodeValue>(n) = entry.estimate;
+        }
+      },
+      katana::no_stats(), katana::loopname("PersonalizedPagerank Output"));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::vector<std::vector<PersonalizedPagerankScore>>>
+katana::analytics::PersonalizedPagerankTopK(
+    const katana::PropertyGraph& pg,
+    const std::vector<std::vector<uint32_t>>& seed_sets, size_t k,
+    PersonalizedPagerankPlan plan) {
+  const katana::GraphTopology& topo = pg.topology();
+  for (const auto& seeds : seed_sets) {
+    KATANA_CHECKED(CheckArguments(topo, seeds, plan));
+  }
+
+  std::vector<std::vector<PersonalizedPagerankScore>> top_k(seed_sets.size());
+
+  katana::StatTimer exec_time("PersonalizedPagerankTopK");
+  exec_time.start();
+
+  if (plan.algorithm() == PersonalizedPagerankPlan::kBatchedForwardPush) {
+    // Queries are independent, so run one per thread with serial pushes.
+    katana::do_all(
+        katana::iterate(size_t{0}, seed_sets.size()),
+        [&](size_t q) {
+          top_k[q] = TopK(RunForwardPush(topo, seed_sets[q], plan), k);
+        },
+        katana::steal(), katana::chunk_size<1>(), katana::no_stats(),
+        katana::loopname("PersonalizedPagerank Batch"));
+  } else {
+    for (size_t q = 0; q < seed_sets.size(); ++q) {
+      top_k[q] = TopK(RunForwardPush(topo, seed_sets[q], plan), k);
+    }
+  }
+
+  exec_time.stop();
+
+  return top_k;
+}
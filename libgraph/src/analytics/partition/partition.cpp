@@ -0,0 +1,643 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/partition/partition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "katana/NUMAArray.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/ClusteringImplementationBase.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct PartitionID : public katana::PODProperty<uint32_t> {};
+
+using NodeData = std::tuple<PartitionID>;
+using EdgeData = std::tuple<>;
+
+using Graph = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::Default, NodeData, EdgeData>;
+using GNode = typename Graph::Node;
+
+constexpr uint32_t kUnmatched = std::numeric_limits<uint32_t>::max();
+/// Rounds of proposals per matching; most nodes are matched in the first
+/// few rounds.
+constexpr uint32_t kMatchingRounds = 4;
+/// Stop coarsening once a level shrinks the graph by less than this.
+constexpr double kMinCoarseningReduction = 0.05;
+/// Coarse nodes may weigh at most this many times the average weight of a
+/// node of the coarsest graph, which keeps the initial partition balanced.
+constexpr double kMaxCoarseNodeWeightFactor = 1.5;
+
+/// Weighted graph in CSR form, used for all levels of the hierarchy.
+struct CsrGraph {
+  katana::NUMAArray<uint64_t> offsets;
+  katana::NUMAArray<uint32_t> dests;
+  katana::NUMAArray<uint64_t> edge_weight;
+  katana::NUMAArray<uint64_t> node_weight;
+  uint64_t total_node_weight{0};
+  uint64_t max_degree{0};
+
+  uint32_t num_nodes() const { return node_weight.size(); }
+  uint64_t begin(uint32_t n) const { return offsets[n]; }
+  uint64_t end(uint32_t n) const { return offsets[n + 1]; }
+};
+
+/// One level of coarsening: the coarse graph and the coarse node of each node
+/// of the finer graph.
+struct Level {
+  CsrGraph graph;
+  katana::NUMAArray<uint32_t> fine_to_coarse;
+};
+
+using PartitionWeights = std::vector<std::atomic<uint64_t>>;
+using PerThreadAccumulator =
+    katana::PerThreadStorage<ClusterWeightAccumulator<uint64_t>>;
+
+void
+ReserveAccumulators(
+    uint64_t num_ids, uint64_t max_ids, PerThreadAccumulator* accumulators) {
+  katana::on_each([&](unsigned, unsigned) {
+    accumulators->getLocal()->Reserve(num_ids, max_ids);
+  });
+}
+
+/// Fill offsets from per node degrees stored at offsets[n + 1].
+void
+DegreesToOffsets(CsrGraph* graph) {
+  graph->offsets[0] = 0;
+  katana::ParallelSTL::partial_sum(
+      graph->offsets.begin(), graph->offsets.end(), graph->offsets.begin());
+}
+
+void
+ComputeMaxDegree(CsrGraph* graph) {
+  katana::GReduceMax<uint64_t> max_degree;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, graph->num_nodes()),
+      [&](uint32_t n) { max_degree.update(graph->end(n) - graph->begin(n)); },
+      katana::no_stats());
+  graph->max_degree = max_degree.reduce();
+}
+
+/// The finest level: a copy of the topology of graph with unit weights and
+/// without self loops.
+CsrGraph
+MakeFinestGraph(const Graph& graph) {
+  CsrGraph csr;
+  const uint32_t num_nodes = graph.NumNodes();
+  csr.offsets.allocateBlocked(num_nodes + 1);
+  csr.node_weight.allocateBlocked(num_nodes);
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        uint64_t degree = 0;
+        for (auto e : graph.OutEdges(n)) {
+          degree += graph.OutEdgeDst(e) != n;
+        }
+        csr.offsets[n + 1] = degree;
+        csr.node_weight[n] = 1;
+      },
+      katana::steal(), katana::no_stats());
+  DegreesToOffsets(&csr);
+
+  csr.dests.allocateBlocked(csr.offsets[num_nodes]);
+  csr.edge_weight.allocateBlocked(csr.offsets[num_nodes]);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        uint64_t pos = csr.begin(n);
+        for (auto e : graph.OutEdges(n)) {
+          GNode dst = graph.OutEdgeDst(e);
+          if (dst != n) {
+            csr.dests[pos] = dst;
+            csr.edge_weight[pos] = 1;
+            ++pos;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  csr.total_node_weight = num_nodes;
+  ComputeMaxDegree(&csr);
+  return csr;
+}
+
+/// Symmetric pseudo-random priority of the edge {a, b} to break ties between
+/// edges of equal weight, so that matching does not favor low node IDs.
+uint64_t
+EdgePriority(uint32_t a, uint32_t b) {
+  uint64_t x = (uint64_t{std::min(a, b)} << 32U | std::max(a, b)) *
+               0x9e3779b97f4a7c15ULL;
+  return x ^ (x >> 29U);
+}
+
+/// Heavy edge matching by handshakes: every unmatched node proposes to the
+/// unmatched neighbor across its heaviest edge, and mutual proposals are
+/// matched. Since edge priorities are symmetric, the heaviest remaining edge
+/// is always matched, so each round makes progress. Unmatched nodes are
+/// matched with themselves.
+void
+HeavyEdgeMatching(
+    const CsrGraph& graph, uint64_t max_node_weight,
+    katana::NUMAArray<uint32_t>* match) {
+  const uint32_t num_nodes = graph.num_nodes();
+  katana::NUMAArray<uint32_t> proposal;
+  proposal.allocateBlocked(num_nodes);
+  match->allocateBlocked(num_nodes);
+  katana::ParallelSTL::fill(match->begin(), match->end(), kUnmatched);
+
+  for (uint32_t round = 0; round < kMatchingRounds; ++round) {
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](uint32_t n) {
+          proposal[n] = kUnmatched;
+          if ((*match)[n] != kUnmatched) {
+            return;
+          }
+          uint64_t best_weight = 0;
+          uint64_t best_priority = 0;
+          for (uint64_t e = graph.begin(n); e < graph.end(n); ++e) {
+            uint32_t v = graph.dests[e];
+            if ((*match)[v] != kUnmatched ||
+                graph.node_weight[n] + graph.node_weight[v] >
+                    max_node_weight) {
+              continue;
+            }
+            uint64_t weight = graph.edge_weight[e];
+            uint64_t priority = EdgePriority(n, v);
+            if (weight > best_weight ||
+                (weight == best_weight && priority > best_priority)) {
+              proposal[n] = v;
+              best_weight = weight;
+              best_priority = priority;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Partition Matching Propose"));
+
+    katana::GAccumulator<uint64_t> matched;
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](uint32_t n) {
+          uint32_t v = proposal[n];
+          if (v != kUnmatched && proposal[v] == n) {
+            (*match)[n] = v;
+            matched += 1;
+          }
+        },
+        katana::no_stats());
+
+    if (matched.reduce() == 0) {
+      break;
+    }
+  }
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        if ((*match)[n] == kUnmatched) {
+          (*match)[n] = n;
+        }
+      },
+      katana::no_stats());
+}
+
+/// Contract every matched pair of fine into one node of the returned level.
+/// Parallel edges are merged by summing their weights, and edges inside a
+/// pair are dropped.
+Level
+Contract(
+    const CsrGraph& fine, const katana::NUMAArray<uint32_t>& match,
+    PerThreadAccumulator* accumulators) {
+  const uint32_t num_fine = fine.num_nodes();
+  Level level;
+  CsrGraph& coarse = level.graph;
+
+  // The lower node of each pair is its leader; leaders are numbered in order.
+  katana::NUMAArray<uint64_t> leader_rank;
+  leader_rank.allocateBlocked(num_fine + 1);
+  leader_rank[0] = 0;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_fine),
+      [&](uint32_t n) { leader_rank[n + 1] = match[n] >= n; },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      leader_rank.begin(), leader_rank.end(), leader_rank.begin());
+  const uint32_t num_coarse = leader_rank[num_fine];
+
+  katana::NUMAArray<uint32_t> leader;
+  leader.allocateBlocked(num_coarse);
+  level.fine_to_coarse.allocateBlocked(num_fine);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_fine),
+      [&](uint32_t n) {
+        level.fine_to_coarse[n] = leader_rank[std::min(n, match[n])];
+        if (match[n] >= n) {
+          leader[leader_rank[n]] = n;
+        }
+      },
+      katana::no_stats());
+
+  coarse.offsets.allocateBlocked(num_coarse + 1);
+  coarse.node_weight.allocateBlocked(num_coarse);
+  ReserveAccumulators(num_coarse, 2 * fine.max_degree + 1, accumulators);
+
+  auto for_each_neighbor = [&](uint32_t c, auto& acc) {
+    uint32_t members[2] = {leader[c], match[leader[c]]};
+    uint32_t num_members = members[0] == members[1] ? 1 : 2;
+    for (uint32_t i = 0; i < num_members; ++i) {
+      uint32_t u = members[i];
+      for (uint64_t e = fine.begin(u); e < fine.end(u); ++e) {
+        uint32_t dst = level.fine_to_coarse[fine.dests[e]];
+        if (dst != c) {
+          acc.Add(dst, fine.edge_weight[e]);
+        }
+      }
+    }
+  };
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_coarse),
+      [&](uint32_t c) {
+        auto& acc = *accumulators->getLocal();
+        for_each_neighbor(c, acc);
+        coarse.offsets[c + 1] = acc.size();
+        acc.Clear();
+
+        uint32_t u = leader[c];
+        coarse.node_weight[c] = fine.node_weight[u];
+        if (match[u] != u) {
+          coarse.node_weight[c] += fine.node_weight[match[u]];
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("Partition Contract Count"));
+  DegreesToOffsets(&coarse);
+
+  coarse.dests.allocateBlocked(coarse.offsets[num_coarse]);
+  coarse.edge_weight.allocateBlocked(coarse.offsets[num_coarse]);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_coarse),
+      [&](uint32_t c) {
+        auto& acc = *accumulators->getLocal();
+        for_each_neighbor(c, acc);
+        uint64_t pos = coarse.begin(c);
+        for (size_t i = 0; i < acc.size(); ++i, ++pos) {
+          coarse.dests[pos] = acc.cluster(i);
+          coarse.edge_weight[pos] = acc.weight(i);
+        }
+        acc.Clear();
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("Partition Contract Write"));
+
+  coarse.total_node_weight = fine.total_node_weight;
+  ComputeMaxDegree(&coarse);
+  return level;
+}
+
+/// Nodes of graph in BFS order, starting each connected component from a node
+/// far away from its first node so that the order sweeps across it.
+std::vector<uint32_t>
+BfsOrder(const CsrGraph& graph) {
+  const uint32_t num_nodes = graph.num_nodes();
+  std::vector<uint32_t> order;
+  order.reserve(num_nodes);
+  std::vector<uint8_t> visited(num_nodes, 0);
+
+  auto bfs = [&](uint32_t source, size_t begin) {
+    visited[source] = 1;
+    order.push_back(source);
+    for (size_t i = begin; i < order.size(); ++i) {
+      uint32_t n = order[i];
+      for (uint64_t e = graph.begin(n); e < graph.end(n); ++e) {
+        uint32_t v = graph.dests[e];
+        if (!visited[v]) {
+          visited[v] = 1;
+          order.push_back(v);
+        }
+      }
+    }
+  };
+
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    if (visited[n]) {
+      continue;
+    }
+    size_t begin = order.size();
+    bfs(n, begin);
+    // Restart from the last node reached, which is peripheral
+    uint32_t peripheral = order.back();
+    for (size_t i = begin; i < order.size(); ++i) {
+      visited[order[i]] = 0;
+    }
+    order.resize(begin);
+    bfs(peripheral, begin);
+  }
+  return order;
+}
+
+/// Split the BFS order of graph into num_partitions consecutive runs of about
+/// equal weight.
+void
+InitialPartition(
+    const CsrGraph& graph, uint32_t num_partitions,
+    katana::NUMAArray<uint32_t>* part) {
+  part->allocateBlocked(graph.num_nodes());
+  const double share =
+      static_cast<double>(graph.total_node_weight) / num_partitions;
+
+  uint32_t p = 0;
+  uint64_t weight = 0;
+  for (uint32_t n : BfsOrder(graph)) {
+    // Move on once more than half of n would spill over the current share
+    while (p + 1 < num_partitions &&
+           weight + graph.node_weight[n] / 2.0 > (p + 1) * share) {
+      ++p;
+    }
+    (*part)[n] = p;
+    weight += graph.node_weight[n];
+  }
+}
+
+/// Greedy k-way refinement. Each pass visits all nodes in parallel and moves
+/// a boundary node to the neighboring partition with the largest reduction in
+/// edge cut, as long as that partition stays under max_partition_weight.
+/// Nodes of overweight partitions may also move at a loss. To keep adjacent
+/// nodes from swapping partitions simultaneously, passes alternate between
+/// only moving to higher and only moving to lower partition IDs.
+void
+Refine(
+    const CsrGraph& graph, uint32_t num_partitions,
+    uint64_t max_partition_weight, uint32_t max_iterations,
+    PerThreadAccumulator* accumulators, katana::NUMAArray<uint32_t>* part) {
+  const uint32_t num_nodes = graph.num_nodes();
+  PartitionWeights weights(num_partitions);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) { weights[(*part)[n]] += graph.node_weight[n]; },
+      katana::no_stats());
+
+  ReserveAccumulators(num_partitions, num_partitions, accumulators);
+
+  for (uint32_t pass = 0; pass < 2 * max_iterations; ++pass) {
+    const bool upwards = pass % 2 == 0;
+    katana::GAccumulator<uint64_t> moved;
+
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_nodes),
+        [&](uint32_t n) {
+          const uint32_t own = (*part)[n];
+          auto& acc = *accumulators->getLocal();
+          int64_t internal = 0;
+          for (uint64_t e = graph.begin(n); e < graph.end(n); ++e) {
+            uint32_t p = (*part)[graph.dests[e]];
+            if (p == own) {
+              internal += graph.edge_weight[e];
+            } else {
+              acc.Add(p, graph.edge_weight[e]);
+            }
+          }
+
+          const uint64_t node_weight = graph.node_weight[n];
+          const bool overweight = weights[own].load() > max_partition_weight;
+          uint32_t best = own;
+          int64_t best_gain = 0;
+          for (size_t i = 0; i < acc.size(); ++i) {
+            uint32_t p = acc.cluster(i);
+            if (upwards != (p > own) ||
+                weights[p].load() + node_weight > max_partition_weight) {
+              continue;
+            }
+            int64_t gain = static_cast<int64_t>(acc.weight(i)) - internal;
+            if ((gain > best_gain || (overweight && best == own)) ||
+                (gain == best_gain && best != own &&
+                 weights[p].load() < weights[best].load())) {
+              best = p;
+              best_gain = gain;
+            }
+          }
+          acc.Clear();
+
+          if (best == own) {
+            return;
+          }
+          if (weights[best].fetch_add(node_weight) + node_weight >
+              max_partition_weight) {
+            weights[best] -= node_weight;
+            return;
+          }
+          weights[own] -= node_weight;
+          (*part)[n] = best;
+          moved += 1;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("Partition Refine"));
+
+    // Stop after a pair of passes in both directions without moves
+    if (moved.reduce() == 0 && !upwards) {
+      break;
+    }
+  }
+}
+
+katana::Result<void>
+PartitionImpl(
+    Graph* graph, uint32_t num_partitions, const PartitionPlan& plan) {
+  const uint32_t num_nodes = graph->NumNodes();
+  if (num_nodes == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("Partition");
+  exec_time.start();
+
+  // Coarsen
+  const uint64_t coarsen_to = std::max<uint64_t>(
+      1, uint64_t{plan.coarsening_threshold()} * num_partitions);
+  std::vector<Level> levels(1);
+  levels[0].graph = MakeFinestGraph(*graph);
+  PerThreadAccumulator accumulators;
+
+  while (levels.back().graph.num_nodes() > coarsen_to) {
+    const CsrGraph& fine = levels.back().graph;
+    const uint64_t max_node_weight = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(
+               kMaxCoarseNodeWeightFactor * fine.total_node_weight /
+               coarsen_to)));
+
+    katana::NUMAArray<uint32_t> match;
+    HeavyEdgeMatching(fine, max_node_weight, &match);
+    Level coarse = Contract(fine, match, &accumulators);
+
+    if (coarse.graph.num_nodes() >
+        (1 - kMinCoarseningReduction) * fine.num_nodes()) {
+      break;
+    }
+    levels.emplace_back(std::move(coarse));
+  }
+  katana::ReportStatSingle("Partition", "Levels", levels.size());
+
+  // Partition the coarsest graph and uncoarsen
+  const double share = static_cast<double>(num_nodes) / num_partitions;
+  const auto max_partition_weight =
+      static_cast<uint64_t>(std::ceil((1 + plan.imbalance()) * share));
+
+  katana::NUMAArray<uint32_t> part;
+  InitialPartition(levels.back().graph, num_partitions, &part);
+
+  for (size_t i = levels.size(); i-- > 0;) {
+    Refine(
+        levels[i].graph, num_partitions, max_partition_weight,
+        plan.refinement_iterations(), &accumulators, &part);
+    if (i == 0) {
+      break;
+    }
+
+    const auto& fine_to_coarse = levels[i].fine_to_coarse;
+    katana::NUMAArray<uint32_t> fine_part;
+    fine_part.allocateBlocked(fine_to_coarse.size());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, fine_to_coarse.size()),
+        [&](uint64_t n) { fine_part[n] = part[fine_to_coarse[n]]; },
+        katana::no_stats());
+    part = std::move(fine_part);
+    // The coarse level is no longer needed
+    levels.pop_back();
+  }
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) { graph->GetData<PartitionID>(n) = part[n]; },
+      katana::no_stats(), katana::loopname("Partition Extract"));
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Partition(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PartitionPlan plan) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "number of partitions must be > 0");
+  }
+  if (plan.imbalance() < 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "imbalance must be >= 0, got {}",
+        plan.imbalance());
+  }
+
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  return PartitionImpl(&graph, num_partitions, plan);
+}
+
+katana::Result<void>
+katana::analytics::PartitionAssertValid(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  auto is_bad = [&graph, num_partitions](const GNode& n) {
+    return graph.GetData<PartitionID>(n) >= num_partitions;
+  };
+
+  if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
+      graph.end()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<PartitionStatistics>
+katana::analytics::PartitionStatistics::Compute(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "number of partitions must be > 0");
+  }
+  KATANA_CHECKED(PartitionAssertValid(pg, num_partitions, property_name));
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GAccumulator<uint64_t> edge_cut;
+  katana::PerThreadStorage<std::vector<uint64_t>> sizes;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        uint32_t p = graph.GetData<PartitionID>(n);
+        for (auto e : graph.OutEdges(n)) {
+          if (graph.GetData<PartitionID>(graph.OutEdgeDst(e)) != p) {
+            edge_cut += 1;
+          }
+        }
+        auto& local_sizes = *sizes.getLocal();
+        local_sizes.resize(num_partitions);
+        local_sizes[p] += 1;
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("Partition Statistics"));
+
+  std::vector<uint64_t> total_sizes(num_partitions);
+  for (unsigned i = 0; i < sizes.size(); ++i) {
+    const auto& local_sizes = *sizes.getRemote(i);
+    for (size_t p = 0; p < local_sizes.size(); ++p) {
+      total_sizes[p] += local_sizes[p];
+    }
+  }
+
+  auto [min_size, max_size] =
+      std::minmax_element(total_sizes.begin(), total_sizes.end());
+  double average_size = static_cast<double>(graph.NumNodes()) / num_partitions;
+
+  return PartitionStatistics{
+      edge_cut.reduce(), *max_size, *min_size,
+      average_size > 0 ? *max_size / average_size : 0};
+}
+
+void
+katana::analytics::PartitionStatistics::Print(std::ostream& os) const {
+  os << "Edge cut = " << edge_cut << std::endl;
+  os << "Largest partition size = " << max_partition_size << std::endl;
+  os << "Smallest partition size = " << min_partition_size << std::endl;
+  os << "Imbalance = " << imbalance << std::endl;
+}
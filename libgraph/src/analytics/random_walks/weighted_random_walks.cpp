@@ -0,0 +1,712 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/random_walks/random_walks.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using SortedPropertyGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
+using SortedGraphView = katana::TypedPropertyGraphView<
+    SortedPropertyGraphView, std::tuple<>, std::tuple<>>;
+using GNode = SortedGraphView::Node;
+using Edge = SortedGraphView::Edge;
+
+/// Steps after a walk reached a node without out edges.
+constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+/// Walks are short, so hand them out in chunks.
+constexpr unsigned kWalkChunkSize = 64;
+/// Nodes with at least this many neighbors get lazily built second-order
+/// tables; rejection sampling is cheap enough for the others.
+constexpr uint32_t kMinHubDegree = 128;
+/// Upper bound on the memory used by second-order tables.
+constexpr uint64_t kSecondOrderTablesBudget = uint64_t{1} << 30U;
+
+/// Small generator so that every walk has its own stream, which makes the
+/// walks independent of how they are scheduled on threads.
+class SplitMix64 {
+public:
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  uint64_t operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31U);
+  }
+
+  /// Uniform in [0, 1)
+  double NextDouble() { return ((*this)() >> 11U) * 0x1.0p-53; }
+
+private:
+  uint64_t state_;
+};
+
+struct AliasScratch {
+  std::vector<double> scaled;
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+};
+
+/// Fills prob and alias so that SampleAlias returns i in [0, n) with
+/// probability weight(i) / sum of weights (Vose's alias method). The
+/// distribution is uniform if all weights are zero.
+template <typename WeightFn>
+void
+BuildAliasTable(
+    uint32_t n, const WeightFn& weight, float* prob, uint32_t* alias,
+    AliasScratch* scratch) {
+  double total = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    total += weight(i);
+  }
+  if (total <= 0) {
+    for (uint32_t i = 0; i < n; ++i) {
+      prob[i] = 1;
+      alias[i] = i;
+    }
+    return;
+  }
+
+  auto& scaled = scratch->scaled;
+  auto& small = scratch->small;
+  auto& large = scratch->large;
+  scaled.resize(n);
+  small.clear();
+  large.clear();
+  for (uint32_t i = 0; i < n; ++i) {
+    scaled[i] = weight(i) * n / total;
+    if (scaled[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    small.pop_back();
+    uint32_t l = large.back();
+    prob[s] = scaled[s];
+    alias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Whatever is left has probability 1 up to rounding errors
+  for (uint32_t i : large) {
+    prob[i] = 1;
+    alias[i] = i;
+  }
+  for (uint32_t i : small) {
+    prob[i] = 1;
+    alias[i] = i;
+  }
+}
+
+uint32_t
+SampleAlias(uint32_t n, const float* prob, const uint32_t* alias, double u) {
+  double x = u * n;
+  uint32_t i = std::min(static_cast<uint32_t>(x), n - 1);
+  return (x - i) < prob[i] ? i : alias[i];
+}
+
+Edge
+FirstEdge(const SortedGraphView& graph, GNode n) {
+  return *graph.OutEdges(n).begin();
+}
+
+/// First-order transitions: an out edge of a node is picked with probability
+/// proportional to its weight, in constant time.
+class EdgeAliasTables {
+public:
+  /// Without weights every out edge is equally likely.
+  EdgeAliasTables(
+      const SortedGraphView& graph, const katana::NUMAArray<float>& weights)
+      : weighted_(weights.size() > 0) {
+    if (!weighted_) {
+      return;
+    }
+    prob_.allocateBlocked(graph.NumEdges());
+    alias_.allocateBlocked(graph.NumEdges());
+
+    katana::PerThreadStorage<AliasScratch> scratch;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) {
+          uint32_t degree = graph.OutDegree(n);
+          if (degree == 0) {
+            return;
+          }
+          Edge first = FirstEdge(graph, n);
+          BuildAliasTable(
+              degree, [&](uint32_t i) { return weights[first + i]; },
+              &prob_[first], &alias_[first], scratch.getLocal());
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("RandomWalks BuildAliasTables"));
+  }
+
+  /// Index of the sampled edge among the degree out edges starting at first
+  uint32_t Sample(Edge first, uint32_t degree, double u) const {
+    if (!weighted_) {
+      return std::min(static_cast<uint32_t>(u * degree), degree - 1);
+    }
+    return SampleAlias(degree, &prob_[first], &alias_[first], u);
+  }
+
+private:
+  bool weighted_;
+  katana::NUMAArray<float> prob_;
+  katana::NUMAArray<uint32_t> alias_;
+};
+
+/// Second-order transitions out of hubs, built the first time a walk moves
+/// from prev to curr and shared by all later walks that do so. The table of
+/// (prev, curr) is stored with the edge from curr back to prev.
+class SecondOrderTables {
+public:
+  struct Table {
+    std::vector<float> prob;
+    std::vector<uint32_t> alias;
+  };
+
+  explicit SecondOrderTables(const SortedGraphView& graph) {
+    first_slot_.allocateBlocked(graph.NumNodes() + 1);
+    first_slot_[0] = 0;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) {
+          uint32_t degree = graph.OutDegree(n);
+          first_slot_[n + 1] = degree >= kMinHubDegree ? degree : 0;
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        first_slot_.begin(), first_slot_.end(), first_slot_.begin());
+
+    slots_.allocateBlocked(first_slot_[graph.NumNodes()]);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, slots_.size()),
+        [&](uint64_t i) { slots_[i] = nullptr; }, katana::no_stats());
+  }
+
+  ~SecondOrderTables() {
+    for (auto& slot : slots_) {
+      delete slot.load();
+    }
+  }
+
+  SecondOrderTables(const SecondOrderTables&) = delete;
+  SecondOrderTables& operator=(const SecondOrderTables&) = delete;
+
+  /// Returns the table for moving on from curr after coming from prev, or
+  /// nullptr if there is none and it cannot be built.
+  template <typename WeightFn>
+  const Table* Get(
+      const SortedGraphView& graph, GNode prev, GNode curr,
+      const WeightFn& weight, AliasScratch* scratch) {
+    Edge first = FirstEdge(graph, curr);
+    uint32_t degree = graph.OutDegree(curr);
+    auto edges = graph.OutEdges(curr);
+    auto back_edge = std::lower_bound(
+        edges.begin(), edges.end(), prev,
+        [&](Edge e, GNode n) { return graph.OutEdgeDst(e) < n; });
+    if (back_edge == edges.end() || graph.OutEdgeDst(*back_edge) != prev) {
+      return nullptr;
+    }
+
+    std::atomic<Table*>& slot =
+        slots_[first_slot_[curr] + (*back_edge - first)];
+    Table* table = slot.load(std::memory_order_acquire);
+    if (table != nullptr) {
+      return table;
+    }
+
+    uint64_t bytes = degree * (sizeof(float) + sizeof(uint32_t));
+    if (bytes_used_.load(std::memory_order_relaxed) + bytes >
+        kSecondOrderTablesBudget) {
+      return nullptr;
+    }
+    bytes_used_ += bytes;
+
+    table = new Table;
+    table->prob.resize(degree);
+    table->alias.resize(degree);
+    BuildAliasTable(
+        degree, [&](uint32_t i) { return weight(first + i); },
+        table->prob.data(), table->alias.data(), scratch);
+
+    Table* expected = nullptr;
+    if (!slot.compare_exchange_strong(
+            expected, table, std::memory_order_acq_rel)) {
+      delete table;
+      bytes_used_ -= bytes;
+      return expected;
+    }
+    return table;
+  }
+
+private:
+  katana::NUMAArray<uint64_t> first_slot_;
+  katana::NUMAArray<std::atomic<Table*>> slots_;
+  std::atomic<uint64_t> bytes_used_{0};
+};
+
+/// Contiguous [number of walks x (walk length + 1)] buffer of walk steps.
+/// Walk i starts at node i % number of nodes.
+class WalkBuffer {
+public:
+  static katana::Result<WalkBuffer> Make(
+      uint64_t num_walks, uint32_t walk_length) {
+    uint64_t width = uint64_t{walk_length} + 1;
+    std::shared_ptr<arrow::Buffer> values = KATANA_CHECKED(
+        arrow::AllocateBuffer(num_walks * width * sizeof(uint32_t)));
+    return WalkBuffer(num_walks, width, std::move(values));
+  }
+
+  uint64_t num_walks() const { return num_walks_; }
+  uint64_t width() const { return width_; }
+
+  uint32_t* walk(uint64_t i) {
+    return reinterpret_cast<uint32_t*>(values_->mutable_data()) + i * width_;
+  }
+
+  /// Wraps the buffer without copying it; steps equal to kNoNode are null.
+  katana::Result<std::shared_ptr<arrow::FixedSizeListArray>> Finish() {
+    const uint64_t num_steps = num_walks_ * width_;
+    const auto* steps = reinterpret_cast<const uint32_t*>(values_->data());
+
+    katana::GAccumulator<uint64_t> null_count;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_steps),
+        [&](uint64_t i) {
+          if (steps[i] == kNoNode) {
+            null_count += 1;
+          }
+        },
+        katana::no_stats());
+
+    std::shared_ptr<arrow::Buffer> validity;
+    if (null_count.reduce() > 0) {
+      validity = KATANA_CHECKED(arrow::AllocateBitmap(num_steps));
+      uint8_t* bits = validity->mutable_data();
+      katana::do_all(
+          katana::iterate(uint64_t{0}, (num_steps + 7) / 8),
+          [&](uint64_t byte) {
+            uint8_t valid = 0;
+            for (uint64_t i = byte * 8; i < std::min(num_steps, byte * 8 + 8);
+                 ++i) {
+              if (steps[i] != kNoNode) {
+                valid |= uint8_t{1} << (i - byte * 8);
+              }
+            }
+            bits[byte] = valid;
+          },
+          katana::no_stats());
+    }
+
+    auto step_array = std::make_shared<arrow::UInt32Array>(
+        num_steps, std::move(values_), std::move(validity),
+        null_count.reduce());
+    return std::make_shared<arrow::FixedSizeListArray>(
+        arrow::fixed_size_list(arrow::uint32(), static_cast<int32_t>(width_)),
+        num_walks_,
+        std::move(step_array));
+  }
+
+private:
+  WalkBuffer(
+      uint64_t num_walks, uint64_t width, std::shared_ptr<arrow::Buffer> values)
+      : num_walks_(num_walks), width_(width), values_(std::move(values)) {}
+
+  uint64_t num_walks_;
+  uint64_t width_;
+  std::shared_ptr<arrow::Buffer> values_;
+};
+
+/// Node2vec return and in-out factors, with the bounds used by rejection
+/// sampling.
+struct Node2VecBias {
+  double prob_backward;
+  double prob_forward;
+  double upper_bound;
+  double lower_bound;
+
+  explicit Node2VecBias(const RandomWalksPlan& plan)
+      : prob_backward(1.0 / plan.backward_probability()),
+        prob_forward(1.0 / plan.forward_probability()),
+        upper_bound(std::max({1.0, prob_backward, prob_forward})),
+        lower_bound(std::min({1.0, prob_backward, prob_forward})) {}
+
+  bool IsUniform() const { return upper_bound == lower_bound; }
+
+  double operator()(const SortedGraphView& graph, GNode prev, GNode nbr)
+      const {
+    if (nbr == prev) {
+      return prob_backward;
+    }
+    if (graph.HasEdge(prev, nbr)) {
+      return 1.0;
+    }
+    return prob_forward;
+  }
+};
+
+struct WeightedNode2VecAlgo {
+  const SortedGraphView& graph_;
+  const katana::NUMAArray<float>& weights_;
+  const RandomWalksPlan& plan_;
+
+  katana::Result<void> operator()(WalkBuffer* walks) {
+    const Node2VecBias bias(plan_);
+    const EdgeAliasTables first_order(graph_, weights_);
+    // With p = q = 1 the walks are first order
+    std::unique_ptr<SecondOrderTables> hubs;
+    if (!bias.IsUniform()) {
+      hubs = std::make_unique<SecondOrderTables>(graph_);
+    }
+
+    auto weight = [&](Edge e) -> double {
+      return weights_.size() > 0 ? weights_[e] : 1.0;
+    };
+
+    katana::PerThreadStorage<AliasScratch> scratch;
+
+    auto next = [&](GNode prev, GNode curr, SplitMix64* rng) -> uint32_t {
+      uint32_t degree = graph_.OutDegree(curr);
+      if (degree == 0) {
+        return kNoNode;
+      }
+      Edge first = FirstEdge(graph_, curr);
+      if (prev == kNoNode || !hubs) {
+        return graph_.OutEdgeDst(
+            first + first_order.Sample(first, degree, rng->NextDouble()));
+      }
+
+      if (degree >= kMinHubDegree) {
+        auto biased_weight = [&](Edge e) {
+          return weight(e) * bias(graph_, prev, graph_.OutEdgeDst(e));
+        };
+        if (const auto* table = hubs->Get(
+                graph_, prev, curr, biased_weight, scratch.getLocal())) {
+          return graph_.OutEdgeDst(
+              first + SampleAlias(
+                          degree, table->prob.data(), table->alias.data(),
+                          rng->NextDouble()));
+        }
+      }
+
+      // Acceptance-rejection sampling with the first-order distribution
+      while (true) {
+        GNode nbr = graph_.OutEdgeDst(
+            first + first_order.Sample(first, degree, rng->NextDouble()));
+        double y = rng->NextDouble() * bias.upper_bound;
+        if (y <= bias.lower_bound || y <= bias(graph_, prev, nbr)) {
+          return nbr;
+        }
+      }
+    };
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, walks->num_walks()),
+        [&](uint64_t w) {
+          SplitMix64 rng(w);
+          uint32_t* walk = walks->walk(w);
+          GNode prev = kNoNode;
+          GNode curr = w % graph_.NumNodes();
+          walk[0] = curr;
+          for (uint64_t step = 1; step < walks->width(); ++step) {
+            uint32_t nbr = curr == kNoNode ? kNoNode : next(prev, curr, &rng);
+            walk[step] = nbr;
+            prev = curr;
+            curr = nbr;
+          }
+        },
+        katana::steal(), katana::chunk_size<kWalkChunkSize>(),
+        katana::loopname("WeightedNode2vec walks"), katana::no_stats());
+
+    return katana::ResultSuccess();
+  }
+};
+
+/// Sums of the histograms of edge types over walks, and of their pairwise
+/// products, from which the type correlations are computed.
+struct EdgeTypeMoments {
+  uint64_t num_walks = 0;
+  std::vector<double> sum;
+  std::vector<double> product_sum;
+  std::vector<uint32_t> histogram;
+
+  void Reset(uint32_t num_types) {
+    num_walks = 0;
+    sum.assign(num_types, 0);
+    product_sum.assign(num_types * num_types, 0);
+    histogram.assign(num_types, 0);
+  }
+};
+
+struct WeightedEdge2VecAlgo {
+  const SortedGraphView& graph_;
+  const katana::NUMAArray<float>& weights_;
+  const RandomWalksPlan& plan_;
+  katana::PropertyGraph* pg_;
+
+  katana::Result<void> operator()(WalkBuffer* walks) {
+    const Node2VecBias bias(plan_);
+    const EdgeAliasTables first_order(graph_, weights_);
+
+    katana::NUMAArray<uint32_t> edge_type;
+    edge_type.allocateBlocked(graph_.NumEdges());
+    katana::GReduceMax<uint32_t> max_type;
+    katana::do_all(
+        katana::iterate(graph_.OutEdges()),
+        [&](Edge e) {
+          edge_type[e] = pg_->GetTypeOfEdgeFromPropertyIndex(
+              graph_.GetEdgePropertyIndexFromOutEdge(e));
+          max_type.update(edge_type[e]);
+        },
+        katana::no_stats());
+    const uint32_t num_types =
+        graph_.NumEdges() > 0 ? max_type.reduce() + 1 : 1;
+
+    // transition[t1 * num_types + t2] weighs following an edge of type t2
+    // after one of type t1
+    std::vector<double> transition(num_types * num_types, 1.0);
+    katana::PerThreadStorage<EdgeTypeMoments> moments;
+
+    const uint32_t iterations = std::max(plan_.max_iterations(), 1U);
+    for (uint32_t iter = 0; iter < iterations; ++iter) {
+      katana::on_each([&](unsigned, unsigned) {
+        moments.getLocal()->Reset(num_types);
+      });
+
+      katana::do_all(
+          katana::iterate(uint64_t{0}, walks->num_walks()),
+          [&](uint64_t w) {
+            SplitMix64 rng(iter * walks->num_walks() + w);
+            EdgeTypeMoments& local = *moments.getLocal();
+            std::fill(local.histogram.begin(), local.histogram.end(), 0);
+
+            uint32_t* walk = walks->walk(w);
+            GNode prev = kNoNode;
+            GNode curr = w % graph_.NumNodes();
+            uint32_t prev_type = 0;
+            walk[0] = curr;
+            for (uint64_t step = 1; step < walks->width(); ++step) {
+              uint32_t degree =
+                  curr == kNoNode ? 0 : graph_.OutDegree(curr);
+              if (degree == 0) {
+                walk[step] = kNoNode;
+                curr = kNoNode;
+                continue;
+              }
+              Edge first = FirstEdge(graph_, curr);
+              Edge e = first;
+              while (true) {
+                e = first +
+                    first_order.Sample(first, degree, rng.NextDouble());
+                if (prev == kNoNode) {
+                  break;
+                }
+                double alpha = bias(graph_, prev, graph_.OutEdgeDst(e)) *
+                               transition[prev_type * num_types + edge_type[e]];
+                if (rng.NextDouble() * bias.upper_bound <= alpha) {
+                  break;
+                }
+              }
+              prev = curr;
+              curr = graph_.OutEdgeDst(e);
+              prev_type = edge_type[e];
+              walk[step] = curr;
+              local.histogram[prev_type] += 1;
+            }
+
+            if (walks->width() < 2 || walk[1] == kNoNode) {
+              return;
+            }
+            local.num_walks += 1;
+            for (uint32_t i = 0; i < num_types; ++i) {
+              local.sum[i] += local.histogram[i];
+              for (uint32_t j = 0; j < num_types; ++j) {
+                local.product_sum[i * num_types + j] +=
+                    static_cast<double>(local.histogram[i]) *
+                    local.histogram[j];
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kWalkChunkSize>(),
+          katana::loopname("WeightedEdge2vec walks"), katana::no_stats());
+
+      UpdateTransitions(moments, num_types, &transition);
+    }
+
+    return katana::ResultSuccess();
+  }
+
+  /// Sets each transition weight to the sigmoid of the Pearson correlation
+  /// of the numbers of edges of the two types over the walks.
+  static void UpdateTransitions(
+      katana::PerThreadStorage<EdgeTypeMoments>& moments, uint32_t num_types,
+      std::vector<double>* transition) {
+    EdgeTypeMoments total;
+    total.Reset(num_types);
+    for (unsigned t = 0; t < moments.size(); ++t) {
+      const EdgeTypeMoments& local = *moments.getRemote(t);
+      if (local.sum.size() != num_types) {
+        continue;
+      }
+      total.num_walks += local.num_walks;
+      for (uint32_t i = 0; i < num_types; ++i) {
+        total.sum[i] += local.sum[i];
+      }
+      for (uint32_t i = 0; i < num_types * num_types; ++i) {
+        total.product_sum[i] += local.product_sum[i];
+      }
+    }
+    if (total.num_walks == 0) {
+      return;
+    }
+
+    const double n = total.num_walks;
+    auto mean = [&](uint32_t i) { return total.sum[i] / n; };
+    auto covariance = [&](uint32_t i, uint32_t j) {
+      return total.product_sum[i * num_types + j] / n - mean(i) * mean(j);
+    };
+    for (uint32_t i = 0; i < num_types; ++i) {
+      for (uint32_t j = 0; j < num_types; ++j) {
+        double sigmas = std::sqrt(covariance(i, i) * covariance(j, j));
+        double corr = sigmas > 0 ? covariance(i, j) / sigmas : 0;
+        (*transition)[i * num_types + j] = 1 / (1 + std::exp(-corr));
+      }
+    }
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+ExtractEdgeWeights(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    katana::NUMAArray<float>* weights) {
+  using WeightProperty = katana::PODProperty<Weight>;
+  using WeightGraphView = katana::TypedPropertyGraphView<
+      SortedPropertyGraphView, std::tuple<>, std::tuple<WeightProperty>>;
+  auto graph = KATANA_CHECKED(
+      WeightGraphView::Make(pg, {}, {edge_weight_property_name}));
+
+  weights->allocateBlocked(graph.NumEdges());
+  katana::GReduceLogicalOr negative;
+  katana::do_all(
+      katana::iterate(graph.OutEdges()),
+      [&](Edge e) {
+        Weight w = graph.template GetEdgeData<WeightProperty>(e);
+        if constexpr (std::is_signed_v<Weight>) {
+          negative.update(w < 0);
+        }
+        (*weights)[e] = static_cast<float>(w);
+      },
+      katana::no_stats());
+
+  if (negative.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "edge weights must not be negative: {}", edge_weight_property_name);
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+katana::analytics::WeightedRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan) {
+  katana::NUMAArray<float> weights;
+  if (!edge_weight_property_name.empty()) {
+    switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+                ->type()
+                ->id()) {
+    case arrow::UInt32Type::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<uint32_t>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    case arrow::Int32Type::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<int32_t>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    case arrow::UInt64Type::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<uint64_t>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    case arrow::Int64Type::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<int64_t>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    case arrow::FloatType::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<float>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    case arrow::DoubleType::type_id:
+      KATANA_CHECKED(ExtractEdgeWeights<double>(
+          pg, edge_weight_property_name, &weights));
+      break;
+    default:
+      return KATANA_ERROR(
+          katana::ErrorCode::TypeError, "Unsupported type: {}",
+          KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->ToString());
+    }
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+  auto graph = KATANA_CHECKED(SortedGraphView::Make(pg, {}, {}));
+
+  WalkBuffer walks = KATANA_CHECKED(WalkBuffer::Make(
+      uint64_t{graph.NumNodes()} * plan.number_of_walks(),
+      plan.walk_length()));
+  if (walks.num_walks() == 0) {
+    return walks.Finish();
+  }
+
+  katana::StatTimer exec_time("WeightedRandomWalks");
+  exec_time.start();
+  switch (plan.algorithm()) {
+  case RandomWalksPlan::kNode2Vec:
+    KATANA_CHECKED((WeightedNode2VecAlgo{graph, weights, plan}(&walks)));
+    break;
+  case RandomWalksPlan::kEdge2Vec:
+    KATANA_CHECKED((WeightedEdge2VecAlgo{graph, weights, plan, pg}(&walks)));
+    break;
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+  exec_time.stop();
+
+  return walks.Finish();
+}
@@ -19,6 +19,13 @@
 
 #include "katana/analytics/sssp/sssp.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "katana/Random.h"
 #include "katana/Reduction.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -225,6 +232,321 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
     }
   }
 
+  /// Number of edge weights sampled to estimate the initial delta.
+  static constexpr size_t kAutoDeltaSamples = 4096;
+  static constexpr unsigned kAutoMaxShift = 30;
+  /// Buckets that settle fewer nodes than this (per thread) are too small to
+  /// keep all threads busy.
+  static constexpr size_t kAutoMinBucketNodesPerThread = 64;
+  /// Number of consecutive small buckets before delta is doubled.
+  static constexpr size_t kAutoSmallBucketPatience = 2;
+  /// Node relaxations per settled node above which delta is halved.
+  static constexpr double kAutoMaxReworkRatio = 2.0;
+  /// Number of buckets ahead of the current one that are kept apart; nodes
+  /// further ahead share an overflow bucket.
+  static constexpr size_t kAutoRingBuckets = 64;
+
+  /// A copy of the out-edges of each node sorted by increasing weight, so that
+  /// the light edges (weight < delta) of a node are a prefix of its edge range
+  /// for any delta.
+  struct WeightSortedEdges {
+    katana::NUMAArray<typename Graph::Node> dst;
+    katana::NUMAArray<Weight> weight;
+  };
+
+  static void SortEdgesByWeight(Graph* graph, WeightSortedEdges* edges) {
+    using Node = typename Graph::Node;
+
+    edges->dst.allocateInterleaved(graph->NumEdges());
+    edges->weight.allocateInterleaved(graph->NumEdges());
+
+    katana::PerThreadStorage<std::vector<std::pair<Weight, Node>>> scratch;
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const Node& n) {
+          auto& adj = *scratch.getLocal();
+          adj.clear();
+          for (auto e : graph->OutEdges(n)) {
+            adj.emplace_back(
+                graph->template GetEdgeData<EdgeWeight>(e),
+                graph->OutEdgeDst(e));
+          }
+          std::sort(adj.begin(), adj.end());
+
+          size_t i = 0;
+          for (auto e : graph->OutEdges(n)) {
+            edges->weight[e] = adj[i].first;
+            edges->dst[e] = adj[i].second;
+            ++i;
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("SSSP SortEdgesByWeight"));
+  }
+
+  /// Pick delta = Theta(max weight / average degree) (Meyer and Sanders),
+  /// using twice the mean of a sample of edge weights as the maximum weight.
+  static unsigned EstimateDeltaShift(
+      Graph* graph, const WeightSortedEdges& edges) {
+    if (graph->NumEdges() == 0) {
+      return 0;
+    }
+
+    auto& gen = katana::GetGenerator();
+    std::uniform_int_distribution<uint64_t> pick(0, graph->NumEdges() - 1);
+    size_t num_samples =
+        std::min<uint64_t>(kAutoDeltaSamples, graph->NumEdges());
+    double total_weight = 0;
+    for (size_t i = 0; i < num_samples; ++i) {
+      total_weight += edges.weight[pick(gen)];
+    }
+
+    double mean_weight = total_weight / num_samples;
+    double average_degree = double(graph->NumEdges()) / graph->size();
+    double delta = 2 * mean_weight / average_degree;
+    if (!(delta > 1)) {
+      return 0;
+    }
+    return std::min<unsigned>(kAutoMaxShift, std::lround(std::log2(delta)));
+  }
+
+  /// The pending nodes of a thread by bucket. Buckets are kept in a ring of
+  /// kAutoRingBuckets slots relative to the bucket being settled, so memory
+  /// does not grow with the largest distance. Nodes beyond the ring wait in
+  /// an overflow bucket until the ring reaches them.
+  struct BucketRing {
+    using Node = typename Graph::Node;
+    using Bucket = katana::gstl::Vector<Node>;
+
+    katana::gstl::Vector<Bucket> slots;
+    Bucket overflow;
+    /// A lower bound of the buckets of the nodes in overflow
+    size_t overflow_min = std::numeric_limits<size_t>::max();
+
+    BucketRing() : slots(kAutoRingBuckets) {}
+
+    /// Add n to bucket idx; base is the first bucket of the ring
+    void Push(Node n, size_t idx, size_t base) {
+      KATANA_LOG_DEBUG_ASSERT(idx >= base);
+      if (idx - base < kAutoRingBuckets) {
+        slots[idx % kAutoRingBuckets].push_back(n);
+      } else {
+        overflow.push_back(n);
+        overflow_min = std::min(overflow_min, idx);
+      }
+    }
+
+    Bucket& Slot(size_t idx) { return slots[idx % kAutoRingBuckets]; }
+
+    /// \returns the first non-empty bucket at or after first, which is
+    /// within the ring that starts at base, or overflow_min
+    size_t FirstBucket(size_t first, size_t base) const {
+      for (size_t idx = first; idx < base + kAutoRingBuckets; ++idx) {
+        if (!slots[idx % kAutoRingBuckets].empty()) {
+          return idx;
+        }
+      }
+      return overflow_min;
+    }
+
+    /// Move every pending node with a distance of at least frontier to its
+    /// bucket in a ring that starts at base
+    template <typename BucketOf, typename DistOf>
+    void Redistribute(
+        Dist frontier, size_t base, const BucketOf& bucket_of,
+        const DistOf& dist_of, bool only_overflow) {
+      Bucket pending;
+      std::swap(pending, overflow);
+      overflow_min = std::numeric_limits<size_t>::max();
+      if (!only_overflow) {
+        for (Bucket& slot : slots) {
+          pending.insert(pending.end(), slot.begin(), slot.end());
+          slot.clear();
+        }
+      }
+      for (Node n : pending) {
+        Dist d = dist_of(n);
+        if (d >= frontier) {
+          Push(n, bucket_of(d), base);
+        }
+      }
+    }
+  };
+
+  static void DeltaStepAutoAlgo(
+      katana::NUMAArray<std::atomic<Weight>>* node_data, Graph* graph,
+      const typename Graph::Node& source) {
+    using Node = typename Graph::Node;
+
+    WeightSortedEdges edges;
+    SortEdgesByWeight(graph, &edges);
+
+    unsigned shift = EstimateDeltaShift(graph, edges);
+    katana::ReportStatSingle("SSSP", "initial delta shift", shift);
+
+    auto bucket_of = [&shift](Dist d) -> size_t {
+      return d / static_cast<Dist>(uint64_t{1} << shift);
+    };
+    auto dist_of = [&](Node n) -> Dist { return (*node_data)[n]; };
+
+    katana::PerThreadStorage<BucketRing> buckets;
+    // The bucket being settled, which is also the first bucket of the rings
+    size_t cur_bucket = 0;
+
+    // Relax either the light (weight < delta) or the heavy edges of n.
+    auto relax = [&](Node n, Dist sdist, bool light, Dist delta,
+                     BucketRing& b) {
+      auto range = graph->OutEdges(n);
+      const Weight* weight = edges.weight.data();
+      const uint64_t begin = *range.begin();
+      const uint64_t end = *range.end();
+      const uint64_t split =
+          std::lower_bound(weight + begin, weight + end, delta) - weight;
+
+      for (uint64_t e = light ? begin : split, last = light ? split : end;
+           e < last; ++e) {
+        auto dest = edges.dst[e];
+        const Dist new_dist = sdist + weight[e];
+        Dist old_dist = katana::atomicMin((*node_data)[dest], new_dist);
+        if (new_dist < old_dist) {
+          b.Push(dest, bucket_of(new_dist), cur_bucket);
+        }
+      }
+    };
+
+    // The round in which a node was last settled, to collect each settled
+    // node once for the heavy edge phase. Several threads may process the
+    // same node in a round; the one that swaps in the round collects it.
+    katana::NUMAArray<std::atomic<uint32_t>> settled_round;
+    settled_round.allocateInterleaved(graph->size());
+    katana::do_all(
+        katana::iterate(size_t{0}, graph->size()),
+        [&](size_t n) { settled_round[n].store(0, std::memory_order_relaxed); },
+        katana::no_stats());
+
+    const size_t min_bucket_nodes =
+        kAutoMinBucketNodesPerThread * katana::getActiveThreads();
+
+    katana::InsertBag<Node> wl;
+    katana::InsertBag<Node> settled;
+    wl.push_back(source);
+
+    size_t small_buckets = 0;
+    size_t delta_changes = 0;
+
+    for (uint32_t round = 1; true; ++round) {
+      const Dist delta = static_cast<Dist>(uint64_t{1} << shift);
+
+      katana::GAccumulator<size_t> processed;
+      katana::GAccumulator<size_t> num_settled;
+      settled.clear();
+
+      // Light phase: relax light edges until the current bucket is empty.
+      while (!wl.empty()) {
+        katana::do_all(
+            katana::iterate(wl),
+            [&](const Node& n) {
+              Dist sdist = (*node_data)[n];
+              if (bucket_of(sdist) != cur_bucket) {
+                return;
+              }
+              processed += 1;
+              uint32_t last = settled_round[n].load(std::memory_order_relaxed);
+              if (last != round &&
+                  settled_round[n].compare_exchange_strong(
+                      last, round, std::memory_order_relaxed)) {
+                settled.push(n);
+                num_settled += 1;
+              }
+              relax(n, sdist, true, delta, *buckets.getLocal());
+            },
+            katana::steal(), katana::no_stats(),
+            katana::loopname("SSSP DeltaStepAuto Light"));
+
+        wl.clear();
+
+        katana::on_each([&](unsigned, unsigned) {
+          auto& slot = buckets.getLocal()->Slot(cur_bucket);
+          for (Node n : slot) {
+            wl.push(n);
+          }
+          slot.clear();
+        });
+      }
+
+      // Heavy phase: heavy edges always leave the current bucket, so they
+      // only need to be relaxed once, from the settled distances.
+      katana::do_all(
+          katana::iterate(settled),
+          [&](const Node& n) {
+            relax(n, (*node_data)[n], false, delta, *buckets.getLocal());
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("SSSP DeltaStepAuto Heavy"));
+
+      // Every distance below frontier is final.
+      const Dist frontier = static_cast<Dist>(cur_bucket + 1) * delta;
+
+      unsigned new_shift = shift;
+      if (shift > 0 &&
+          processed.reduce() > kAutoMaxReworkRatio * num_settled.reduce()) {
+        new_shift = shift - 1;
+        small_buckets = 0;
+      } else if (num_settled.reduce() < min_bucket_nodes) {
+        if (++small_buckets >= kAutoSmallBucketPatience &&
+            shift < kAutoMaxShift) {
+          new_shift = shift + 1;
+          small_buckets = 0;
+        }
+      } else {
+        small_buckets = 0;
+      }
+
+      // The rings start at cur_bucket until the next bucket is chosen
+      if (new_shift != shift) {
+        shift = new_shift;
+        ++delta_changes;
+        cur_bucket = bucket_of(frontier);
+        katana::on_each([&](unsigned, unsigned) {
+          buckets.getLocal()->Redistribute(
+              frontier, cur_bucket, bucket_of, dist_of, false);
+        });
+      }
+
+      katana::GReduceMin<size_t> least_bucket;
+      const size_t first_bucket = bucket_of(frontier);
+
+      katana::on_each([&](unsigned, unsigned) {
+        least_bucket.update(
+            buckets.getLocal()->FirstBucket(first_bucket, cur_bucket));
+      });
+
+      cur_bucket = least_bucket.reduce();
+      if (cur_bucket == std::numeric_limits<size_t>::max()) {
+        katana::ReportStatSingle("SSSP", "rounds", round);
+        katana::ReportStatSingle("SSSP", "delta changes", delta_changes);
+        katana::ReportStatSingle("SSSP", "final delta shift", shift);
+        break;
+      }
+
+      // Slots before cur_bucket are empty and now stand for the buckets at
+      // the end of the ring, which overflowing nodes may belong to
+      katana::on_each([&](unsigned, unsigned) {
+        BucketRing& b = *buckets.getLocal();
+        if (b.overflow_min - cur_bucket < kAutoRingBuckets) {
+          b.Redistribute(frontier, cur_bucket, bucket_of, dist_of, true);
+        }
+        auto& slot = b.Slot(cur_bucket);
+        for (Node n : slot) {
+          wl.push(n);
+        }
+        slot.clear();
+        slot.shrink_to_fit();
+      });
+    }
+  }
+
   template <typename T, typename P, typename R>
   static void SerDeltaAlgo(
       Graph* graph, const typename Graph::Node& source, const P& pushWrap,
@@ -462,6 +784,9 @@ public:
     case SsspPlan::kDeltaStepFusion:
       DeltaStepFusionAlgo(&node_data, &edge_data, &graph, source, plan.delta());
       break;
+    case SsspPlan::kDeltaStepAuto:
+      DeltaStepAutoAlgo(&node_data, &graph, source);
+      break;
     case SsspPlan::kSerialDeltaTile:
       SerDeltaAlgo<SrcEdgeTile>(
           &graph, source, SrcEdgeTilePushWrap{&graph, *this}, TileRangeFn(),
@@ -0,0 +1,499 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/NUMAArray.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+#include "katana/analytics/connected_components/connected_components.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct NodeScc : public katana::PODProperty<uint64_t> {};
+
+using NodeData = std::tuple<NodeScc>;
+using EdgeData = std::tuple<>;
+using Graph = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::BiDirectional, NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+
+/// Nodes not yet in an SCC are split into partitions that are unions of
+/// SCCs. Only edges within a partition are live; trimming and traversals
+/// ignore the others, which keeps the work of a round proportional to the
+/// live edges and lets all partitions be processed by the same loops.
+///
+/// A partition is named by a key, 3 * its smallest node + a code that tells
+/// apart the parts a forward-backward round splits it into. Between rounds,
+/// keys are renumbered so that code is 0 and the smallest node is the pivot.
+/// Coloring rounds instead name each partition 3 * its color.
+class SccSolver {
+public:
+  explicit SccSolver(const Graph& graph) : graph_(graph) {
+    const uint32_t num_nodes = graph_.NumNodes();
+    scc_.allocateBlocked(num_nodes);
+    key_.allocateBlocked(num_nodes);
+    forward_.allocateBlocked(num_nodes);
+    backward_.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& n) {
+          scc_[n].store(kUnassigned, std::memory_order_relaxed);
+          key_[n] = 0;
+          forward_[n].store(0, std::memory_order_relaxed);
+          backward_[n].store(0, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+  }
+
+  uint32_t Scc(GNode n) const {
+    return scc_[n].load(std::memory_order_relaxed);
+  }
+
+  void ForwardBackward(uint32_t rounds) {
+    katana::NUMAArray<std::atomic<uint32_t>> smallest;
+    smallest.allocateBlocked(3 * uint64_t{graph_.NumNodes()});
+
+    uint32_t round = 0;
+    for (; round < rounds; ++round) {
+      katana::InsertBag<GNode> remaining;
+      if (Remaining(&remaining) == 0) {
+        break;
+      }
+      Trim(remaining);
+      katana::InsertBag<GNode> pivots;
+      if (Repartition(&smallest, &pivots) == 0) {
+        break;
+      }
+      Reach<true>(pivots, &forward_);
+      Reach<false>(pivots, &backward_);
+      Split();
+    }
+    katana::ReportStatSingle(
+        "StronglyConnectedComponents", "ForwardBackwardRounds", round);
+
+    Coloring();
+  }
+
+  void Coloring() {
+    katana::NUMAArray<std::atomic<uint32_t>> color;
+    color.allocateBlocked(graph_.NumNodes());
+
+    uint32_t round = 0;
+    while (true) {
+      katana::InsertBag<GNode> remaining;
+      if (Remaining(&remaining) == 0) {
+        break;
+      }
+      ++round;
+      Trim(remaining);
+
+      katana::do_all(
+          katana::iterate(remaining),
+          [&](const GNode& n) { color[n].store(n, std::memory_order_relaxed); },
+          katana::no_stats());
+
+      // Every node ends up with the largest node that reaches it
+      katana::for_each(
+          katana::iterate(remaining),
+          [&](const GNode& v, auto& ctx) {
+            if (Assigned(v)) {
+              return;
+            }
+            uint32_t c = color[v].load(std::memory_order_relaxed);
+            for (auto e : graph_.OutEdges(v)) {
+              GNode u = graph_.OutEdgeDst(e);
+              if (Live(v, u) && katana::atomicMax(color[u], c) < c) {
+                ctx.push(u);
+              }
+            }
+          },
+          katana::disable_conflict_detection(),
+          katana::loopname("SCC-Coloring-Propagate"));
+
+      // The SCC of a root is the set of nodes of its color that reach it
+      katana::InsertBag<GNode> roots;
+      katana::do_all(
+          katana::iterate(remaining),
+          [&](const GNode& n) {
+            if (!Assigned(n) && color[n].load(std::memory_order_relaxed) == n) {
+              scc_[n].store(n, std::memory_order_relaxed);
+              roots.push(n);
+            }
+          },
+          katana::no_stats());
+
+      katana::for_each(
+          katana::iterate(roots),
+          [&](const GNode& v, auto& ctx) {
+            uint32_t c = color[v].load(std::memory_order_relaxed);
+            for (auto e : graph_.InEdges(v)) {
+              GNode u = graph_.InEdgeSrc(e);
+              if (Live(v, u) && color[u].load(std::memory_order_relaxed) == c &&
+                  Claim(u, c)) {
+                ctx.push(u);
+              }
+            }
+          },
+          katana::disable_conflict_detection(),
+          katana::loopname("SCC-Coloring-Backward"));
+
+      // Every SCC lies within one color, so each color becomes a partition
+      // of its own and the edges between colors are dead from now on
+      katana::do_all(
+          katana::iterate(remaining),
+          [&](const GNode& n) {
+            if (!Assigned(n)) {
+              key_[n] = 3 * uint64_t{color[n].load(std::memory_order_relaxed)};
+            }
+          },
+          katana::no_stats());
+    }
+    katana::ReportStatSingle(
+        "StronglyConnectedComponents", "ColoringRounds", round);
+  }
+
+private:
+  bool Assigned(GNode n) const { return Scc(n) != kUnassigned; }
+
+  bool Claim(GNode n, uint32_t scc) {
+    uint32_t expected = kUnassigned;
+    return scc_[n].compare_exchange_strong(
+        expected, scc, std::memory_order_relaxed);
+  }
+
+  /// Whether the edge between v and u is live, seen from v.
+  bool Live(GNode v, GNode u) const {
+    return u != v && key_[u] == key_[v] && !Assigned(u);
+  }
+
+  uint64_t Remaining(katana::InsertBag<GNode>* remaining) const {
+    katana::GAccumulator<uint64_t> count;
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& n) {
+          if (!Assigned(n)) {
+            remaining->push(n);
+            count += 1;
+          }
+        },
+        katana::no_stats());
+    return count.reduce();
+  }
+
+  /// Make every node without live in-edges or without live out-edges an SCC
+  /// by itself. Trimming a node can make its neighbors trimmable, so they
+  /// are revisited.
+  void Trim(const katana::InsertBag<GNode>& remaining) {
+    katana::GAccumulator<uint64_t> trimmed;
+    katana::for_each(
+        katana::iterate(remaining),
+        [&](const GNode& v, auto& ctx) {
+          if (Assigned(v)) {
+            return;
+          }
+          bool has_out = false;
+          for (auto e : graph_.OutEdges(v)) {
+            if (Live(v, graph_.OutEdgeDst(e))) {
+              has_out = true;
+              break;
+            }
+          }
+          bool has_in = false;
+          for (auto e : graph_.InEdges(v)) {
+            if (Live(v, graph_.InEdgeSrc(e))) {
+              has_in = true;
+              break;
+            }
+          }
+          if ((has_out && has_in) || !Claim(v, v)) {
+            return;
+          }
+          trimmed += 1;
+          for (auto e : graph_.OutEdges(v)) {
+            GNode u = graph_.OutEdgeDst(e);
+            if (Live(v, u)) {
+              ctx.push(u);
+            }
+          }
+          for (auto e : graph_.InEdges(v)) {
+            GNode u = graph_.InEdgeSrc(e);
+            if (Live(v, u)) {
+              ctx.push(u);
+            }
+          }
+        },
+        katana::disable_conflict_detection(), katana::loopname("SCC-Trim"));
+    katana::ReportStatSingle(
+        "StronglyConnectedComponents", "Trimmed", trimmed.reduce());
+  }
+
+  /// Rename every partition after its smallest remaining node, which
+  /// becomes its pivot. Returns the number of pivots.
+  uint64_t Repartition(
+      katana::NUMAArray<std::atomic<uint32_t>>* smallest,
+      katana::InsertBag<GNode>* pivots) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, smallest->size()),
+        [&](uint64_t k) {
+          (*smallest)[k].store(kUnassigned, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& n) {
+          if (!Assigned(n)) {
+            katana::atomicMin((*smallest)[key_[n]], n);
+          }
+        },
+        katana::no_stats());
+
+    katana::GAccumulator<uint64_t> num_pivots;
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& n) {
+          if (Assigned(n)) {
+            return;
+          }
+          GNode pivot = (*smallest)[key_[n]].load(std::memory_order_relaxed);
+          key_[n] = 3 * uint64_t{pivot};
+          if (pivot == n) {
+            forward_[n].store(1, std::memory_order_relaxed);
+            backward_[n].store(1, std::memory_order_relaxed);
+            pivots->push(n);
+            num_pivots += 1;
+          }
+        },
+        katana::no_stats());
+    return num_pivots.reduce();
+  }
+
+  /// Mark the nodes reachable from the pivots along live edges, forward or
+  /// backward. Traversals from different pivots never meet because live
+  /// edges stay within a partition.
+  template <bool kForward>
+  void Reach(
+      const katana::InsertBag<GNode>& pivots,
+      katana::NUMAArray<std::atomic<uint8_t>>* reached) {
+    auto visit = [&](GNode v, GNode u, auto& ctx) {
+      if (Live(v, u) && (*reached)[u].load(std::memory_order_relaxed) == 0 &&
+          (*reached)[u].exchange(1, std::memory_order_relaxed) == 0) {
+        ctx.push(u);
+      }
+    };
+    katana::for_each(
+        katana::iterate(pivots),
+        [&](const GNode& v, auto& ctx) {
+          if constexpr (kForward) {
+            for (auto e : graph_.OutEdges(v)) {
+              visit(v, graph_.OutEdgeDst(e), ctx);
+            }
+          } else {
+            for (auto e : graph_.InEdges(v)) {
+              visit(v, graph_.InEdgeSrc(e), ctx);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::loopname(kForward ? "SCC-Forward" : "SCC-Backward"));
+  }
+
+  /// Nodes reached both ways form the SCC of their pivot; the rest split
+  /// into the forward only, backward only and unreached parts.
+  void Split() {
+    katana::do_all(
+        katana::iterate(graph_),
+        [&](const GNode& n) {
+          if (Assigned(n)) {
+            return;
+          }
+          bool f = forward_[n].load(std::memory_order_relaxed);
+          bool b = backward_[n].load(std::memory_order_relaxed);
+          forward_[n].store(0, std::memory_order_relaxed);
+          backward_[n].store(0, std::memory_order_relaxed);
+          if (f && b) {
+            scc_[n].store(key_[n] / 3, std::memory_order_relaxed);
+          } else {
+            key_[n] += f ? 0 : (b ? 1 : 2);
+          }
+        },
+        katana::steal(), katana::no_stats(), katana::loopname("SCC-Split"));
+  }
+
+  const Graph& graph_;
+  katana::NUMAArray<std::atomic<uint32_t>> scc_;
+  katana::NUMAArray<uint64_t> key_;
+  katana::NUMAArray<std::atomic<uint8_t>> forward_;
+  katana::NUMAArray<std::atomic<uint8_t>> backward_;
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponents(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx, StronglyConnectedComponentsPlan plan) {
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("StronglyConnectedComponents");
+  exec_time.start();
+
+  SccSolver solver(graph);
+  switch (plan.algorithm()) {
+  case StronglyConnectedComponentsPlan::kForwardBackward:
+    solver.ForwardBackward(plan.forward_backward_rounds());
+    break;
+  case StronglyConnectedComponentsPlan::kColoring:
+    solver.Coloring();
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "Unknown algorithm");
+  }
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeScc>(n) = solver.Scc(n); },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponentsAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+  const uint32_t num_nodes = graph.NumNodes();
+  constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+
+  // Iterative Tarjan
+  std::vector<uint32_t> index(num_nodes, kUnvisited);
+  std::vector<uint32_t> low(num_nodes);
+  std::vector<uint32_t> component(num_nodes, kUnvisited);
+  std::vector<GNode> stack;
+  std::vector<std::pair<GNode, uint64_t>> calls;
+  uint32_t next_index = 0;
+  uint32_t num_components = 0;
+
+  auto visit = [&](GNode v) {
+    index[v] = low[v] = next_index++;
+    stack.push_back(v);
+    calls.emplace_back(v, *graph.OutEdges(v).begin());
+  };
+
+  for (GNode root = 0; root < num_nodes; ++root) {
+    if (index[root] != kUnvisited) {
+      continue;
+    }
+    visit(root);
+    while (!calls.empty()) {
+      auto& [v, it] = calls.back();
+      if (it != *graph.OutEdges(v).end()) {
+        GNode w = graph.OutEdgeDst(it);
+        ++it;
+        if (index[w] == kUnvisited) {
+          visit(w);
+        } else if (component[w] == kUnvisited) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+
+      GNode done = v;
+      calls.pop_back();
+      if (low[done] == index[done]) {
+        GNode w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          component[w] = num_components;
+        } while (w != done);
+        ++num_components;
+      }
+      if (!calls.empty()) {
+        GNode parent = calls.back().first;
+        low[parent] = std::min(low[parent], low[done]);
+      }
+    }
+  }
+
+  // The IDs must induce the same partition as the Tarjan components
+  std::vector<uint64_t> id_of_component(num_components, kUnvisited);
+  std::vector<uint32_t> component_of_id(num_nodes, kUnvisited);
+  for (GNode n = 0; n < num_nodes; ++n) {
+    uint64_t id = graph.GetData<NodeScc>(n);
+    if (id >= num_nodes) {
+      return katana::ErrorCode::AssertionFailed;
+    }
+    uint32_t c = component[n];
+    if (id_of_component[c] == kUnvisited) {
+      id_of_component[c] = id;
+    }
+    if (component_of_id[id] == kUnvisited) {
+      component_of_id[id] = c;
+    }
+    if (id_of_component[c] != id || component_of_id[id] != c) {
+      KATANA_LOG_DEBUG("{} (SCC: {}) is in the wrong SCC", n, id);
+      return katana::ErrorCode::AssertionFailed;
+    }
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<StronglyConnectedComponentsStatistics>
+katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  // SCC IDs are component IDs as far as counting goes
+  auto stats =
+      KATANA_CHECKED(ConnectedComponentsStatistics::Compute(pg, property_name));
+  return StronglyConnectedComponentsStatistics{
+      stats.total_components, stats.total_non_trivial_components,
+      stats.largest_component_size, stats.largest_component_ratio};
+}
+
+void
+katana::analytics::StronglyConnectedComponentsStatistics::Print(
+    std::ostream& os) const {
+  os << "Total number of SCCs = " << total_components << std::endl;
+  os << "Total number of non trivial SCCs = " << total_non_trivial_components
+     << std::endl;
+  os << "Number of nodes in the largest SCC = " << largest_component_size
+     << std::endl;
+  os << "Ratio of nodes in the largest SCC = " << largest_component_ratio
+     << std::endl;
+}
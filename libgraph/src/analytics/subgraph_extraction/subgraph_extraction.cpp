@@ -19,8 +19,16 @@
 
 #include "katana/analytics/subgraph_extraction/subgraph_extraction.h"
 
+#include <algorithm>
 #include <iostream>
+#include <optional>
+#include <unordered_set>
+#include <utility>
 
+#include <arrow/array/concatenate.h>
+#include <arrow/compute/api.h>
+
+#include "katana/DynamicBitset.h"
 #include "katana/PropertyGraph.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -33,70 +41,345 @@ using edge_iterator = boost::counting_iterator<uint64_t>;
 using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
 using Node = SortedGraphView::Node;
 using Edge = SortedGraphView::Edge;
+using PropertyIndex = katana::GraphTopology::PropertyIndex;
+
+/// Number of indices gathered by one task when copying properties
+constexpr uint64_t kTakeBlockSize = 1U << 16U;
+
+/// Gather the values of property at indices into a new column. A run of
+/// consecutive indices is a slice that shares memory with property.
+katana::Result<std::shared_ptr<arrow::ChunkedArray>>
+TakeProperty(
+    const std::shared_ptr<arrow::ChunkedArray>& property,
+    const katana::NUMAArray<PropertyIndex>& indices) {
+  const uint64_t size = indices.size();
+  if (size == 0) {
+    return property->Slice(0, 0);
+  }
+
+  katana::GReduceLogicalOr has_gap;
+  katana::do_all(
+      katana::iterate(uint64_t{1}, size),
+      [&](uint64_t i) {
+        if (indices[i] != indices[i - 1] + 1) {
+          has_gap.update(true);
+        }
+      },
+      katana::no_stats());
+  if (!has_gap.reduce()) {
+    return property->Slice(indices[0], size);
+  }
+
+  // Take on a chunked array concatenates its chunks, so do it only once
+  std::shared_ptr<arrow::Array> values;
+  if (property->num_chunks() == 1) {
+    values = property->chunk(0);
+  } else {
+    values = KATANA_CHECKED(arrow::Concatenate(property->chunks()));
+  }
+
+  const uint64_t num_blocks = (size + kTakeBlockSize - 1) / kTakeBlockSize;
+  std::vector<std::shared_ptr<arrow::Array>> chunks(num_blocks);
+  std::vector<arrow::Status> statuses(num_blocks);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block) {
+        uint64_t begin = block * kTakeBlockSize;
+        uint64_t length = std::min(kTakeBlockSize, size - begin);
+        arrow::UInt64Array block_indices(
+            length, arrow::Buffer::Wrap(indices.data() + begin, length));
+        auto res = arrow::compute::Take(*values, block_indices);
+        if (!res.ok()) {
+          statuses[block] = res.status();
+          return;
+        }
+        chunks[block] = std::move(res).ValueUnsafe();
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("SubGraphExtraction-TakeProperty"));
+  for (const auto& status : statuses) {
+    if (!status.ok()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "gathering property values: {}",
+          status.ToString());
+    }
+  }
+  return std::make_shared<arrow::ChunkedArray>(
+      std::move(chunks), property->type());
+}
 
+/// Copy the named properties, in the order of indices, into a table.
+template <typename GetProperty>
+katana::Result<std::shared_ptr<arrow::Table>>
+TakeProperties(
+    const std::vector<std::string>& names,
+    const katana::NUMAArray<PropertyIndex>& indices,
+    const GetProperty& get_property) {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (const auto& name : names) {
+    auto property = KATANA_CHECKED(get_property(name));
+    columns.emplace_back(KATANA_CHECKED(TakeProperty(property, indices)));
+    fields.emplace_back(arrow::field(name, property->type()));
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+/// Build the sub-graph of pg whose node n is node_indices[n] of pg.
+/// for_each_edge(n, fn) calls fn(dest, edge_index) for every edge of node n
+/// of the sub-graph, in order, with the sub-graph ID of its destination and
+/// the property index of the edge in pg. It is called twice per node, once
+/// to size the adjacency of the node and once to fill it in.
+template <typename ForEachEdge>
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
-SubGraphNodeSet(
-    const SortedGraphView& graph, const std::vector<Node>& node_set) {
-  uint64_t num_nodes = node_set.size();
+BuildSubGraph(
+    katana::PropertyGraph* pg,
+    katana::NUMAArray<PropertyIndex>&& node_indices,
+    const ForEachEdge& for_each_edge,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx) {
+  const uint64_t num_nodes = node_indices.size();
+  if (num_nodes == 0) {
+    return std::make_unique<katana::PropertyGraph>();
+  }
+
   // Subgraph topology : out indices
   katana::NUMAArray<Edge> out_indices;
   out_indices.allocateInterleaved(num_nodes);
-
-  katana::gstl::Vector<katana::gstl::Vector<Node>> subgraph_edges;
-  subgraph_edges.resize(num_nodes);
-
   katana::do_all(
       katana::iterate(Node(0), Node(num_nodes)),
       [&](const Node& n) {
-        Node src = node_set[n];
-
-        auto last = graph.OutEdges(src).end();
-        for (Node m = 0; m < num_nodes; ++m) {
-          auto dest = node_set[m];
-          // Binary search on the edges sorted by destination id
-          for (auto edge_it = graph.FindEdge(src, dest);
-               edge_it != last && graph.OutEdgeDst(*edge_it) == dest;
-               ++edge_it) {
-            subgraph_edges[n].push_back(m);
-          }
-        }
-        out_indices[n] = subgraph_edges[n].size();
+        Edge count = 0;
+        for_each_edge(n, [&](Node, PropertyIndex) { ++count; });
+        out_indices[n] = count;
       },
-      katana::steal(), katana::loopname("SubgraphExtraction"));
+      katana::steal(), katana::loopname("SubGraphExtraction-CountEdges"));
 
   // Prefix sum
   katana::ParallelSTL::partial_sum(
       out_indices.begin(), out_indices.end(), out_indices.begin());
   uint64_t num_edges = out_indices[num_nodes - 1];
 
-  // Subgraph topology : out dests
+  // Subgraph topology : out dests, and where each edge came from
   katana::NUMAArray<Node> out_dests;
   out_dests.allocateInterleaved(num_edges);
+  katana::NUMAArray<PropertyIndex> edge_indices;
+  edge_indices.allocateInterleaved(num_edges);
 
   katana::do_all(
       katana::iterate(Node(0), Node(num_nodes)),
       [&](const Node& n) {
         uint64_t offset = n == 0 ? 0 : out_indices[n - 1];
-        for (Node dest : subgraph_edges[n]) {
+        for_each_edge(n, [&](Node dest, PropertyIndex edge_index) {
           out_dests[offset] = dest;
+          edge_indices[offset] = edge_index;
           offset++;
-        }
+        });
       },
       katana::steal(), katana::loopname("ConstructTopology"));
 
+  katana::PropertyGraph::EntityTypeIDArray node_types;
+  node_types.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        node_types[n] = pg->GetTypeOfNodeFromPropertyIndex(node_indices[n]);
+      },
+      katana::no_stats());
+  katana::PropertyGraph::EntityTypeIDArray edge_types;
+  edge_types.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        edge_types[e] = pg->GetTypeOfEdgeFromPropertyIndex(edge_indices[e]);
+      },
+      katana::no_stats());
+
   katana::GraphTopology sub_g_topo{
       std::move(out_indices), std::move(out_dests)};
-  auto sub_g_res = katana::PropertyGraph::Make(std::move(sub_g_topo));
+  auto sub_g = KATANA_CHECKED(katana::PropertyGraph::Make(
+      std::move(sub_g_topo), std::move(node_types), std::move(edge_types),
+      katana::EntityTypeManager{pg->GetNodeTypeManager()},
+      katana::EntityTypeManager{pg->GetEdgeTypeManager()}));
+
+  if (!node_properties_to_copy.empty()) {
+    auto table = KATANA_CHECKED(TakeProperties(
+        node_properties_to_copy, node_indices,
+        [&](const std::string& name) { return pg->GetNodeProperty(name); }));
+    KATANA_CHECKED(sub_g->AddNodeProperties(table, txn_ctx));
+  }
+  if (!edge_properties_to_copy.empty()) {
+    auto table = KATANA_CHECKED(TakeProperties(
+        edge_properties_to_copy, edge_indices,
+        [&](const std::string& name) { return pg->GetEdgeProperty(name); }));
+    KATANA_CHECKED(sub_g->AddEdgeProperties(table, txn_ctx));
+  }
 
-  return sub_g_res;
+  return sub_g;
 }
-}  // namespace
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
-katana::analytics::SubGraphExtraction(
-    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
-    SubGraphExtractionPlan plan) {
-  // Remove duplicates from the node vector
+SubGraphNodeSet(
+    katana::PropertyGraph* pg, const SortedGraphView& graph,
+    const std::vector<Node>& node_set,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx) {
+  uint64_t num_nodes = node_set.size();
+
+  // Pairs of node ID in pg and in the subgraph, sorted by node ID in pg
+  std::vector<std::pair<Node, Node>> members(num_nodes);
+  for (Node n = 0; n < num_nodes; ++n) {
+    members[n] = {node_set[n], n};
+  }
+  std::sort(members.begin(), members.end());
+
+  katana::NUMAArray<PropertyIndex> node_indices;
+  node_indices.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        node_indices[n] = graph.GetNodePropertyIndex(node_set[n]);
+      },
+      katana::no_stats());
+
+  auto for_each_edge = [&](Node n, const auto& fn) {
+    Node src = node_set[n];
+    // Either look up the destination of every edge among the members or
+    // look up every member among the edges, whichever searches less. Both
+    // go in order of node ID in pg.
+    if (graph.OutDegree(src) <= num_nodes) {
+      for (Edge e : graph.OutEdges(src)) {
+        Node dest = graph.OutEdgeDst(e);
+        auto it = std::lower_bound(
+            members.begin(), members.end(), dest,
+            [](const auto& member, Node key) { return member.first < key; });
+        if (it != members.end() && it->first == dest) {
+          fn(it->second, graph.GetEdgePropertyIndexFromOutEdge(e));
+        }
+      }
+      return;
+    }
+
+    auto last = graph.OutEdges(src).end();
+    for (const auto& [dest, m] : members) {
+      // Binary search on the edges sorted by destination id
+      for (auto edge_it = graph.FindEdge(src, dest);
+           edge_it != last && graph.OutEdgeDst(*edge_it) == dest; ++edge_it) {
+        fn(m, graph.GetEdgePropertyIndexFromOutEdge(*edge_it));
+      }
+    }
+  };
+
+  return BuildSubGraph(
+      pg, std::move(node_indices), for_each_edge, node_properties_to_copy,
+      edge_properties_to_copy, txn_ctx);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+SubGraphFiltered(
+    katana::PropertyGraph* pg, const SubGraphFilter& filter,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx) {
+  const auto& topology = pg->topology();
+  const uint64_t num_nodes = topology.NumNodes();
+
+  // The types of the entities that have any of the filter types, so that
+  // testing an entity is a single bit test
+  std::optional<katana::SetOfEntityTypeIDs> node_types;
+  if (filter.node_types) {
+    node_types = pg->GetNodeTypeManager().GetSupertypesOfAny(
+        filter.node_types.value());
+  }
+  std::optional<katana::SetOfEntityTypeIDs> edge_types;
+  if (filter.edge_types) {
+    edge_types = pg->GetEdgeTypeManager().GetSupertypesOfAny(
+        filter.edge_types.value());
+  }
+
+  // Pass 1: mark the kept nodes and number them with a prefix sum
+  katana::NUMAArray<Node> new_ids;
+  new_ids.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const Node& n) {
+        auto index = pg->GetNodePropertyIndex(n);
+        bool keep = (!node_types ||
+                     node_types->test(
+                         pg->GetTypeOfNodeFromPropertyIndex(index))) &&
+                    (!filter.node_mask || filter.node_mask->test(index)) &&
+                    (!filter.node_predicate || filter.node_predicate(index));
+        new_ids[n] = keep;
+      },
+      katana::steal(), katana::loopname("SubGraphExtraction-FilterNodes"));
+  katana::ParallelSTL::partial_sum(
+      new_ids.begin(), new_ids.end(), new_ids.begin());
+  const uint64_t num_new_nodes = num_nodes == 0 ? 0 : new_ids[num_nodes - 1];
+
+  katana::NUMAArray<Node> old_ids;
+  old_ids.allocateInterleaved(num_new_nodes);
+  katana::NUMAArray<PropertyIndex> node_indices;
+  node_indices.allocateInterleaved(num_new_nodes);
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const Node& n) {
+        Node prev = n == 0 ? 0 : new_ids[n - 1];
+        if (new_ids[n] != prev) {
+          old_ids[prev] = n;
+          node_indices[prev] = pg->GetNodePropertyIndex(n);
+        }
+      },
+      katana::no_stats());
+  auto is_kept = [&](Node n) {
+    return new_ids[n] != (n == 0 ? 0 : new_ids[n - 1]);
+  };
+
+  // Evaluate the edge filters once, so that the two passes over the edges
+  // of BuildSubGraph only test a bit
+  katana::DynamicBitset kept_edges;
+  kept_edges.resize(topology.NumEdges());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_new_nodes),
+      [&](uint64_t n) {
+        for (Edge e : topology.OutEdges(old_ids[n])) {
+          if (!is_kept(topology.OutEdgeDst(e))) {
+            continue;
+          }
+          auto index = pg->GetEdgePropertyIndexFromOutEdge(e);
+          if (edge_types &&
+              !edge_types->test(pg->GetTypeOfEdgeFromPropertyIndex(index))) {
+            continue;
+          }
+          if (filter.edge_mask && !filter.edge_mask->test(index)) {
+            continue;
+          }
+          if (filter.edge_predicate && !filter.edge_predicate(index)) {
+            continue;
+          }
+          kept_edges.set(e);
+        }
+      },
+      katana::steal(), katana::loopname("SubGraphExtraction-FilterEdges"));
+
+  auto for_each_edge = [&](Node n, const auto& fn) {
+    for (Edge e : topology.OutEdges(old_ids[n])) {
+      if (kept_edges.test(e)) {
+        fn(new_ids[topology.OutEdgeDst(e)] - 1,
+           pg->GetEdgePropertyIndexFromOutEdge(e));
+      }
+    }
+  };
+
+  return BuildSubGraph(
+      pg, std::move(node_indices), for_each_edge, node_properties_to_copy,
+      edge_properties_to_copy, txn_ctx);
+}
+
+/// Remove duplicates from the node vector, keeping first occurrences
+std::vector<Node>
+Deduplicate(const std::vector<Node>& node_vec) {
   std::unordered_set<uint32_t> set;
   std::vector<uint32_t> dedup_node_vec;
   for (auto n : node_vec) {
@@ -104,7 +387,25 @@ katana::analytics::SubGraphExtraction(
       dedup_node_vec.push_back(n);
     }
   }
+  return dedup_node_vec;
+}
+
+}  // namespace
 
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtraction(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
+    SubGraphExtractionPlan plan) {
+  return SubGraphExtraction(pg, node_vec, {}, {}, nullptr, plan);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::SubGraphExtraction(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx, SubGraphExtractionPlan plan) {
+  std::vector<Node> dedup_node_vec = Deduplicate(node_vec);
   if (dedup_node_vec.empty()) {
     return std::make_unique<katana::PropertyGraph>();
   }
@@ -115,12 +416,40 @@ katana::analytics::SubGraphExtraction(
   switch (plan.algorithm()) {
   case SubGraphExtractionPlan::kNodeSet: {
     execTime.start();
-    auto subgraph = SubGraphNodeSet(sg, dedup_node_vec);
+    auto subgraph = SubGraphNodeSet(
+        pg, sg, dedup_node_vec, node_properties_to_copy,
+        edge_properties_to_copy, txn_ctx);
     execTime.stop();
-    KATANA_LOG_DEBUG_ASSERT(subgraph);
-    return std::move(subgraph.value());
+    return subgraph;
   }
   default:
     return katana::ErrorCode::InvalidArgument;
   }
 }
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::analytics::FilteredSubGraphExtraction(
+    katana::PropertyGraph* pg, const SubGraphFilter& filter,
+    const std::vector<std::string>& node_properties_to_copy,
+    const std::vector<std::string>& edge_properties_to_copy,
+    katana::TxnContext* txn_ctx) {
+  if (filter.node_mask && filter.node_mask->size() != pg->NumOriginalNodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "node mask has {} bits, expected {}", filter.node_mask->size(),
+        pg->NumOriginalNodes());
+  }
+  if (filter.edge_mask && filter.edge_mask->size() != pg->NumOriginalEdges()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "edge mask has {} bits, expected {}", filter.edge_mask->size(),
+        pg->NumOriginalEdges());
+  }
+
+  katana::StatTimer execTime("SubGraph-Extraction-Filtered");
+  execTime.start();
+  auto subgraph = SubGraphFiltered(
+      pg, filter, node_properties_to_copy, edge_properties_to_copy, txn_ctx);
+  execTime.stop();
+  return subgraph;
+}
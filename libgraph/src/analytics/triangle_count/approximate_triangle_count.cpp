@@ -0,0 +1,428 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/triangle_count/triangle_count.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct NodeTriangles : public katana::PODProperty<double> {};
+
+using NodeData = std::tuple<NodeTriangles>;
+using EdgeData = std::tuple<>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+using PerNodeCounts = katana::NUMAArray<std::atomic<uint64_t>>;
+
+/// splitmix64 finalizer
+uint64_t
+Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31U);
+}
+
+/// Uniform in [0, 1)
+double
+ToUnit(uint64_t x) {
+  return (x >> 11U) * 0x1.0p-53;
+}
+
+/// The 97.5% quantile of Student's t distribution, for two-sided 95%
+/// intervals from a few trials.
+double
+TQuantile(uint32_t degrees_of_freedom) {
+  static const double kQuantiles[] = {
+      12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086};
+  constexpr uint32_t kNumQuantiles = std::size(kQuantiles);
+  if (degrees_of_freedom == 0) {
+    return 0;
+  }
+  if (degrees_of_freedom <= kNumQuantiles) {
+    return kQuantiles[degrees_of_freedom - 1];
+  }
+  return 1.96;
+}
+
+/// Count the triangles of the subgraph of the edges u - v for which
+/// keep(u, v) holds exactly, adding the triangles of each node to per_node
+/// if it is not null. keep must be symmetric.
+///
+/// The kept edges are copied into a small CSR of edges to larger neighbors,
+/// so each triangle u < v < w is found once, from u.
+template <typename Keep>
+uint64_t
+CountSampledTriangles(
+    const katana::GraphTopology& topology, const Keep& keep,
+    PerNodeCounts* per_node) {
+  const uint64_t num_nodes = topology.NumNodes();
+  if (num_nodes == 0) {
+    return 0;
+  }
+
+  katana::NUMAArray<uint64_t> offsets;
+  offsets.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& u) {
+        uint64_t count = 0;
+        for (auto e : topology.OutEdges(u)) {
+          GNode v = topology.OutEdgeDst(e);
+          count += u < v && keep(u, v);
+        }
+        offsets[u] = count;
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      offsets.begin(), offsets.end(), offsets.begin());
+  auto begin = [&](GNode u) { return u == 0 ? 0 : offsets[u - 1]; };
+
+  katana::NUMAArray<GNode> dests;
+  dests.allocateBlocked(offsets[num_nodes - 1]);
+  katana::NUMAArray<uint64_t> ends;
+  ends.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& u) {
+        uint64_t end = begin(u);
+        for (auto e : topology.OutEdges(u)) {
+          GNode v = topology.OutEdgeDst(e);
+          if (u < v && keep(u, v)) {
+            dests[end++] = v;
+          }
+        }
+        std::sort(dests.begin() + begin(u), dests.begin() + end);
+        ends[u] = std::unique(dests.begin() + begin(u), dests.begin() + end) -
+                  dests.begin();
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::GAccumulator<uint64_t> triangles;
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& u) {
+        uint64_t local = 0;
+        for (uint64_t i = begin(u); i < ends[u]; ++i) {
+          GNode v = dests[i];
+          uint64_t a = i + 1;
+          uint64_t b = begin(v);
+          while (a < ends[u] && b < ends[v]) {
+            if (dests[a] < dests[b]) {
+              ++a;
+            } else if (dests[b] < dests[a]) {
+              ++b;
+            } else {
+              ++local;
+              if (per_node) {
+                (*per_node)[v].fetch_add(1, std::memory_order_relaxed);
+                (*per_node)[dests[a]].fetch_add(1, std::memory_order_relaxed);
+              }
+              ++a;
+              ++b;
+            }
+          }
+        }
+        triangles += local;
+        if (per_node && local > 0) {
+          (*per_node)[u].fetch_add(local, std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("ApproximateTriangleCount-Count"));
+  return triangles.reduce();
+}
+
+/// Run num_trials sparsified counts and combine them. sample(seed) returns
+/// the keep predicate of one trial and scale its scaling factor.
+template <typename Sample>
+TriangleCountEstimate
+SparsifiedEstimate(
+    const katana::GraphTopology& topology,
+    const ApproximateTriangleCountPlan& plan, const Sample& sample,
+    double scale, PerNodeCounts* per_node) {
+  const uint32_t num_trials = plan.num_trials();
+  std::vector<double> estimates;
+  for (uint32_t t = 0; t < num_trials; ++t) {
+    auto keep = sample(Mix(plan.seed() + t));
+    estimates.push_back(
+        scale * CountSampledTriangles(topology, keep, per_node));
+  }
+
+  double mean = 0;
+  for (double x : estimates) {
+    mean += x;
+  }
+  mean /= num_trials;
+  double variance = 0;
+  for (double x : estimates) {
+    variance += (x - mean) * (x - mean);
+  }
+  double half_width = 0;
+  if (num_trials > 1) {
+    variance /= num_trials - 1;
+    half_width = TQuantile(num_trials - 1) * std::sqrt(variance / num_trials);
+  }
+  return TriangleCountEstimate{
+      mean, std::max(0.0, mean - half_width), mean + half_width};
+}
+
+TriangleCountEstimate
+WedgeSamplingEstimate(
+    const katana::GraphTopology& topology,
+    const ApproximateTriangleCountPlan& plan, PerNodeCounts* per_node,
+    double* scale) {
+  const uint64_t num_nodes = topology.NumNodes();
+  *scale = 0;
+  if (num_nodes == 0) {
+    return TriangleCountEstimate{0, 0, 0};
+  }
+
+  // Wedges centered at each node, as a running sum. Like the sampled
+  // subgraphs, wedges use distinct neighbors other than the node itself.
+  katana::NUMAArray<uint64_t> wedges;
+  wedges.allocateBlocked(num_nodes);
+  katana::PerThreadStorage<std::vector<GNode>> scratch;
+  katana::do_all(
+      katana::iterate(topology.Nodes()),
+      [&](const GNode& v) {
+        auto& neighbors = *scratch.getLocal();
+        neighbors.clear();
+        for (auto e : topology.OutEdges(v)) {
+          GNode u = topology.OutEdgeDst(e);
+          if (u != v) {
+            neighbors.push_back(u);
+          }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        uint64_t degree =
+            std::unique(neighbors.begin(), neighbors.end()) - neighbors.begin();
+        wedges[v] = degree < 2 ? 0 : degree * (degree - 1) / 2;
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      wedges.begin(), wedges.end(), wedges.begin());
+  const uint64_t total_wedges = wedges[num_nodes - 1];
+  if (total_wedges == 0) {
+    return TriangleCountEstimate{0, 0, 0};
+  }
+
+  auto has_edge = [&](GNode x, GNode y) {
+    if (topology.OutDegree(x) > topology.OutDegree(y)) {
+      std::swap(x, y);
+    }
+    for (auto e : topology.OutEdges(x)) {
+      if (topology.OutEdgeDst(e) == y) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Whether the a-th out-edge of v is the first one to a neighbor other
+  // than v, so that drawing out-edges until one is gives every distinct
+  // neighbor the same chance
+  auto is_first = [&](GNode v, uint64_t a) {
+    auto first = *topology.OutEdges(v).begin();
+    GNode u = topology.OutEdgeDst(first + a);
+    if (u == v) {
+      return false;
+    }
+    for (uint64_t i = 0; i < a; ++i) {
+      if (topology.OutEdgeDst(first + i) == u) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const uint64_t num_samples = plan.num_wedges();
+  katana::GAccumulator<uint64_t> closed;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_samples),
+      [&](uint64_t i) {
+        // Every sample has its own stream, independent of scheduling
+        uint64_t state = Mix(plan.seed() ^ Mix(i));
+        auto next = [&state]() { return Mix(state++); };
+
+        uint64_t r = next() % total_wedges;
+        GNode v = std::upper_bound(wedges.begin(), wedges.end(), r) -
+                  wedges.begin();
+        // v has at least two distinct neighbors, so both draws end
+        auto first = *topology.OutEdges(v).begin();
+        uint64_t degree = topology.OutDegree(v);
+        uint64_t a = next() % degree;
+        while (!is_first(v, a)) {
+          a = next() % degree;
+        }
+        GNode x = topology.OutEdgeDst(first + a);
+        uint64_t b = next() % degree;
+        while (b == a || !is_first(v, b)) {
+          b = next() % degree;
+        }
+        GNode y = topology.OutEdgeDst(first + b);
+        if (has_edge(x, y)) {
+          closed += 1;
+          if (per_node) {
+            (*per_node)[v].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("ApproximateTriangleCount-Wedges"));
+
+  // Every closed wedge centered at v is a triangle of v
+  *scale = static_cast<double>(total_wedges) / num_samples;
+
+  double closed_fraction = static_cast<double>(closed.reduce()) / num_samples;
+  double half_width =
+      1.96 * std::sqrt(closed_fraction * (1 - closed_fraction) / num_samples);
+  double triangles_per_fraction = total_wedges / 3.0;
+  return TriangleCountEstimate{
+      closed_fraction * triangles_per_fraction,
+      std::max(0.0, closed_fraction - half_width) * triangles_per_fraction,
+      std::min(1.0, closed_fraction + half_width) * triangles_per_fraction};
+}
+
+}  // namespace
+
+katana::Result<TriangleCountEstimate>
+katana::analytics::ApproximateTriangleCount(
+    katana::PropertyGraph* pg, katana::TxnContext* txn_ctx,
+    const std::string& output_property_name,
+    ApproximateTriangleCountPlan plan) {
+  switch (plan.algorithm()) {
+  case ApproximateTriangleCountPlan::kColorful:
+    if (plan.num_colors() == 0 || plan.num_trials() == 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "colors and trials must be positive");
+    }
+    break;
+  case ApproximateTriangleCountPlan::kEdgeSampling:
+    if (!(plan.edge_probability() > 0 && plan.edge_probability() <= 1) ||
+        plan.num_trials() == 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge probability must be in (0, 1] and trials positive");
+    }
+    break;
+  case ApproximateTriangleCountPlan::kWedgeSampling:
+    if (plan.num_wedges() == 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "wedges must be positive");
+    }
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "Unknown algorithm");
+  }
+
+  const auto& topology = pg->topology();
+  const bool want_per_node = !output_property_name.empty();
+
+  katana::ReportPageAllocGuard page_alloc;
+  katana::StatTimer exec_time("ApproximateTriangleCount");
+  exec_time.start();
+
+  PerNodeCounts per_node;
+  if (want_per_node) {
+    per_node.allocateBlocked(topology.NumNodes());
+    katana::do_all(
+        katana::iterate(topology.Nodes()),
+        [&](const GNode& n) {
+          per_node[n].store(0, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+  }
+  PerNodeCounts* per_node_ptr = want_per_node ? &per_node : nullptr;
+
+  TriangleCountEstimate estimate{};
+  // Multiplies the per-node counts into estimates
+  double per_node_scale = 0;
+  switch (plan.algorithm()) {
+  case ApproximateTriangleCountPlan::kColorful: {
+    const uint64_t num_colors = plan.num_colors();
+    auto sample = [num_colors](uint64_t seed) {
+      return [seed, num_colors](GNode u, GNode v) {
+        return Mix(seed ^ u) % num_colors == Mix(seed ^ v) % num_colors;
+      };
+    };
+    double scale = static_cast<double>(num_colors * num_colors);
+    estimate = SparsifiedEstimate(topology, plan, sample, scale, per_node_ptr);
+    per_node_scale = scale / plan.num_trials();
+    break;
+  }
+  case ApproximateTriangleCountPlan::kEdgeSampling: {
+    const double p = plan.edge_probability();
+    auto sample = [p](uint64_t seed) {
+      return [seed, p](GNode u, GNode v) {
+        uint64_t edge = uint64_t{std::min(u, v)} << 32U | std::max(u, v);
+        return ToUnit(Mix(seed ^ Mix(edge))) < p;
+      };
+    };
+    double scale = 1 / (p * p * p);
+    estimate = SparsifiedEstimate(topology, plan, sample, scale, per_node_ptr);
+    per_node_scale = scale / plan.num_trials();
+    break;
+  }
+  case ApproximateTriangleCountPlan::kWedgeSampling:
+    estimate =
+        WedgeSamplingEstimate(topology, plan, per_node_ptr, &per_node_scale);
+    break;
+  }
+  exec_time.stop();
+
+  if (want_per_node) {
+    KATANA_CHECKED(
+        pg->ConstructNodeProperties<NodeData>(txn_ctx, {output_property_name}));
+    auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) {
+          graph.GetData<NodeTriangles>(n) =
+              per_node[n].load(std::memory_order_relaxed) * per_node_scale;
+        },
+        katana::no_stats());
+  }
+
+  return estimate;
+}
+
+void
+katana::analytics::TriangleCountEstimate::Print(std::ostream& os) const {
+  os << "Estimated number of triangles = " << estimate << std::endl;
+  os << "95% confidence interval = [" << lower_bound << ", " << upper_bound
+     << "]" << std::endl;
+}
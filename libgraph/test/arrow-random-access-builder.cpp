@@ -0,0 +1,121 @@
+#include <string>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/Properties.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+constexpr size_t kLength = 1000;
+
+bool
+IsSet(size_t i) {
+  return i % 3 != 0;
+}
+
+std::string
+Name(size_t i) {
+  return std::string(i % 7, 'a' + i % 26);
+}
+
+void
+TestNumeric() {
+  katana::ArrowRandomAccessBuilder<arrow::Int64Type> builder(kLength);
+  katana::do_all(katana::iterate(size_t{0}, kLength), [&](size_t i) {
+    if (IsSet(i)) {
+      builder[i] = i * 2;
+    }
+  });
+
+  auto array = std::static_pointer_cast<arrow::Int64Array>(
+      builder.Finalize().value());
+  KATANA_LOG_ASSERT(array->ValidateFull().ok());
+  KATANA_LOG_ASSERT(array->length() == static_cast<int64_t>(kLength));
+  for (size_t i = 0; i < kLength; ++i) {
+    KATANA_LOG_VASSERT(array->IsValid(i) == IsSet(i), "validity of {}", i);
+    if (IsSet(i)) {
+      KATANA_LOG_ASSERT(array->Value(i) == static_cast<int64_t>(i * 2));
+    }
+  }
+}
+
+void
+TestBoolean() {
+  katana::ArrowRandomAccessBuilder<arrow::BooleanType> builder(kLength);
+  katana::do_all(katana::iterate(size_t{0}, kLength), [&](size_t i) {
+    builder.SetValue(i, i % 5 == 0);
+  });
+
+  auto array = std::static_pointer_cast<arrow::BooleanArray>(
+      builder.Finalize().value());
+  KATANA_LOG_ASSERT(array->ValidateFull().ok());
+  KATANA_LOG_ASSERT(array->null_count() == 0);
+  for (size_t i = 0; i < kLength; ++i) {
+    KATANA_LOG_VASSERT(array->Value(i) == (i % 5 == 0), "value of {}", i);
+  }
+}
+
+template <typename ArrowType>
+void
+TestString() {
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+  katana::ArrowRandomAccessBuilder<ArrowType> builder(kLength);
+  katana::do_all(katana::iterate(size_t{0}, kLength), [&](size_t i) {
+    if (IsSet(i)) {
+      builder.SetValue(i, Name(i));
+    }
+  });
+
+  auto array = std::static_pointer_cast<ArrayType>(builder.Finalize().value());
+  KATANA_LOG_ASSERT(array->ValidateFull().ok());
+  for (size_t i = 0; i < kLength; ++i) {
+    KATANA_LOG_VASSERT(array->IsValid(i) == IsSet(i), "validity of {}", i);
+    if (IsSet(i)) {
+      KATANA_LOG_VASSERT(
+          array->GetString(i) == Name(i), "value of {}: {}", i,
+          array->GetString(i));
+    }
+  }
+}
+
+void
+TestAllocate() {
+  auto table = katana::UInt32Property::Allocate(kLength, "value").value();
+  auto array =
+      std::static_pointer_cast<arrow::UInt32Array>(table->column(0)->chunk(0));
+  KATANA_LOG_ASSERT(array->ValidateFull().ok());
+  KATANA_LOG_ASSERT(array->length() == static_cast<int64_t>(kLength));
+  KATANA_LOG_ASSERT(array->null_count() == 0);
+  for (size_t i = 0; i < kLength; ++i) {
+    KATANA_LOG_ASSERT(array->Value(i) == 0);
+  }
+
+  table = katana::ArrayProperty<double, 3>::Allocate(kLength, "vec").value();
+  auto lists = std::static_pointer_cast<arrow::LargeListArray>(
+      table->column(0)->chunk(0));
+  KATANA_LOG_ASSERT(lists->ValidateFull().ok());
+  KATANA_LOG_ASSERT(lists->length() == static_cast<int64_t>(kLength));
+  for (size_t i = 0; i < kLength; ++i) {
+    KATANA_LOG_ASSERT(lists->value_length(i) == 3);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestNumeric();
+  TestBoolean();
+  TestString<arrow::StringType>();
+  TestString<arrow::LargeStringType>();
+  TestAllocate();
+
+  return 0;
+}
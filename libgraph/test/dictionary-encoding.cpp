@@ -0,0 +1,244 @@
+#include <string>
+
+#include <arrow/api.h>
+#include <arrow/type.h>
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/DictionaryEncoding.h"
+#include "katana/EntityIndex.h"
+#include "katana/Logging.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyPredicate.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+using P = katana::PropertyPredicate;
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 1000;
+
+bool
+HasCountry(size_t i) {
+  return i % 11 != 0;
+}
+
+std::string
+Country(size_t i) {
+  static const char* kCountries[] = {"fr", "de", "us", "jp", "br"};
+  return kCountries[(i * 7) % 5];
+}
+
+/// Values in chunks that end at chunk_ends
+std::shared_ptr<arrow::ChunkedArray>
+MakeCountries(const std::vector<size_t>& chunk_ends) {
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  size_t begin = 0;
+  for (size_t end : chunk_ends) {
+    arrow::LargeStringBuilder builder;
+    for (size_t i = begin; i < end; ++i) {
+      if (HasCountry(i)) {
+        KATANA_LOG_ASSERT(builder.Append(Country(i)).ok());
+      } else {
+        KATANA_LOG_ASSERT(builder.AppendNull().ok());
+      }
+    }
+    chunks.emplace_back();
+    KATANA_LOG_ASSERT(builder.Finish(&chunks.back()).ok());
+    begin = end;
+  }
+  return std::make_shared<arrow::ChunkedArray>(chunks);
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(katana::TxnContext* txn_ctx) {
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy, txn_ctx);
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("country", arrow::large_utf8())}),
+      {MakeCountries({kNumNodes})});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table, txn_ctx));
+  KATANA_LOG_ASSERT(g->DictionaryEncodeNodeProperty("country", txn_ctx));
+  return g;
+}
+
+void
+TestEncodeChunks() {
+  // Chunks of uneven sizes, of which one is encoded already
+  auto strings = MakeCountries({100, 337, kNumNodes});
+  std::vector<std::shared_ptr<arrow::Array>> chunks = strings->chunks();
+  chunks[1] = katana::DictionaryEncodeStrings(arrow::ChunkedArray(chunks[1]))
+                  .value()
+                  ->chunk(0);
+  auto encoded =
+      katana::DictionaryEncodeStrings(arrow::ChunkedArray(chunks)).value();
+
+  KATANA_LOG_ASSERT(encoded->num_chunks() == 1);
+  const auto& array =
+      static_cast<const arrow::DictionaryArray&>(*encoded->chunk(0));
+  KATANA_LOG_ASSERT(array.ValidateFull().ok());
+  KATANA_LOG_ASSERT(array.dictionary()->length() == 5);
+  const auto& dictionary =
+      static_cast<const arrow::LargeStringArray&>(*array.dictionary());
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    KATANA_LOG_ASSERT(array.IsValid(i) == HasCountry(i));
+    if (HasCountry(i)) {
+      KATANA_LOG_ASSERT(
+          dictionary.GetString(array.GetValueIndex(i)) == Country(i));
+    }
+  }
+
+  auto numbers = arrow::MakeArrayOfNull(arrow::int32(), 3).ValueOrDie();
+  KATANA_LOG_ASSERT(
+      !katana::DictionaryEncodeStrings(arrow::ChunkedArray(numbers)));
+}
+
+void
+TestView(const katana::PropertyGraph& pg) {
+  auto column = pg.GetNodeProperty("country").value();
+  KATANA_LOG_ASSERT(column->type()->id() == arrow::Type::DICTIONARY);
+  KATANA_LOG_ASSERT(column->num_chunks() == 1);
+
+  auto view = katana::ConstructPropertyView<
+                  katana::DictionaryStringReadOnlyProperty>(
+                  column->chunk(0).get())
+                  .value();
+  KATANA_LOG_ASSERT(view.size() == kNumNodes);
+  KATANA_LOG_ASSERT(view.num_codes() == 5);
+
+  // The dictionary is sorted
+  for (size_t code = 1; code < view.num_codes(); ++code) {
+    KATANA_LOG_ASSERT(view.CodeValue(code - 1) < view.CodeValue(code));
+  }
+
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    KATANA_LOG_VASSERT(view.IsValid(i) == HasCountry(i), "validity of {}", i);
+    if (HasCountry(i)) {
+      KATANA_LOG_ASSERT(view.GetValue(i) == Country(i));
+      KATANA_LOG_ASSERT(view.GetCode(i) == view.FindCode(Country(i)));
+    }
+  }
+  KATANA_LOG_ASSERT(view.FindCode("xx") == -1);
+}
+
+void
+TestUnsortedDictionary() {
+  arrow::LargeStringBuilder dictionary_builder;
+  KATANA_LOG_ASSERT(dictionary_builder.Append("us").ok());
+  KATANA_LOG_ASSERT(dictionary_builder.Append("fr").ok());
+  std::shared_ptr<arrow::Array> dictionary;
+  KATANA_LOG_ASSERT(dictionary_builder.Finish(&dictionary).ok());
+
+  arrow::Int32Builder codes_builder;
+  KATANA_LOG_ASSERT(codes_builder.AppendValues({0, 1, 1}).ok());
+  std::shared_ptr<arrow::Array> codes;
+  KATANA_LOG_ASSERT(codes_builder.Finish(&codes).ok());
+
+  arrow::DictionaryArray array(
+      arrow::dictionary(arrow::int32(), arrow::large_utf8()), codes,
+      dictionary);
+  KATANA_LOG_ASSERT(!katana::DictionaryStringPropertyReadOnlyView::Make(array));
+}
+
+void
+TestPredicate(const katana::PropertyGraph& pg) {
+  auto mask = P::Compare("country", P::CompareOp::kEqual, std::string("jp"))
+                  .EvaluateNodes(pg)
+                  .value();
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    KATANA_LOG_ASSERT(mask.test(i) == (HasCountry(i) && Country(i) == "jp"));
+  }
+
+  mask = P::Compare("country", P::CompareOp::kLess, std::string("fr"))
+             .EvaluateNodes(pg)
+             .value();
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    KATANA_LOG_ASSERT(mask.test(i) == (HasCountry(i) && Country(i) < "fr"));
+  }
+
+  KATANA_LOG_ASSERT(!P::Compare("country", P::CompareOp::kEqual, int64_t{1})
+                         .EvaluateNodes(pg));
+}
+
+void
+TestIndex(katana::PropertyGraph* pg) {
+  using IndexType = katana::DictionaryEntityIndex<Node>;
+
+  KATANA_LOG_ASSERT(pg->MakeNodeIndex("country"));
+  auto generic_index = pg->GetNodeIndex("country").value();
+  auto* index = static_cast<IndexType*>(generic_index.get());
+
+  size_t num_with_country = 0;
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    num_with_country += HasCountry(i);
+  }
+  KATANA_LOG_ASSERT(index->size() == num_with_country);
+
+  auto [first, last] = index->EqualRange("us");
+  KATANA_LOG_ASSERT(first != last);
+  for (auto it = first; it != last; ++it) {
+    KATANA_LOG_ASSERT(HasCountry(*it) && Country(*it) == "us");
+  }
+
+  // Lower bounds between and past the strings of the dictionary
+  KATANA_LOG_ASSERT(index->Find("es") == index->end());
+  KATANA_LOG_ASSERT(index->LowerBound("es") == index->Find("fr"));
+  KATANA_LOG_ASSERT(index->LowerBound("zz") == index->end());
+  KATANA_LOG_ASSERT(index->LowerBound("") == index->begin());
+}
+
+/// Store the graph and check the dictionary column that is loaded back
+void
+TestStoreAndReload(katana::PropertyGraph* pg, katana::TxnContext* txn_ctx) {
+  auto uri_res = katana::URI::MakeRand("/tmp/dictionaryencoding");
+  KATANA_LOG_ASSERT(uri_res);
+  katana::URI rdg_dir = std::move(uri_res.value());
+
+  auto write_res = pg->Write(rdg_dir, "dictionary-encoding", txn_ctx);
+  if (!write_res) {
+    fs::remove_all(rdg_dir.path());
+    KATANA_LOG_FATAL("writing graph: {}", write_res.error());
+  }
+
+  auto make_res = katana::PropertyGraph::Make(
+      rdg_dir, txn_ctx, katana::RDGLoadOptions());
+  if (!make_res) {
+    fs::remove_all(rdg_dir.path());
+    KATANA_LOG_FATAL("loading graph: {}", make_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> reloaded = std::move(make_res.value());
+
+  TestView(*reloaded);
+  TestPredicate(*reloaded);
+  // The graph was not loaded from an RDG, so no index was stored with it and
+  // the index is built from the loaded column
+  TestIndex(reloaded.get());
+
+  reloaded.reset();
+  fs::remove_all(rdg_dir.path());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::TxnContext txn_ctx;
+
+  TestEncodeChunks();
+
+  auto pg = MakeGraph(&txn_ctx);
+  TestView(*pg);
+  TestPredicate(*pg);
+  TestIndex(pg.get());
+  TestUnsortedDictionary();
+  TestStoreAndReload(pg.get(), &txn_ctx);
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+#include "katana/Galois.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+
+using namespace katana;
+using Edge = PropertyGraph::Edge;
+using Node = PropertyGraph::Node;
+using MaskedGraphView = PropertyGraphViews::Masked;
+
+constexpr size_t kNumNodes = 1200;
+constexpr size_t kDegree = 3;
+
+bool
+KeepNode(Node n) {
+  return n % 3 != 0;
+}
+
+bool
+KeepEdge(Edge e) {
+  return e % 5 != 0;
+}
+
+Result<void>
+TestMaskedView() {
+  // A ring where every node points to its next kDegree nodes, so that the
+  // masks span several blocks
+  AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(kNumNodes);
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    for (size_t i = 1; i <= kDegree; ++i) {
+      builder.AddEdge(n, (n + i) % kNumNodes);
+    }
+  }
+  auto pg = KATANA_CHECKED(PropertyGraph::Make(builder.ConvertToCSR()));
+  const auto& topo = pg->topology();
+
+  DynamicBitset node_mask;
+  node_mask.resize(kNumNodes);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    if (KeepNode(n)) {
+      node_mask.set(n);
+    }
+  }
+  DynamicBitset edge_mask;
+  edge_mask.resize(topo.NumEdges());
+  for (Edge e = 0; e < topo.NumEdges(); ++e) {
+    if (KeepEdge(e)) {
+      edge_mask.set(e);
+    }
+  }
+
+  MaskedGraphView view =
+      KATANA_CHECKED(pg->BuildMaskedView(&node_mask, &edge_mask));
+
+  // IDs are those of the graph
+  KATANA_LOG_ASSERT(view.NumNodes() == kNumNodes);
+  KATANA_LOG_ASSERT(view.NumEdges() == topo.NumEdges());
+
+  std::vector<Node> nodes(view.begin(), view.end());
+  std::vector<Node> expected_nodes;
+  size_t expected_num_edges = 0;
+  for (Node n : topo.Nodes()) {
+    if (!KeepNode(n)) {
+      continue;
+    }
+    expected_nodes.emplace_back(n);
+
+    std::vector<Edge> expected_edges;
+    for (Edge e : topo.OutEdges(n)) {
+      if (KeepEdge(e) && KeepNode(topo.OutEdgeDst(e))) {
+        expected_edges.emplace_back(e);
+      }
+    }
+    auto e_range = view.OutEdges(n);
+    std::vector<Edge> edges(e_range.begin(), e_range.end());
+    KATANA_LOG_VASSERT(edges == expected_edges, "edges of node {} differ", n);
+    KATANA_LOG_ASSERT(view.OutDegree(n) == expected_edges.size());
+    expected_num_edges += expected_edges.size();
+  }
+  KATANA_LOG_ASSERT(nodes == expected_nodes);
+  KATANA_LOG_ASSERT(view.NumKeptNodes() == expected_nodes.size());
+  KATANA_LOG_ASSERT(view.NumKeptEdges() == expected_num_edges);
+
+  // Parallel loops over the view only visit kept nodes and edges
+  GAccumulator<size_t> num_nodes;
+  GAccumulator<size_t> num_edges;
+  do_all(iterate(view), [&](Node n) {
+    KATANA_LOG_ASSERT(view.IsNodeKept(n));
+    num_nodes += 1;
+    for (Edge e : view.OutEdges(n)) {
+      KATANA_LOG_ASSERT(view.IsEdgeKept(e));
+      num_edges += 1;
+    }
+  });
+  KATANA_LOG_ASSERT(num_nodes.reduce() == expected_nodes.size());
+  KATANA_LOG_ASSERT(num_edges.reduce() == expected_num_edges);
+
+  // As do loops over blocks of IDs
+  KATANA_LOG_ASSERT(view.NumNodeBlocks() > 1);
+  KATANA_LOG_ASSERT(view.NumEdgeBlocks() > view.NumNodeBlocks());
+  GAccumulator<size_t> num_block_nodes;
+  do_all(iterate(uint64_t{0}, view.NumNodeBlocks()), [&](uint64_t b) {
+    for (Node n : view.NodesInBlock(b)) {
+      KATANA_LOG_ASSERT(view.IsNodeKept(n));
+      KATANA_LOG_ASSERT(n / view.kBlockSize == b);
+      num_block_nodes += 1;
+    }
+  });
+  KATANA_LOG_ASSERT(num_block_nodes.reduce() == expected_nodes.size());
+
+  GAccumulator<size_t> num_block_edges;
+  do_all(iterate(uint64_t{0}, view.NumEdgeBlocks()), [&](uint64_t b) {
+    for (Edge e : view.EdgesInBlock(b)) {
+      KATANA_LOG_ASSERT(view.IsEdgeKept(e));
+      KATANA_LOG_ASSERT(e / view.kBlockSize == b);
+      num_block_edges += 1;
+    }
+  });
+  KATANA_LOG_ASSERT(num_block_edges.reduce() == expected_num_edges);
+
+  // Without masks every node and edge is kept
+  MaskedGraphView full = KATANA_CHECKED(pg->BuildMaskedView(nullptr, nullptr));
+  KATANA_LOG_ASSERT(full.NumKeptNodes() == kNumNodes);
+  KATANA_LOG_ASSERT(full.NumKeptEdges() == topo.NumEdges());
+
+  DynamicBitset short_mask;
+  short_mask.resize(kNumNodes - 1);
+  KATANA_LOG_ASSERT(!pg->BuildMaskedView(&short_mask, nullptr));
+
+  return katana::ResultSuccess();
+}
+
+int
+main() {
+  SharedMemSys sys;
+
+  auto res = TestMaskedView();
+  KATANA_LOG_ASSERT(res);
+
+  return 0;
+}
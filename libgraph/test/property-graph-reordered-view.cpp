@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <vector>
+
+#include "katana/GraphReordering.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/TypedPropertyGraph.h"
+
+using NodeSortKind = katana::RDGTopology::NodeSortKind;
+
+const std::vector<NodeSortKind> kReorderings = {
+    NodeSortKind::kReverseCuthillMcKee, NodeSortKind::kHubSorted,
+    NodeSortKind::kHubClustered,        NodeSortKind::kGorder,
+    NodeSortKind::kRabbitOrder,
+};
+
+void
+TestPermutation(const katana::GraphTopology& topo, NodeSortKind kind) {
+  auto new_to_old = katana::ComputeNodeReordering(topo, kind);
+  KATANA_LOG_VASSERT(
+      new_to_old.size() == topo.NumNodes(),
+      "Reordering {} has the wrong size", static_cast<int>(kind));
+
+  std::vector<bool> seen(topo.NumNodes(), false);
+  for (auto old_id : new_to_old) {
+    KATANA_LOG_VASSERT(
+        old_id < topo.NumNodes() && !seen[old_id],
+        "Reordering {} is not a permutation", static_cast<int>(kind));
+    seen[old_id] = true;
+  }
+}
+
+/// Every edge of pg is present in the reordered graph after mapping its
+/// endpoints.
+void
+TestReorderedGraph(katana::PropertyGraph* pg, NodeSortKind kind) {
+  auto reordered_res = katana::PropertyGraph::MakeReorderedGraph(*pg, kind);
+  KATANA_LOG_VASSERT(
+      reordered_res, "Failed to reorder graph: {}", reordered_res.error());
+  auto reordered = std::move(reordered_res.value());
+
+  const auto& topo = pg->topology();
+  const auto& new_topo = reordered->topology();
+  KATANA_LOG_VASSERT(
+      new_topo.NumNodes() == topo.NumNodes() &&
+          new_topo.NumEdges() == topo.NumEdges(),
+      "Reordered graph has a different size");
+
+  for (auto src : topo.Nodes()) {
+    auto new_src = reordered->OriginalToTransformedNodeID(src);
+    KATANA_LOG_VASSERT(
+        new_topo.OutDegree(new_src) == topo.OutDegree(src),
+        "Degree of node {} changed", src);
+    for (auto e : topo.OutEdges(src)) {
+      auto new_dst = reordered->OriginalToTransformedNodeID(topo.OutEdgeDst(e));
+      bool found = false;
+      for (auto new_e : new_topo.OutEdges(new_src)) {
+        found |= new_topo.OutEdgeDst(new_e) == new_dst;
+      }
+      KATANA_LOG_VASSERT(found, "Edge {} lost by reordering", e);
+    }
+  }
+}
+
+void
+TestAll(std::unique_ptr<katana::PropertyGraph>&& pg) {
+  for (auto kind : kReorderings) {
+    TestPermutation(pg->topology(), kind);
+    TestReorderedGraph(pg.get(), kind);
+  }
+}
+
+/// RCM numbers a grid by anti-diagonals, so its bandwidth stays within two
+/// diagonals.
+void
+TestBandwidth() {
+  constexpr uint32_t kWidth = 20;
+  auto pg = katana::MakeGrid(kWidth, 50, false);
+
+  using View = katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::NodesReorderedByRCM, std::tuple<>,
+      std::tuple<>>;
+  auto view_res = View::Make(pg.get(), {}, {});
+  KATANA_LOG_VASSERT(
+      view_res, "Failed to create RCM view: {}", view_res.error());
+  auto graph = view_res.value();
+
+  uint64_t bandwidth = 0;
+  for (auto src : graph.Nodes()) {
+    for (auto e : graph.OutEdges(src)) {
+      auto dst = graph.OutEdgeDst(e);
+      bandwidth = std::max<uint64_t>(
+          bandwidth, src > dst ? src - dst : dst - src);
+      KATANA_LOG_VASSERT(
+          graph.HasEdge(src, dst), "Edges are not sorted by destination");
+    }
+  }
+  KATANA_LOG_VASSERT(
+      bandwidth <= 2 * kWidth, "RCM bandwidth too large. Found: {}",
+      bandwidth);
+}
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestAll(katana::MakeGrid(7, 9, false));
+  TestAll(katana::MakeGrid(10, 10, true));
+  TestAll(katana::MakeFerrisWheel(100));
+  TestAll(katana::MakeSawtooth(50));
+  TestAll(katana::MakeClique(20));
+  TestAll(katana::MakeTriangle(1));
+
+  TestBandwidth();
+
+  return 0;
+}
@@ -1,6 +1,21 @@
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
 #include "katana/Logging.h"
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+namespace fs = boost::filesystem;
+
+using katana::EntityTypeID;
+using Node = katana::GraphTopology::Node;
 
 void
 TestEdgeSource(const katana::GraphTopology& topo) noexcept {
@@ -12,6 +27,285 @@ TestEdgeSource(const katana::GraphTopology& topo) noexcept {
   }
 }
 
+/// Node 0 is a hub with hub_degree edges, the other nodes have a few each
+katana::GraphTopology
+MakeHubTopology(size_t num_nodes, size_t hub_degree) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<katana::GraphTopology::Node> node_dist(
+      0, num_nodes - 1);
+
+  katana::GraphTopology::AdjIndexVec adj_indices;
+  adj_indices.allocateInterleaved(num_nodes);
+  std::vector<katana::GraphTopology::Node> dests;
+  for (size_t n = 0; n < num_nodes; ++n) {
+    size_t degree = n == 0 ? hub_degree : n % 7;
+    for (size_t i = 0; i < degree; ++i) {
+      dests.emplace_back(node_dist(gen));
+    }
+    adj_indices[n] = dests.size();
+  }
+
+  katana::GraphTopology::EdgeDestVec dest_vec;
+  dest_vec.allocateInterleaved(dests.size());
+  std::copy(dests.begin(), dests.end(), dest_vec.begin());
+  return katana::GraphTopology{std::move(adj_indices), std::move(dest_vec)};
+}
+
+/// Check that view is topo with its nodes relabeled and its edges sorted by
+/// destination
+template <typename View>
+void
+CheckSortedView(const katana::GraphTopology& topo, const View& view) {
+  KATANA_LOG_ASSERT(view.NumEdges() == topo.NumEdges());
+
+  std::vector<bool> seen(topo.NumEdges());
+  for (auto n : view.Nodes()) {
+    auto old_src = view.GetNodePropertyIndex(n);
+    katana::GraphTopology::Node prev_dst = 0;
+    for (auto e : view.OutEdges(n)) {
+      auto old_e = view.GetEdgePropertyIndexFromOutEdge(e);
+      KATANA_LOG_ASSERT(!seen[old_e]);
+      seen[old_e] = true;
+
+      KATANA_LOG_ASSERT(topo.GetEdgeSrc(old_e) == old_src);
+      auto dst = view.OutEdgeDst(e);
+      KATANA_LOG_ASSERT(
+          topo.OutEdgeDst(old_e) == view.GetNodePropertyIndex(dst));
+      KATANA_LOG_ASSERT(dst >= prev_dst);
+      prev_dst = dst;
+    }
+  }
+}
+
+void
+TestSortedViews(katana::GraphTopology&& topo) {
+  katana::GraphTopology copy = katana::GraphTopology::Copy(topo);
+  auto pg_res = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(pg_res);
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  CheckSortedView(
+      copy, pg->BuildView<katana::PropertyGraphViews::EdgesSortedByDestID>());
+
+  using SortedByDegree =
+      katana::PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID;
+  auto view = pg->BuildView<SortedByDegree>();
+  CheckSortedView(copy, view);
+  for (auto n : view.Nodes()) {
+    KATANA_LOG_ASSERT(n == 0 || view.OutDegree(n - 1) >= view.OutDegree(n));
+  }
+}
+
+void
+TestViewCache(katana::GraphTopology&& topo) {
+  using Transposed = katana::PropertyGraphViews::Transposed;
+  using SortedByDestID = katana::PropertyGraphViews::EdgesSortedByDestID;
+
+  auto pg_res = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(pg_res);
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  auto uri_res = katana::URI::MakeRand("/tmp/viewcache");
+  KATANA_LOG_ASSERT(uri_res);
+  katana::URI spill_dir = std::move(uri_res.value());
+  fs::create_directories(spill_dir.path());
+  pg->SetViewSpillDir(spill_dir);
+
+  std::vector<katana::GraphTopology::Node> expected;
+  {
+    auto view = pg->BuildView<Transposed>();
+    for (auto e : view.OutEdges()) {
+      expected.emplace_back(view.OutEdgeDst(e));
+    }
+
+    // Views in use are never evicted
+    pg->SetViewMemoryBudget(1);
+    KATANA_LOG_ASSERT(pg->view_cache_stats().evictions == 0);
+    KATANA_LOG_ASSERT(pg->view_cache_stats().bytes > 1);
+  }
+
+  // Caching another view evicts the unused one, spilling it
+  pg->BuildView<SortedByDestID>();
+  const katana::PGViewCacheStats& stats = pg->view_cache_stats();
+  KATANA_LOG_ASSERT(stats.evictions == 1);
+  KATANA_LOG_ASSERT(stats.spills == 1);
+
+  uint64_t builds = stats.builds;
+  {
+    auto view = pg->BuildView<Transposed>();
+    KATANA_LOG_ASSERT(stats.reloads == 1);
+    KATANA_LOG_ASSERT(stats.builds == builds);
+
+    size_t i = 0;
+    for (auto e : view.OutEdges()) {
+      KATANA_LOG_ASSERT(view.OutEdgeDst(e) == expected[i++]);
+    }
+  }
+
+  // Without a budget, views stay
+  pg->SetViewMemoryBudget(0);
+  pg->BuildView<Transposed>();
+  KATANA_LOG_ASSERT(stats.hits > 0);
+
+  pg.reset();
+  fs::remove_all(spill_dir.path());
+}
+
+/// Check the type runs of topo against the counts of (src, dst, type) edges
+void
+CheckTypeRuns(
+    const katana::PropertyGraph& pg, const katana::EdgeTypeAwareTopology& topo,
+    const std::map<std::tuple<Node, Node, EntityTypeID>, size_t>& counts,
+    const std::vector<EntityTypeID>& types) {
+  auto count_of = [&](Node src, Node dst, EntityTypeID type) {
+    auto it = counts.find({src, dst, type});
+    return it == counts.end() ? size_t{0} : it->second;
+  };
+
+  for (auto n : topo.Nodes()) {
+    for (auto type : types) {
+      size_t degree = 0;
+      for (auto e : topo.OutEdges(n, type)) {
+        KATANA_LOG_ASSERT(
+            pg.GetTypeOfEdgeFromPropertyIndex(
+                topo.GetEdgePropertyIndexFromOutEdge(e)) == type);
+        ++degree;
+      }
+
+      size_t expected_degree = 0;
+      for (auto dst : topo.Nodes()) {
+        size_t count = count_of(n, dst, type);
+        expected_degree += count;
+        KATANA_LOG_ASSERT(topo.HasEdge(n, dst, type) == (count > 0));
+        KATANA_LOG_ASSERT(topo.FindAllEdges(n, dst, type).size() == count);
+      }
+      KATANA_LOG_VASSERT(
+          degree == expected_degree, "node {} type {}: {} != {}", n, type,
+          degree, expected_degree);
+    }
+
+    for (auto dst : topo.Nodes()) {
+      bool connected = false;
+      for (auto type : types) {
+        connected = connected || count_of(n, dst, type) > 0;
+      }
+      KATANA_LOG_ASSERT(topo.HasEdge(n, dst) == connected);
+
+      auto found = topo.FindAllEdges(n, dst);
+      KATANA_LOG_ASSERT(found.empty() != connected);
+      for (auto e : found) {
+        KATANA_LOG_ASSERT(topo.OutEdgeDst(e) == dst);
+      }
+    }
+  }
+}
+
+/// Node 0 has more edge types than are searched linearly, and lacks a type
+/// that other nodes have. Its edges to the same destination span many runs.
+void
+TestEdgeTypeAwareTopology(size_t num_nodes) {
+  constexpr size_t kNumTypes = 40;
+  constexpr size_t kHubMissingType = 20;
+
+  katana::EntityTypeManager node_type_manager;
+  katana::EntityTypeManager edge_type_manager;
+  std::vector<EntityTypeID> types;
+  for (size_t i = 0; i < kNumTypes; ++i) {
+    auto res = edge_type_manager.AddAtomicEntityType(fmt::format("t{}", i));
+    KATANA_LOG_ASSERT(res);
+    types.emplace_back(res.value());
+  }
+
+  // Edges of each node are added in decreasing order of type, so that
+  // building the topology has to sort them
+  std::vector<std::tuple<Node, Node, EntityTypeID>> edges;
+  for (size_t t = kNumTypes; t-- > 0;) {
+    if (t != kHubMissingType) {
+      edges.emplace_back(0, t % 7, types[t]);
+      edges.emplace_back(0, (t * 3) % 7, types[t]);
+    }
+  }
+  for (Node n = 1; n < num_nodes; ++n) {
+    edges.emplace_back(n, n % 7, types[kHubMissingType]);
+    edges.emplace_back(n, (n + 1) % num_nodes, types[n % 3]);
+  }
+
+  katana::GraphTopology::AdjIndexVec adj_indices;
+  adj_indices.allocateInterleaved(num_nodes);
+  katana::GraphTopology::EdgeDestVec dests;
+  dests.allocateInterleaved(edges.size());
+  katana::PropertyGraph::EntityTypeIDArray edge_types;
+  edge_types.allocateInterleaved(edges.size());
+  katana::PropertyGraph::EntityTypeIDArray node_types;
+  node_types.allocateInterleaved(num_nodes);
+  std::fill(node_types.begin(), node_types.end(), katana::kUnknownEntityType);
+
+  std::map<std::tuple<Node, Node, EntityTypeID>, size_t> counts;
+  std::fill(adj_indices.begin(), adj_indices.end(), 0);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    auto [src, dst, type] = edges[e];
+    adj_indices[src] += 1;
+    dests[e] = dst;
+    edge_types[e] = type;
+    counts[edges[e]] += 1;
+  }
+  std::partial_sum(
+      adj_indices.begin(), adj_indices.end(), adj_indices.begin());
+
+  auto pg_res = katana::PropertyGraph::Make(
+      katana::GraphTopology{std::move(adj_indices), std::move(dests)},
+      std::move(node_types), std::move(edge_types),
+      std::move(node_type_manager), std::move(edge_type_manager));
+  KATANA_LOG_ASSERT(pg_res);
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  auto edge_type_index =
+      katana::CondensedTypeIDMap::MakeFromEdgeTypes(pg.get());
+  auto make_sorted = [&]() {
+    return katana::EdgeShuffleTopology::Make(
+        pg.get(), katana::RDGTopology::TransposeKind::kNo,
+        katana::RDGTopology::EdgeSortKind::kSortedByEdgeType);
+  };
+  auto topo = katana::EdgeTypeAwareTopology::MakeFrom(
+      pg.get(), edge_type_index, std::move(*make_sorted()));
+
+  KATANA_LOG_ASSERT(topo->GetOutEdgeTypes(0).size() == kNumTypes - 1);
+  KATANA_LOG_ASSERT(topo->OutEdges(0, types[kHubMissingType]).empty());
+  KATANA_LOG_ASSERT(topo->OutDegree(1, types[kHubMissingType]) == 1);
+
+  // A type that no edge has
+  auto unused_type = static_cast<EntityTypeID>(types.back() + 1);
+  KATANA_LOG_ASSERT(!topo->DoesEdgeTypeExist(unused_type));
+  std::vector<EntityTypeID> checked_types = types;
+  checked_types.emplace_back(unused_type);
+
+  CheckTypeRuns(*pg, *topo, counts, checked_types);
+
+  // Store and reload the runs
+  katana::GraphTopology::AdjIndexVec per_type_adj_indices;
+  auto rdg_res = topo->ToRDGTopology(&per_type_adj_indices);
+  KATANA_LOG_ASSERT(rdg_res);
+  katana::RDGTopology rdg_topo = std::move(rdg_res.value());
+  auto reloaded = katana::EdgeTypeAwareTopology::Make(
+      &rdg_topo, edge_type_index, std::move(*make_sorted()));
+
+  KATANA_LOG_ASSERT(reloaded->NumTypeRuns() == topo->NumTypeRuns());
+  for (auto n : topo->Nodes()) {
+    auto expected = topo->GetOutEdgeTypes(n);
+    auto actual = reloaded->GetOutEdgeTypes(n);
+    KATANA_LOG_ASSERT(std::equal(
+        expected.begin(), expected.end(), actual.begin(), actual.end()));
+    for (auto type : checked_types) {
+      auto expected_edges = topo->OutEdges(n, type);
+      auto actual_edges = reloaded->OutEdges(n, type);
+      KATANA_LOG_ASSERT(
+          *expected_edges.begin() == *actual_edges.begin() &&
+          *expected_edges.end() == *actual_edges.end());
+    }
+  }
+  CheckTypeRuns(*pg, *reloaded, counts, checked_types);
+}
+
 int
 main() {
   katana::SharedMemSys S;
@@ -24,5 +318,12 @@ main() {
 
   TestEdgeSource(topo);
 
+  TestViewCache(katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode));
+
+  // The hub has more edges than are sorted by a single thread
+  TestSortedViews(MakeHubTopology(kNumNodes, 100000));
+
+  TestEdgeTypeAwareTopology(50);
+
   return 0;
 }
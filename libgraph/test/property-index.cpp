@@ -1,17 +1,34 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include <arrow/api.h>
 #include <arrow/type.h>
 #include <arrow/type_traits.h>
+#include <boost/filesystem.hpp>
 
 #include "TestTypedPropertyGraph.h"
 #include "katana/EntityIndex.h"
+#include "katana/EntityIndexPrimitive.h"
 #include "katana/Logging.h"
 #include "katana/Properties.h"
 #include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+namespace fs = boost::filesystem;
 
 template <typename node_or_edge>
 struct NodeOrEdge {
   static katana::Result<katana::EntityIndex<node_or_edge>*> MakeIndex(
-      katana::PropertyGraph* pg, const std::string& property_name);
+      katana::PropertyGraph* pg, const std::string& property_name,
+      katana::EntityIndexKind kind = katana::EntityIndexKind::kOrdered);
+  static katana::Result<katana::EntityIndex<node_or_edge>*> MakeCompositeIndex(
+      katana::PropertyGraph* pg, const std::vector<std::string>& property_names,
+      katana::EntityIndexKind kind);
   static katana::Result<void> AddProperties(
       katana::PropertyGraph* pg, std::shared_ptr<arrow::Table> properties,
       katana::TxnContext* txn_ctx);
@@ -23,8 +40,10 @@ using Edge = NodeOrEdge<katana::GraphTopology::Edge>;
 
 template <>
 katana::Result<katana::EntityIndex<katana::GraphTopology::Node>*>
-Node::MakeIndex(katana::PropertyGraph* pg, const std::string& property_name) {
-  auto result = pg->MakeNodeIndex(property_name);
+Node::MakeIndex(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::EntityIndexKind kind) {
+  auto result = pg->MakeNodeIndex(property_name, kind);
   if (!result) {
     return result.error();
   }
@@ -40,8 +59,10 @@ Node::MakeIndex(katana::PropertyGraph* pg, const std::string& property_name) {
 
 template <>
 katana::Result<katana::EntityIndex<katana::GraphTopology::Edge>*>
-Edge::MakeIndex(katana::PropertyGraph* pg, const std::string& property_name) {
-  auto result = pg->MakeEdgeIndex(property_name);
+Edge::MakeIndex(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::EntityIndexKind kind) {
+  auto result = pg->MakeEdgeIndex(property_name, kind);
   if (!result) {
     return result.error();
   }
@@ -55,12 +76,36 @@ Edge::MakeIndex(katana::PropertyGraph* pg, const std::string& property_name) {
   return KATANA_ERROR(katana::ErrorCode::NotFound, "Created index not found");
 }
 
+template <>
+katana::Result<katana::EntityIndex<katana::GraphTopology::Node>*>
+Node::MakeCompositeIndex(
+    katana::PropertyGraph* pg, const std::vector<std::string>& property_names,
+    katana::EntityIndexKind kind) {
+  auto result = pg->MakeCompositeNodeIndex(property_names, kind);
+  if (!result) {
+    return result.error();
+  }
+  return pg->GetNodeIndex(katana::CompositeIndexName(property_names))->get();
+}
+
 template <>
 size_t
 Node::num_entities(katana::PropertyGraph* pg) {
   return pg->NumNodes();
 }
 
+template <>
+katana::Result<katana::EntityIndex<katana::GraphTopology::Edge>*>
+Edge::MakeCompositeIndex(
+    katana::PropertyGraph* pg, const std::vector<std::string>& property_names,
+    katana::EntityIndexKind kind) {
+  auto result = pg->MakeCompositeEdgeIndex(property_names, kind);
+  if (!result) {
+    return result.error();
+  }
+  return pg->GetEdgeIndex(katana::CompositeIndexName(property_names))->get();
+}
+
 template <>
 size_t
 Edge::num_entities(katana::PropertyGraph* pg) {
@@ -203,6 +248,17 @@ TestPrimitiveIndex(size_t num_nodes, size_t line_width) {
   it = nonuniform_index->UpperBound(44);
   KATANA_LOG_ASSERT(it != nonuniform_index->end());
   KATANA_LOG_ASSERT(typed_prop->Value(*it) == 46);
+
+  auto [first, last] = uniform_index->EqualRange(42);
+  KATANA_LOG_ASSERT(first == uniform_index->begin());
+  KATANA_LOG_ASSERT(last == uniform_index->end());
+
+  std::vector<DataType> keys{43, 44, 0};
+  auto bounds = nonuniform_index->LowerBounds(keys);
+  KATANA_LOG_ASSERT(bounds.size() == keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    KATANA_LOG_ASSERT(bounds[i] == nonuniform_index->LowerBound(keys[i]));
+  }
 }
 
 template <typename node_or_edge>
@@ -271,6 +327,308 @@ TestStringIndex(size_t num_nodes, size_t line_width) {
   it = nonuniform_index->UpperBound("aaak");
   KATANA_LOG_ASSERT(it != nonuniform_index->end());
   KATANA_LOG_ASSERT(typed_prop->GetView(*it) == "aaam");
+
+  auto [first, last] = nonuniform_index->EqualRange("aaak");
+  KATANA_LOG_ASSERT(last - first == 1);
+  KATANA_LOG_ASSERT(typed_prop->GetView(*first) == "aaak");
+}
+
+template <typename node_or_edge, typename DataType>
+void
+TestHashIndex(size_t num_nodes, size_t line_width) {
+  using IndexType = katana::HashEntityIndex<node_or_edge, DataType>;
+  using ArrayType = typename arrow::CTypeTraits<DataType>::ArrayType;
+
+  LinePolicy policy{line_width};
+
+  katana::TxnContext txn_ctx;
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 0, &policy, &txn_ctx);
+  size_t num_entities = NodeOrEdge<node_or_edge>::num_entities(g.get());
+
+  std::shared_ptr<arrow::Table> uniform_prop =
+      CreatePrimitiveProperty<DataType>("uniform", true, num_entities);
+  std::shared_ptr<arrow::Table> nonuniform_prop =
+      CreatePrimitiveProperty<DataType>("nonuniform", false, num_entities);
+  KATANA_LOG_ASSERT(
+      NodeOrEdge<node_or_edge>::AddProperties(g.get(), uniform_prop, &txn_ctx));
+  KATANA_LOG_ASSERT(NodeOrEdge<node_or_edge>::AddProperties(
+      g.get(), nonuniform_prop, &txn_ctx));
+
+  auto uniform_index_result = NodeOrEdge<node_or_edge>::MakeIndex(
+      g.get(), "uniform", katana::EntityIndexKind::kHash);
+  KATANA_LOG_VASSERT(
+      uniform_index_result, "Could not create index: {}",
+      uniform_index_result.error());
+  auto nonuniform_index_result = NodeOrEdge<node_or_edge>::MakeIndex(
+      g.get(), "nonuniform", katana::EntityIndexKind::kHash);
+  KATANA_LOG_VASSERT(
+      nonuniform_index_result, "Could not create index: {}",
+      nonuniform_index_result.error());
+
+  auto* uniform_index = static_cast<IndexType*>(uniform_index_result.value());
+  auto* nonuniform_index =
+      static_cast<IndexType*>(nonuniform_index_result.value());
+
+  // Every entity has the value 42
+  KATANA_LOG_ASSERT(uniform_index->Find(0) == uniform_index->end());
+  auto [first, last] = uniform_index->EqualRange(42);
+  KATANA_LOG_ASSERT(first == uniform_index->begin());
+  KATANA_LOG_ASSERT(last == uniform_index->end());
+  KATANA_LOG_ASSERT(uniform_index->size() == num_entities);
+
+  // Every entity has its own value
+  auto typed_prop =
+      std::static_pointer_cast<ArrayType>(nonuniform_prop->column(0)->chunk(0));
+  std::vector<DataType> keys;
+  for (size_t i = 0; i < num_entities; ++i) {
+    keys.emplace_back(i * 2 + 42);
+  }
+  keys.emplace_back(43);
+  auto found = nonuniform_index->Finds(keys);
+  for (size_t i = 0; i < num_entities; ++i) {
+    KATANA_LOG_ASSERT(found[i] != nonuniform_index->end());
+    KATANA_LOG_ASSERT(typed_prop->Value(*found[i]) == keys[i]);
+    auto range = nonuniform_index->EqualRange(keys[i]);
+    KATANA_LOG_ASSERT(range.second - range.first == 1);
+  }
+  KATANA_LOG_ASSERT(found.back() == nonuniform_index->end());
+}
+
+template <typename node_or_edge>
+void
+TestCompositeIndex(
+    size_t num_nodes, size_t line_width, katana::EntityIndexKind kind) {
+  using IndexType = katana::CompositeEntityIndex<node_or_edge>;
+
+  LinePolicy policy{line_width};
+
+  katana::TxnContext txn_ctx;
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int>(num_nodes, 0, &policy, &txn_ctx);
+  size_t num_entities = NodeOrEdge<node_or_edge>::num_entities(g.get());
+
+  KATANA_LOG_ASSERT(NodeOrEdge<node_or_edge>::AddProperties(
+      g.get(), CreateStringProperty("name", true, num_entities), &txn_ctx));
+  KATANA_LOG_ASSERT(NodeOrEdge<node_or_edge>::AddProperties(
+      g.get(), CreatePrimitiveProperty<int64_t>("rank", false, num_entities),
+      &txn_ctx));
+
+  auto index_result = NodeOrEdge<node_or_edge>::MakeCompositeIndex(
+      g.get(), {"name", "rank"}, kind);
+  KATANA_LOG_VASSERT(
+      index_result, "Could not create index: {}", index_result.error());
+  auto* index = static_cast<IndexType*>(index_result.value());
+  KATANA_LOG_ASSERT(index->size() == num_entities);
+
+  // Every entity has the name "aaaa" and its own rank
+  for (size_t i = 0; i < num_entities; ++i) {
+    auto key = index->EncodeKey(
+        {std::string_view("aaaa"), static_cast<int64_t>(i * 2 + 42)});
+    KATANA_LOG_VASSERT(key, "Could not encode key: {}", key.error());
+    auto [first, last] = index->EqualRange(key.value());
+    KATANA_LOG_ASSERT(last - first == 1);
+  }
+
+  auto missing = index->EncodeKey({std::string_view("aaaa"), uint64_t{43}});
+  KATANA_LOG_ASSERT(missing);
+  KATANA_LOG_ASSERT(index->Find(missing.value()) == index->end());
+
+  KATANA_LOG_ASSERT(!index->EncodeKey({int64_t{1}, int64_t{1}}));
+  KATANA_LOG_ASSERT(!index->EncodeKey({std::string_view("aaaa")}));
+
+  if (kind == katana::EntityIndexKind::kOrdered) {
+    // Keys sort like (name, rank)
+    auto it = index->LowerBound(missing.value());
+    KATANA_LOG_ASSERT(it == index->begin() + 1);
+  }
+}
+
+/// Composite indexes must not share names with each other or with plain
+/// indexes, whatever the property names contain.
+template <typename node_or_edge>
+void
+TestCompositeIndexNames(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int>(num_nodes, 0, &policy, &txn_ctx);
+  size_t num_entities = NodeOrEdge<node_or_edge>::num_entities(g.get());
+
+  for (const std::string name : {"a", "b", "a,b"}) {
+    KATANA_LOG_ASSERT(NodeOrEdge<node_or_edge>::AddProperties(
+        g.get(), CreatePrimitiveProperty<int64_t>(name, false, num_entities),
+        &txn_ctx));
+  }
+
+  std::vector<std::vector<std::string>> composites{{"a"}, {"a", "b"}, {"a,b"}};
+  for (const auto& names : composites) {
+    KATANA_LOG_ASSERT(katana::CompositeIndexName(names) != names[0]);
+  }
+  KATANA_LOG_ASSERT(
+      katana::CompositeIndexName({"a", "b"}) !=
+      katana::CompositeIndexName({"a,b"}));
+
+  auto plain = NodeOrEdge<node_or_edge>::MakeIndex(g.get(), "a");
+  KATANA_LOG_VASSERT(plain, "Could not create index: {}", plain.error());
+  std::vector<katana::EntityIndex<node_or_edge>*> indexes{plain.value()};
+  for (const auto& names : composites) {
+    auto index = NodeOrEdge<node_or_edge>::MakeCompositeIndex(
+        g.get(), names, katana::EntityIndexKind::kOrdered);
+    KATANA_LOG_VASSERT(index, "Could not create index: {}", index.error());
+    indexes.emplace_back(index.value());
+  }
+
+  // Every index was found under its own name
+  std::sort(indexes.begin(), indexes.end());
+  KATANA_LOG_ASSERT(
+      std::unique(indexes.begin(), indexes.end()) == indexes.end());
+}
+
+/// The files of stored entity index ids in rdg_dir
+std::vector<std::string>
+StoredIDsFiles(const katana::URI& rdg_dir) {
+  std::vector<std::string> files;
+  for (const auto& entry : fs::directory_iterator(rdg_dir.path())) {
+    std::string name = entry.path().filename().string();
+    const std::string& prefix =
+        katana::kOptionalDatastructureEntityIndexPrimitiveIDsFilename;
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      files.emplace_back(name);
+    }
+  }
+  return files;
+}
+
+std::vector<katana::GraphTopology::Node>
+ReadIDs(const fs::path& path) {
+  std::ifstream in(path.string(), std::ios::binary);
+  std::vector<char> bytes(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::vector<katana::GraphTopology::Node> ids(
+      bytes.size() / sizeof(katana::GraphTopology::Node));
+  std::memcpy(ids.data(), bytes.data(), ids.size() * sizeof(ids[0]));
+  return ids;
+}
+
+void
+WriteIDs(
+    const fs::path& path, const std::vector<katana::GraphTopology::Node>& ids) {
+  std::ofstream out(path.string(), std::ios::binary | std::ios::trunc);
+  out.write(
+      reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(ids[0]));
+}
+
+std::unique_ptr<katana::PropertyGraph>
+Reload(const katana::URI& rdg_dir, katana::TxnContext* txn_ctx) {
+  auto res =
+      katana::PropertyGraph::Make(rdg_dir, txn_ctx, katana::RDGLoadOptions());
+  KATANA_LOG_VASSERT(res, "loading graph: {}", res.error());
+  return std::move(res.value());
+}
+
+/// Index a reloaded graph and check that the index has the expected order.
+/// Returns the ids of the index.
+std::vector<katana::GraphTopology::Node>
+CheckStoredIndex(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::GraphTopology::Node>& expected) {
+  auto index_result = Node::MakeIndex(pg, "value");
+  KATANA_LOG_VASSERT(
+      index_result, "Could not create index: {}", index_result.error());
+  auto* index = index_result.value();
+  std::vector<katana::GraphTopology::Node> ids(index->begin(), index->end());
+  KATANA_LOG_ASSERT(ids == expected);
+  return ids;
+}
+
+/// Store an index with its graph, reload it and query it, and check that an
+/// index whose stored ids are stale or damaged is built again.
+void
+TestStoredIndex(size_t num_nodes, size_t line_width) {
+  using IndexType =
+      katana::PrimitiveEntityIndex<katana::GraphTopology::Node, int64_t>;
+  using Ids = std::vector<katana::GraphTopology::Node>;
+
+  LinePolicy policy{line_width};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy, &txn_ctx);
+
+  // Values out of id order, with ties
+  arrow::Int64Builder builder;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    KATANA_LOG_ASSERT(builder.Append((i * 7) % 11).ok());
+  }
+  std::shared_ptr<arrow::Array> values;
+  KATANA_LOG_ASSERT(builder.Finish(&values).ok());
+  KATANA_LOG_ASSERT(g->AddNodeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("value", arrow::int64())}), {values}),
+      &txn_ctx));
+
+  Ids expected(num_nodes);
+  std::iota(expected.begin(), expected.end(), 0);
+  std::sort(expected.begin(), expected.end(), [](auto a, auto b) {
+    return std::make_pair((a * 7) % 11, a) < std::make_pair((b * 7) % 11, b);
+  });
+
+  auto uri_res = katana::URI::MakeRand("/tmp/propertyindex");
+  KATANA_LOG_ASSERT(uri_res);
+  katana::URI rdg_dir = std::move(uri_res.value());
+  auto write_res = g->Write(rdg_dir, "property-index", &txn_ctx);
+  KATANA_LOG_VASSERT(write_res, "writing graph: {}", write_res.error());
+
+  // Indexes are stored next to an RDG, so index the loaded graph and commit
+  auto pg = Reload(rdg_dir, &txn_ctx);
+  CheckStoredIndex(pg.get(), expected);
+  KATANA_LOG_ASSERT(pg->Commit("property-index", &txn_ctx));
+  std::vector<std::string> files = StoredIDsFiles(rdg_dir);
+  KATANA_LOG_ASSERT(files.size() == 1);
+  fs::path ids_path = fs::path(rdg_dir.path()) / files[0];
+  KATANA_LOG_ASSERT(ReadIDs(ids_path) == expected);
+
+  // The stored ids are taken as they are
+  pg = Reload(rdg_dir, &txn_ctx);
+  CheckStoredIndex(pg.get(), expected);
+  auto* index = static_cast<IndexType*>(pg->GetNodeIndex("value")->get());
+  katana::NUMAArray<katana::GraphTopology::Node> stored_ids;
+  stored_ids.allocateBlocked(num_nodes);
+  Ids read = ReadIDs(ids_path);
+  std::copy(read.begin(), read.end(), stored_ids.begin());
+  KATANA_LOG_ASSERT(index->BuildFromSortedIDs(std::move(stored_ids)));
+  KATANA_LOG_ASSERT(index->Find(0) != index->end());
+
+  // Storing an unchanged index again keeps its file
+  KATANA_LOG_ASSERT(pg->Commit("property-index", &txn_ctx));
+  KATANA_LOG_ASSERT(StoredIDsFiles(rdg_dir) == files);
+
+  // Stale ids, in the wrong order, are rejected and the index is rebuilt
+  Ids stale = expected;
+  std::reverse(stale.begin(), stale.end());
+  WriteIDs(ids_path, stale);
+  pg = Reload(rdg_dir, &txn_ctx);
+  CheckStoredIndex(pg.get(), expected);
+
+  // Storing the rebuilt index replaces the stale file
+  KATANA_LOG_ASSERT(pg->Commit("property-index", &txn_ctx));
+  std::vector<std::string> replaced = StoredIDsFiles(rdg_dir);
+  KATANA_LOG_ASSERT(replaced.size() == 1 && replaced != files);
+  ids_path = fs::path(rdg_dir.path()) / replaced[0];
+  KATANA_LOG_ASSERT(ReadIDs(ids_path) == expected);
+
+  // So is a truncated file, or a missing one
+  WriteIDs(ids_path, Ids(expected.begin(), expected.begin() + num_nodes / 2));
+  pg = Reload(rdg_dir, &txn_ctx);
+  CheckStoredIndex(pg.get(), expected);
+  fs::remove(ids_path);
+  pg = Reload(rdg_dir, &txn_ctx);
+  CheckStoredIndex(pg.get(), expected);
+
+  pg.reset();
+  fs::remove_all(rdg_dir.path());
 }
 
 int
@@ -289,5 +647,23 @@ main() {
   TestStringIndex<katana::GraphTopology::Node>(10, 3);
   TestStringIndex<katana::GraphTopology::Edge>(10, 3);
 
+  TestHashIndex<katana::GraphTopology::Node, int64_t>(10, 3);
+  TestHashIndex<katana::GraphTopology::Edge, int64_t>(10, 3);
+  TestHashIndex<katana::GraphTopology::Node, uint64_t>(200, 5);
+
+  TestCompositeIndex<katana::GraphTopology::Node>(
+      10, 3, katana::EntityIndexKind::kOrdered);
+  TestCompositeIndex<katana::GraphTopology::Edge>(
+      10, 3, katana::EntityIndexKind::kOrdered);
+  TestCompositeIndex<katana::GraphTopology::Node>(
+      10, 3, katana::EntityIndexKind::kHash);
+  TestCompositeIndex<katana::GraphTopology::Edge>(
+      10, 3, katana::EntityIndexKind::kHash);
+
+  TestCompositeIndexNames<katana::GraphTopology::Node>(10, 3);
+  TestCompositeIndexNames<katana::GraphTopology::Edge>(10, 3);
+
+  TestStoredIndex(100, 3);
+
   return 0;
 }
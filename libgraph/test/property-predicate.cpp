@@ -0,0 +1,238 @@
+#include <arrow/api.h>
+#include <arrow/type.h>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyPredicate.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using P = katana::PropertyPredicate;
+
+constexpr size_t kNumNodes = 1000;
+
+double
+Weight(size_t i) {
+  return static_cast<double>((i * 37) % 100) / 100;
+}
+
+bool
+HasCount(size_t i) {
+  return i % 7 != 0;
+}
+
+int32_t
+Count(size_t i) {
+  return static_cast<int32_t>(i % 50) - 25;
+}
+
+/// Split values into chunks of uneven sizes, so that words of the masks
+/// straddle chunks
+template <typename BuilderType, typename AppendFn>
+std::shared_ptr<arrow::ChunkedArray>
+MakeChunked(size_t num_rows, const AppendFn& append) {
+  std::vector<size_t> chunk_ends{100, 100, 337, num_rows};
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  size_t begin = 0;
+  for (size_t end : chunk_ends) {
+    BuilderType builder;
+    for (size_t i = begin; i < end; ++i) {
+      append(&builder, i);
+    }
+    chunks.emplace_back();
+    KATANA_LOG_ASSERT(builder.Finish(&chunks.back()).ok());
+    begin = end;
+  }
+  return std::make_shared<arrow::ChunkedArray>(chunks);
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(katana::TxnContext* txn_ctx) {
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, &policy, txn_ctx);
+
+  auto weight = MakeChunked<arrow::DoubleBuilder>(
+      kNumNodes, [](arrow::DoubleBuilder* builder, size_t i) {
+        KATANA_LOG_ASSERT(builder->Append(Weight(i)).ok());
+      });
+  auto count = MakeChunked<arrow::Int32Builder>(
+      kNumNodes, [](arrow::Int32Builder* builder, size_t i) {
+        if (HasCount(i)) {
+          KATANA_LOG_ASSERT(builder->Append(Count(i)).ok());
+        } else {
+          KATANA_LOG_ASSERT(builder->AppendNull().ok());
+        }
+      });
+  auto name = MakeChunked<arrow::StringBuilder>(
+      kNumNodes, [](arrow::StringBuilder* builder, size_t) {
+        KATANA_LOG_ASSERT(builder->Append("node").ok());
+      });
+  auto node_table = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field("weight", arrow::float64()),
+           arrow::field("count", arrow::int32()),
+           arrow::field("name", arrow::utf8())}),
+      {weight, count, name});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(node_table, txn_ctx));
+
+  auto level = MakeChunked<arrow::UInt8Builder>(
+      g->NumEdges(), [](arrow::UInt8Builder* builder, size_t i) {
+        KATANA_LOG_ASSERT(builder->Append(i % 256).ok());
+      });
+  auto edge_table = arrow::Table::Make(
+      arrow::schema({arrow::field("level", arrow::uint8())}), {level});
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(edge_table, txn_ctx));
+
+  return g;
+}
+
+template <typename Fn>
+void
+CheckMask(
+    const katana::DynamicBitset& mask, size_t size, const Fn& expected,
+    const std::string& what) {
+  KATANA_LOG_VASSERT(
+      mask.size() == size, "{}: {} bits, expected {}", what, mask.size(),
+      size);
+  for (size_t i = 0; i < size; ++i) {
+    KATANA_LOG_VASSERT(
+        mask.test(i) == expected(i), "{}: bit {} is {}", what, i,
+        mask.test(i));
+  }
+}
+
+void
+TestCompare(const katana::PropertyGraph& pg) {
+  auto mask = P::Compare("weight", P::CompareOp::kGreater, 0.5)
+                  .EvaluateNodes(pg)
+                  .value();
+  CheckMask(
+      mask, kNumNodes, [](size_t i) { return Weight(i) > 0.5; }, "weight");
+
+  // Integer values compare exactly, and nulls never pass
+  mask = P::Compare("count", P::CompareOp::kLessEqual, int64_t{-3})
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(
+      mask, kNumNodes,
+      [](size_t i) { return HasCount(i) && Count(i) <= -3; }, "count");
+
+  mask = P::Compare("count", P::CompareOp::kNotEqual, 2.0)
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(
+      mask, kNumNodes, [](size_t i) { return HasCount(i) && Count(i) != 2; },
+      "count as double");
+
+  // Values outside of the range of the property type
+  mask = P::Compare("count", P::CompareOp::kLess, int64_t{1} << 40)
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(mask, kNumNodes, HasCount, "count above range");
+
+  mask = P::Compare("count", P::CompareOp::kGreater, -(int64_t{1} << 40))
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(mask, kNumNodes, HasCount, "count below range");
+
+  mask = P::Compare("count", P::CompareOp::kLessEqual, -(int64_t{1} << 40))
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(
+      mask, kNumNodes, [](size_t) { return false; }, "count not below range");
+
+  auto edge_mask =
+      P::Compare("level", P::CompareOp::kGreaterEqual, int64_t{-1})
+          .EvaluateEdges(pg)
+          .value();
+  CheckMask(
+      edge_mask, pg.NumEdges(), [](size_t) { return true; },
+      "level below range");
+
+  edge_mask = P::Compare("level", P::CompareOp::kEqual, int64_t{7})
+                  .EvaluateEdges(pg)
+                  .value();
+  CheckMask(
+      edge_mask, pg.NumEdges(), [](size_t i) { return i % 256 == 7; },
+      "level");
+}
+
+void
+TestCombinations(const katana::PropertyGraph& pg) {
+  auto heavy = P::Compare("weight", P::CompareOp::kGreaterEqual, 0.25);
+  auto mask = P::And(heavy, P::Not(P::IsValid("count")))
+                  .EvaluateNodes(pg)
+                  .value();
+  CheckMask(
+      mask, kNumNodes,
+      [](size_t i) { return Weight(i) >= 0.25 && !HasCount(i); }, "and not");
+
+  mask = P::Or(heavy, P::Compare("count", P::CompareOp::kEqual, int64_t{0}))
+             .EvaluateNodes(pg)
+             .value();
+  CheckMask(
+      mask, kNumNodes,
+      [](size_t i) {
+        return Weight(i) >= 0.25 || (HasCount(i) && Count(i) == 0);
+      },
+      "or");
+}
+
+void
+TestErrors(const katana::PropertyGraph& pg) {
+  auto res = P::Compare("name", P::CompareOp::kEqual, int64_t{0})
+                 .EvaluateNodes(pg);
+  KATANA_LOG_ASSERT(!res);
+  res = P::IsValid("no such property").EvaluateNodes(pg);
+  KATANA_LOG_ASSERT(!res);
+}
+
+void
+TestProjection(katana::PropertyGraph* pg) {
+  auto node_mask = P::Compare("weight", P::CompareOp::kLess, 0.5)
+                       .EvaluateNodes(*pg)
+                       .value();
+  auto edge_mask = P::Compare("level", P::CompareOp::kLess, int64_t{128})
+                       .EvaluateEdges(*pg)
+                       .value();
+  auto projected =
+      katana::PropertyGraph::MakeProjectedGraph(*pg, &node_mask, &edge_mask)
+          .value();
+
+  KATANA_LOG_ASSERT(projected->NumNodes() == node_mask.count());
+  size_t num_edges = 0;
+  const auto& topo = pg->topology();
+  for (auto n : topo.Nodes()) {
+    for (auto e : topo.OutEdges(n)) {
+      num_edges += node_mask.test(n) && node_mask.test(topo.OutEdgeDst(e)) &&
+                   edge_mask.test(e);
+    }
+  }
+  KATANA_LOG_VASSERT(
+      projected->NumEdges() == num_edges, "{} edges, expected {}",
+      projected->NumEdges(), num_edges);
+
+  katana::DynamicBitset short_mask;
+  short_mask.resize(kNumNodes / 2);
+  KATANA_LOG_ASSERT(
+      !katana::PropertyGraph::MakeProjectedGraph(*pg, &short_mask, nullptr));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::TxnContext txn_ctx;
+
+  auto pg = MakeGraph(&txn_ctx);
+
+  TestCompare(*pg);
+  TestCombinations(*pg);
+  TestErrors(*pg);
+  TestProjection(pg.get());
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/sssp/sssp.h"
+
+using katana::analytics::SsspPlan;
+
+using Edge = katana::PropertyGraph::Edge;
+
+namespace {
+
+const std::string kWeightProperty = "weight";
+const std::string kDistanceProperty = "distance";
+
+enum GraphClass {
+  /// Low degree, large diameter and wide weight range.
+  kRoadLike,
+  /// One hub connected to every other node of a long cycle.
+  kHub,
+  /// Dense graph with small weights.
+  kDense,
+  /// Large diameter with unit weights.
+  kUnitWeightChain,
+};
+
+/// Deterministic pseudo-random weight in [1, max_weight].
+int64_t
+EdgeWeight(Edge e, int64_t max_weight) {
+  uint64_t x = (e + 1) * 0x9e3779b97f4a7c15ULL;
+  x ^= x >> 31U;
+  return 1 + static_cast<int64_t>(x % static_cast<uint64_t>(max_weight));
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(GraphClass graph_class) {
+  std::unique_ptr<katana::PropertyGraph> pg;
+  int64_t max_weight = 1;
+  switch (graph_class) {
+  case kRoadLike:
+    pg = katana::MakeGrid(1024, 1024, false);
+    max_weight = 100000;
+    break;
+  case kHub:
+    pg = katana::MakeFerrisWheel(1 << 20);
+    max_weight = 255;
+    break;
+  case kDense:
+    pg = katana::MakeClique(2048);
+    max_weight = 255;
+    break;
+  case kUnitWeightChain:
+    pg = katana::MakeSawtooth(1 << 19);
+    break;
+  default:
+    KATANA_LOG_FATAL("unknown graph class: {}", graph_class);
+  }
+
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kWeightProperty, [max_weight](Edge e) {
+        return EdgeWeight(e, max_weight);
+      }));
+  KATANA_LOG_VASSERT(r, "could not add edge weights: {}", r.error());
+  return pg;
+}
+
+SsspPlan
+MakePlan(SsspPlan::Algorithm algorithm) {
+  switch (algorithm) {
+  case SsspPlan::kDeltaTile:
+    return SsspPlan::DeltaTile();
+  case SsspPlan::kDeltaStepFusion:
+    return SsspPlan::DeltaStepFusion();
+  case SsspPlan::kDeltaStepAuto:
+    return SsspPlan::DeltaStepAuto();
+  default:
+    KATANA_LOG_FATAL("unexpected algorithm: {}", algorithm);
+  }
+}
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long graph_class : {kRoadLike, kHub, kDense, kUnitWeightChain}) {
+    for (long algorithm :
+         {SsspPlan::kDeltaTile, SsspPlan::kDeltaStepFusion,
+          SsspPlan::kDeltaStepAuto}) {
+      b->Args({graph_class, algorithm});
+    }
+  }
+}
+
+void
+Sssp(benchmark::State& state) {
+  auto graph_class = static_cast<GraphClass>(state.range(0));
+  auto algorithm = static_cast<SsspPlan::Algorithm>(state.range(1));
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeGraph(graph_class);
+  SsspPlan plan = MakePlan(algorithm);
+
+  for (auto _ : state) {
+    katana::TxnContext txn_ctx;
+    auto r = katana::analytics::Sssp(
+        pg.get(), 0, kWeightProperty, kDistanceProperty, &txn_ctx, plan);
+    KATANA_LOG_VASSERT(r, "Sssp failed: {}", r.error());
+
+    state.PauseTiming();
+    auto valid = katana::analytics::SsspAssertValid(
+        pg.get(), 0, kWeightProperty, kDistanceProperty, &txn_ctx);
+    KATANA_LOG_VASSERT(valid, "invalid distances: {}", valid.error());
+    auto removed = pg->RemoveNodeProperty(kDistanceProperty, &txn_ctx);
+    KATANA_LOG_VASSERT(
+        removed, "could not remove distances: {}", removed.error());
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK(Sssp)->Apply(MakeArguments)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
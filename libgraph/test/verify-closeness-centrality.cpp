@@ -0,0 +1,89 @@
+#include <cmath>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/closeness_centrality/closeness_centrality.h"
+
+using namespace katana::analytics;
+
+constexpr static const double kTolerance = 1e-9;
+
+void
+RunClosenessCentrality(
+    std::unique_ptr<katana::PropertyGraph>&& pg,
+    const ClosenessCentralityPlan& plan, ClosenessCentralityMeasure measure,
+    const ClosenessCentralityStatistics& expected, double tolerance) noexcept {
+  const std::string property_name = "closeness";
+
+  katana::TxnContext txn_ctx;
+  auto result =
+      ClosenessCentrality(pg.get(), property_name, &txn_ctx, measure, plan);
+  KATANA_LOG_VASSERT(
+      result, "ClosenessCentrality failed and returned error {}",
+      result.error());
+
+  auto valid = ClosenessCentralityAssertValid(pg.get(), property_name);
+  KATANA_LOG_VASSERT(valid, "Invalid centrality values: {}", valid.error());
+
+  auto stats_result =
+      ClosenessCentralityStatistics::Compute(pg.get(), property_name);
+  KATANA_LOG_VASSERT(
+      stats_result, "Failed to compute ClosenessCentrality statistics: {}",
+      stats_result.error());
+
+  ClosenessCentralityStatistics stats = stats_result.value();
+  KATANA_LOG_VASSERT(
+      std::abs(stats.max_centrality - expected.max_centrality) <= tolerance,
+      "Wrong maximum centrality. Found: {}, Expected: {}",
+      stats.max_centrality, expected.max_centrality);
+  KATANA_LOG_VASSERT(
+      std::abs(stats.min_centrality - expected.min_centrality) <= tolerance,
+      "Wrong minimum centrality. Found: {}, Expected: {}",
+      stats.min_centrality, expected.min_centrality);
+}
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // Every node of a clique is adjacent to every other node.
+  RunClosenessCentrality(
+      katana::MakeClique(100), ClosenessCentralityPlan::Exact(),
+      ClosenessCentralityMeasure::kCloseness,
+      ClosenessCentralityStatistics{1, 1, 1}, kTolerance);
+  RunClosenessCentrality(
+      katana::MakeClique(100), ClosenessCentralityPlan::Exact(),
+      ClosenessCentralityMeasure::kHarmonic,
+      ClosenessCentralityStatistics{1, 1, 1}, kTolerance);
+
+  // The hub of a Ferris wheel with 11 nodes is adjacent to all 10 rim nodes.
+  // A rim node has 3 neighbors at distance 1 and 7 at distance 2.
+  RunClosenessCentrality(
+      katana::MakeFerrisWheel(11), ClosenessCentralityPlan::Exact(),
+      ClosenessCentralityMeasure::kCloseness,
+      ClosenessCentralityStatistics{1, 10.0 / 17.0, 0}, kTolerance);
+  RunClosenessCentrality(
+      katana::MakeFerrisWheel(11), ClosenessCentralityPlan::Exact(),
+      ClosenessCentralityMeasure::kHarmonic,
+      ClosenessCentralityStatistics{1, 6.5 / 10.0, 0}, kTolerance);
+
+  // A path longer than kDefaultMaxIterations: the ends are at distance
+  // 1 + ... + 1500 from the rest and the middle node at twice 1 + ... + 750.
+  RunClosenessCentrality(
+      katana::MakeGrid(1, 1501, false), ClosenessCentralityPlan::Exact(),
+      ClosenessCentralityMeasure::kCloseness,
+      ClosenessCentralityStatistics{1500.0 / 563250, 1500.0 / 1125750, 0},
+      kTolerance);
+
+  // Approximations should be close on small dense graphs.
+  RunClosenessCentrality(
+      katana::MakeClique(100), ClosenessCentralityPlan::SampledPivots(32),
+      ClosenessCentralityMeasure::kCloseness,
+      ClosenessCentralityStatistics{1, 1, 1}, 0.1);
+  RunClosenessCentrality(
+      katana::MakeClique(100), ClosenessCentralityPlan::HyperBall(8),
+      ClosenessCentralityMeasure::kHarmonic,
+      ClosenessCentralityStatistics{1, 1, 1}, 0.2);
+
+  return 0;
+}
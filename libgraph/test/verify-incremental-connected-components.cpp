@@ -0,0 +1,122 @@
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/connected_components/incremental_connected_components.h"
+
+using namespace katana::analytics;
+
+using Node = IncrementalConnectedComponents::Node;
+
+namespace {
+
+const std::string kLabelProperty = "component";
+
+std::unique_ptr<katana::PropertyGraph>
+MakeIsolatedNodes(size_t num_nodes) {
+  katana::SymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+IncrementalConnectedComponents
+MakeComponents(const katana::PropertyGraph& pg, bool is_symmetric) {
+  auto res = IncrementalConnectedComponents::Make(pg, is_symmetric);
+  KATANA_LOG_VASSERT(res, "could not compute components: {}", res.error());
+  return std::move(res.value());
+}
+
+void
+ExpectComponents(const IncrementalConnectedComponents& cc, uint64_t expected) {
+  KATANA_LOG_VASSERT(
+      cc.num_components() == expected,
+      "Wrong number of components. Found: {}, Expected: {}",
+      cc.num_components(), expected);
+}
+
+void
+InsertEdges(
+    IncrementalConnectedComponents* cc,
+    const std::vector<std::pair<Node, Node>>& edges) {
+  auto res = cc->InsertEdges(edges);
+  KATANA_LOG_VASSERT(res, "could not insert edges: {}", res.error());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  ExpectComponents(MakeComponents(*katana::MakeGrid(20, 30, true), true), 1);
+  ExpectComponents(MakeComponents(*katana::MakeGrid(20, 30, false), false), 1);
+  ExpectComponents(MakeComponents(*katana::MakeFerrisWheel(100), true), 1);
+
+  auto pg = MakeIsolatedNodes(1000);
+  auto cc = MakeComponents(*pg, true);
+  ExpectComponents(cc, 1000);
+
+  // Paths of ten nodes, inserted in two batches and in both directions
+  std::vector<std::pair<Node, Node>> forward;
+  std::vector<std::pair<Node, Node>> backward;
+  for (Node n = 0; n + 1 < 1000; ++n) {
+    if (n % 10 != 9) {
+      (n % 2 == 0 ? forward : backward).emplace_back(n + 1, n);
+    }
+  }
+  InsertEdges(&cc, forward);
+  ExpectComponents(cc, 500);
+  InsertEdges(&cc, backward);
+  InsertEdges(&cc, backward);
+  ExpectComponents(cc, 100);
+  for (Node n = 0; n < 1000; ++n) {
+    KATANA_LOG_VASSERT(
+        cc.Label(n) == n - n % 10, "Wrong label for {}: {}", n, cc.Label(n));
+  }
+
+  // Checkpoint and resume
+  katana::TxnContext txn_ctx;
+  auto write_res = cc.WriteLabels(pg.get(), kLabelProperty, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      write_res, "could not write labels: {}", write_res.error());
+  auto load_res =
+      IncrementalConnectedComponents::FromLabels(pg.get(), kLabelProperty);
+  KATANA_LOG_VASSERT(load_res, "could not load labels: {}", load_res.error());
+  auto resumed = std::move(load_res.value());
+  ExpectComponents(resumed, 100);
+
+  // Endpoints must exist, and new nodes start out alone
+  KATANA_LOG_VASSERT(
+      !resumed.InsertEdges({{0, 1005}}), "InsertEdges accepted a bad node");
+  auto add_res = resumed.AddNodes(1010);
+  KATANA_LOG_VASSERT(add_res, "could not add nodes: {}", add_res.error());
+  ExpectComponents(resumed, 110);
+
+  // Join the paths into a ladder
+  std::vector<std::pair<Node, Node>> rungs;
+  for (Node n = 0; n + 10 < 1000; ++n) {
+    rungs.emplace_back(n + 10, n);
+  }
+  InsertEdges(&resumed, rungs);
+  InsertEdges(&resumed, {{1005, 999}});
+  ExpectComponents(resumed, 10);
+  KATANA_LOG_VASSERT(resumed.Label(1005) == 0, "Wrong label for 1005");
+  KATANA_LOG_VASSERT(resumed.Label(1004) == 1004, "Wrong label for 1004");
+
+  // Labels written again replace the old ones
+  pg = MakeIsolatedNodes(1010);
+  write_res = resumed.WriteLabels(pg.get(), kLabelProperty, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      write_res, "could not write labels: {}", write_res.error());
+  write_res = resumed.WriteLabels(pg.get(), kLabelProperty, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      write_res, "could not write labels: {}", write_res.error());
+  auto stats = ConnectedComponentsStatistics::Compute(pg.get(), kLabelProperty);
+  KATANA_LOG_VASSERT(stats, "could not compute statistics: {}", stats.error());
+  KATANA_LOG_VASSERT(
+      stats.value().total_components == 10 &&
+          stats.value().largest_component_size == 1001,
+      "Wrong statistics for written labels");
+
+  return 0;
+}
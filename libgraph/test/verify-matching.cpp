@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <arrow/array.h>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/matching/matching.h"
+
+using namespace katana::analytics;
+
+using Edge = katana::PropertyGraph::Edge;
+
+namespace {
+
+const std::string kWeightProperty = "weight";
+const std::string kMateProperty = "mate";
+
+katana::Result<MatchingStatistics>
+TryMatching(
+    std::unique_ptr<katana::PropertyGraph>&& pg,
+    const std::string& weight_property, const MatchingPlan& plan) {
+  katana::TxnContext txn_ctx;
+  if (!weight_property.empty()) {
+    auto r = katana::AddEdgeProperties(
+        pg.get(), &txn_ctx,
+        katana::PropertyGenerator(
+            weight_property, [](Edge e) { return double(e % 11) / 4; }));
+    KATANA_LOG_VASSERT(r, "could not add weights: {}", r.error());
+  }
+
+  KATANA_CHECKED(
+      Matching(pg.get(), weight_property, kMateProperty, &txn_ctx, plan));
+
+  auto valid = MatchingAssertValid(pg.get(), kMateProperty);
+  KATANA_LOG_VASSERT(valid, "Invalid matching: {}", valid.error());
+
+  return MatchingStatistics::Compute(pg.get(), kMateProperty);
+}
+
+MatchingStatistics
+RunMatching(
+    std::unique_ptr<katana::PropertyGraph>&& pg, const MatchingPlan& plan,
+    const std::string& weight_property = "") {
+  auto stats_result = TryMatching(std::move(pg), weight_property, plan);
+  KATANA_LOG_VASSERT(
+      stats_result, "Matching failed and returned error {}",
+      stats_result.error());
+  return stats_result.value();
+}
+
+/// The maximum weight of a matching of a clique of the nodes that are not in
+/// used, by exhaustive search
+double
+MaxMatchingWeight(
+    uint32_t num_nodes, uint32_t used,
+    const std::function<double(uint32_t, uint32_t)>& weight) {
+  uint32_t u = 0;
+  while (u < num_nodes && (used & (1U << u))) {
+    ++u;
+  }
+  if (u == num_nodes) {
+    return 0;
+  }
+  used |= 1U << u;
+  double best = MaxMatchingWeight(num_nodes, used, weight);
+  for (uint32_t v = u + 1; v < num_nodes; ++v) {
+    if (!(used & (1U << v))) {
+      best = std::max(
+          best,
+          weight(u, v) + MaxMatchingWeight(num_nodes, used | 1U << v, weight));
+    }
+  }
+  return best;
+}
+
+/// Locally dominant matching of a clique where the two directions of an edge
+/// have different weights, directed_weight(u, v) for u -> v. The matching
+/// must terminate and weigh at least half of the maximum weight matching
+/// with the larger weight of each edge.
+void
+TestAsymmetricWeights(
+    uint32_t num_nodes,
+    const std::function<double(uint32_t, uint32_t)>& directed_weight) {
+  auto pg = katana::MakeClique(num_nodes);
+  const auto& topology = pg->topology();
+  std::vector<double> weights(topology.NumEdges());
+  for (auto u : topology.Nodes()) {
+    for (auto e : topology.OutEdges(u)) {
+      weights[e] = directed_weight(u, topology.OutEdgeDst(e));
+    }
+  }
+
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(
+          kWeightProperty, [&](Edge e) { return weights[e]; }));
+  KATANA_LOG_VASSERT(r, "could not add weights: {}", r.error());
+
+  auto matched = Matching(
+      pg.get(), kWeightProperty, kMateProperty, &txn_ctx,
+      MatchingPlan::LocallyDominant());
+  KATANA_LOG_VASSERT(matched, "Matching failed: {}", matched.error());
+  auto valid = MatchingAssertValid(pg.get(), kMateProperty);
+  KATANA_LOG_VASSERT(valid, "Invalid matching: {}", valid.error());
+
+  auto weight = [&](uint32_t u, uint32_t v) {
+    return std::max(directed_weight(u, v), directed_weight(v, u));
+  };
+  auto mates = std::static_pointer_cast<arrow::UInt32Array>(
+      pg->GetNodeProperty(kMateProperty).value()->chunk(0));
+  double matched_weight = 0;
+  for (uint32_t u = 0; u < num_nodes; ++u) {
+    uint32_t v = mates->Value(u);
+    if (v != kUnmatchedNode && u < v) {
+      matched_weight += weight(u, v);
+    }
+  }
+  double max_weight = MaxMatchingWeight(num_nodes, 0, weight);
+  KATANA_LOG_VASSERT(
+      2 * matched_weight >= max_weight,
+      "Matching weighs {}, less than half of the maximum {}", matched_weight,
+      max_weight);
+}
+
+/// A bipartite graph stored with edges from the left side to the right side
+/// only, or with both directions if symmetric.
+std::unique_ptr<katana::PropertyGraph>
+MakeLeftToRight(bool symmetric) {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(4);
+  std::vector<std::pair<uint32_t, uint32_t>> edges{{0, 2}, {0, 3}, {1, 2}};
+  for (auto [u, v] : edges) {
+    builder.AddEdge(u, v);
+    if (symmetric) {
+      builder.AddEdge(v, u);
+    }
+  }
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+void
+ExpectCardinality(const MatchingStatistics& stats, uint64_t expected) {
+  KATANA_LOG_VASSERT(
+      stats.cardinality == expected,
+      "Wrong matching cardinality. Found: {}, Expected: {}", stats.cardinality,
+      expected);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // Maximality is checked by MatchingAssertValid
+  auto ld = MatchingPlan::LocallyDominant();
+  RunMatching(katana::MakeGrid(20, 30, true), ld);
+  RunMatching(katana::MakeFerrisWheel(200), ld);
+  RunMatching(katana::MakeSawtooth(100), ld);
+  RunMatching(katana::MakeGrid(20, 30, false), ld, kWeightProperty);
+  RunMatching(katana::MakeFerrisWheel(200), ld, kWeightProperty);
+
+  // Any maximal matching of a clique leaves at most one node unmatched
+  ExpectCardinality(RunMatching(katana::MakeClique(10), ld), 5);
+  ExpectCardinality(
+      RunMatching(katana::MakeClique(11), ld, kWeightProperty), 5);
+
+  // Each node prefers its successor, which is a cycle of proposals unless
+  // the two directions of an edge are given the same weight
+  TestAsymmetricWeights(3, [](uint32_t u, uint32_t v) {
+    return v == (u + 1) % 3 ? 3.0 : 1.0;
+  });
+  TestAsymmetricWeights(10, [](uint32_t u, uint32_t v) {
+    return double((7 * u + 3 * v) % 10 + 1);
+  });
+
+  // Grids without diagonals are bipartite and have perfect matchings
+  auto pf = MatchingPlan::PothenFan();
+  ExpectCardinality(RunMatching(katana::MakeGrid(8, 8, false), pf), 32);
+  ExpectCardinality(RunMatching(katana::MakeGrid(31, 40, false), pf), 620);
+
+  // A grid of width one is a path
+  ExpectCardinality(RunMatching(katana::MakeGrid(1, 101, false), pf), 50);
+
+  // Pothen-Fan rejects graphs with odd cycles
+  auto clique = TryMatching(katana::MakeClique(5), "", pf);
+  KATANA_LOG_VASSERT(!clique, "Pothen-Fan should reject non-bipartite graphs");
+  auto sawtooth = TryMatching(katana::MakeSawtooth(10), "", pf);
+  KATANA_LOG_VASSERT(
+      !sawtooth, "Pothen-Fan should reject non-bipartite graphs");
+
+  // Edges without a reverse edge are rejected rather than waiting forever
+  // for a proposal back
+  for (const auto& plan : {ld, pf}) {
+    auto one_way = TryMatching(MakeLeftToRight(false), "", plan);
+    KATANA_LOG_VASSERT(!one_way, "Matching should reject asymmetric graphs");
+    ExpectCardinality(RunMatching(MakeLeftToRight(true), plan), 2);
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/max_flow/max_flow.h"
+
+using namespace katana::analytics;
+
+using Edge = katana::PropertyGraph::Edge;
+
+namespace {
+
+const std::string kCapacityProperty = "capacity";
+const std::string kFlowProperty = "flow";
+const std::string kCutProperty = "cut";
+
+template <typename CapacityFn>
+MaxFlowStatistics
+RunMaxFlow(
+    std::unique_ptr<katana::PropertyGraph>&& pg, uint32_t source, uint32_t sink,
+    CapacityFn capacity, const MaxFlowPlan& plan = {}) {
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kCapacityProperty, capacity));
+  KATANA_LOG_VASSERT(r, "could not add capacities: {}", r.error());
+
+  auto result = MaxFlow(
+      pg.get(), source, sink, kCapacityProperty, kFlowProperty, kCutProperty,
+      &txn_ctx, plan);
+  KATANA_LOG_VASSERT(
+      result, "MaxFlow failed and returned error {}", result.error());
+
+  auto valid = MaxFlowAssertValid(
+      pg.get(), source, sink, kCapacityProperty, kFlowProperty, kCutProperty);
+  KATANA_LOG_VASSERT(valid, "Invalid maximum flow: {}", valid.error());
+
+  auto stats_result = MaxFlowStatistics::Compute(
+      pg.get(), source, kFlowProperty, kCutProperty);
+  KATANA_LOG_VASSERT(
+      stats_result, "Failed to compute MaxFlow statistics: {}",
+      stats_result.error());
+  return stats_result.value();
+}
+
+void
+ExpectFlow(const MaxFlowStatistics& stats, uint64_t expected) {
+  KATANA_LOG_VASSERT(
+      stats.flow_value == expected, "Wrong flow value. Found: {}, Expected: {}",
+      stats.flow_value, expected);
+}
+
+const auto UnitCapacity = [](Edge) { return uint32_t{1}; };
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // The degree of the corners of a grid bounds the flow between them
+  ExpectFlow(RunMaxFlow(katana::MakeGrid(8, 8, false), 0, 63, UnitCapacity), 2);
+  ExpectFlow(RunMaxFlow(katana::MakeGrid(8, 8, true), 0, 63, UnitCapacity), 3);
+
+  // Every other node of a clique is a path of length two
+  ExpectFlow(RunMaxFlow(katana::MakeClique(10), 0, 1, UnitCapacity), 9);
+
+  // Frequent global relabels must not change the result
+  ExpectFlow(
+      RunMaxFlow(
+          katana::MakeGrid(8, 8, true), 0, 63, UnitCapacity,
+          MaxFlowPlan::PushRelabel(1)),
+      3);
+
+  // Nonuniform capacities; optimality is checked by MaxFlowAssertValid
+  RunMaxFlow(katana::MakeGrid(20, 30, false), 5, 590, [](Edge e) {
+    return static_cast<int64_t>(e % 5 + 1);
+  });
+  RunMaxFlow(katana::MakeFerrisWheel(200), 0, 100, [](Edge e) {
+    return static_cast<uint64_t>(e % 7);
+  });
+  RunMaxFlow(katana::MakeSawtooth(100), 0, 199, [](Edge e) {
+    return static_cast<int32_t>(e % 3 + 1);
+  });
+
+  // Source and sink must differ
+  auto pg = katana::MakeTriangle(1);
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kCapacityProperty, UnitCapacity));
+  KATANA_LOG_VASSERT(r, "could not add capacities: {}", r.error());
+  auto same = MaxFlow(
+      pg.get(), 0, 0, kCapacityProperty, kFlowProperty, kCutProperty,
+      &txn_ctx);
+  KATANA_LOG_VASSERT(!same, "MaxFlow should reject source == sink");
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/partition/partition.h"
+
+using namespace katana::analytics;
+
+void
+RunPartition(
+    std::unique_ptr<katana::PropertyGraph>&& pg, uint32_t num_partitions,
+    uint64_t max_edge_cut, double max_imbalance) noexcept {
+  const std::string property_name = "partition";
+
+  katana::TxnContext txn_ctx;
+  auto result = Partition(pg.get(), num_partitions, property_name, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      result, "Partition failed and returned error {}", result.error());
+
+  auto valid = PartitionAssertValid(pg.get(), num_partitions, property_name);
+  KATANA_LOG_VASSERT(valid, "Invalid partition IDs: {}", valid.error());
+
+  auto stats_result =
+      PartitionStatistics::Compute(pg.get(), num_partitions, property_name);
+  KATANA_LOG_VASSERT(
+      stats_result, "Failed to compute Partition statistics: {}",
+      stats_result.error());
+
+  PartitionStatistics stats = stats_result.value();
+  KATANA_LOG_VASSERT(
+      stats.edge_cut <= max_edge_cut,
+      "Edge cut too large. Found: {}, Expected at most: {}", stats.edge_cut,
+      max_edge_cut);
+  KATANA_LOG_VASSERT(
+      stats.imbalance <= max_imbalance,
+      "Partitions too imbalanced. Found: {}, Expected at most: {}",
+      stats.imbalance, max_imbalance);
+}
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // One partition cuts nothing
+  RunPartition(katana::MakeGrid(16, 16, false), 1, 0, 1.0);
+
+  // Cutting a 64x64 grid into quadrants cuts 256 edges (counting both
+  // directions); a random partition cuts about 12000.
+  RunPartition(katana::MakeGrid(64, 64, false), 4, 1024, 1.1);
+  RunPartition(katana::MakeGrid(64, 64, true), 2, 1024, 1.1);
+
+  // A long sawtooth should be cut into runs
+  RunPartition(katana::MakeSawtooth(1000), 8, 200, 1.1);
+
+  // Unequal parts of a clique cut fewer edges, so refinement uses the slack
+  // of the balance constraint.
+  RunPartition(katana::MakeClique(12), 3, 96, 1.25);
+
+  // More partitions than nodes
+  RunPartition(katana::MakeTriangle(1), 5, 6, 2.0);
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+const std::string kPprProperty = "ppr";
+
+constexpr static const float kEpsilon = 1e-7;
+constexpr static const float kAlpha = 0.85;
+/// Slack for the rounding error of the single precision estimates.
+constexpr static const double kRoundingTolerance = 1e-5;
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(const katana::AsymmetricGraphTopologyBuilder& builder) {
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+/// A random directed graph. With few edges per node some nodes have no
+/// out-edges, which exercises the jumps back to the seeds.
+std::unique_ptr<katana::PropertyGraph>
+MakeRandomGraph(size_t num_nodes, size_t num_edges, uint32_t seed) {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+  for (size_t i = 0; i < num_edges; ++i) {
+    builder.AddEdge(dist(rng), dist(rng));
+  }
+  return MakeGraph(builder);
+}
+
+/// Personalized Page Rank by power iteration, using the same random walk as
+/// PersonalizedPagerank: follow an out-edge with probability alpha, otherwise
+/// (and always at nodes without out-edges) jump to a seed.
+std::vector<double>
+PowerIteration(
+    const katana::GraphTopology& topo, const std::vector<uint32_t>& seeds,
+    double alpha) {
+  std::vector<double> teleport(topo.NumNodes(), 0);
+  for (uint32_t seed : seeds) {
+    teleport[seed] += 1.0 / seeds.size();
+  }
+
+  std::vector<double> rank = teleport;
+  for (size_t iter = 0; iter < 10000; ++iter) {
+    double dangling = 0;
+    std::vector<double> next(topo.NumNodes(), 0);
+    for (auto src : topo.Nodes()) {
+      size_t degree = topo.OutDegree(src);
+      if (degree == 0) {
+        dangling += rank[src];
+        continue;
+      }
+      for (auto e : topo.OutEdges(src)) {
+        next[topo.OutEdgeDst(e)] += alpha * rank[src] / degree;
+      }
+    }
+
+    double change = 0;
+    for (auto n : topo.Nodes()) {
+      next[n] += ((1 - alpha) + alpha * dangling) * teleport[n];
+      change += std::abs(next[n] - rank[n]);
+    }
+    rank.swap(next);
+    if (change < 1e-12) {
+      break;
+    }
+  }
+  return rank;
+}
+
+/// The residuals left by the push are below epsilon times the out-degree (at
+/// least 1) of each node, and every estimate is low by at most their sum.
+double
+PushTolerance(const katana::GraphTopology& topo, float epsilon) {
+  return epsilon * (topo.NumEdges() + topo.NumNodes()) + kRoundingTolerance;
+}
+
+void
+CheckRanks(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::vector<double>& expected, const PersonalizedPagerankPlan& plan) {
+  katana::TxnContext txn_ctx;
+  auto result = PersonalizedPagerank(pg, seeds, kPprProperty, &txn_ctx, plan);
+  KATANA_LOG_VASSERT(
+      result, "PersonalizedPagerank failed and returned error {}",
+      result.error());
+
+  auto ranks = pg->GetNodePropertyTyped<float>(kPprProperty);
+  KATANA_LOG_VASSERT(ranks, "Missing ranks: {}", ranks.error());
+
+  double tolerance = PushTolerance(pg->topology(), plan.epsilon());
+  for (auto n : pg->topology().Nodes()) {
+    double found = ranks.value()->Value(n);
+    KATANA_LOG_VASSERT(
+        std::abs(found - expected[n]) <= tolerance,
+        "Wrong rank of node {}. Found: {}, Expected: {}", n, found,
+        expected[n]);
+  }
+
+  auto removed = pg->RemoveNodeProperty(kPprProperty, &txn_ctx);
+  KATANA_LOG_VASSERT(removed, "Failed to remove ranks: {}", removed.error());
+}
+
+void
+CheckTopK(
+    const katana::PropertyGraph& pg,
+    const std::vector<std::vector<uint32_t>>& seed_sets,
+    const PersonalizedPagerankPlan& plan) {
+  const size_t k = 10;
+  auto result = PersonalizedPagerankTopK(pg, seed_sets, k, plan);
+  KATANA_LOG_VASSERT(
+      result, "PersonalizedPagerankTopK failed and returned error {}",
+      result.error());
+  KATANA_LOG_ASSERT(result.value().size() == seed_sets.size());
+
+  double tolerance = PushTolerance(pg.topology(), plan.epsilon());
+  for (size_t q = 0; q < seed_sets.size(); ++q) {
+    std::vector<double> expected =
+        PowerIteration(pg.topology(), seed_sets[q], plan.alpha());
+    const auto& top = result.value()[q];
+    KATANA_LOG_ASSERT(top.size() <= k);
+
+    for (size_t i = 0; i < top.size(); ++i) {
+      KATANA_LOG_VASSERT(
+          std::abs(top[i].rank - expected[top[i].node]) <= tolerance,
+          "Wrong rank of node {} for query {}. Found: {}, Expected: {}",
+          top[i].node, q, top[i].rank, expected[top[i].node]);
+      KATANA_LOG_ASSERT(i == 0 || top[i - 1].rank >= top[i].rank);
+    }
+
+    // A node left out of the top k may not rank clearly above its last
+    // entry. With fewer than k entries, every node left out was never
+    // reached by the push.
+    std::vector<bool> in_top(pg.topology().NumNodes(), false);
+    for (const auto& score : top) {
+      in_top[score.node] = true;
+    }
+    double bound =
+        top.size() == k ? top.back().rank + 2 * tolerance : tolerance;
+    for (auto n : pg.topology().Nodes()) {
+      KATANA_LOG_VASSERT(
+          in_top[n] || expected[n] <= bound,
+          "Node {} with rank {} is missing from the top {} of query {}", n,
+          expected[n], k, q);
+    }
+  }
+}
+
+void
+TestPath() {
+  // 0 -> 1, and the walk at 1 always jumps back to 0, so
+  // p(0) = (1 - alpha) + alpha * p(1) and p(1) = alpha * p(0).
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(2);
+  builder.AddEdge(0, 1);
+  auto pg = MakeGraph(builder);
+
+  std::vector<double> expected{1 / (1 + kAlpha), kAlpha / (1 + kAlpha)};
+  std::vector<double> reference = PowerIteration(pg->topology(), {0}, kAlpha);
+  for (size_t n = 0; n < expected.size(); ++n) {
+    KATANA_LOG_VASSERT(
+        std::abs(reference[n] - expected[n]) <= 1e-9,
+        "Wrong reference rank of node {}. Found: {}, Expected: {}", n,
+        reference[n], expected[n]);
+  }
+
+  CheckRanks(
+      pg.get(), {0}, expected,
+      PersonalizedPagerankPlan::ForwardPush(kEpsilon, kAlpha));
+  CheckRanks(
+      pg.get(), {0}, expected,
+      PersonalizedPagerankPlan::BatchedForwardPush(kEpsilon, kAlpha));
+}
+
+void
+TestRandomGraph() {
+  auto pg = MakeRandomGraph(200, 600, 42);
+  const katana::GraphTopology& topo = pg->topology();
+
+  std::vector<std::vector<uint32_t>> seed_sets{{0}, {7, 100, 199}, {3, 150}};
+  for (const auto& seeds : seed_sets) {
+    std::vector<double> expected = PowerIteration(topo, seeds, kAlpha);
+    CheckRanks(
+        pg.get(), seeds, expected,
+        PersonalizedPagerankPlan::ForwardPush(kEpsilon, kAlpha));
+    CheckRanks(
+        pg.get(), seeds, expected,
+        PersonalizedPagerankPlan::BatchedForwardPush(kEpsilon, kAlpha));
+  }
+
+  CheckTopK(
+      *pg, seed_sets, PersonalizedPagerankPlan::ForwardPush(kEpsilon, kAlpha));
+  CheckTopK(
+      *pg, seed_sets,
+      PersonalizedPagerankPlan::BatchedForwardPush(kEpsilon, kAlpha));
+}
+
+void
+TestGrid() {
+  // A symmetric graph without dangling nodes, with the default parameters.
+  auto pg = katana::MakeGrid(10, 10, true);
+  std::vector<uint32_t> seeds{0, 55};
+  std::vector<double> expected = PowerIteration(
+      pg->topology(), seeds, PersonalizedPagerankPlan::kDefaultAlpha);
+  CheckRanks(
+      pg.get(), seeds, expected, PersonalizedPagerankPlan::ForwardPush());
+  CheckRanks(
+      pg.get(), seeds, expected,
+      PersonalizedPagerankPlan::BatchedForwardPush());
+}
+
+void
+TestInvalidArguments() {
+  auto pg = katana::MakeGrid(2, 2, false);
+  katana::TxnContext txn_ctx;
+  KATANA_LOG_ASSERT(
+      !PersonalizedPagerank(pg.get(), {}, kPprProperty, &txn_ctx));
+  KATANA_LOG_ASSERT(
+      !PersonalizedPagerank(pg.get(), {4}, kPprProperty, &txn_ctx));
+  KATANA_LOG_ASSERT(!PersonalizedPagerank(
+      pg.get(), {0}, kPprProperty, &txn_ctx,
+      PersonalizedPagerankPlan::ForwardPush(0)));
+  KATANA_LOG_ASSERT(!PersonalizedPagerank(
+      pg.get(), {0}, kPprProperty, &txn_ctx,
+      PersonalizedPagerankPlan::ForwardPush(kEpsilon, 1)));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestPath();
+  TestRandomGraph();
+  TestGrid();
+  TestInvalidArguments();
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+#include <cmath>
+
+#include <arrow/api.h>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/random_walks/random_walks.h"
+
+using katana::analytics::RandomWalksPlan;
+
+using Edge = katana::PropertyGraph::Edge;
+
+namespace {
+
+const std::string kWeightProperty = "weight";
+
+std::shared_ptr<arrow::FixedSizeListArray>
+RunWalks(
+    katana::PropertyGraph* pg, const std::string& weight_property,
+    const RandomWalksPlan& plan) {
+  auto walks_result =
+      katana::analytics::WeightedRandomWalks(pg, weight_property, plan);
+  KATANA_LOG_VASSERT(
+      walks_result, "WeightedRandomWalks failed: {}", walks_result.error());
+  auto walks = std::move(walks_result.value());
+
+  uint64_t num_nodes = pg->topology().NumNodes();
+  KATANA_LOG_VASSERT(
+      static_cast<uint64_t>(walks->length()) ==
+          num_nodes * plan.number_of_walks(),
+      "Wrong number of walks. Found: {}, Expected: {}", walks->length(),
+      num_nodes * plan.number_of_walks());
+  KATANA_LOG_VASSERT(
+      static_cast<uint32_t>(walks->value_length()) == plan.walk_length() + 1,
+      "Wrong walk width. Found: {}, Expected: {}", walks->value_length(),
+      plan.walk_length() + 1);
+  return walks;
+}
+
+/// Every walk starts at its node and every step follows an edge.
+void
+VerifyWalksFollowEdges(
+    katana::PropertyGraph* pg, const arrow::FixedSizeListArray& walks) {
+  const auto& topology = pg->topology();
+  const auto& nodes = static_cast<const arrow::UInt32Array&>(*walks.values());
+
+  for (int64_t i = 0; i < walks.length(); ++i) {
+    int64_t begin = walks.value_offset(i);
+    KATANA_LOG_VASSERT(
+        nodes.Value(begin) == i % topology.NumNodes(),
+        "Walk {} starts at {}", i, nodes.Value(begin));
+    for (int64_t j = begin + 1; j < begin + walks.value_length(); ++j) {
+      KATANA_LOG_VASSERT(
+          nodes.IsValid(j), "Walk {} stops early on a symmetric graph", i);
+      uint32_t prev = nodes.Value(j - 1);
+      uint32_t curr = nodes.Value(j);
+      bool found = false;
+      for (auto e : topology.OutEdges(prev)) {
+        found |= topology.OutEdgeDst(e) == curr;
+      }
+      KATANA_LOG_VASSERT(found, "Walk {} steps along a non-edge", i);
+    }
+  }
+}
+
+void
+RunFollowEdges(
+    std::unique_ptr<katana::PropertyGraph>&& pg, const RandomWalksPlan& plan) {
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kWeightProperty, [](Edge e) {
+        return static_cast<float>(e % 7 + 1);
+      }));
+  KATANA_LOG_VASSERT(r, "could not add edge weights: {}", r.error());
+
+  VerifyWalksFollowEdges(pg.get(), *RunWalks(pg.get(), "", plan));
+  VerifyWalksFollowEdges(pg.get(), *RunWalks(pg.get(), kWeightProperty, plan));
+}
+
+/// In a 3-clique node 0 has out edges 0 and 1 (to nodes 1 and 2), so with
+/// weight e + 1 the first step from node 0 goes to node 2 with probability
+/// 2 / 3.
+void
+RunFirstStepFrequency() {
+  auto pg = katana::MakeClique(3);
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kWeightProperty, [](Edge e) {
+        return static_cast<uint32_t>(e + 1);
+      }));
+  KATANA_LOG_VASSERT(r, "could not add edge weights: {}", r.error());
+
+  constexpr uint32_t kNumWalks = 30000;
+  auto walks = RunWalks(
+      pg.get(), kWeightProperty, RandomWalksPlan::Node2Vec(1, kNumWalks));
+  const auto& nodes = static_cast<const arrow::UInt32Array&>(*walks->values());
+
+  uint32_t num_from_zero = 0;
+  uint32_t num_to_two = 0;
+  for (int64_t i = 0; i < walks->length(); ++i) {
+    int64_t begin = walks->value_offset(i);
+    if (nodes.Value(begin) == 0) {
+      ++num_from_zero;
+      num_to_two += nodes.Value(begin + 1) == 2;
+    }
+  }
+
+  double frequency = static_cast<double>(num_to_two) / num_from_zero;
+  KATANA_LOG_VASSERT(
+      std::abs(frequency - 2.0 / 3.0) < 0.02,
+      "Wrong first step frequency. Found: {}, Expected: {}", frequency,
+      2.0 / 3.0);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  RunFollowEdges(
+      katana::MakeGrid(5, 7, false), RandomWalksPlan::Node2Vec(8, 2));
+  RunFollowEdges(
+      katana::MakeGrid(5, 7, true), RandomWalksPlan::Node2Vec(8, 2, 2.0, 0.5));
+  RunFollowEdges(
+      katana::MakeFerrisWheel(300), RandomWalksPlan::Node2Vec(8, 2, 0.5, 2.0));
+  // Nodes of a large clique are hubs, so second-order tables are used.
+  RunFollowEdges(
+      katana::MakeClique(200), RandomWalksPlan::Node2Vec(4, 1, 0.25, 4.0));
+  RunFollowEdges(
+      katana::MakeSawtooth(10),
+      RandomWalksPlan::Edge2Vec(6, 2, 2.0, 0.5, 3, 1));
+
+  RunFirstStepFrequency();
+
+  return 0;
+}
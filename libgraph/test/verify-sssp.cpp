@@ -0,0 +1,72 @@
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/sssp/sssp.h"
+
+using namespace katana::analytics;
+
+using Edge = katana::PropertyGraph::Edge;
+
+namespace {
+
+const std::string kWeightProperty = "weight";
+
+/// Deterministic pseudo-random weight in [1, max_weight].
+int64_t
+EdgeWeight(Edge e, int64_t max_weight) {
+  uint64_t x = (e + 1) * 0x9e3779b97f4a7c15ULL;
+  x ^= x >> 31U;
+  return 1 + static_cast<int64_t>(x % static_cast<uint64_t>(max_weight));
+}
+
+/// Compare the distances of DeltaStepAuto with those of Dijkstra
+void
+CompareWithDijkstra(
+    std::unique_ptr<katana::PropertyGraph>&& pg, int64_t max_weight,
+    size_t start_node = 0) {
+  katana::TxnContext txn_ctx;
+  auto r = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator(kWeightProperty, [max_weight](Edge e) {
+        return EdgeWeight(e, max_weight);
+      }));
+  KATANA_LOG_VASSERT(r, "could not add edge weights: {}", r.error());
+
+  auto expected = Sssp(
+      pg.get(), start_node, kWeightProperty, "dijkstra", &txn_ctx,
+      SsspPlan::Dijkstra());
+  KATANA_LOG_VASSERT(expected, "Dijkstra failed: {}", expected.error());
+  auto found = Sssp(
+      pg.get(), start_node, kWeightProperty, "auto", &txn_ctx,
+      SsspPlan::DeltaStepAuto());
+  KATANA_LOG_VASSERT(found, "DeltaStepAuto failed: {}", found.error());
+
+  auto valid =
+      SsspAssertValid(pg.get(), start_node, kWeightProperty, "auto", &txn_ctx);
+  KATANA_LOG_VASSERT(valid, "Invalid distances: {}", valid.error());
+
+  auto expected_dist = pg->GetNodeProperty("dijkstra").value();
+  auto found_dist = pg->GetNodeProperty("auto").value();
+  KATANA_LOG_VASSERT(
+      found_dist->Equals(*expected_dist),
+      "DeltaStepAuto distances differ from Dijkstra (max weight {})",
+      max_weight);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  CompareWithDijkstra(katana::MakeGrid(60, 80, false), 1000);
+  CompareWithDijkstra(katana::MakeFerrisWheel(5000), 255);
+  CompareWithDijkstra(katana::MakeClique(200), 255, 17);
+  CompareWithDijkstra(katana::MakeSawtooth(3000), 1);
+
+  // Weights far larger than delta leave most pending nodes beyond the ring
+  // of buckets
+  CompareWithDijkstra(katana::MakeGrid(50, 50, false), int64_t{1} << 30);
+  CompareWithDijkstra(katana::MakeFerrisWheel(2000), int64_t{1} << 24);
+
+  return 0;
+}
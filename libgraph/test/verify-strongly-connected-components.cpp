@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <random>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+const std::string kSccProperty = "scc";
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(const katana::AsymmetricGraphTopologyBuilder& builder) {
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+/// num_cycles directed cycles of cycle_length nodes, each with an edge to the
+/// next cycle, followed by a path of path_length nodes leaving the last one.
+std::unique_ptr<katana::PropertyGraph>
+MakeCycleChain(size_t num_cycles, size_t cycle_length, size_t path_length) {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  size_t num_cycle_nodes = num_cycles * cycle_length;
+  builder.AddNodes(num_cycle_nodes + path_length);
+  for (size_t c = 0; c < num_cycles; ++c) {
+    size_t first = c * cycle_length;
+    for (size_t i = 0; i < cycle_length; ++i) {
+      builder.AddEdge(first + i, first + (i + 1) % cycle_length);
+    }
+    if (c + 1 < num_cycles) {
+      builder.AddEdge(first, first + cycle_length);
+    }
+  }
+  size_t first_path_node = std::max<size_t>(num_cycle_nodes, 1);
+  for (size_t n = first_path_node; n < num_cycle_nodes + path_length; ++n) {
+    builder.AddEdge(n - 1, n);
+  }
+  return MakeGraph(builder);
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeRandomGraph(size_t num_nodes, size_t num_edges, uint32_t seed) {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+  for (size_t i = 0; i < num_edges; ++i) {
+    builder.AddEdge(dist(rng), dist(rng));
+  }
+  return MakeGraph(builder);
+}
+
+StronglyConnectedComponentsStatistics
+RunScc(
+    std::unique_ptr<katana::PropertyGraph>&& pg,
+    const StronglyConnectedComponentsPlan& plan) {
+  katana::TxnContext txn_ctx;
+  auto result =
+      StronglyConnectedComponents(pg.get(), kSccProperty, &txn_ctx, plan);
+  KATANA_LOG_VASSERT(
+      result, "StronglyConnectedComponents failed and returned error {}",
+      result.error());
+
+  auto valid = StronglyConnectedComponentsAssertValid(pg.get(), kSccProperty);
+  KATANA_LOG_VASSERT(valid, "Invalid SCCs: {}", valid.error());
+
+  auto stats_result =
+      StronglyConnectedComponentsStatistics::Compute(pg.get(), kSccProperty);
+  KATANA_LOG_VASSERT(
+      stats_result, "Failed to compute SCC statistics: {}",
+      stats_result.error());
+  return stats_result.value();
+}
+
+void
+ExpectComponents(
+    const StronglyConnectedComponentsStatistics& stats, uint64_t expected,
+    uint64_t expected_largest) {
+  KATANA_LOG_VASSERT(
+      stats.total_components == expected,
+      "Wrong number of SCCs. Found: {}, Expected: {}", stats.total_components,
+      expected);
+  KATANA_LOG_VASSERT(
+      stats.largest_component_size == expected_largest,
+      "Wrong largest SCC. Found: {}, Expected: {}",
+      stats.largest_component_size, expected_largest);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  std::vector<StronglyConnectedComponentsPlan> plans = {
+      StronglyConnectedComponentsPlan::ForwardBackward(),
+      StronglyConnectedComponentsPlan::ForwardBackward(1),
+      StronglyConnectedComponentsPlan::ForwardBackward(100),
+      StronglyConnectedComponentsPlan::Coloring(),
+  };
+
+  for (const auto& plan : plans) {
+    // Symmetric graphs are strongly connected
+    ExpectComponents(RunScc(katana::MakeGrid(20, 30, true), plan), 1, 600);
+    ExpectComponents(RunScc(katana::MakeClique(20), plan), 1, 20);
+
+    ExpectComponents(RunScc(MakeCycleChain(50, 7, 0), plan), 50, 7);
+    ExpectComponents(RunScc(MakeCycleChain(1, 1000, 30), plan), 31, 1000);
+    ExpectComponents(RunScc(MakeCycleChain(0, 0, 100), plan), 100, 1);
+
+    // Random graphs around the giant SCC threshold; checked against Tarjan
+    RunScc(MakeRandomGraph(2000, 1500, 1), plan);
+    RunScc(MakeRandomGraph(2000, 2500, 2), plan);
+    RunScc(MakeRandomGraph(2000, 8000, 3), plan);
+  }
+
+  return 0;
+}
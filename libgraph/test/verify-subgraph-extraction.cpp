@@ -0,0 +1,175 @@
+#include <algorithm>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/subgraph_extraction/subgraph_extraction.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct NodeID : public katana::PODProperty<uint64_t> {};
+struct EdgeID : public katana::PODProperty<uint64_t> {};
+
+using NodeData = std::tuple<NodeID>;
+using EdgeData = std::tuple<EdgeID>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+const std::string kNodeIDProperty = "node_id";
+const std::string kEdgeIDProperty = "edge_id";
+
+/// Give every node and edge its own ID as a property
+std::unique_ptr<katana::PropertyGraph>
+AddIDs(std::unique_ptr<katana::PropertyGraph>&& pg) {
+  katana::TxnContext txn_ctx;
+  KATANA_LOG_ASSERT(
+      pg->ConstructNodeProperties<NodeData>(&txn_ctx, {kNodeIDProperty}));
+  KATANA_LOG_ASSERT(
+      pg->ConstructEdgeProperties<EdgeData>(&txn_ctx, {kEdgeIDProperty}));
+  auto graph = Graph::Make(pg.get(), {kNodeIDProperty}, {kEdgeIDProperty});
+  KATANA_LOG_ASSERT(graph);
+  for (auto n : graph.value()) {
+    graph.value().GetData<NodeID>(n) = n;
+    for (auto e : graph.value().OutEdges(n)) {
+      graph.value().GetEdgeData<EdgeID>(e) = e;
+    }
+  }
+  return std::move(pg);
+}
+
+/// The expected edges of one node of a sub-graph, as pairs of destination
+/// in the sub-graph and edge ID in the original graph
+using ExpectedEdges = std::vector<std::pair<uint64_t, uint64_t>>;
+
+void
+ExpectSubGraph(
+    katana::PropertyGraph* sub_pg, const std::vector<uint64_t>& nodes,
+    const std::vector<ExpectedEdges>& edges) {
+  KATANA_LOG_VASSERT(
+      sub_pg->NumNodes() == nodes.size(),
+      "Wrong number of nodes. Found: {}, Expected: {}", sub_pg->NumNodes(),
+      nodes.size());
+  auto graph = Graph::Make(sub_pg, {kNodeIDProperty}, {kEdgeIDProperty});
+  KATANA_LOG_ASSERT(graph);
+  for (auto n : graph.value()) {
+    KATANA_LOG_VASSERT(
+        graph.value().GetData<NodeID>(n) == nodes[n],
+        "Wrong node {}. Found: {}, Expected: {}", n,
+        graph.value().GetData<NodeID>(n), nodes[n]);
+    ExpectedEdges found;
+    for (auto e : graph.value().OutEdges(n)) {
+      found.emplace_back(
+          graph.value().OutEdgeDst(e), graph.value().GetEdgeData<EdgeID>(e));
+    }
+    KATANA_LOG_VASSERT(
+        found == edges[n], "Wrong edges of node {}. Found: {}, Expected: {}",
+        n, found.size(), edges[n].size());
+  }
+}
+
+/// Extract node_set and compare it with a serial extraction that follows
+/// the documented order: distinct nodes in the order given, and edges in
+/// order of destination in pg.
+void
+TestNodeSet(katana::PropertyGraph* pg, const std::vector<uint32_t>& node_set) {
+  std::vector<uint64_t> nodes;
+  for (auto n : node_set) {
+    if (std::find(nodes.begin(), nodes.end(), n) == nodes.end()) {
+      nodes.push_back(n);
+    }
+  }
+  const auto& topology = pg->topology();
+  std::vector<ExpectedEdges> edges(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (auto e : topology.OutEdges(nodes[i])) {
+      auto it =
+          std::find(nodes.begin(), nodes.end(), topology.OutEdgeDst(e));
+      if (it != nodes.end()) {
+        edges[i].emplace_back(it - nodes.begin(), e);
+      }
+    }
+    std::stable_sort(
+        edges[i].begin(), edges[i].end(), [&](const auto& a, const auto& b) {
+          return nodes[a.first] < nodes[b.first];
+        });
+  }
+
+  katana::TxnContext txn_ctx;
+  auto sub_pg = SubGraphExtraction(
+      pg, node_set, {kNodeIDProperty}, {kEdgeIDProperty}, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      sub_pg, "SubGraphExtraction failed and returned error {}",
+      sub_pg.error());
+  ExpectSubGraph(sub_pg.value().get(), nodes, edges);
+
+  auto topology_only = SubGraphExtraction(pg, node_set);
+  KATANA_LOG_ASSERT(topology_only);
+  KATANA_LOG_ASSERT(
+      topology_only.value()->NumEdges() == sub_pg.value()->NumEdges());
+}
+
+/// Keep nodes whose ID is a multiple of node_modulus and edges whose ID is a
+/// multiple of edge_modulus
+void
+TestFilter(
+    katana::PropertyGraph* pg, uint64_t node_modulus, uint64_t edge_modulus) {
+  const auto& topology = pg->topology();
+  std::vector<uint64_t> nodes;
+  std::vector<uint64_t> new_ids(topology.NumNodes(), 0);
+  for (auto n : topology.Nodes()) {
+    if (n % node_modulus == 0) {
+      new_ids[n] = nodes.size();
+      nodes.push_back(n);
+    }
+  }
+  std::vector<ExpectedEdges> edges(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (auto e : topology.OutEdges(nodes[i])) {
+      auto dest = topology.OutEdgeDst(e);
+      if (dest % node_modulus == 0 && e % edge_modulus == 0) {
+        edges[i].emplace_back(new_ids[dest], e);
+      }
+    }
+  }
+
+  SubGraphFilter filter;
+  filter.node_predicate = [&](uint64_t n) { return n % node_modulus == 0; };
+  filter.edge_predicate = [&](uint64_t e) { return e % edge_modulus == 0; };
+  katana::TxnContext txn_ctx;
+  auto sub_pg = FilteredSubGraphExtraction(
+      pg, filter, {kNodeIDProperty}, {kEdgeIDProperty}, &txn_ctx);
+  KATANA_LOG_VASSERT(
+      sub_pg, "FilteredSubGraphExtraction failed and returned error {}",
+      sub_pg.error());
+  ExpectSubGraph(sub_pg.value().get(), nodes, edges);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  auto grid = AddIDs(katana::MakeGrid(10, 10, true));
+  TestNodeSet(grid.get(), {55, 3, 44, 45, 54, 3, 56});
+  // A run of consecutive nodes
+  TestNodeSet(grid.get(), {10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+  TestNodeSet(grid.get(), {99});
+
+  // Fewer members than neighbors
+  auto clique = AddIDs(katana::MakeClique(50));
+  TestNodeSet(clique.get(), {7, 3});
+  TestNodeSet(clique.get(), {49, 0, 25, 1, 48});
+
+  auto empty = SubGraphExtraction(clique.get(), {});
+  KATANA_LOG_ASSERT(empty && empty.value()->NumNodes() == 0);
+
+  TestFilter(grid.get(), 1, 1);
+  TestFilter(grid.get(), 2, 1);
+  TestFilter(grid.get(), 3, 2);
+  TestFilter(clique.get(), 2, 3);
+  TestFilter(clique.get(), 1000, 1);
+
+  return 0;
+}
@@ -1,5 +1,8 @@
+#include <cmath>
+
 #include "katana/SharedMemSys.h"
 #include "katana/TopologyGeneration.h"
+#include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/triangle_count/triangle_count.h"
 
 void
@@ -22,6 +25,97 @@ RunTriCount(
   }
 }
 
+/// Check that the estimate of plan is within relative_error of the exact
+/// count, and that the per-node estimates add up to three times the estimate.
+void
+RunApproximateTriCount(
+    std::unique_ptr<katana::PropertyGraph>&& pg,
+    const katana::analytics::ApproximateTriangleCountPlan& plan,
+    const size_t num_expected_triangles, double relative_error) noexcept {
+  const std::string kProperty = "triangles";
+  katana::TxnContext txn_ctx;
+  auto estimate = katana::analytics::ApproximateTriangleCount(
+      pg.get(), &txn_ctx, kProperty, plan);
+  KATANA_LOG_VASSERT(
+      estimate, "ApproximateTriangleCount failed and returned error {}",
+      estimate.error());
+  double expected = num_expected_triangles;
+  KATANA_LOG_VASSERT(
+      std::abs(estimate.value().estimate - expected) <=
+          relative_error * expected,
+      "Bad estimate of triangles. Found: {}, Expected: {}",
+      estimate.value().estimate, expected);
+  KATANA_LOG_VASSERT(
+      estimate.value().lower_bound <= estimate.value().estimate &&
+          estimate.value().estimate <= estimate.value().upper_bound,
+      "Estimate {} outside of its interval [{}, {}]",
+      estimate.value().estimate, estimate.value().lower_bound,
+      estimate.value().upper_bound);
+
+  struct NodeTriangles : public katana::PODProperty<double> {};
+  using Graph =
+      katana::TypedPropertyGraph<std::tuple<NodeTriangles>, std::tuple<>>;
+  auto graph = Graph::Make(pg.get(), {kProperty}, {});
+  KATANA_LOG_ASSERT(graph);
+  double total = 0;
+  for (auto n : graph.value()) {
+    total += graph.value().GetData<NodeTriangles>(n);
+  }
+  KATANA_LOG_VASSERT(
+      std::abs(total - 3 * estimate.value().estimate) <=
+          1e-6 * std::max(1.0, total),
+      "Per-node estimates add up to {}, Expected: {}", total,
+      3 * estimate.value().estimate);
+}
+
+/// A triangle 0 - 1 - 2 with every edge doubled, a self loop on 0 and a
+/// node 3 joined to 0 by three parallel edges.
+std::unique_ptr<katana::PropertyGraph>
+MakeMultiTriangle() {
+  katana::SymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(4);
+  for (int i = 0; i < 2; ++i) {
+    builder.AddEdge(0, 1);
+    builder.AddEdge(1, 2);
+    builder.AddEdge(2, 0);
+  }
+  builder.AddEdge(0, 0);
+  for (int i = 0; i < 3; ++i) {
+    builder.AddEdge(0, 3);
+  }
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+void
+RunApproximateTriCount() {
+  using Plan = katana::analytics::ApproximateTriangleCountPlan;
+
+  // Keeping everything is exact
+  RunApproximateTriCount(
+      katana::MakeGrid(100, 100, true), Plan::Colorful(1, 1), 39204, 0);
+  RunApproximateTriCount(
+      katana::MakeGrid(100, 100, true), Plan::EdgeSampling(1, 1), 39204, 0);
+  RunApproximateTriCount(
+      katana::MakeGrid(5, 7, false), Plan::WedgeSampling(), 0, 0);
+
+  RunApproximateTriCount(
+      katana::MakeGrid(100, 100, true), Plan::Colorful(2), 39204, 0.25);
+  RunApproximateTriCount(
+      katana::MakeGrid(100, 100, true), Plan::EdgeSampling(0.5), 39204, 0.25);
+  RunApproximateTriCount(
+      katana::MakeGrid(100, 100, true), Plan::WedgeSampling(), 39204, 0.05);
+  RunApproximateTriCount(
+      katana::MakeClique(100), Plan::WedgeSampling(), 161700, 0.05);
+
+  // Parallel edges count once and self loops are ignored: of the five
+  // wedges, only 1 - 0 - 3 and 2 - 0 - 3 are open
+  RunApproximateTriCount(MakeMultiTriangle(), Plan::Colorful(1, 1), 1, 0);
+  RunApproximateTriCount(MakeMultiTriangle(), Plan::EdgeSampling(1, 1), 1, 0);
+  RunApproximateTriCount(MakeMultiTriangle(), Plan::WedgeSampling(), 1, 0.05);
+}
+
 int
 main() {
   katana::SharedMemSys S;
@@ -52,5 +146,7 @@ main() {
   RunTriCount(katana::MakeTriangle(3), 9);
   RunTriCount(katana::MakeTriangle(4), 16);
 
+  RunApproximateTriCount();
+
   return 0;
 }
@@ -0,0 +1,71 @@
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/k_truss/k_truss.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+const std::string kTrussnessProperty = "trussness";
+
+TrussDecompositionStatistics
+RunTrussDecomposition(std::unique_ptr<katana::PropertyGraph>&& pg) {
+  katana::TxnContext txn_ctx;
+  auto result = TrussDecomposition(&txn_ctx, pg.get(), kTrussnessProperty);
+  KATANA_LOG_VASSERT(
+      result, "TrussDecomposition failed and returned error {}",
+      result.error());
+
+  auto valid = TrussDecompositionAssertValid(pg.get(), kTrussnessProperty);
+  KATANA_LOG_VASSERT(valid, "Invalid trussness: {}", valid.error());
+
+  auto stats_result =
+      TrussDecompositionStatistics::Compute(pg.get(), kTrussnessProperty);
+  KATANA_LOG_VASSERT(
+      stats_result, "Failed to compute truss statistics: {}",
+      stats_result.error());
+  return stats_result.value();
+}
+
+void
+ExpectStatistics(
+    const TrussDecompositionStatistics& stats, uint32_t max_trussness,
+    uint64_t max_truss_edges) {
+  KATANA_LOG_VASSERT(
+      stats.max_trussness == max_trussness,
+      "Wrong maximum trussness. Found: {}, Expected: {}", stats.max_trussness,
+      max_trussness);
+  KATANA_LOG_VASSERT(
+      stats.max_truss_edges == max_truss_edges,
+      "Wrong number of edges. Found: {}, Expected: {}", stats.max_truss_edges,
+      max_truss_edges);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // Every edge of an n-clique is in n - 2 triangles
+  ExpectStatistics(RunTrussDecomposition(katana::MakeClique(12)), 12, 66);
+
+  // Without triangles every edge is only in the 2-truss
+  ExpectStatistics(
+      RunTrussDecomposition(katana::MakeGrid(20, 30, false)), 2,
+      19 * 30 + 20 * 29);
+
+  // Spokes are in two triangles and the rim in one, so peeling the rim
+  // takes the spokes with it
+  ExpectStatistics(RunTrussDecomposition(katana::MakeFerrisWheel(101)), 3, 200);
+
+  // Cells with both diagonals are 4-cliques that share edges
+  auto grid_stats = RunTrussDecomposition(katana::MakeGrid(20, 30, true));
+  KATANA_LOG_VASSERT(
+      grid_stats.max_trussness >= 4, "Wrong maximum trussness: {}",
+      grid_stats.max_trussness);
+
+  ExpectStatistics(RunTrussDecomposition(katana::MakeSawtooth(50)), 3, 150);
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+#ifndef KATANA_LIBTSUBA_KATANA_ENTITYINDEXPRIMITIVE_H_
+#define KATANA_LIBTSUBA_KATANA_ENTITYINDEXPRIMITIVE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "katana/ErrorCode.h"
+#include "katana/FileFrame.h"
+#include "katana/FileView.h"
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/RDGOptionalDatastructure.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/config.h"
+#include "katana/file.h"
+#include "katana/tsuba.h"
+
+namespace katana {
+
+const std::string kOptionalDatastructureEntityIndexPrimitive =
+    "kg.v1.entity_index";
+const std::string kOptionalDatastructureEntityIndexPrimitiveFilename =
+    "entity_index_manifest";
+const std::string kOptionalDatastructureEntityIndexPrimitiveIDsFilename =
+    "entity_index_ids";
+
+/// The sorted order of the entities of indexed node and edge properties, so
+/// that an index can be loaded without sorting its property again. The ids
+/// of each index are kept in their own file, listed in paths_ so that they
+/// move with the RDG.
+class KATANA_EXPORT EntityIndexPrimitive
+    : private katana::RDGOptionalDatastructure {
+public:
+  struct Entry {
+    std::string property_name;
+    bool is_node;
+    uint64_t num_ids;
+    /// The size in bytes of one id
+    uint32_t id_size;
+    /// The file of the ids, relative to the RDG directory
+    std::string file;
+  };
+
+  static katana::Result<EntityIndexPrimitive> Load(
+      const katana::URI& rdg_dir_path, const std::string& path) {
+    EntityIndexPrimitive index =
+        KATANA_CHECKED(LoadJson(rdg_dir_path.Join(path).string()));
+    return index;
+  }
+
+  katana::Result<std::string> Write(katana::URI rdg_dir_path) {
+    // Write out our json manifest
+    katana::URI manifest_path = rdg_dir_path.RandFile(
+        kOptionalDatastructureEntityIndexPrimitiveFilename);
+    KATANA_CHECKED(WriteManifest(manifest_path.string()));
+    return manifest_path.BaseName();
+  }
+
+  /// Store the sorted ids of the index over property_name in rdg_dir_path,
+  /// replacing any previous entry for it. The file of the previous entry is
+  /// kept if it already holds these ids and deleted otherwise, so that
+  /// storing again does not leave stale files behind.
+  katana::Result<void> AddIndex(
+      const katana::URI& rdg_dir_path, const std::string& property_name,
+      bool is_node, const void* ids, uint64_t num_ids, uint32_t id_size) {
+    Entry* existing = FindEntry(property_name, is_node);
+    if (existing && existing->num_ids == num_ids &&
+        existing->id_size == id_size &&
+        HoldsIds(rdg_dir_path, *existing, ids)) {
+      return katana::ResultSuccess();
+    }
+
+    katana::URI ids_path = rdg_dir_path.RandFile(
+        kOptionalDatastructureEntityIndexPrimitiveIDsFilename);
+    KATANA_CHECKED(
+        katana::FileStore(ids_path.string(), ids, num_ids * id_size));
+
+    Entry entry{property_name, is_node, num_ids, id_size, ids_path.BaseName()};
+    paths_[Key(property_name, is_node)] = entry.file;
+    if (!existing) {
+      entries_.emplace_back(std::move(entry));
+      return katana::ResultSuccess();
+    }
+
+    std::string replaced = std::move(existing->file);
+    *existing = std::move(entry);
+    if (auto res = katana::FileDelete(rdg_dir_path.string(), {replaced});
+        !res) {
+      KATANA_LOG_WARN(
+          "could not delete replaced entity index file {}: {}", replaced,
+          res.error());
+    }
+    return katana::ResultSuccess();
+  }
+
+  /// \returns the entry of the index over property_name, or nullptr
+  const Entry* FindIndex(const std::string& property_name, bool is_node) const {
+    for (const auto& entry : entries_) {
+      if (entry.property_name == property_name && entry.is_node == is_node) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Copy the ids of entry into ids, which holds entry.num_ids ids of
+  /// entry.id_size bytes each.
+  katana::Result<void> ReadIndex(
+      const katana::URI& rdg_dir_path, const Entry& entry, void* ids) const {
+    katana::FileView fv;
+    KATANA_CHECKED(fv.Bind(rdg_dir_path.Join(entry.file).string(), true));
+    if (fv.size() != entry.num_ids * entry.id_size) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "entity index file {} has {} bytes, expected {}", entry.file,
+          fv.size(), entry.num_ids * entry.id_size);
+    }
+    std::memcpy(ids, fv.ptr<uint8_t>(), fv.size());
+    KATANA_CHECKED(fv.Unbind());
+    return katana::ResultSuccess();
+  }
+
+  const std::vector<Entry>& entries() const { return entries_; }
+
+  friend void to_json(nlohmann::json& j, const EntityIndexPrimitive& index);
+  friend void from_json(const nlohmann::json& j, EntityIndexPrimitive& index);
+
+private:
+  std::vector<Entry> entries_;
+
+  Entry* FindEntry(const std::string& property_name, bool is_node) {
+    for (auto& entry : entries_) {
+      if (entry.property_name == property_name && entry.is_node == is_node) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Whether the file of entry exists and holds exactly ids
+  bool HoldsIds(
+      const katana::URI& rdg_dir_path, const Entry& entry,
+      const void* ids) const {
+    katana::FileView fv;
+    if (!fv.Bind(rdg_dir_path.Join(entry.file).string(), true)) {
+      return false;
+    }
+    uint64_t num_bytes = entry.num_ids * entry.id_size;
+    bool same = fv.size() == num_bytes &&
+                (num_bytes == 0 ||
+                 std::memcmp(fv.ptr<uint8_t>(), ids, num_bytes) == 0);
+    if (!fv.Unbind()) {
+      return false;
+    }
+    return same;
+  }
+
+  static std::string Key(const std::string& property_name, bool is_node) {
+    return (is_node ? "node:" : "edge:") + property_name;
+  }
+
+  static katana::Result<EntityIndexPrimitive> LoadJson(
+      const std::string& path) {
+    katana::FileView fv;
+    KATANA_CHECKED(fv.Bind(path, true));
+
+    if (fv.size() == 0) {
+      return EntityIndexPrimitive();
+    }
+
+    EntityIndexPrimitive index;
+    KATANA_CHECKED(katana::JsonParse<EntityIndexPrimitive>(fv, &index));
+
+    return index;
+  }
+
+  katana::Result<void> WriteManifest(const std::string& path) const {
+    std::string serialized = KATANA_CHECKED(katana::JsonDump(*this));
+    // POSIX files end with newlines
+    serialized = serialized + "\n";
+
+    auto ff = std::make_unique<katana::FileFrame>();
+    KATANA_CHECKED(ff->Init(serialized.size()));
+    if (auto res = ff->Write(serialized.data(), serialized.size()); !res.ok()) {
+      return KATANA_ERROR(
+          katana::ArrowToKatana(res.code()), "arrow error: {}", res);
+    }
+    ff->Bind(path);
+    // persist now
+    KATANA_CHECKED(ff->Persist());
+
+    return katana::ResultSuccess();
+  }
+};
+
+}  // namespace katana
+
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <cstddef>
 #include <optional>
@@ -121,6 +122,9 @@ public:
     for (size_t i = 0; i < num_entity_types; i++) {
       entity_type_id_to_atomic_entity_type_ids_.at(i).resize(set_size);
     }
+    SetOfEntityTypeIDsSize_ = set_size;
+
+    BuildSupertypeMap();
   }
 
   EntityTypeManager(
@@ -149,6 +153,8 @@ public:
     //Must ensure all sets are at least big enough to fit all EntityTypeIDs
     size_t num_entity_types = entity_type_id_to_atomic_entity_type_ids_.size();
     ResizeSetOfEntityTypeIDsMaps(num_entity_types - 1);
+
+    BuildSupertypeMap();
   }
 
   static Result<katana::EntityTypeManager> Make(
@@ -569,17 +575,58 @@ public:
     return entity_type_id_to_atomic_entity_type_ids_.at(entity_type_id);
   }
 
+  /// \returns the set of entity types that the entity type \p entity_type_id
+  /// is a sub-type of, including itself; unlike GetSupertypes, this is defined
+  /// for non-atomic types too
+  /// (assumes that the entity type exists)
+  const SetOfEntityTypeIDs& GetAllSupertypes(
+      EntityTypeID entity_type_id) const {
+    return entity_type_id_to_supertype_ids_.at(entity_type_id);
+  }
+
+  /// \returns the set of entity types that are a super-type of any of the
+  /// entity types in \p entity_type_ids, i.e., the types of the entities
+  /// that have one of \p entity_type_ids. Types that do not exist are
+  /// ignored.
+  SetOfEntityTypeIDs GetSupertypesOfAny(
+      const SetOfEntityTypeIDs& entity_type_ids) const;
+
   /// \returns true iff the type \p sub_type is a
-  /// sub-type of the type \p super_type
-  /// (assumes that the sub_type and super_type EntityTypeIDs exists)
+  /// sub-type of the type \p super_type; false if either of them does not
+  /// exist
   bool IsSubtypeOf(EntityTypeID sub_type, EntityTypeID super_type) const {
-    const auto& super_atomic_types = GetAtomicSubtypes(super_type);
-    const auto& sub_atomic_types = GetAtomicSubtypes(sub_type);
-    // return true if sub_atomic_types is a subset of super_atomic_types
-    SetOfEntityTypeIDs res;
-    res.resize(SetOfEntityTypeIDsSize_);
-    res.bitwise_and(sub_atomic_types, super_atomic_types);
-    return (res == sub_atomic_types);
+    if (!HasEntityType(sub_type) || !HasEntityType(super_type)) {
+      return false;
+    }
+    return entity_type_id_to_supertype_ids_.at(sub_type).test(super_type);
+  }
+
+  /// Tests a batch of up to 64 entity types against a set at once, which is
+  /// cheaper than testing them one by one. Together with GetSupertypesOfAny,
+  /// this tests whether entities have any of a set of types.
+  ///
+  /// \returns a word whose bit i is set iff \p entity_type_ids[i] is in
+  /// \p types, for the \p n <= 64 entity types starting at
+  /// \p entity_type_ids. Types outside of \p types, like kInvalidEntityType,
+  /// never match.
+  static uint64_t MatchEntityTypes(
+      const SetOfEntityTypeIDs& types, const EntityTypeID* entity_type_ids,
+      size_t n) {
+    KATANA_LOG_DEBUG_ASSERT(n <= SetOfEntityTypeIDs::kNumBitsInUint64);
+    const auto& words = types.get_vec();
+    size_t num_types = types.size();
+    uint64_t bits = 0;
+    for (size_t i = 0; i < n; ++i) {
+      size_t type = entity_type_ids[i];
+      uint64_t word =
+          type < num_types
+              ? words[type / SetOfEntityTypeIDs::kNumBitsInUint64].load(
+                    std::memory_order_relaxed)
+              : 0;
+      bits |= ((word >> (type % SetOfEntityTypeIDs::kNumBitsInUint64)) & 1)
+              << i;
+    }
+    return bits;
   }
 
   const EntityTypeIDToSetOfEntityTypeIDsMap&
@@ -685,6 +732,19 @@ private:
     KATANA_LOG_ASSERT(id.value() == kUnknownEntityType);
   }
 
+  /// Add the super-types of the newest entity type \p new_entity_type_id to
+  /// entity_type_id_to_supertype_ids_, and add it as a super-type of the
+  /// existing types that are its sub-types
+  void AddSupertypes(EntityTypeID new_entity_type_id);
+
+  /// Build entity_type_id_to_supertype_ids_ from
+  /// entity_type_id_to_atomic_entity_type_ids_
+  void BuildSupertypeMap();
+
+  /// The super-types of \p entity_type_id, from
+  /// atomic_entity_type_id_to_entity_type_ids_
+  SetOfEntityTypeIDs ComputeSupertypes(EntityTypeID entity_type_id) const;
+
   /// The current size of the SetEntityTypeIDs bitsets
   size_t SetOfEntityTypeIDsSize_ = kDefaultSetOfEntityTypeIDsSize;
 
@@ -713,6 +773,13 @@ private:
   /// ex: atomic_entity_type_id_to_entity_type_ids_[atomic_id][atomic_id] == 1
   /// but atomic_entity_type_id_to_entity_type_ids_[non_atomic_id][non_atomic_id] == 0
   EntityTypeIDToSetOfEntityTypeIDsMap atomic_entity_type_id_to_entity_type_ids_;
+
+  /// A map from the EntityTypeID to its super-types
+  /// (to the set of the EntityTypeIDs whose atomic types include its atomic
+  /// types): derived from entity_type_id_to_atomic_entity_type_ids_
+  /// Precomputed so that IsSubtypeOf is a single bit test; every EntityTypeID
+  /// is a super-type of itself and of kUnknownEntityType
+  EntityTypeIDToSetOfEntityTypeIDsMap entity_type_id_to_supertype_ids_;
 };
 
 }  // namespace katana
@@ -64,7 +64,8 @@ private:
 
   std::shared_ptr<parquet::WriterProperties> StandardWriterProperties();
 
-  std::shared_ptr<parquet::ArrowWriterProperties> StandardArrowProperties();
+  std::shared_ptr<parquet::ArrowWriterProperties> StandardArrowProperties(
+      const arrow::Schema& schema);
 
   katana::Result<void> StoreParquet(
       const katana::URI& uri, katana::WriteGroup* desc);
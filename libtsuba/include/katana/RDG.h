@@ -12,6 +12,7 @@
 #include <nlohmann/json.hpp>
 
 #include "katana/Cache.h"
+#include "katana/EntityIndexPrimitive.h"
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/FileFrame.h"
@@ -333,6 +334,13 @@ public:
   katana::Result<void> WriteRDKSubstructureIndexPrimitive(
       katana::RDKSubstructureIndexPrimitive& index);
 
+  // Returns std::nullopt if no entity index was stored with this RDG
+  katana::Result<std::optional<katana::EntityIndexPrimitive>>
+  LoadEntityIndexPrimitive();
+
+  katana::Result<void> WriteEntityIndexPrimitive(
+      katana::EntityIndexPrimitive& index);
+
 private:
   std::string view_type_;
   RDG(std::unique_ptr<RDGCore>&& core);
@@ -44,7 +44,13 @@ public:
     kInvalid = -1,
     kAny = 0,
     kSortedByDegree,
-    kSortedByNodeType
+    kSortedByNodeType,
+    // Locality-improving reorderings, see katana/GraphReordering.h
+    kReverseCuthillMcKee,
+    kHubSorted,
+    kHubClustered,
+    kGorder,
+    kRabbitOrder
   };
 
   enum class TopologyKind : int {
@@ -3,6 +3,29 @@
 #include "katana/Logging.h"
 #include "katana/Result.h"
 
+namespace {
+
+/// \returns true iff every element of \p sub is in \p super
+bool
+IsSubsetOf(
+    const katana::SetOfEntityTypeIDs& sub,
+    const katana::SetOfEntityTypeIDs& super) {
+  const auto& sub_words = sub.get_vec();
+  const auto& super_words = super.get_vec();
+  for (size_t i = 0; i < sub_words.size(); ++i) {
+    uint64_t sub_word = sub_words[i].load(std::memory_order_relaxed);
+    uint64_t super_word = i < super_words.size()
+                              ? super_words[i].load(std::memory_order_relaxed)
+                              : 0;
+    if ((sub_word & ~super_word) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 //TODO(emcginnis): while this logic works and technically saves cycles by avoiding
 // looping through all of the sets too frequently, its cumbersome and likely not worth it
 // simplify to just resizing as we need to, and let the reserve functionality in the backend
@@ -170,6 +193,7 @@ katana::EntityTypeManager::AddNonAtomicEntityType(
           .set(new_entity_type_id);
     }
   }
+  AddSupertypes(new_entity_type_id);
 
   // Ideally this would return an error instead of failing. But checking is
   // probably too slow. Remember kids, fast is more important than correct.
@@ -263,6 +287,7 @@ katana::EntityTypeManager::AddAtomicEntityType(const std::string& name) {
   entity_type_ids.set(new_entity_type_id);
   entity_type_id_to_atomic_entity_type_ids_.emplace_back(entity_type_ids);
   atomic_entity_type_id_to_entity_type_ids_.emplace_back(entity_type_ids);
+  AddSupertypes(new_entity_type_id);
 
   return MakeResult(std::move(new_entity_type_id));
 }
@@ -310,11 +335,98 @@ katana::EntityTypeManager::ResizeSetOfEntityTypeIDsMaps(
           atomic_entity_type_id_to_entity_type_ids_[i].size(), i);
       atomic_entity_type_id_to_entity_type_ids_[i].resize(new_size);
     }
+    for (auto& supertypes : entity_type_id_to_supertype_ids_) {
+      supertypes.resize(new_size);
+    }
 
     SetOfEntityTypeIDsSize_ = new_size;
   }
 }
 
+katana::SetOfEntityTypeIDs
+katana::EntityTypeManager::ComputeSupertypes(
+    katana::EntityTypeID entity_type_id) const {
+  // The super-types of a type are the types that have all of its atomic
+  // types, i.e., the intersection of the types of each of its atomic types
+  SetOfEntityTypeIDs supertypes;
+  bool has_atomic_types = false;
+  for (size_t atomic_type :
+       entity_type_id_to_atomic_entity_type_ids_.at(entity_type_id)) {
+    const auto& types =
+        atomic_entity_type_id_to_entity_type_ids_.at(atomic_type);
+    if (has_atomic_types) {
+      supertypes.bitwise_and(types);
+    } else {
+      supertypes = types;
+      has_atomic_types = true;
+    }
+  }
+
+  // Every type has all of the atomic types of a type with none
+  if (!has_atomic_types) {
+    supertypes.resize(SetOfEntityTypeIDsSize_);
+    for (size_t i = 0; i < GetNumEntityTypes(); ++i) {
+      supertypes.set(i);
+    }
+  }
+  return supertypes;
+}
+
+void
+katana::EntityTypeManager::AddSupertypes(
+    katana::EntityTypeID new_entity_type_id) {
+  KATANA_LOG_DEBUG_ASSERT(
+      entity_type_id_to_supertype_ids_.size() == new_entity_type_id);
+  const auto& new_atomic_types =
+      entity_type_id_to_atomic_entity_type_ids_.at(new_entity_type_id);
+
+  // The sub-types of the new type are kUnknownEntityType, which has no
+  // atomic types, and types whose atomic types it all has, which share one
+  // with it. Only those are tested rather than every existing type, so that
+  // adding an atomic type, which shares none, does not scan them all.
+  if (new_entity_type_id != kUnknownEntityType) {
+    entity_type_id_to_supertype_ids_.at(kUnknownEntityType)
+        .set(new_entity_type_id);
+  }
+  SetOfEntityTypeIDs candidates;
+  candidates.resize(SetOfEntityTypeIDsSize_);
+  for (size_t atomic_type : new_atomic_types) {
+    candidates.bitwise_or(
+        atomic_entity_type_id_to_entity_type_ids_.at(atomic_type));
+  }
+  for (size_t i : candidates) {
+    if (i != new_entity_type_id &&
+        IsSubsetOf(
+            entity_type_id_to_atomic_entity_type_ids_[i], new_atomic_types)) {
+      entity_type_id_to_supertype_ids_[i].set(new_entity_type_id);
+    }
+  }
+  entity_type_id_to_supertype_ids_.emplace_back(
+      ComputeSupertypes(new_entity_type_id));
+}
+
+void
+katana::EntityTypeManager::BuildSupertypeMap() {
+  entity_type_id_to_supertype_ids_.clear();
+  entity_type_id_to_supertype_ids_.reserve(GetNumEntityTypes());
+  for (size_t i = 0; i < GetNumEntityTypes(); ++i) {
+    entity_type_id_to_supertype_ids_.emplace_back(ComputeSupertypes(i));
+  }
+}
+
+katana::SetOfEntityTypeIDs
+katana::EntityTypeManager::GetSupertypesOfAny(
+    const katana::SetOfEntityTypeIDs& entity_type_ids) const {
+  SetOfEntityTypeIDs res;
+  res.resize(SetOfEntityTypeIDsSize_);
+  for (size_t type : entity_type_ids) {
+    if (HasEntityType(type)) {
+      res.bitwise_or(entity_type_id_to_supertype_ids_[type]);
+    }
+  }
+  return res;
+}
+
 // helper function for ToString
 // Converts a SetOfEntityTypeIDs to its integer represenation
 size_t
@@ -1,11 +1,16 @@
 #include "katana/ParquetReader.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <vector>
 
+#include <arrow/array/array_dict.h>
 #include <arrow/array/util.h>
 #include <arrow/chunked_array.h>
+#include <arrow/compute/api_vector.h>
 #include <arrow/compute/cast.h>
 #include <arrow/type.h>
 #include <arrow/type_fwd.h>
@@ -22,6 +27,37 @@ using ErrorCode = katana::ErrorCode;
 
 namespace {
 
+struct SortedDictionary {
+  std::shared_ptr<arrow::Array> dictionary;
+  /// ranks[code] is the position of the string of code in dictionary
+  std::shared_ptr<arrow::Array> ranks;
+};
+
+/// Sort the strings of dictionary
+katana::Result<SortedDictionary>
+SortDictionary(const arrow::LargeStringArray& dictionary) {
+  // Dictionaries are small, so they are sorted serially
+  std::vector<int64_t> order(dictionary.length());
+  std::iota(order.begin(), order.end(), int64_t{0});
+  std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+    return dictionary.GetView(a) < dictionary.GetView(b);
+  });
+
+  arrow::LargeStringBuilder builder;
+  std::vector<int64_t> ranks(order.size());
+  for (size_t rank = 0; rank < order.size(); ++rank) {
+    KATANA_CHECKED(builder.Append(dictionary.GetView(order[rank])));
+    ranks[order[rank]] = rank;
+  }
+  arrow::Int64Builder ranks_builder;
+  KATANA_CHECKED(ranks_builder.AppendValues(ranks));
+
+  SortedDictionary sorted;
+  KATANA_CHECKED(builder.Finish(&sorted.dictionary));
+  KATANA_CHECKED(ranks_builder.Finish(&sorted.ranks));
+  return sorted;
+}
+
 katana::Result<std::shared_ptr<arrow::ChunkedArray>>
 HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
   switch (old_array->type()->id()) {
@@ -39,6 +75,49 @@ HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
         KATANA_CHECKED(arrow::compute::Cast(old_array, opts));
     return cast_res.chunked_array();
   }
+  case arrow::Type::type::DICTIONARY: {
+    // Row groups are read with dictionaries of their own, which must be the
+    // same dictionary before chunks can be combined
+    auto unified = KATANA_CHECKED(
+        arrow::DictionaryUnifier::UnifyChunkedArray(old_array));
+    const auto& type =
+        static_cast<const arrow::DictionaryType&>(*unified->type());
+    if (type.value_type()->id() != arrow::Type::type::STRING &&
+        type.value_type()->id() != arrow::Type::type::LARGE_STRING) {
+      return unified;
+    }
+    auto new_type = arrow::dictionary(type.index_type(), arrow::large_utf8());
+    std::vector<std::shared_ptr<arrow::Array>> chunks;
+    if (unified->num_chunks() == 0) {
+      return std::make_shared<arrow::ChunkedArray>(chunks, new_type);
+    }
+
+    auto opts = arrow::compute::CastOptions();
+    opts.to_type = arrow::large_utf8();
+    arrow::Datum dictionary = KATANA_CHECKED(arrow::compute::Cast(
+        static_cast<const arrow::DictionaryArray&>(*unified->chunk(0))
+            .dictionary(),
+        opts));
+    // Unifying appends the strings of later row groups to the dictionary, so
+    // it is sorted again for codes to compare like their strings
+    std::shared_ptr<arrow::Array> strings = dictionary.make_array();
+    SortedDictionary sorted = KATANA_CHECKED(SortDictionary(
+        static_cast<const arrow::LargeStringArray&>(*strings)));
+
+    auto index_opts = arrow::compute::CastOptions();
+    index_opts.to_type = type.index_type();
+    for (const auto& chunk : unified->chunks()) {
+      const auto& dict_chunk =
+          static_cast<const arrow::DictionaryArray&>(*chunk);
+      arrow::Datum ranks = KATANA_CHECKED(
+          arrow::compute::Take(sorted.ranks, dict_chunk.indices()));
+      arrow::Datum indices =
+          KATANA_CHECKED(arrow::compute::Cast(ranks, index_opts));
+      chunks.emplace_back(std::make_shared<arrow::DictionaryArray>(
+          new_type, indices.make_array(), sorted.dictionary));
+    }
+    return std::make_shared<arrow::ChunkedArray>(chunks, new_type);
+  }
   default:
     return old_array;
   }
@@ -51,6 +130,16 @@ HandleBadParquetTypes(std::shared_ptr<arrow::Field> old_field) {
     return std::make_shared<arrow::Field>(
         old_field->name(), arrow::large_utf8());
   }
+  case arrow::Type::type::DICTIONARY: {
+    const auto& type =
+        static_cast<const arrow::DictionaryType&>(*old_field->type());
+    if (type.value_type()->id() != arrow::Type::type::STRING) {
+      return old_field;
+    }
+    return std::make_shared<arrow::Field>(
+        old_field->name(),
+        arrow::dictionary(type.index_type(), arrow::large_utf8()));
+  }
   default:
     return old_field;
   }
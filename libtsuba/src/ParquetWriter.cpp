@@ -142,8 +142,19 @@ katana::ParquetWriter::StandardWriterProperties() {
 }
 
 std::shared_ptr<parquet::ArrowWriterProperties>
-katana::ParquetWriter::StandardArrowProperties() {
-  return parquet::ArrowWriterProperties::Builder().build();
+katana::ParquetWriter::StandardArrowProperties(const arrow::Schema& schema) {
+  parquet::ArrowWriterProperties::Builder builder;
+  // Storing the arrow schema keeps the dictionary encoding of columns when
+  // they are read back, rather than decoding the dictionary pages to strings.
+  // Only tables with dictionaries store it, so that the types that other
+  // tables are read back with do not change.
+  for (const auto& field : schema.fields()) {
+    if (field->type()->id() == arrow::Type::DICTIONARY) {
+      builder.store_schema();
+      break;
+    }
+  }
+  return builder.build();
 }
 
 /// Store the arrow table in a file
@@ -152,7 +163,7 @@ katana::ParquetWriter::StoreParquet(
     std::shared_ptr<arrow::Table> table, const katana::URI& uri,
     katana::WriteGroup* desc) {
   auto writer_props = StandardWriterProperties();
-  auto arrow_props = StandardArrowProperties();
+  auto arrow_props = StandardArrowProperties(*table->schema());
   std::string prefix = uri.string();
 
   if (table->num_rows() <= kMaxRowsPerFile) {
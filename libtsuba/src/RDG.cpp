@@ -1129,6 +1129,36 @@ katana::RDG::WriteRDKSubstructureIndexPrimitive(
   return katana::ResultSuccess();
 }
 
+katana::Result<std::optional<katana::EntityIndexPrimitive>>
+katana::RDG::LoadEntityIndexPrimitive() {
+  // Most RDGs have no entity index, so check quietly before asking for the
+  // manifest
+  if (core_->part_header().optional_datastructure_manifests().count(
+          kOptionalDatastructureEntityIndexPrimitive) == 0) {
+    return std::nullopt;
+  }
+  std::optional<std::string> res =
+      KATANA_CHECKED(core_->part_header().OptionalDatastructureManifest(
+          kOptionalDatastructureEntityIndexPrimitive));
+  if (!res) {
+    return std::nullopt;
+  }
+
+  katana::EntityIndexPrimitive index = KATANA_CHECKED_CONTEXT(
+      katana::EntityIndexPrimitive::Load(rdg_dir(), res.value()),
+      "Failed to load EntityIndexPrimitive located at {}", res.value());
+  return index;
+}
+
+katana::Result<void>
+katana::RDG::WriteEntityIndexPrimitive(katana::EntityIndexPrimitive& index) {
+  std::string path = KATANA_CHECKED(index.Write(rdg_dir()));
+  core_->part_header().AppendOptionalDatastructureManifest(
+      kOptionalDatastructureEntityIndexPrimitive, path);
+
+  return katana::ResultSuccess();
+}
+
 katana::RDG::RDG(std::unique_ptr<RDGCore>&& core) : core_(std::move(core)) {}
 
 katana::RDG::RDG() : core_(std::make_unique<RDGCore>()) {}
@@ -731,6 +731,36 @@ katana::to_json(
       {"paths", index.paths_}};
 }
 
+void
+katana::from_json(
+    const nlohmann::json& j, katana::EntityIndexPrimitive& index) {
+  index.entries_.clear();
+  for (const auto& entry : j.at("entries")) {
+    katana::EntityIndexPrimitive::Entry e;
+    entry.at("property_name").get_to(e.property_name);
+    entry.at("is_node").get_to(e.is_node);
+    entry.at("num_ids").get_to(e.num_ids);
+    entry.at("id_size").get_to(e.id_size);
+    entry.at("file").get_to(e.file);
+    index.entries_.emplace_back(std::move(e));
+  }
+  j.at("paths").get_to(index.paths_);
+}
+
+void
+katana::to_json(nlohmann::json& j, const katana::EntityIndexPrimitive& index) {
+  auto entries = nlohmann::json::array();
+  for (const auto& e : index.entries_) {
+    entries.push_back(nlohmann::json{
+        {"property_name", e.property_name},
+        {"is_node", e.is_node},
+        {"num_ids", e.num_ids},
+        {"id_size", e.id_size},
+        {"file", e.file}});
+  }
+  j = nlohmann::json{{"entries", entries}, {"paths", index.paths_}};
+}
+
 void
 katana::from_json(
     const nlohmann::json& j, katana::RDGOptionalDatastructure& data) {
@@ -13,6 +13,7 @@
 #include <arrow/api.h>
 
 #include "PartitionTopologyMetadata.h"
+#include "katana/EntityIndexPrimitive.h"
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/JSON.h"
@@ -437,7 +438,8 @@ public:
   void AppendOptionalDatastructureManifest(
       const std::string& optional_datastructure_name,
       const std::string& optional_datastructure_path) {
-    optional_datastructure_manifests_.emplace(
+    // A datastructure that is written again replaces its old manifest
+    optional_datastructure_manifests_.insert_or_assign(
         optional_datastructure_name, optional_datastructure_path);
     KATANA_LOG_DEBUG(
         "Appended optional datastructure manifest {}, at path {}, total count "
@@ -605,6 +607,9 @@ void from_json(const nlohmann::json& j, RDKLSHIndexPrimitive& index);
 void to_json(nlohmann::json& j, const RDKSubstructureIndexPrimitive& index);
 void from_json(const nlohmann::json& j, RDKSubstructureIndexPrimitive& index);
 
+void to_json(nlohmann::json& j, const EntityIndexPrimitive& index);
+void from_json(const nlohmann::json& j, EntityIndexPrimitive& index);
+
 void to_json(nlohmann::json& j, const RDGOptionalDatastructure& data);
 void from_json(const nlohmann::json& j, RDGOptionalDatastructure& data);
 
@@ -631,7 +636,12 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
     {{RDGTopology::NodeSortKind::kInvalid, "kInvalid"},
      {RDGTopology::NodeSortKind::kAny, "kAny"},
      {RDGTopology::NodeSortKind::kSortedByDegree, "kSortedByDegree"},
-     {RDGTopology::NodeSortKind::kSortedByNodeType, "kSortedByNodeType"}})
+     {RDGTopology::NodeSortKind::kSortedByNodeType, "kSortedByNodeType"},
+     {RDGTopology::NodeSortKind::kReverseCuthillMcKee, "kReverseCuthillMcKee"},
+     {RDGTopology::NodeSortKind::kHubSorted, "kHubSorted"},
+     {RDGTopology::NodeSortKind::kHubClustered, "kHubClustered"},
+     {RDGTopology::NodeSortKind::kGorder, "kGorder"},
+     {RDGTopology::NodeSortKind::kRabbitOrder, "kRabbitOrder"}})
 
 NLOHMANN_JSON_SERIALIZE_ENUM(
     RDGTopology::TopologyKind,
@@ -1,3 +1,7 @@
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
 #include <arrow/chunked_array.h>
 #include <arrow/type_fwd.h>
 
@@ -38,10 +42,94 @@ TestLargeStringRoundTrip(const std::string& dir) {
   return katana::ResultSuccess();
 }
 
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeDictionaryChunk(
+    const std::vector<std::string>& dictionary,
+    const std::vector<int32_t>& codes) {
+  arrow::LargeStringBuilder dictionary_builder;
+  KATANA_CHECKED(dictionary_builder.AppendValues(dictionary));
+  std::shared_ptr<arrow::Array> dictionary_array;
+  KATANA_CHECKED(dictionary_builder.Finish(&dictionary_array));
+
+  arrow::Int32Builder codes_builder;
+  KATANA_CHECKED(codes_builder.AppendValues(codes));
+  std::shared_ptr<arrow::Array> codes_array;
+  KATANA_CHECKED(codes_builder.Finish(&codes_array));
+
+  return std::make_shared<arrow::DictionaryArray>(
+      arrow::dictionary(arrow::int32(), arrow::large_utf8()), codes_array,
+      dictionary_array);
+}
+
+/// A table with a dictionary column, whose chunks have different sorted
+/// dictionaries, next to columns of other types
+katana::Result<void>
+TestDictionaryRoundTrip(const std::string& dir) {
+  auto uri = KATANA_CHECKED(katana::URI::Make(dir)).Join("dictionary.parquet");
+
+  std::vector<std::string> expected = {"us", "jp", "us", "us", "br", "fr"};
+  auto dictionary_column = std::make_shared<arrow::ChunkedArray>(
+      std::vector<std::shared_ptr<arrow::Array>>{
+          KATANA_CHECKED(MakeDictionaryChunk({"jp", "us"}, {1, 0, 1})),
+          KATANA_CHECKED(MakeDictionaryChunk({"br", "fr", "us"}, {2, 0, 1})),
+      });
+
+  arrow::Int32Builder int_builder;
+  KATANA_CHECKED(int_builder.AppendValues({0, 1, 2, 3, 4, 5}));
+  std::shared_ptr<arrow::Array> ints;
+  KATANA_CHECKED(int_builder.Finish(&ints));
+
+  auto strings = KATANA_CHECKED(MakeArrayOfStrings());
+  auto table = arrow::Table::Make(
+      arrow::schema({
+          arrow::field("dictionary", dictionary_column->type()),
+          arrow::field("int", arrow::int32()),
+          arrow::field("string", arrow::large_utf8()),
+      }),
+      {dictionary_column, std::make_shared<arrow::ChunkedArray>(ints),
+       strings->Slice(0, expected.size())});
+
+  auto writer = KATANA_CHECKED(katana::ParquetWriter::Make(table));
+  KATANA_CHECKED(writer->WriteToUri(uri));
+
+  auto reader = KATANA_CHECKED(katana::ParquetReader::Make());
+  auto read_table = KATANA_CHECKED(reader->ReadTable(uri));
+
+  KATANA_LOG_ASSERT(read_table->num_columns() == 3);
+  KATANA_LOG_ASSERT(read_table->column(0)->type()->Equals(
+      arrow::dictionary(arrow::int32(), arrow::large_utf8())));
+  KATANA_LOG_ASSERT(read_table->column(1)->type()->Equals(arrow::int32()));
+  KATANA_LOG_ASSERT(
+      read_table->column(2)->type()->Equals(arrow::large_utf8()));
+  KATANA_LOG_ASSERT(read_table->column(1)->Equals(table->column(1)));
+  KATANA_LOG_ASSERT(read_table->column(2)->Equals(table->column(2)));
+
+  // The values are the same, and the dictionary is sorted
+  size_t i = 0;
+  for (const auto& chunk : read_table->column(0)->chunks()) {
+    const auto& array = static_cast<const arrow::DictionaryArray&>(*chunk);
+    const auto& dictionary =
+        static_cast<const arrow::LargeStringArray&>(*array.dictionary());
+    for (int64_t code = 1; code < dictionary.length(); ++code) {
+      KATANA_LOG_ASSERT(
+          dictionary.GetView(code - 1) < dictionary.GetView(code));
+    }
+    for (int64_t row = 0; row < array.length(); ++row) {
+      KATANA_LOG_ASSERT(
+          dictionary.GetString(array.GetValueIndex(row)) == expected[i++]);
+    }
+  }
+  KATANA_LOG_ASSERT(i == expected.size());
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 TestAll(const std::string& dir) {
   KATANA_CHECKED_CONTEXT(
       TestLargeStringRoundTrip(dir), "TestLargeStringRoundTrip");
+  KATANA_CHECKED_CONTEXT(
+      TestDictionaryRoundTrip(dir), "TestDictionaryRoundTrip");
 
   return katana::ResultSuccess();
 }
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "katana/EntityTypeManager.h"
 #include "katana/Logging.h"
 
@@ -51,6 +53,13 @@ ValidateConstructor() {
     KATANA_LOG_ASSERT(res);
   }
 
+  // Types that do not exist are not sub-types or super-types of any type
+  katana::EntityTypeID num_types = mgr.GetNumEntityTypes();
+  KATANA_LOG_ASSERT(!mgr.IsSubtypeOf(num_types, katana::kUnknownEntityType));
+  KATANA_LOG_ASSERT(!mgr.IsSubtypeOf(katana::kUnknownEntityType, num_types));
+  KATANA_LOG_ASSERT(
+      !mgr.IsSubtypeOf(katana::kInvalidEntityType, katana::kInvalidEntityType));
+
   katana::EntityTypeIDToAtomicTypeNameMap name_map(
       mgr.GetEntityTypeIDToAtomicTypeNameMap());
   katana::EntityTypeIDToSetOfEntityTypeIDsMap id_map(
@@ -67,8 +76,116 @@ ValidateConstructor() {
   }
 }
 
+/// \returns true iff the atomic types of sub_type are atomic types of
+/// super_type, computed from the atomic types rather than the supertype map
+bool
+IsSubtypeOfSlow(
+    const katana::EntityTypeManager& mgr, katana::EntityTypeID sub_type,
+    katana::EntityTypeID super_type) {
+  const auto& sub_atomic_types = mgr.GetAtomicSubtypes(sub_type);
+  const auto& super_atomic_types = mgr.GetAtomicSubtypes(super_type);
+  for (size_t i = 0; i < sub_atomic_types.size(); ++i) {
+    if (sub_atomic_types.test(i) && !super_atomic_types.test(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+CheckSubtypes(const katana::EntityTypeManager& mgr) {
+  for (size_t sub = 0; sub < mgr.GetNumEntityTypes(); ++sub) {
+    for (size_t super = 0; super < mgr.GetNumEntityTypes(); ++super) {
+      KATANA_LOG_VASSERT(
+          mgr.IsSubtypeOf(sub, super) == IsSubtypeOfSlow(mgr, sub, super),
+          "sub={} super={}", sub, super);
+    }
+  }
+}
+
+void
+ValidateSubtypes() {
+  std::vector<katana::TypeNameSet> tnss = {
+      {"alice"},
+      {"baker"},
+      {"alice", "baker"},
+      {"charlie"},
+      {"alice", "baker", "charlie"},
+      {"david", "eleanor"}};
+  katana::EntityTypeManager mgr;
+  for (const auto& tns : tnss) {
+    auto res = mgr.GetOrAddNonAtomicEntityTypeFromStrings(tns);
+    KATANA_LOG_ASSERT(res);
+  }
+  CheckSubtypes(mgr);
+
+  // Types added out of order have to update the supertypes of existing types
+  auto res = mgr.GetOrAddNonAtomicEntityTypeFromStrings(
+      katana::TypeNameSet{"baker", "charlie"});
+  KATANA_LOG_ASSERT(res);
+  CheckSubtypes(mgr);
+
+  katana::EntityTypeIDToAtomicTypeNameMap name_map(
+      mgr.GetEntityTypeIDToAtomicTypeNameMap());
+  katana::EntityTypeIDToSetOfEntityTypeIDsMap id_map(
+      mgr.GetEntityTypeIDToAtomicEntityTypeIDs());
+  katana::EntityTypeManager mgr_copy(std::move(name_map), std::move(id_map));
+  CheckSubtypes(mgr_copy);
+
+  katana::EntityTypeID alice = mgr.GetEntityTypeID("alice");
+  katana::EntityTypeID charlie = mgr.GetEntityTypeID("charlie");
+  katana::SetOfEntityTypeIDs types;
+  types.resize(mgr.SetOfEntityTypeIDsSize());
+  types.set(alice);
+  types.set(charlie);
+  katana::SetOfEntityTypeIDs supertypes = mgr.GetSupertypesOfAny(types);
+  for (size_t t = 0; t < mgr.GetNumEntityTypes(); ++t) {
+    KATANA_LOG_VASSERT(
+        supertypes.test(t) ==
+            (mgr.IsSubtypeOf(alice, t) || mgr.IsSubtypeOf(charlie, t)),
+        "t={}", t);
+  }
+
+  // Batches that are not full words, and types that do not exist
+  std::vector<katana::EntityTypeID> entity_types;
+  for (size_t i = 0; i < 100; ++i) {
+    entity_types.emplace_back(i % (mgr.GetNumEntityTypes() + 1));
+  }
+  entity_types.emplace_back(katana::kInvalidEntityType);
+  for (size_t begin = 0; begin < entity_types.size(); begin += 64) {
+    size_t n = std::min(size_t{64}, entity_types.size() - begin);
+    uint64_t bits = katana::EntityTypeManager::MatchEntityTypes(
+        supertypes, entity_types.data() + begin, n);
+    for (size_t i = 0; i < 64; ++i) {
+      katana::EntityTypeID type = i < n ? entity_types[begin + i] : 0;
+      bool expected = i < n && mgr.HasEntityType(type) && supertypes.test(type);
+      KATANA_LOG_VASSERT(
+          ((bits >> i) & 1) == expected, "entity {} of type {}", begin + i,
+          type);
+    }
+  }
+}
+
+void
+ValidateManyAtomicTypes() {
+  // Enough types to resize the sets, mixing atomic and non-atomic ones
+  katana::EntityTypeManager mgr;
+  for (size_t i = 0; i < 300; ++i) {
+    auto res = mgr.AddAtomicEntityType(fmt::format("t{}", i));
+    KATANA_LOG_ASSERT(res);
+    if (i % 50 == 49) {
+      katana::TypeNameSet pair{
+          fmt::format("t{}", i - 1), fmt::format("t{}", i)};
+      KATANA_LOG_ASSERT(mgr.GetOrAddNonAtomicEntityTypeFromStrings(pair));
+    }
+  }
+  CheckSubtypes(mgr);
+}
+
 int
 main() {
   CreateEntityTypeIDs();
   ValidateConstructor();
+  ValidateSubtypes();
+  ValidateManyAtomicTypes();
 }
@@ -0,0 +1,184 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2020, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/closeness_centrality/closeness_centrality.h"
+
+using namespace katana::analytics;
+
+constexpr static const char* const name = "Closeness Centrality";
+constexpr static const char* const desc =
+    "Computes the closeness or harmonic centrality of every node.";
+static const char* url = "closeness_centrality";
+
+namespace cll = llvm::cl;
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<ClosenessCentralityPlan::Algorithm> algo(
+    "algo", cll::desc("Choose an algorithm (default value Exact):"),
+    cll::values(
+        clEnumValN(
+            ClosenessCentralityPlan::kExact, "Exact",
+            "Exact batched BFS from every node"),
+        clEnumValN(
+            ClosenessCentralityPlan::kSampledPivots, "SampledPivots",
+            "Batched BFS from randomly sampled pivots"),
+        clEnumValN(
+            ClosenessCentralityPlan::kHyperBall, "HyperBall",
+            "HyperLogLog neighborhood size estimation")),
+    cll::init(ClosenessCentralityPlan::kExact));
+
+static cll::opt<bool> harmonic(
+    "harmonic",
+    cll::desc("Compute harmonic instead of closeness centrality (default "
+              "false)"),
+    cll::init(false));
+
+static cll::opt<uint32_t> numPivots(
+    "numPivots",
+    cll::desc("Number of pivots for SampledPivots (default value 256)"),
+    cll::init(ClosenessCentralityPlan::kDefaultNumPivots));
+
+static cll::opt<uint32_t> log2Registers(
+    "log2Registers",
+    cll::desc("Log2 of the number of HyperLogLog registers per node for "
+              "HyperBall (default value 6)"),
+    cll::init(ClosenessCentralityPlan::kDefaultLog2Registers));
+
+static cll::opt<uint32_t> maxIterations(
+    "maxIterations",
+    cll::desc("Maximum distance considered (default unbounded for Exact, "
+              "1000 otherwise)"),
+    cll::init(ClosenessCentralityPlan::kDefaultMaxIterations));
+
+std::string
+AlgorithmName(ClosenessCentralityPlan::Algorithm algorithm) {
+  switch (algorithm) {
+  case ClosenessCentralityPlan::kExact:
+    return "Exact";
+  case ClosenessCentralityPlan::kSampledPivots:
+    return "SampledPivots";
+  case ClosenessCentralityPlan::kHyperBall:
+    return "HyperBall";
+  default:
+    return "Unknown";
+  }
+}
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  auto res = katana::URI::Make(inputFile);
+  if (!res) {
+    KATANA_LOG_FATAL("input file {} error: {}", inputFile, res.error());
+  }
+  auto inputURI = res.value();
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputURI, edge_property_name);
+
+  std::cout << "Read " << pg->topology().NumNodes() << " nodes, "
+            << pg->topology().NumEdges() << " edges\n";
+
+  std::cout << "Running " << AlgorithmName(algo) << "\n";
+
+  std::unique_ptr<katana::PropertyGraph> pg_projected_view =
+      ProjectPropertyGraphForArguments(pg);
+
+  std::cout << "Projected graph has: "
+            << pg_projected_view->topology().NumNodes() << " nodes, "
+            << pg_projected_view->topology().NumEdges() << " edges\n";
+
+  ClosenessCentralityPlan plan;
+  switch (algo) {
+  case ClosenessCentralityPlan::kExact:
+    plan = maxIterations.getNumOccurrences() > 0
+               ? ClosenessCentralityPlan::Exact(maxIterations)
+               : ClosenessCentralityPlan::Exact();
+    break;
+  case ClosenessCentralityPlan::kSampledPivots:
+    plan = ClosenessCentralityPlan::SampledPivots(numPivots, maxIterations);
+    break;
+  case ClosenessCentralityPlan::kHyperBall:
+    plan = ClosenessCentralityPlan::HyperBall(log2Registers, maxIterations);
+    break;
+  default:
+    KATANA_LOG_FATAL("Invalid algorithm");
+  }
+
+  ClosenessCentralityMeasure measure =
+      harmonic ? ClosenessCentralityMeasure::kHarmonic
+               : ClosenessCentralityMeasure::kCloseness;
+
+  std::string output_property_name = "closeness_centrality";
+
+  katana::TxnContext txn_ctx;
+  if (auto r = ClosenessCentrality(
+          pg_projected_view.get(), output_property_name, &txn_ctx, measure,
+          plan);
+      !r) {
+    KATANA_LOG_FATAL("Failed to compute closeness centrality: {}", r.error());
+  }
+
+  auto stats_result = ClosenessCentralityStatistics::Compute(
+      pg_projected_view.get(), output_property_name);
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute closeness centrality statistics: {}",
+        stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    if (ClosenessCentralityAssertValid(
+            pg_projected_view.get(), output_property_name)) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed");
+    }
+  }
+
+  if (output) {
+    auto r = pg_projected_view->GetNodePropertyTyped<double>(
+        output_property_name);
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) ==
+        pg_projected_view->topology().NumNodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}
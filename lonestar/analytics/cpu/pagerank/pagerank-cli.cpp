@@ -46,6 +46,7 @@ static cll::opt<PagerankPlan::Algorithm> algo(
             PagerankPlan::kPullTopological, "PullTopological",
             "PullTopological"),
         clEnumValN(PagerankPlan::kPullResidual, "PullResidual", "PullResidual"),
+        clEnumValN(PagerankPlan::kPullBlocked, "PullBlocked", "PullBlocked"),
         clEnumValN(PagerankPlan::kPushSynchronous, "PushSync", "PushSync"),
         clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync")),
     cll::init(PagerankPlan::kPushAsynchronous));
@@ -0,0 +1,153 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+static const char* name = "Personalized Page Rank";
+static const char* url = nullptr;
+
+const char* desc =
+    "Computes the nodes with the highest personalized page rank for each "
+    "seed node using forward push.";
+
+using namespace katana::analytics;
+namespace cll = llvm::cl;
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+static cll::opt<std::string> seedsFile(
+    "seedsFile",
+    cll::desc("File containing whitespace separated list of seed nodes; each "
+              "seed is a separate query; if set, -seeds is ignored"));
+static cll::opt<std::string> seedsString(
+    "seeds",
+    cll::desc("String containing whitespace separated list of seed nodes; "
+              "each seed is a separate query (default value '0')"),
+    cll::init("0"));
+static cll::opt<unsigned int> topK(
+    "topK", cll::desc("Number of nodes to report per query (default 10)"),
+    cll::init(10));
+static cll::opt<float> epsilon(
+    "epsilon", cll::desc("Residual threshold per out-edge (default 1e-6)"),
+    cll::init(PersonalizedPagerankPlan::kDefaultEpsilon));
+static cll::opt<float> alpha(
+    "alpha", cll::desc("Probability of following an edge (default 0.85)"),
+    cll::init(PersonalizedPagerankPlan::kDefaultAlpha));
+
+static cll::opt<PersonalizedPagerankPlan::Algorithm> algo(
+    "algo", cll::desc("Choose an algorithm:"),
+    cll::values(
+        clEnumValN(
+            PersonalizedPagerankPlan::kForwardPush, "ForwardPush",
+            "Parallel forward push, one query at a time"),
+        clEnumValN(
+            PersonalizedPagerankPlan::kBatchedForwardPush,
+            "BatchedForwardPush", "Serial forward push, queries in parallel")),
+    cll::init(PersonalizedPagerankPlan::kBatchedForwardPush));
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer totalTime("TimerTotal");
+  totalTime.start();
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  auto res = katana::URI::Make(inputFile);
+  if (!res) {
+    KATANA_LOG_FATAL("input file {} error: {}", inputFile, res.error());
+  }
+  auto inputURI = res.value();
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputURI, edge_property_name);
+
+  std::cout << "Read " << pg->topology().NumNodes() << " nodes, "
+            << pg->topology().NumEdges() << " edges\n";
+
+  std::unique_ptr<katana::PropertyGraph> pg_projected_view =
+      ProjectPropertyGraphForArguments(pg);
+
+  std::cout << "Projected graph has: "
+            << pg_projected_view->topology().NumNodes() << " nodes, "
+            << pg_projected_view->topology().NumEdges() << " edges\n";
+
+  std::vector<uint32_t> seeds;
+  if (!seedsFile.getValue().empty()) {
+    std::ifstream file(seedsFile);
+    if (!file.good()) {
+      KATANA_LOG_FATAL("failed to open file: {}", seedsFile);
+    }
+    seeds.insert(
+        seeds.end(), std::istream_iterator<uint64_t>{file},
+        std::istream_iterator<uint64_t>{});
+  } else {
+    std::istringstream str(seedsString);
+    seeds.insert(
+        seeds.end(), std::istream_iterator<uint64_t>{str},
+        std::istream_iterator<uint64_t>{});
+  }
+
+  std::vector<std::vector<uint32_t>> seed_sets;
+  for (uint32_t seed : seeds) {
+    seed_sets.emplace_back(std::vector<uint32_t>{seed});
+  }
+  std::cout << "Running " << seed_sets.size() << " queries\n";
+
+  PersonalizedPagerankPlan plan =
+      algo == PersonalizedPagerankPlan::kForwardPush
+          ? PersonalizedPagerankPlan::ForwardPush(epsilon, alpha)
+          : PersonalizedPagerankPlan::BatchedForwardPush(epsilon, alpha);
+
+  auto top_k_result =
+      PersonalizedPagerankTopK(*pg_projected_view, seed_sets, topK, plan);
+  if (!top_k_result) {
+    KATANA_LOG_FATAL(
+        "Failed to run PersonalizedPagerank {}", top_k_result.error());
+  }
+  auto top_k = std::move(top_k_result.value());
+
+  for (size_t q = 0; q < seed_sets.size(); ++q) {
+    std::cout << "Seed " << seed_sets[q][0] << ":";
+    for (const auto& score : top_k[q]) {
+      std::cout << " " << score.node << "(" << score.rank << ")";
+    }
+    std::cout << "\n";
+  }
+
+  if (!skipVerify) {
+    for (size_t q = 0; q < seed_sets.size(); ++q) {
+      for (size_t i = 1; i < top_k[q].size(); ++i) {
+        if (top_k[q][i - 1].rank < top_k[q][i].rank) {
+          KATANA_LOG_FATAL("verification failed");
+        }
+      }
+    }
+    std::cout << "Verification successful.\n";
+  }
+
+  totalTime.stop();
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2020, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+
+#include "Lonestar/BoilerPlate.h"
+#include "katana/analytics/partition/partition.h"
+
+using namespace katana::analytics;
+
+constexpr static const char* const name = "Partition";
+constexpr static const char* const desc =
+    "Partitions the nodes of a graph into parts of about equal size while "
+    "minimizing the number of edges between parts.";
+static const char* url = "partition";
+
+namespace cll = llvm::cl;
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input file>"), cll::Required);
+
+static cll::opt<uint32_t> numPartitions(
+    "numPartitions", cll::desc("Number of partitions (default value 2)"),
+    cll::init(2));
+
+static cll::opt<double> imbalance(
+    "imbalance",
+    cll::desc("Allowed partition size above the average, as a fraction of the "
+              "average (default value 0.03)"),
+    cll::init(PartitionPlan::kDefaultImbalance));
+
+static cll::opt<uint32_t> refinementIterations(
+    "refinementIterations",
+    cll::desc("Maximum number of refinement passes per level (default value "
+              "8)"),
+    cll::init(PartitionPlan::kDefaultRefinementIterations));
+
+static cll::opt<uint32_t> coarseningThreshold(
+    "coarseningThreshold",
+    cll::desc("Stop coarsening at this many nodes per partition (default "
+              "value 32)"),
+    cll::init(PartitionPlan::kDefaultCoarseningThreshold));
+
+int
+main(int argc, char** argv) {
+  std::unique_ptr<katana::SharedMemSys> G =
+      LonestarStart(argc, argv, name, desc, url, &inputFile);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  if (!symmetricGraph) {
+    KATANA_LOG_FATAL(
+        "This application requires a symmetric graph input;"
+        " please use the -symmetricGraph flag "
+        " to indicate the input is a symmetric graph.");
+  }
+
+  std::cout << "Reading from file: " << inputFile << "\n";
+  auto res = katana::URI::Make(inputFile);
+  if (!res) {
+    KATANA_LOG_FATAL("input file {} error: {}", inputFile, res.error());
+  }
+  auto inputURI = res.value();
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeFileGraph(inputURI, edge_property_name);
+
+  std::cout << "Read " << pg->topology().NumNodes() << " nodes, "
+            << pg->topology().NumEdges() << " edges\n";
+
+  std::unique_ptr<katana::PropertyGraph> pg_projected_view =
+      ProjectPropertyGraphForArguments(pg);
+
+  std::cout << "Projected graph has: "
+            << pg_projected_view->topology().NumNodes() << " nodes, "
+            << pg_projected_view->topology().NumEdges() << " edges\n";
+
+  std::cout << "Running Multilevel with " << numPartitions << " partitions\n";
+
+  PartitionPlan plan = PartitionPlan::Multilevel(
+      imbalance, refinementIterations, coarseningThreshold);
+
+  std::string output_property_name = "partition";
+
+  katana::TxnContext txn_ctx;
+  if (auto r = Partition(
+          pg_projected_view.get(), numPartitions, output_property_name,
+          &txn_ctx, plan);
+      !r) {
+    KATANA_LOG_FATAL("Failed to compute partition: {}", r.error());
+  }
+
+  auto stats_result = PartitionStatistics::Compute(
+      pg_projected_view.get(), numPartitions, output_property_name);
+  if (!stats_result) {
+    KATANA_LOG_FATAL(
+        "Failed to compute partition statistics: {}", stats_result.error());
+  }
+  auto stats = stats_result.value();
+  stats.Print();
+
+  if (!skipVerify) {
+    if (PartitionAssertValid(
+            pg_projected_view.get(), numPartitions, output_property_name)) {
+      std::cout << "Verification successful.\n";
+    } else {
+      KATANA_LOG_FATAL("verification failed");
+    }
+  }
+
+  if (output) {
+    auto r = pg_projected_view->GetNodePropertyTyped<uint32_t>(
+        output_property_name);
+    if (!r) {
+      KATANA_LOG_FATAL("Failed to get node property {}", r.error());
+    }
+    auto results = r.value();
+    KATANA_LOG_DEBUG_ASSERT(
+        uint64_t(results->length()) ==
+        pg_projected_view->topology().NumNodes());
+
+    writeOutput(outputLocation, results->raw_values(), results->length());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}
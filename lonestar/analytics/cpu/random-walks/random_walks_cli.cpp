@@ -69,6 +69,12 @@ static cll::opt<uint32_t> numberOfEdgeTypes(
     "numberOfEdgeTypes", cll::desc("Number of edge types (only for Edge2Vec)"),
     cll::init(1));
 
+static cll::opt<bool> weighted(
+    "weighted",
+    cll::desc("Follow edges proportionally to the edge property given by "
+              "-edgePropertyName (uniformly if it is not set)"),
+    cll::init(false));
+
 std::string
 AlgorithmName(RandomWalksPlan::Algorithm algorithm) {
   switch (algorithm) {
@@ -95,6 +101,24 @@ PrintWalks(
   }
 }
 
+void
+PrintWalks(
+    const arrow::FixedSizeListArray& walks, const std::string& output_file) {
+  std::ofstream f(output_file);
+  const auto& nodes = static_cast<const arrow::UInt32Array&>(*walks.values());
+
+  for (int64_t i = 0; i < walks.length(); ++i) {
+    int64_t begin = walks.value_offset(i);
+    for (int64_t j = begin; j < begin + walks.value_length(); ++j) {
+      if (nodes.IsNull(j)) {
+        break;
+      }
+      f << nodes.Value(j) << " ";
+    }
+    f << std::endl;
+  }
+}
+
 int
 main(int argc, char** argv) {
   std::unique_ptr<katana::SharedMemSys> G =
@@ -139,6 +163,21 @@ main(int argc, char** argv) {
     KATANA_LOG_FATAL("Invalid algorithm");
   }
 
+  if (weighted) {
+    auto walks_result = WeightedRandomWalks(pg.get(), edge_property_name, plan);
+    if (!walks_result) {
+      KATANA_LOG_FATAL(
+          "Failed to run WeightedRandomWalks: {}", walks_result.error());
+    }
+
+    if (output) {
+      std::string output_file = outputLocation + "/" + outputFile;
+      katana::gInfo("Writing random walks to a file: ", output_file);
+      PrintWalks(*walks_result.value(), output_file);
+    }
+    return 0;
+  }
+
   auto walks_result = RandomWalks(pg.get(), plan);
   if (!walks_result) {
     KATANA_LOG_FATAL("Failed to run RandomWalks: {}", walks_result.error());
@@ -75,6 +75,10 @@ static cll::opt<SsspPlan::Algorithm> algo(
         clEnumValN(
             SsspPlan::kDeltaStepFusion, "DeltaStepFusion",
             "Delta stepping with barrier and fused buckets"),
+        clEnumValN(
+            SsspPlan::kDeltaStepAuto, "DeltaStepAuto",
+            "Delta stepping with automatically tuned delta and light/heavy "
+            "edge splitting (ignores -delta)"),
         clEnumValN(
             SsspPlan::kSerialDelta, "SerialDelta", "Serial delta stepping"),
         clEnumValN(
@@ -109,6 +113,8 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "DeltaStepBarrier";
   case SsspPlan::kDeltaStepFusion:
     return "DeltaStepFusion";
+  case SsspPlan::kDeltaStepAuto:
+    return "DeltaStepAuto";
   case SsspPlan::kSerialDeltaTile:
     return "SerialDeltaTile";
   case SsspPlan::kSerialDelta:
@@ -225,6 +231,9 @@ main(int argc, char** argv) {
   case SsspPlan::kDeltaStepFusion:
     plan = SsspPlan::DeltaStepFusion(stepShift);
     break;
+  case SsspPlan::kDeltaStepAuto:
+    plan = SsspPlan::DeltaStepAuto();
+    break;
   case SsspPlan::kSerialDeltaTile:
     plan = SsspPlan::SerialDeltaTile(stepShift);
     break;
@@ -41,6 +41,7 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
             kPullResidual "katana::analytics::PagerankPlan::kPullResidual"
             kPushSynchronous "katana::analytics::PagerankPlan::kPushSynchronous"
             kPushAsynchronous "katana::analytics::PagerankPlan::kPushAsynchronous"
+            kPullBlocked "katana::analytics::PagerankPlan::kPullBlocked"
 
         # unsigned int kChunkSize
 
@@ -57,6 +58,8 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
         @staticmethod
         _PagerankPlan PullResidual(float tolerance, unsigned int max_iterations, float alpha)
         @staticmethod
+        _PagerankPlan PullBlocked(float tolerance, unsigned int max_iterations, float alpha)
+        @staticmethod
         _PagerankPlan PushAsynchronous(float tolerance, float alpha)
         @staticmethod
         _PagerankPlan PushSynchronous(float tolerance, unsigned int max_iterations, float alpha)
@@ -85,6 +88,7 @@ class _PagerankPlanAlgorithm(Enum):
     PullResidual = _PagerankPlan.Algorithm.kPullResidual
     PushSynchronous = _PagerankPlan.Algorithm.kPushSynchronous
     PushAsynchronous = _PagerankPlan.Algorithm.kPushAsynchronous
+    PullBlocked = _PagerankPlan.Algorithm.kPullBlocked
 
 
 cdef class PagerankPlan(Plan):
@@ -145,6 +149,15 @@ cdef class PagerankPlan(Plan):
         """
         return PagerankPlan.make(_PagerankPlan.PullResidual(tolerance, max_iterations, alpha))
 
+    @staticmethod
+    def pull_blocked(float tolerance = kDefaultTolerance, unsigned int max_iterations = kDefaultMaxIterations, float alpha = kDefaultAlpha):
+        """
+        Cache-blocked topological algorithm using propagation blocking
+
+        Computes the same ranks as pull_topological using an extra 8 bytes per edge.
+        """
+        return PagerankPlan.make(_PagerankPlan.PullBlocked(tolerance, max_iterations, alpha))
+
     @staticmethod
     def push_asynchronous(float tolerance = kDefaultTolerance, float alpha = kDefaultAlpha):
         """
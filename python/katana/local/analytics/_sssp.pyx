@@ -39,6 +39,7 @@ cdef extern from "katana/analytics/sssp/sssp.h" namespace "katana::analytics" no
             kDeltaStep "katana::analytics::SsspPlan::kDeltaStep"
             kDeltaStepBarrier "katana::analytics::SsspPlan::kDeltaStepBarrier"
             kDeltaStepFusion "katana::analytics::SsspPlan::kDeltaStepFusion"
+            kDeltaStepAuto "katana::analytics::SsspPlan::kDeltaStepAuto"
             kSerialDeltaTile "katana::analytics::SsspPlan::kSerialDeltaTile"
             kSerialDelta "katana::analytics::SsspPlan::kSerialDelta"
             kDijkstraTile "katana::analytics::SsspPlan::kDijkstraTile"
@@ -63,6 +64,8 @@ cdef extern from "katana/analytics/sssp/sssp.h" namespace "katana::analytics" no
         @staticmethod
         _SsspPlan DeltaStepFusion(unsigned delta)
         @staticmethod
+        _SsspPlan DeltaStepAuto()
+        @staticmethod
         _SsspPlan SerialDeltaTile(unsigned delta, ptrdiff_t edge_tile_size)
         @staticmethod
         _SsspPlan SerialDelta(unsigned delta)
@@ -105,6 +108,7 @@ class _SsspAlgorithm(Enum):
     DeltaStep = _SsspPlan.Algorithm.kDeltaStep
     DeltaStepBarrier = _SsspPlan.Algorithm.kDeltaStepBarrier
     DeltaStepFusion = _SsspPlan.Algorithm.kDeltaStepFusion
+    DeltaStepAuto = _SsspPlan.Algorithm.kDeltaStepAuto
     SerialDeltaTile = _SsspPlan.Algorithm.kSerialDeltaTile
     SerialDelta = _SsspPlan.Algorithm.kSerialDelta
     DijkstraTile = _SsspPlan.Algorithm.kDijkstraTile
@@ -198,6 +202,14 @@ cdef class SsspPlan(Plan):
         """
         return SsspPlan.make(_SsspPlan.DeltaStepFusion(delta))
 
+    @staticmethod
+    def delta_step_auto() -> SsspPlan:
+        """
+        Delta stepping with light/heavy edge splitting and a delta that is estimated from the graph and adjusted
+        while running
+        """
+        return SsspPlan.make(_SsspPlan.DeltaStepAuto())
+
     @staticmethod
     def serial_delta_tile(unsigned delta = kDefaultDelta, ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) -> SsspPlan:
         """